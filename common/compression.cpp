@@ -15,7 +15,9 @@ namespace EQ
 		if (deflateInit(&zstream, Z_FINISH) != Z_OK)
 			return 0;
 
-		return deflateBound(&zstream, len);
+		uint32 bound = deflateBound(&zstream, len);
+		deflateEnd(&zstream);
+		return bound;
 	}
 
 	uint32 DeflateData(const char *buffer, uint32 len, char *out_buffer, uint32 out_len_max) {
@@ -90,8 +90,35 @@ bool DBcore::DoesTableExist(std::string table_name)
 	return results.RowCount() > 0;
 }
 
+namespace {
+	thread_local uint64 thread_query_time_us = 0;
+	thread_local int    thread_query_depth   = 0;
+
+	// charges a query to the calling thread once, the reconnect retry runs nested inside the first attempt
+	struct QueryTimeScope {
+		std::chrono::steady_clock::time_point start;
+
+		QueryTimeScope() : start(std::chrono::steady_clock::now()) { ++thread_query_depth; }
+		~QueryTimeScope()
+		{
+			if (--thread_query_depth == 0) {
+				thread_query_time_us += std::chrono::duration_cast<std::chrono::microseconds>(
+					std::chrono::steady_clock::now() - start
+				).count();
+			}
+		}
+	};
+}
+
+uint64 DBcore::GetThreadQueryTimeUS()
+{
+	return thread_query_time_us;
+}
+
 MySQLRequestResult DBcore::QueryDatabase(const char *query, uint32 querylen, bool retryOnFailureOnce)
 {
+	QueryTimeScope query_time;
+
 	BenchTimer timer;
 	timer.reset();
 
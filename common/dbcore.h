@@ -37,6 +37,11 @@ public:
 
 	bool DoesTableExist(std::string table_name);
 
+	/**
+	 * Wall time the calling thread has spent inside QueryDatabase, across all connections
+	 */
+	static uint64 GetThreadQueryTimeUS();
+
 protected:
 	bool Open(
 		const char *iHost,
@@ -74,6 +74,10 @@ void EQEmuConfig::parse_config()
 	WorldIP      = _root["server"]["world"]["tcp"].get("host", "127.0.0.1").asString();
 	WorldTCPPort = atoi(_root["server"]["world"]["tcp"].get("port", "9000").asString().c_str());
 
+	// compact encoding is negotiated per connection, so peers without it keep the legacy layout
+	WorldTCPCompact  = _root["server"]["world"]["tcp"].get("compact", "true").asString() == "true";
+	WorldTCPCompress = _root["server"]["world"]["tcp"].get("compress", "false").asString() == "true";
+
 	TelnetIP      = _root["server"]["world"]["telnet"].get("ip", "127.0.0.1").asString();
 	TelnetTCPPort = atoi(_root["server"]["world"]["telnet"].get("port", "9001").asString().c_str());
 	TelnetEnabled = false;
@@ -121,6 +125,9 @@ void EQEmuConfig::parse_config()
 	QSDatabaseUsername = _root["server"]["qsdatabase"].get("username", "eq").asString();
 	QSDatabasePassword = _root["server"]["qsdatabase"].get("password", "eq").asString();
 	QSDatabaseDB       = _root["server"]["qsdatabase"].get("db", "eq").asString();
+	QSBatchSize        = atoi(_root["server"]["qsdatabase"].get("batch_size", "100").asString().c_str());
+	QSBatchFlushMS     = atoi(_root["server"]["qsdatabase"].get("batch_flush_ms", "1000").asString().c_str());
+	QSSpoolFile        = _root["server"]["qsdatabase"].get("spool_file", "").asString();
 
 	/**
 	 * Zones
@@ -203,6 +210,12 @@ std::string EQEmuConfig::GetByName(const std::string &var_name) const
 	if (var_name == "WorldIP") {
 		return (WorldIP);
 	}
+	if (var_name == "WorldTCPCompact") {
+		return (WorldTCPCompact ? "true" : "false");
+	}
+	if (var_name == "WorldTCPCompress") {
+		return (WorldTCPCompress ? "true" : "false");
+	}
 	if (var_name == "TelnetTCPPort") {
 		return (itoa(TelnetTCPPort));
 	}
@@ -263,6 +276,15 @@ std::string EQEmuConfig::GetByName(const std::string &var_name) const
 	if (var_name == "QSDatabasePort") {
 		return (itoa(QSDatabasePort));
 	}
+	if (var_name == "QSBatchSize") {
+		return (itoa(QSBatchSize));
+	}
+	if (var_name == "QSBatchFlushMS") {
+		return (itoa(QSBatchFlushMS));
+	}
+	if (var_name == "QSSpoolFile") {
+		return (QSSpoolFile);
+	}
 	if (var_name == "SpellsFile") {
 		return (SpellsFile);
 	}
@@ -332,6 +354,8 @@ void EQEmuConfig::Dump() const
 	std::cout << "Locked = " << Locked << std::endl;
 	std::cout << "WorldTCPPort = " << WorldTCPPort << std::endl;
 	std::cout << "WorldIP = " << WorldIP << std::endl;
+	std::cout << "WorldTCPCompact = " << WorldTCPCompact << std::endl;
+	std::cout << "WorldTCPCompress = " << WorldTCPCompress << std::endl;
 	std::cout << "TelnetTCPPort = " << TelnetTCPPort << std::endl;
 	std::cout << "TelnetIP = " << TelnetIP << std::endl;
 	std::cout << "TelnetEnabled = " << TelnetEnabled << std::endl;
@@ -352,6 +376,9 @@ void EQEmuConfig::Dump() const
 	std::cout << "QSDatabasePassword = " << QSDatabasePassword << std::endl;
 	std::cout << "QSDatabaseDB = " << QSDatabaseDB << std::endl;
 	std::cout << "QSDatabasePort = " << QSDatabasePort << std::endl;
+	std::cout << "QSBatchSize = " << QSBatchSize << std::endl;
+	std::cout << "QSBatchFlushMS = " << QSBatchFlushMS << std::endl;
+	std::cout << "QSSpoolFile = " << QSSpoolFile << std::endl;
 	std::cout << "SpellsFile = " << SpellsFile << std::endl;
 	std::cout << "OpCodesFile = " << OpCodesFile << std::endl;
 	std::cout << "MailOpcodesFile = " << MailOpCodesFile << std::endl;
@@ -50,6 +50,8 @@ class EQEmuConfig
 		bool Locked;
 		uint16 WorldTCPPort;
 		std::string WorldIP;
+		bool WorldTCPCompact;
+		bool WorldTCPCompress;
 		uint16 TelnetTCPPort;
 		std::string TelnetIP;
 		bool TelnetEnabled;
@@ -87,6 +89,9 @@ class EQEmuConfig
 		std::string QSDatabasePassword;
 		std::string QSDatabaseDB;
 		uint16 QSDatabasePort;
+		uint32 QSBatchSize;
+		uint32 QSBatchFlushMS;
+		std::string QSSpoolFile;
 
 		// From <files/>
 		std::string SpellsFile;
@@ -25,15 +25,18 @@
 #include "database.h"
 #include "misc.h"
 
+#include <atomic>
+#include <condition_variable>
 #include <iostream>
 #include <fstream>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 #include <iomanip>
 #include <time.h>
 #include <sys/stat.h>
 
-std::ofstream process_log;
-
 #ifdef _WINDOWS
 #include <direct.h>
 #include <conio.h>
@@ -82,6 +85,221 @@ namespace Console {
 	};
 }
 
+/**
+ * Bounded multi-producer ring buffer of pending file log lines. Every cell carries a sequence number
+ * that tells producers and the consumer whose turn it is, so enqueueing never takes a lock and a full
+ * buffer fails immediately instead of stalling the game thread.
+ */
+class FileLogRing {
+public:
+	struct Record {
+		uint16      log_category;
+		time_t      time_stamp;
+		std::string message;
+	};
+
+	explicit FileLogRing(size_t capacity)
+	{
+		size_t size = 2;
+		while (size < capacity) {
+			size <<= 1;
+		}
+
+		mask  = size - 1;
+		cells = std::vector<Cell>(size);
+		for (size_t i = 0; i < size; ++i) {
+			cells[i].sequence.store(i, std::memory_order_relaxed);
+		}
+
+		enqueue_pos.store(0, std::memory_order_relaxed);
+		dequeue_pos.store(0, std::memory_order_relaxed);
+	}
+
+	bool Push(Record &&record)
+	{
+		Cell   *cell;
+		size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+		for (;;) {
+			cell = &cells[pos & mask];
+			size_t   seq  = cell->sequence.load(std::memory_order_acquire);
+			intptr_t diff = (intptr_t) seq - (intptr_t) pos;
+			if (diff == 0) {
+				if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+					break;
+				}
+			}
+			else if (diff < 0) {
+				return false;
+			}
+			else {
+				pos = enqueue_pos.load(std::memory_order_relaxed);
+			}
+		}
+
+		cell->record = std::move(record);
+		cell->sequence.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+
+	// single consumer, only the writer thread calls this
+	bool Pop(Record &record)
+	{
+		size_t   pos  = dequeue_pos.load(std::memory_order_relaxed);
+		Cell     *cell = &cells[pos & mask];
+		size_t   seq  = cell->sequence.load(std::memory_order_acquire);
+		intptr_t diff = (intptr_t) seq - (intptr_t) (pos + 1);
+		if (diff < 0) {
+			return false;
+		}
+
+		dequeue_pos.store(pos + 1, std::memory_order_relaxed);
+		record = std::move(cell->record);
+		cell->sequence.store(pos + mask + 1, std::memory_order_release);
+		return true;
+	}
+
+private:
+	struct Cell {
+		std::atomic<size_t> sequence;
+		Record              record;
+
+		Cell() : sequence(0) {}
+		Cell(Cell &&o) : sequence(o.sequence.load()), record(std::move(o.record)) {}
+	};
+
+	std::vector<Cell>   cells;
+	size_t              mask;
+	std::atomic<size_t> enqueue_pos;
+	std::atomic<size_t> dequeue_pos;
+};
+
+/**
+ * Owns the process log file. The game thread only pushes records, timestamping, writing, flushing and
+ * size based rotation all happen on the writer thread.
+ */
+struct EQEmuLogSys::FileLogWriter {
+	FileLogWriter(const std::string &file_path, size_t buffer_lines, uint64 rotate_bytes)
+		: path(file_path), ring(buffer_lines), rotate_bytes(rotate_bytes)
+	{
+		file.open(path, std::ios_base::app | std::ios_base::out);
+		written = file ? static_cast<uint64>(file.tellp()) : 0;
+		running = true;
+		dropped = 0;
+		thread  = std::thread(&FileLogWriter::Run, this);
+	}
+
+	~FileLogWriter()
+	{
+		{
+			std::lock_guard<std::mutex> lock(wake_lock);
+			running = false;
+		}
+		wake.notify_one();
+		thread.join();
+	}
+
+	void Push(uint16 log_category, const std::string &message)
+	{
+		FileLogRing::Record record;
+		record.log_category = log_category;
+		record.time_stamp   = time(nullptr);
+		record.message      = message;
+
+		if (!ring.Push(std::move(record))) {
+			dropped.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	void Run()
+	{
+		FileLogRing::Record record;
+		time_t              stamped_time = 0;
+		char                time_stamp[80] = {0};
+		uint64              reported_dropped = 0;
+
+		for (;;) {
+			bool wrote = false;
+			while (ring.Pop(record)) {
+				// localtime/strftime once per second rather than once per line
+				if (record.time_stamp != stamped_time) {
+					struct tm *time_info = localtime(&record.time_stamp);
+					strftime(time_stamp, sizeof(time_stamp), "[%m-%d-%Y :: %H:%M:%S]", time_info);
+					stamped_time = record.time_stamp;
+				}
+
+				Write(time_stamp, record.message);
+				wrote = true;
+			}
+
+			auto total_dropped = dropped.load(std::memory_order_relaxed);
+			if (total_dropped != reported_dropped) {
+				Write(
+					time_stamp,
+					fmt::format("[Logging] File log buffer full, dropped [{}] lines", total_dropped - reported_dropped)
+				);
+				reported_dropped = total_dropped;
+				wrote = true;
+			}
+
+			if (wrote && file) {
+				file.flush();
+			}
+
+			std::unique_lock<std::mutex> lock(wake_lock);
+			if (!running) {
+				// anything pushed before the stop is drained on this last pass
+				lock.unlock();
+				while (ring.Pop(record)) {
+					Write(time_stamp, record.message);
+				}
+				if (file) {
+					file.flush();
+				}
+				return;
+			}
+
+			wake.wait_for(lock, std::chrono::milliseconds(25));
+		}
+	}
+
+	void Write(const char *time_stamp, const std::string &message)
+	{
+		if (!file) {
+			return;
+		}
+
+		file << time_stamp << " " << message << "\n";
+		written += strlen(time_stamp) + message.length() + 2;
+
+		if (rotate_bytes > 0 && written >= rotate_bytes) {
+			Rotate();
+		}
+	}
+
+	void Rotate()
+	{
+		file.close();
+
+		std::string rotated = path + ".1";
+		remove(rotated.c_str());
+		rename(path.c_str(), rotated.c_str());
+
+		file.open(path, std::ios_base::trunc | std::ios_base::out);
+		written = 0;
+	}
+
+	std::string             path;
+	std::ofstream           file;
+	FileLogRing             ring;
+	uint64                  rotate_bytes;
+	uint64                  written;
+	std::thread             thread;
+	std::mutex              wake_lock;
+	std::condition_variable wake;
+	bool                    running;
+	std::atomic<uint64>     dropped;
+};
+
 /**
  * EQEmuLogSys Constructor
  */
@@ -94,7 +312,10 @@ EQEmuLogSys::EQEmuLogSys()
 /**
  * EQEmuLogSys Deconstructor
  */
-EQEmuLogSys::~EQEmuLogSys() = default;
+EQEmuLogSys::~EQEmuLogSys()
+{
+	CloseFileLogs();
+}
 
 void EQEmuLogSys::LoadLogSettingsDefaults()
 {
@@ -207,12 +428,14 @@ std::string EQEmuLogSys::FormatOutMessageString(
 )
 {
 	std::string return_string;
+	return_string.reserve(in_message.length() + 48);
 
 	if (IsRfc5424LogCategory(log_category)) {
-		return_string = "[" + GetPlatformName() + "] ";
+		return_string.append("[").append(GetPlatformName()).append("] ");
 	}
 
-	return return_string + "[" + Logs::LogCategoryName[log_category] + "] " + in_message;
+	return_string.append("[").append(Logs::LogCategoryName[log_category]).append("] ").append(in_message);
+	return return_string;
 }
 
 /**
@@ -265,14 +488,19 @@ void EQEmuLogSys::ProcessLogWrite(
 		crash_log.close();
 	}
 
-	char time_stamp[80];
-	EQEmuLogSys::SetCurrentTimeStamp(time_stamp);
-
-	if (process_log) {
-		process_log << time_stamp << " " << message << std::endl;
+	if (file_log_writer) {
+		file_log_writer->Push(log_category, message);
 	}
 }
 
+/**
+ * @return
+ */
+uint64 EQEmuLogSys::GetDroppedFileLogLines() const
+{
+	return file_log_writer ? file_log_writer->dropped.load(std::memory_order_relaxed) : 0;
+}
+
 /**
  * @param log_category
  * @return
@@ -459,26 +687,100 @@ void EQEmuLogSys::Out(
 		return;
 	}
 
-	std::string prefix;
-
-	if (RuleB(Logging, PrintFileFunctionAndLine)) {
-		prefix = fmt::format("[{0}::{1}:{2}] ", base_file_name(file), func, line);
-	}
-
 	va_list args;
 	va_start(args, message);
 	std::string output_message = vStringFormat(message, args);
 	va_end(args);
 
-	std::string output_debug_message = EQEmuLogSys::FormatOutMessageString(log_category, prefix + output_message);
+	OutMessage(debug_level, log_category, file, func, line, output_message);
+}
 
-	if (log_to_console) {
+/**
+ * @param debug_level
+ * @param log_category
+ * @param file
+ * @param func
+ * @param line
+ * @param message
+ */
+void EQEmuLogSys::OutFormatted(
+	Logs::DebugLevel debug_level,
+	uint16 log_category,
+	const char *file,
+	const char *func,
+	int line,
+	const std::string &message
+)
+{
+	if (!IsLogEnabled(debug_level, log_category)) {
+		return;
+	}
+
+	OutMessage(debug_level, log_category, file, func, line, message);
+}
+
+static thread_local std::vector<EQEmuLogSys::DeferredMessage> *deferred_thread_messages = nullptr;
+
+/**
+ * @param messages
+ */
+void EQEmuLogSys::DeferThreadMessages(std::vector<DeferredMessage> *messages)
+{
+	deferred_thread_messages = messages;
+}
+
+/**
+ * @param messages
+ */
+void EQEmuLogSys::OutDeferred(const std::vector<DeferredMessage> &messages)
+{
+	for (auto &m : messages) {
+		OutMessage(m.debug_level, m.log_category, m.file, m.func, m.line, m.message);
+	}
+}
+
+/**
+ * @param debug_level
+ * @param log_category
+ * @param file
+ * @param func
+ * @param line
+ * @param message
+ */
+void EQEmuLogSys::OutMessage(
+	Logs::DebugLevel debug_level,
+	uint16 log_category,
+	const char *file,
+	const char *func,
+	int line,
+	const std::string &message
+)
+{
+	if (deferred_thread_messages) {
+		deferred_thread_messages->push_back(DeferredMessage{debug_level, log_category, file, func, line, message});
+		return;
+	}
+
+	const LogSettings &settings = log_settings[log_category];
+
+	std::string output_debug_message;
+	if (RuleB(Logging, PrintFileFunctionAndLine)) {
+		output_debug_message = EQEmuLogSys::FormatOutMessageString(
+			log_category,
+			fmt::format("[{0}::{1}:{2}] {3}", base_file_name(file), func, line, message)
+		);
+	}
+	else {
+		output_debug_message = EQEmuLogSys::FormatOutMessageString(log_category, message);
+	}
+
+	if (settings.log_to_console >= debug_level) {
 		EQEmuLogSys::ProcessConsoleMessage(debug_level, log_category, output_debug_message);
 	}
-	if (log_to_gmsay) {
+	if (settings.log_to_gmsay >= debug_level) {
 		EQEmuLogSys::ProcessGMSay(debug_level, log_category, output_debug_message);
 	}
-	if (log_to_file) {
+	if (settings.log_to_file >= debug_level) {
 		EQEmuLogSys::ProcessLogWrite(debug_level, log_category, output_debug_message);
 	}
 }
@@ -516,9 +818,8 @@ void EQEmuLogSys::MakeDirectory(const std::string &directory_name)
 
 void EQEmuLogSys::CloseFileLogs()
 {
-	if (process_log.is_open()) {
-		process_log.close();
-	}
+	// joins the writer thread after it drains whatever is still buffered
+	file_log_writer.reset();
 }
 
 /**
@@ -557,9 +858,12 @@ void EQEmuLogSys::StartFileLogs(const std::string &log_name)
 		/**
 		 * Open file pointer
 		 */
-		process_log.open(
-			StringFormat("logs/zone/%s_%i.log", platform_file_name.c_str(), getpid()),
-			std::ios_base::app | std::ios_base::out
+		file_log_writer.reset(
+			new FileLogWriter(
+				StringFormat("logs/zone/%s_%i.log", platform_file_name.c_str(), getpid()),
+				RuleI(Logging, FileLogBufferLines),
+				static_cast<uint64>(RuleI(Logging, FileLogRotateSizeMB)) * 1024 * 1024
+			)
 		);
 	}
 	else {
@@ -576,9 +880,12 @@ void EQEmuLogSys::StartFileLogs(const std::string &log_name)
 		/**
 		 * Open file pointer
 		 */
-		process_log.open(
-			StringFormat("logs/%s_%i.log", platform_file_name.c_str(), getpid()),
-			std::ios_base::app | std::ios_base::out
+		file_log_writer.reset(
+			new FileLogWriter(
+				StringFormat("logs/%s_%i.log", platform_file_name.c_str(), getpid()),
+				RuleI(Logging, FileLogBufferLines),
+				static_cast<uint64>(RuleI(Logging, FileLogRotateSizeMB)) * 1024 * 1024
+			)
 		);
 	}
 }
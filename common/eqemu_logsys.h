@@ -25,6 +25,9 @@
 #include <fstream>
 #include <stdio.h>
 #include <functional>
+#include <memory>
+#include <string>
+#include <vector>
 
 #ifdef _WIN32
 #ifdef utf16_to_utf8
@@ -242,6 +245,55 @@ public:
 		...
 	);
 
+	/**
+	 * Same as Out, for messages that are already formatted (fmt based aliases), skips the printf pass
+	 */
+	void OutFormatted(
+		Logs::DebugLevel debug_level,
+		uint16 log_category,
+		const char *file,
+		const char *func,
+		int line,
+		const std::string &message
+	);
+
+	/**
+	 * Cheap check callers can make before paying for formatting, true when any output wants this level
+	 *
+	 * @param debug_level
+	 * @param log_category
+	 * @return
+	 */
+	inline bool IsLogEnabled(Logs::DebugLevel debug_level, uint16 log_category) const
+	{
+		const LogSettings &s = log_settings[log_category];
+		return s.log_to_console >= debug_level || s.log_to_file >= debug_level || s.log_to_gmsay >= debug_level;
+	}
+
+	/**
+	 * Lines the background file writer had to throw away because its buffer was full
+	 */
+	uint64 GetDroppedFileLogLines() const;
+
+	struct DeferredMessage {
+		Logs::DebugLevel debug_level;
+		uint16           log_category;
+		const char       *file;
+		const char       *func;
+		int              line;
+		std::string      message;
+	};
+
+	/**
+	 * While set, messages logged from the calling thread are appended to messages instead of reaching the console,
+	 * file and gmsay outputs. Worker threads use it and hand the messages to the main thread to replay with
+	 * OutDeferred, the gmsay hook in zone touches the entity list
+	 *
+	 * @param messages nullptr logs normally again
+	 */
+	static void DeferThreadMessages(std::vector<DeferredMessage> *messages);
+	void OutDeferred(const std::vector<DeferredMessage> &messages);
+
 	/**
 	 * Used in file logs to prepend a timestamp entry for logs
 	 * @param time_stamp
@@ -319,6 +371,12 @@ public:
 
 private:
 
+	/**
+	 * File logs are written from a background thread, see FileLogWriter in eqemu_logsys.cpp
+	 */
+	struct FileLogWriter;
+	std::unique_ptr<FileLogWriter> file_log_writer;
+
 	/**
 	 * Callback pointer to zone process for hooking logs to zone using GMSay
 	 */
@@ -330,6 +388,18 @@ private:
 	 */
 	std::string FormatOutMessageString(uint16 log_category, const std::string &in_message);
 
+	/**
+	 * Routes a formatted message to the enabled outputs
+	 */
+	void OutMessage(
+		Logs::DebugLevel debug_level,
+		uint16 log_category,
+		const char *file,
+		const char *func,
+		int line,
+		const std::string &message
+	);
+
 	/**
 	 * Linux console color messages mapped by category
 	 *
@@ -393,7 +463,8 @@ void OutF(
 
 #define OutF(ls, debug_level, log_category, file, func, line, formatStr, ...) \
 do { \
-    ls.Out(debug_level, log_category, file, func, line, fmt::format(formatStr, ##__VA_ARGS__).c_str()); \
+    if (ls.IsLogEnabled(debug_level, log_category)) \
+        ls.OutFormatted(debug_level, log_category, file, func, line, fmt::format(formatStr, ##__VA_ARGS__)); \
 } while(0)
 
 #endif
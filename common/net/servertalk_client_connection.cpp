@@ -1,4 +1,5 @@
 #include "servertalk_client_connection.h"
+#include "servertalk_codec.h"
 #include "dns.h"
 #include "../eqemu_logsys.h"
 
@@ -10,6 +11,8 @@ EQ::Net::ServertalkClient::ServertalkClient(const std::string &addr, int port, b
 	m_identifier = identifier.empty() ? "Unknown" : identifier;
 	m_credentials = credentials;
 	m_connecting = false;
+	m_encrypted = false;
+	m_features = 0;
 	DNSLookup(addr, port, false, [this](const std::string &address) {
 		m_addr = address;
 	});
@@ -20,6 +23,19 @@ EQ::Net::ServertalkClient::~ServertalkClient()
 }
 
 void EQ::Net::ServertalkClient::Send(uint16_t opcode, EQ::Net::Packet &p)
+{
+	// empty payloads keep the legacy framing, which is how they have always been delivered
+	if ((m_features & ServertalkFeatureCompact) && p.Length() > 0) {
+		EQ::Net::DynamicPacket compact;
+		ServertalkCompactEncode(p, compact, (m_features & ServertalkFeatureCompress) != 0);
+		InternalSendMessage(ServertalkCompactMessage, opcode, compact);
+		return;
+	}
+
+	InternalSendMessage(ServertalkMessage, opcode, p);
+}
+
+void EQ::Net::ServertalkClient::InternalSendMessage(ServertalkPacketType type, uint16_t opcode, EQ::Net::Packet &p)
 {
 	EQ::Net::DynamicPacket out;
 #ifdef ENABLE_SECURITY
@@ -47,7 +63,7 @@ void EQ::Net::ServertalkClient::Send(uint16_t opcode, EQ::Net::Packet &p)
 	out.PutUInt16(4, opcode);
 	out.PutPacket(6, p);
 #endif
-	InternalSend(ServertalkMessage, out);
+	InternalSend(type, out);
 }
 
 void EQ::Net::ServertalkClient::SendPacket(ServerPacket *p)
@@ -88,6 +104,7 @@ void EQ::Net::ServertalkClient::Connect()
 		m_connection->OnDisconnect([this](EQ::Net::TCPConnection *c) {
 			LogF(Logs::General, Logs::TCPConnection, "Connection lost to {0}:{1}, attempting to reconnect...", m_addr, m_port);
 			m_encrypted = false;
+			m_features = 0;
 			m_connection.reset();
 		});
 
@@ -169,9 +186,15 @@ void EQ::Net::ServertalkClient::ProcessReadBuffer()
 			case ServertalkServerHello:
 				ProcessHello(p);
 				break;
+			case ServertalkServerFeatures:
+				ProcessFeatures(p);
+				break;
 			case ServertalkMessage:
 				ProcessMessage(p);
 				break;
+			case ServertalkCompactMessage:
+				ProcessMessage(p, true);
+				break;
 			}
 		}
 
@@ -196,6 +219,7 @@ void EQ::Net::ServertalkClient::ProcessHello(EQ::Net::Packet &p)
 	memset(m_nonce_theirs, 0, crypto_box_NONCEBYTES);
 	memset(m_shared_key, 0, crypto_box_BEFORENMBYTES);
 	m_encrypted = false;
+	m_features = 0;
 
 	try {
 		bool enc = p.GetInt8(0) == 1 ? true : false;
@@ -233,6 +257,8 @@ void EQ::Net::ServertalkClient::ProcessHello(EQ::Net::Packet &p)
 		}
 	}
 #else
+	m_features = 0;
+
 	try {
 		bool enc = p.GetInt8(0) == 1 ? true : false;
 
@@ -262,7 +288,18 @@ void EQ::Net::ServertalkClient::ProcessHello(EQ::Net::Packet &p)
 #endif
 }
 
-void EQ::Net::ServertalkClient::ProcessMessage(EQ::Net::Packet &p)
+void EQ::Net::ServertalkClient::ProcessFeatures(EQ::Net::Packet &p)
+{
+	try {
+		m_features = p.GetUInt8(0);
+		LogF(Logs::General, Logs::TCPConnection, "Server at {0}:{1} accepted features {2}", m_addr, m_port, m_features);
+	}
+	catch (std::exception &ex) {
+		LogError("Error parsing features from server: {0}", ex.what());
+	}
+}
+
+void EQ::Net::ServertalkClient::ProcessMessage(EQ::Net::Packet &p, bool compact)
 {
 	try {
 		auto length = p.GetUInt32(0);
@@ -284,41 +321,20 @@ void EQ::Net::ServertalkClient::ProcessMessage(EQ::Net::Packet &p)
 
 				(*(uint64_t*)&m_nonce_theirs[0])++;
 
-				auto cb = m_message_callbacks.find(opcode);
-				if (cb != m_message_callbacks.end()) {
-					cb->second(opcode, decrypted_packet);
-				}
-
-				if (m_message_callback) {
-					m_message_callback(opcode, decrypted_packet);
-				}
+				DeliverMessage(opcode, decrypted_packet, compact);
 			}
 			else {
 				size_t message_len = length;
 				EQ::Net::StaticPacket packet(&data[0], message_len);
 
-				auto cb = m_message_callbacks.find(opcode);
-				if (cb != m_message_callbacks.end()) {
-					cb->second(opcode, packet);
-				}
-
-				if (m_message_callback) {
-					m_message_callback(opcode, packet);
-				}
+				DeliverMessage(opcode, packet, compact);
 			}
 
 #else
 			size_t message_len = length;
 			EQ::Net::StaticPacket packet(&data[0], message_len);
 
-			auto cb = m_message_callbacks.find(opcode);
-			if (cb != m_message_callbacks.end()) {
-				cb->second(opcode, packet);
-			}
-
-			if (m_message_callback) {
-				m_message_callback(opcode, packet);
-			}
+			DeliverMessage(opcode, packet, compact);
 #endif
 		}
 	}
@@ -327,6 +343,26 @@ void EQ::Net::ServertalkClient::ProcessMessage(EQ::Net::Packet &p)
 	}
 }
 
+void EQ::Net::ServertalkClient::DeliverMessage(uint16_t opcode, EQ::Net::Packet &p, bool compact)
+{
+	EQ::Net::DynamicPacket decoded;
+	if (compact && !ServertalkCompactDecode(p, decoded)) {
+		LogError("Error decoding compact message {0:#x} from server", opcode);
+		return;
+	}
+
+	EQ::Net::Packet &packet = compact ? static_cast<EQ::Net::Packet&>(decoded) : p;
+
+	auto cb = m_message_callbacks.find(opcode);
+	if (cb != m_message_callbacks.end()) {
+		cb->second(opcode, packet);
+	}
+
+	if (m_message_callback) {
+		m_message_callback(opcode, packet);
+	}
+}
+
 void EQ::Net::ServertalkClient::SendHandshake(bool downgrade)
 {
 	EQ::Net::DynamicPacket handshake;
@@ -344,8 +380,8 @@ void EQ::Net::ServertalkClient::SendHandshake(bool downgrade)
 		memset(m_public_key_theirs, 0, crypto_box_PUBLICKEYBYTES);
 		memset(m_private_key_ours, 0, crypto_box_SECRETKEYBYTES);
 
-		size_t cipher_length = m_identifier.length() + 1 + m_credentials.length() + 1 + crypto_secretbox_MACBYTES;
-		size_t data_length = m_identifier.length() + 1 + m_credentials.length() + 1;
+		size_t cipher_length = m_identifier.length() + 1 + m_credentials.length() + 1 + 1 + crypto_secretbox_MACBYTES;
+		size_t data_length = m_identifier.length() + 1 + m_credentials.length() + 1 + 1;
 		
 		std::unique_ptr<unsigned char[]> signed_buffer(new unsigned char[cipher_length]);
 		std::unique_ptr<unsigned char[]> data_buffer(new unsigned char[data_length]);
@@ -353,6 +389,7 @@ void EQ::Net::ServertalkClient::SendHandshake(bool downgrade)
 		memset(&data_buffer[0], 0, data_length);
 		memcpy(&data_buffer[0], m_identifier.c_str(), m_identifier.length());
 		memcpy(&data_buffer[1 + m_identifier.length()], m_credentials.c_str(), m_credentials.length());
+		data_buffer[data_length - 1] = ServertalkFeatureCompact | ServertalkFeatureCompress;
 		
 		crypto_box_easy_afternm(&signed_buffer[0], &data_buffer[0], data_length, m_nonce_ours, m_shared_key);
 
@@ -364,11 +401,13 @@ void EQ::Net::ServertalkClient::SendHandshake(bool downgrade)
 		handshake.PutString(0, m_identifier);
 		handshake.PutString(m_identifier.length() + 1, m_credentials);
 		handshake.PutUInt8(m_identifier.length() + 1 + m_credentials.length(), 0);
+		handshake.PutUInt8(m_identifier.length() + 1 + m_credentials.length() + 1, ServertalkFeatureCompact | ServertalkFeatureCompress);
 	}
 #else
 	handshake.PutString(0, m_identifier);
 	handshake.PutString(m_identifier.length() + 1, m_credentials);
 	handshake.PutUInt8(m_identifier.length() + 1 + m_credentials.length(), 0);
+	handshake.PutUInt8(m_identifier.length() + 1 + m_credentials.length() + 1, ServertalkFeatureCompact | ServertalkFeatureCompress);
 #endif
 
 	if (downgrade) {
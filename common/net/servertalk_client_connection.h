@@ -33,7 +33,11 @@ namespace EQ
 			void InternalSend(ServertalkPacketType type, EQ::Net::Packet &p);
 			void ProcessReadBuffer();
 			void ProcessHello(EQ::Net::Packet &p);
-			void ProcessMessage(EQ::Net::Packet &p);
+			void ProcessFeatures(EQ::Net::Packet &p);
+			void ProcessMessage(EQ::Net::Packet &p) { ProcessMessage(p, false); }
+			void ProcessMessage(EQ::Net::Packet &p, bool compact);
+			void InternalSendMessage(ServertalkPacketType type, uint16_t opcode, EQ::Net::Packet &p);
+			void DeliverMessage(uint16_t opcode, EQ::Net::Packet &p, bool compact);
 			void SendHandshake() { SendHandshake(false); }
 			void SendHandshake(bool downgrade);
 
@@ -46,6 +50,7 @@ namespace EQ
 			int m_port;
 			bool m_ipv6;
 			bool m_encrypted;
+			uint8_t m_features;
 			std::shared_ptr<EQ::Net::TCPConnection> m_connection;
 			std::vector<char> m_buffer;
 			std::unordered_map<uint16_t, std::function<void(uint16_t, EQ::Net::Packet&)>> m_message_callbacks;
@@ -0,0 +1,184 @@
+#include "servertalk_codec.h"
+#include "../types.h"
+#include "../compression.h"
+
+#include <vector>
+
+namespace
+{
+	// zero runs shorter than this cost more as a run than as literal bytes
+	const size_t MinZeroRun = 3;
+
+	// deflate is only tried on run streams at least this long
+	const size_t MinDeflateLength = 128;
+
+	void PutVarint(std::vector<char> &out, uint64_t value)
+	{
+		while (value >= 0x80) {
+			out.push_back((char)((value & 0x7f) | 0x80));
+			value >>= 7;
+		}
+
+		out.push_back((char)value);
+	}
+
+	bool GetVarint(const unsigned char *data, size_t length, size_t &offset, uint64_t &value)
+	{
+		value = 0;
+		for (int shift = 0; shift < 64; shift += 7) {
+			if (offset >= length) {
+				return false;
+			}
+
+			auto byte = data[offset++];
+			value |= (uint64_t)(byte & 0x7f) << shift;
+			if ((byte & 0x80) == 0) {
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	size_t ZeroRunLength(const unsigned char *data, size_t length, size_t offset)
+	{
+		size_t end = offset;
+		while (end < length && data[end] == 0) {
+			end++;
+		}
+
+		return end - offset;
+	}
+}
+
+void EQ::Net::ServertalkCompactEncode(const Packet &in, DynamicPacket &out, bool compress)
+{
+	auto length = in.Length();
+	auto data = length > 0 ? (const unsigned char*)in.Data() : nullptr;
+
+	std::vector<char> runs;
+	runs.reserve(length / 2 + 16);
+
+	size_t current = 0;
+	while (current < length) {
+		size_t literal_end = current;
+		size_t zeros = 0;
+		while (literal_end < length) {
+			zeros = ZeroRunLength(data, length, literal_end);
+			if (zeros >= MinZeroRun || literal_end + zeros == length) {
+				break;
+			}
+
+			literal_end += zeros > 0 ? zeros : 1;
+			zeros = 0;
+		}
+
+		PutVarint(runs, literal_end - current);
+		runs.insert(runs.end(), (const char*)data + current, (const char*)data + literal_end);
+		PutVarint(runs, zeros);
+
+		current = literal_end + zeros;
+	}
+
+	std::vector<char> header;
+	uint8_t flags = 0;
+
+	std::vector<char> deflated;
+	if (compress && runs.size() >= MinDeflateLength) {
+		deflated.resize(EQ::EstimateDeflateBuffer((uint32)runs.size()));
+		auto deflated_length = deflated.empty() ? 0 : EQ::DeflateData(&runs[0], (uint32)runs.size(), &deflated[0], (uint32)deflated.size());
+		if (deflated_length > 0 && deflated_length < runs.size()) {
+			deflated.resize(deflated_length);
+			flags |= ServertalkCompactDeflated;
+		}
+	}
+
+	header.push_back((char)flags);
+	PutVarint(header, length);
+
+	out.Clear();
+	if (flags & ServertalkCompactDeflated) {
+		PutVarint(header, runs.size());
+		out.PutData(0, &header[0], header.size());
+		out.PutData(header.size(), &deflated[0], deflated.size());
+	}
+	else {
+		out.PutData(0, &header[0], header.size());
+		if (!runs.empty()) {
+			out.PutData(header.size(), &runs[0], runs.size());
+		}
+	}
+}
+
+bool EQ::Net::ServertalkCompactDecode(const Packet &in, DynamicPacket &out)
+{
+	auto data = (const unsigned char*)in.Data();
+	auto length = in.Length();
+
+	if (length < 2) {
+		return false;
+	}
+
+	uint8_t flags = data[0];
+	size_t offset = 1;
+
+	uint64_t payload_length = 0;
+	if (!GetVarint(data, length, offset, payload_length)) {
+		return false;
+	}
+
+	// far beyond any ServerTalk packet, only a corrupt length gets here
+	if (payload_length > 0x7fffffff) {
+		return false;
+	}
+
+	std::vector<char> inflated;
+	if (flags & ServertalkCompactDeflated) {
+		uint64_t runs_length = 0;
+		// a run stream is at most about twice the payload, short literals between three byte zero runs
+		if (!GetVarint(data, length, offset, runs_length) || runs_length == 0 || runs_length > payload_length * 2 + 16 || offset >= length) {
+			return false;
+		}
+
+		inflated.resize((size_t)runs_length);
+		auto inflated_length = EQ::InflateData((const char*)data + offset, (uint32)(length - offset), &inflated[0], (uint32)inflated.size());
+		if (inflated_length != runs_length) {
+			return false;
+		}
+
+		data = (const unsigned char*)&inflated[0];
+		length = inflated.size();
+		offset = 0;
+	}
+
+	out.Clear();
+	if (payload_length > 0) {
+		out.Resize((size_t)payload_length);
+	}
+
+	size_t written = 0;
+	while (written < payload_length) {
+		uint64_t literals = 0;
+		uint64_t zeros = 0;
+
+		if (!GetVarint(data, length, offset, literals) || literals > length - offset || written + literals > payload_length) {
+			return false;
+		}
+
+		if (literals > 0) {
+			memcpy((char*)out.Data() + written, data + offset, (size_t)literals);
+		}
+
+		offset += (size_t)literals;
+		written += (size_t)literals;
+
+		if (!GetVarint(data, length, offset, zeros) || written + zeros > payload_length) {
+			return false;
+		}
+
+		// Resize zero filled the payload already
+		written += (size_t)zeros;
+	}
+
+	return offset == length;
+}
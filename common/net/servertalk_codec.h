@@ -0,0 +1,35 @@
+#pragma once
+
+#include "packet.h"
+
+namespace EQ
+{
+	namespace Net
+	{
+		/**
+		 * Compact ServerTalk payload encoding, used once both ends agreed on it during the handshake.
+		 *
+		 * ServerTalk structs are fixed size and zero filled, so most of a packet is the padding of its char
+		 * arrays. The payload is written as runs of literal bytes and zero bytes, each run length a varint,
+		 * and the run stream is deflated as well when compression was agreed on and it pays off.
+		 *
+		 * uint8  flags (ServertalkCompactDeflated)
+		 * varint payload length
+		 * varint run stream length, deflated only
+		 * runs:  varint literal count, literal bytes, varint zero count, repeated until the payload is complete
+		 */
+		enum ServertalkCompactFlags
+		{
+			ServertalkCompactDeflated = 1,
+		};
+
+		void ServertalkCompactEncode(const Packet &in, DynamicPacket &out, bool compress);
+
+		/**
+		 * @param in
+		 * @param out
+		 * @return false on a malformed payload
+		 */
+		bool ServertalkCompactDecode(const Packet &in, DynamicPacket &out);
+	}
+}
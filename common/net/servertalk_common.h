@@ -13,6 +13,18 @@ namespace EQ
 			ServertalkClientHandshake,
 			ServertalkClientDowngradeSecurityHandshake,
 			ServertalkMessage,
+			ServertalkServerFeatures,
+			ServertalkCompactMessage,
+		};
+
+		/**
+		 * Optional features, offered by the client after the credentials in its handshake and answered by the
+		 * server with ServertalkServerFeatures. Peers that predate them ignore both, and keep the legacy layout
+		 */
+		enum ServertalkFeature
+		{
+			ServertalkFeatureCompact = 1,
+			ServertalkFeatureCompress = 2,
 		};
 	}
-}
\ No newline at end of file
+}
@@ -19,6 +19,8 @@ namespace EQ
 			bool ipv6;
 			bool encrypted;
 			bool allow_downgrade;
+			bool compact;
+			bool compress;
 			std::string credentials;
 
 			ServertalkServerOptions() {
@@ -30,6 +32,8 @@ namespace EQ
 				allow_downgrade = true;
 #endif
 				ipv6 = false;
+				compact = true;
+				compress = false;
 			}
 		};
 
@@ -56,6 +60,7 @@ namespace EQ
 			std::map<std::string, std::function<void(std::shared_ptr<ServertalkServerConnection>)>> m_on_disc;
 			bool m_encrypted;
 			bool m_allow_downgrade;
+			uint8_t m_features;
 			std::string m_credentials;
 
 			friend class ServertalkServerConnection;
@@ -1,14 +1,17 @@
 #include "servertalk_server_connection.h"
 #include "servertalk_server.h"
+#include "servertalk_codec.h"
 #include "../eqemu_logsys.h"
 #include "../util/uuid.h"
 
-EQ::Net::ServertalkServerConnection::ServertalkServerConnection(std::shared_ptr<EQ::Net::TCPConnection> c, EQ::Net::ServertalkServer *parent, bool encrypted, bool allow_downgrade)
+EQ::Net::ServertalkServerConnection::ServertalkServerConnection(std::shared_ptr<EQ::Net::TCPConnection> c, EQ::Net::ServertalkServer *parent, bool encrypted, bool allow_downgrade, uint8_t features)
 {
 	m_connection = c;
 	m_parent = parent;
 	m_encrypted = encrypted;
 	m_allow_downgrade = allow_downgrade;
+	m_supported_features = features;
+	m_features = 0;
 	m_uuid = EQ::Util::UUID::Generate().ToString();
 	m_connection->OnRead(std::bind(&ServertalkServerConnection::OnRead, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
 	m_connection->OnDisconnect(std::bind(&ServertalkServerConnection::OnDisconnect, this, std::placeholders::_1));
@@ -20,6 +23,19 @@ EQ::Net::ServertalkServerConnection::~ServertalkServerConnection()
 }
 
 void EQ::Net::ServertalkServerConnection::Send(uint16_t opcode, EQ::Net::Packet & p)
+{
+	// empty payloads keep the legacy framing, which is how they have always been delivered
+	if ((m_features & ServertalkFeatureCompact) && p.Length() > 0) {
+		EQ::Net::DynamicPacket compact;
+		ServertalkCompactEncode(p, compact, (m_features & ServertalkFeatureCompress) != 0);
+		InternalSendMessage(ServertalkCompactMessage, opcode, compact);
+		return;
+	}
+
+	InternalSendMessage(ServertalkMessage, opcode, p);
+}
+
+void EQ::Net::ServertalkServerConnection::InternalSendMessage(ServertalkPacketType type, uint16_t opcode, EQ::Net::Packet &p)
 {
 	EQ::Net::DynamicPacket out;
 #ifdef ENABLE_SECURITY
@@ -46,7 +62,7 @@ void EQ::Net::ServertalkServerConnection::Send(uint16_t opcode, EQ::Net::Packet
 	out.PutUInt16(4, opcode);
 	out.PutPacket(6, p);
 #endif
-	InternalSend(ServertalkMessage, out);
+	InternalSend(type, out);
 }
 
 void EQ::Net::ServertalkServerConnection::SendPacket(ServerPacket *p)
@@ -133,6 +149,9 @@ void EQ::Net::ServertalkServerConnection::ProcessReadBuffer()
 			case ServertalkMessage:
 				ProcessMessage(p);
 				break;
+			case ServertalkCompactMessage:
+				ProcessMessage(p, true);
+				break;
 			}
 		}
 
@@ -234,8 +253,12 @@ void EQ::Net::ServertalkServerConnection::ProcessHandshake(EQ::Net::Packet &p, b
 					return;
 				}
 
-				m_parent->ConnectionIdentified(this);
 				(*(uint64_t*)&m_nonce_theirs[0])++;
+
+				size_t features_offset = m_identifier.length() + 1 + credentials.length() + 1;
+				AcceptFeatures(message_len > features_offset ? decrypted_text[features_offset] : 0);
+
+				m_parent->ConnectionIdentified(this);
 			}
 		}
 		catch (std::exception &ex) {
@@ -254,6 +277,9 @@ void EQ::Net::ServertalkServerConnection::ProcessHandshake(EQ::Net::Packet &p, b
 				return;
 			}
 
+			size_t features_offset = m_identifier.length() + 1 + credentials.length() + 1;
+			AcceptFeatures(p.Length() > features_offset ? p.GetUInt8(features_offset) : 0);
+
 			m_parent->ConnectionIdentified(this);
 		}
 		catch (std::exception &ex) {
@@ -272,6 +298,9 @@ void EQ::Net::ServertalkServerConnection::ProcessHandshake(EQ::Net::Packet &p, b
 			return;
 		}
 
+		size_t features_offset = m_identifier.length() + 1 + credentials.length() + 1;
+		AcceptFeatures(p.Length() > features_offset ? p.GetUInt8(features_offset) : 0);
+
 		m_parent->ConnectionIdentified(this);
 	}
 	catch (std::exception &ex) {
@@ -281,7 +310,27 @@ void EQ::Net::ServertalkServerConnection::ProcessHandshake(EQ::Net::Packet &p, b
 #endif
 }
 
-void EQ::Net::ServertalkServerConnection::ProcessMessage(EQ::Net::Packet &p)
+/**
+ * Agrees on the features both ends support and tells the client before the first message goes out, so the
+ * client can start sending compact messages while those that crossed the reply stay readable by their type
+ *
+ * @param offered features from the client handshake, 0 for clients that predate them
+ */
+void EQ::Net::ServertalkServerConnection::AcceptFeatures(uint8_t offered)
+{
+	m_features = offered & m_supported_features;
+	if (m_features == 0) {
+		return;
+	}
+
+	EQ::Net::DynamicPacket features;
+	features.PutUInt8(0, m_features);
+	InternalSend(ServertalkServerFeatures, features);
+
+	LogF(Logs::General, Logs::TCPConnection, "Accepted features {0} from {1}:{2}", m_features, m_connection->RemoteIP(), m_connection->RemotePort());
+}
+
+void EQ::Net::ServertalkServerConnection::ProcessMessage(EQ::Net::Packet &p, bool compact)
 {
 	try {
 		auto length = p.GetUInt32(0);
@@ -304,41 +353,20 @@ void EQ::Net::ServertalkServerConnection::ProcessMessage(EQ::Net::Packet &p)
 
 				(*(uint64_t*)&m_nonce_theirs[0])++;
 
-				auto cb = m_message_callbacks.find(opcode);
-				if (cb != m_message_callbacks.end()) {
-					cb->second(opcode, decrypted_packet);
-				}
-
-				if (m_message_callback) {
-					m_message_callback(opcode, decrypted_packet);
-				}
+				DeliverMessage(opcode, decrypted_packet, compact);
 			}
 			else {
 				size_t message_len = length;
 				EQ::Net::StaticPacket packet(&data[0], message_len);
 
-				auto cb = m_message_callbacks.find(opcode);
-				if (cb != m_message_callbacks.end()) {
-					cb->second(opcode, packet);
-				}
-
-				if (m_message_callback) {
-					m_message_callback(opcode, packet);
-				}
+				DeliverMessage(opcode, packet, compact);
 			}
 
 #else
 			size_t message_len = length;
 			EQ::Net::StaticPacket packet(&data[0], message_len);
 
-			auto cb = m_message_callbacks.find(opcode);
-			if (cb != m_message_callbacks.end()) {
-				cb->second(opcode, packet);
-			}
-
-			if (m_message_callback) {
-				m_message_callback(opcode, packet);
-			}
+			DeliverMessage(opcode, packet, compact);
 #endif
 		}
 	}
@@ -346,3 +374,23 @@ void EQ::Net::ServertalkServerConnection::ProcessMessage(EQ::Net::Packet &p)
 		LogError("Error parsing message from client: {0}", ex.what());
 	}
 }
+
+void EQ::Net::ServertalkServerConnection::DeliverMessage(uint16_t opcode, EQ::Net::Packet &p, bool compact)
+{
+	EQ::Net::DynamicPacket decoded;
+	if (compact && !ServertalkCompactDecode(p, decoded)) {
+		LogError("Error decoding compact message {0:#x} from client", opcode);
+		return;
+	}
+
+	EQ::Net::Packet &packet = compact ? static_cast<EQ::Net::Packet&>(decoded) : p;
+
+	auto cb = m_message_callbacks.find(opcode);
+	if (cb != m_message_callbacks.end()) {
+		cb->second(opcode, packet);
+	}
+
+	if (m_message_callback) {
+		m_message_callback(opcode, packet);
+	}
+}
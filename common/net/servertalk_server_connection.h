@@ -16,7 +16,7 @@ namespace EQ
 		class ServertalkServerConnection
 		{
 		public:
-			ServertalkServerConnection(std::shared_ptr<EQ::Net::TCPConnection> c, ServertalkServer *parent, bool encrypted, bool allow_downgrade);
+			ServertalkServerConnection(std::shared_ptr<EQ::Net::TCPConnection> c, ServertalkServer *parent, bool encrypted, bool allow_downgrade, uint8_t features);
 			~ServertalkServerConnection();
 
 			void Send(uint16_t opcode, EQ::Net::Packet &p);
@@ -27,6 +27,7 @@ namespace EQ
 			std::string GetIdentifier() const { return m_identifier; }
 			std::shared_ptr<EQ::Net::TCPConnection> Handle() { return m_connection; }
 			std::string GetUUID() const { return m_uuid; }
+			uint8_t GetFeatures() const { return m_features; }
 		private:
 			void OnRead(TCPConnection* c, const unsigned char* data, size_t sz);
 			void ProcessReadBuffer();
@@ -35,7 +36,11 @@ namespace EQ
 			void InternalSend(ServertalkPacketType type, EQ::Net::Packet &p);
 			void ProcessHandshake(EQ::Net::Packet &p) { ProcessHandshake(p, false); }
 			void ProcessHandshake(EQ::Net::Packet &p, bool security_downgrade);
-			void ProcessMessage(EQ::Net::Packet &p);
+			void AcceptFeatures(uint8_t offered);
+			void ProcessMessage(EQ::Net::Packet &p) { ProcessMessage(p, false); }
+			void ProcessMessage(EQ::Net::Packet &p, bool compact);
+			void InternalSendMessage(ServertalkPacketType type, uint16_t opcode, EQ::Net::Packet &p);
+			void DeliverMessage(uint16_t opcode, EQ::Net::Packet &p, bool compact);
 
 			std::shared_ptr<EQ::Net::TCPConnection> m_connection;
 			ServertalkServer *m_parent;
@@ -48,6 +53,8 @@ namespace EQ
 
 			bool m_encrypted;
 			bool m_allow_downgrade;
+			uint8_t m_supported_features;
+			uint8_t m_features;
 #ifdef ENABLE_SECURITY
 			unsigned char m_public_key_ours[crypto_box_PUBLICKEYBYTES];
 			unsigned char m_private_key_ours[crypto_box_SECRETKEYBYTES];
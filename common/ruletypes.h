@@ -247,6 +247,10 @@ RULE_INT (World, TellQueueSize, 20, "Maximum tell queue size")
 RULE_BOOL(World, StartZoneSameAsBindOnCreation, true, "Should the start zone always be the same location as your bind?")
 RULE_BOOL(World, EnforceCharacterLimitAtLogin, false, "Enforce the limit for characters that are online at login")
 RULE_BOOL(World, EnableDevTools, true, "Enable or Disable the Developer Tools globally (Most of the time you want this enabled)")
+RULE_INT(World, WhoIndexRefreshMS, 1000, "Longest time the /who, friends who and LFG search indexes go without a rebuild, they are also rebuilt when players log in, log out, zone or change guild, class, level or LFG")
+RULE_BOOL(World, RouteBroadcastPackets, true, "Send channel messages and emotes only to zones with players in them, guild messages only to zones holding a member of the guild, false sends them to every zone")
+RULE_INT(World, WhoCacheTTLMS, 1000, "Time an identical /who all reply is reused for requesters of the same status, 0 disables the reply cache")
+RULE_INT(World, GroupRaidWriteBehindMS, 1000, "How long world holds group and raid roster changes before writing them to the group_id and raid_members tables as one transaction. 0 writes them immediately")
 RULE_CATEGORY_END()
 
 RULE_CATEGORY(Zone)
@@ -280,6 +284,12 @@ RULE_BOOL(Zone, EnableZoneControllerGlobals, false, "Enables the ability to use
 RULE_INT(Zone, GlobalLootMultiplier, 1, "Sets Global Loot drop multiplier for database based drops, useful for double, triple loot etc")
 RULE_BOOL(Zone, KillProcessOnDynamicShutdown, true, "When process has booted a zone and has hit its zone shut down timer, it will hard kill the process to free memory back to the OS")
 RULE_INT(Zone, SecondsBeforeIdle, 60, "Seconds before IDLE_WHEN_EMPTY define kicks in")
+RULE_INT(Zone, MapCacheSize, 0, "Parsed map, water map and navmesh sets a zone process keeps between boots. A sleeping process prewarms it with the most populated zones, 0 disables the cache")
+RULE_BOOL(Zone, DeltaClientList, true, "Send world only changed who fields and a client list sequence each interserver tick instead of full client updates and every client's world id")
+RULE_BOOL(Zone, TickProfiler, true, "Time each phase of the zone main loop, see #tickstats and the get_tick_statistics api call. Costs two clock reads per phase, turn it off only to rule the profiler out")
+RULE_INT(Zone, SlowTickThresholdMS, 100, "Zone ticks taking at least this long log a per phase breakdown, 0 disables slow tick traces")
+RULE_INT(Zone, ZoneInSpawnBurst, 100, "Nearest spawns sent in the bulk spawn packet while a client zones in, the rest stream in by distance once connected. -1 sends every spawn within range in the bulk packet")
+RULE_INT(Zone, ZoneInSpawnPacketBudget, 40, "Spawn and wear change packets streamed to a newly zoned client per client process, 0 sends them all at once")
 RULE_CATEGORY_END()
 
 RULE_CATEGORY(Map)
@@ -289,6 +299,12 @@ RULE_REAL(Map, DistanceCanTravelBeforeAdjustment, 10.0, "Distance a mob can path
 RULE_BOOL(Map, MobZVisualDebug, false, "Displays spell effects determining whether or not NPC is hitting Best Z calcs (blue for hit, red for miss)")
 RULE_REAL(Map, FixPathingZMaxDeltaSendTo, 20, "At runtime in SendTo: maximum change in Z to allow the BestZ code to apply")
 RULE_INT(Map, FindBestZHeightAdjust, 1, "Adds this to the current Z before seeking the best Z position")
+RULE_BOOL(Map, UseHeightField, false, "Precompute a layered ground height grid when loading maps so FindBestZ only raycasts the layer it needs")
+RULE_REAL(Map, HeightFieldCellSize, 8.0, "Width in units of a height field cell, larger cells use less memory but produce taller layers")
+RULE_INT(Map, HeightFieldMaxLayers, 8, "Maximum number of height layers stored per height field cell, nearby layers are merged past this")
+RULE_BOOL(Map, UseLoSCache, false, "Cache line of sight results between positions snapped to LoSCacheGridSize")
+RULE_INT(Map, LoSCacheSize, 16384, "Maximum number of line of sight results kept in the cache before the least recently used are evicted")
+RULE_REAL(Map, LoSCacheGridSize, 1.0, "Size in units of the grid positions are snapped to when looking up cached line of sight results")
 RULE_CATEGORY_END()
 
 RULE_CATEGORY(Pathing)
@@ -298,6 +314,9 @@ RULE_BOOL(Pathing, Fear, true, "Enable pathing for fear")
 RULE_REAL(Pathing, NavmeshStepSize, 100.0f, "Step size for the movement manager")
 RULE_REAL(Pathing, ShortMovementUpdateRange, 130.0f, "Range for short movement updates")
 RULE_INT(Pathing, MaxNavmeshNodes, 4092, "Maximum navmesh nodes in a traversable path")
+RULE_BOOL(Pathing, AsyncPathfinding, true, "Run ground path queries for the movement manager on worker threads, NPCs keep their current movement until the route arrives")
+RULE_INT(Pathing, PathCacheSize, 1024, "Number of recent start/end navmesh poly corridors to cache, 0 disables the cache")
+RULE_INT(Pathing, MediumRangeUpdateIntervalMS, 500, "Minimum time between moving NPC updates sent to clients between short and long update range, 0 sends every step")
 RULE_CATEGORY_END()
 
 RULE_CATEGORY(Watermap)
@@ -655,6 +674,9 @@ RULE_BOOL(Mail, EnableMailSystem, true, "Setting whether the mail system is acti
 RULE_INT(Mail, ExpireTrash, 0, "Setting when the mail trash is emptied. Time in seconds. 0 will delete all messages in the trash when the mailserver starts")
 RULE_INT(Mail, ExpireRead, 31536000, "Setting when read mails expire. 31536000=1 Year. Set to -1 for never")
 RULE_INT(Mail, ExpireUnread, 31536000, "Setting when unread mails expire. 31536000=1 Year. Set to -1 for never")
+RULE_INT(Mail, WriteBehindMS, 1000, "How long mail status changes and deletes are held before being written to the database as one batch. 0 writes them immediately")
+RULE_INT(Mail, ExpireBatchSize, 500, "Maximum number of expired mails deleted per step of the background expiry")
+RULE_INT(Mail, ExpireCheckIntervalS, 3600, "How often UCS repeats the mail expiry after startup, in seconds. 0 only expires at startup")
 RULE_CATEGORY_END()
 
 RULE_CATEGORY(Channels)
@@ -766,6 +788,8 @@ RULE_CATEGORY_END()
 
 RULE_CATEGORY(Logging)
 RULE_BOOL(Logging, PrintFileFunctionAndLine, false, "Ex: [World Server] [net.cpp::main:309] Loading variables...")
+RULE_INT(Logging, FileLogBufferLines, 16384, "Lines the background file log writer can buffer before new lines are dropped")
+RULE_INT(Logging, FileLogRotateSizeMB, 0, "Rotate the process file log to <name>.1 once it grows past this many MB, 0 disables rotation")
 RULE_CATEGORY_END()
 
 RULE_CATEGORY(HotReload)
@@ -793,6 +817,7 @@ RULE_INT(Expedition, WorldExpeditionProcessRateMS, 6000, "Timer interval (ms) th
 RULE_BOOL(Expedition, AlwaysNotifyNewLeaderOnChange, false, "Always notify clients when made expedition leader. If false (live-like) new leaders are only notified when made leader via /dzmakeleader")
 RULE_REAL(Expedition, LockoutDurationMultiplier, 1.0, "Multiplies lockout duration by this value when new lockouts are added")
 RULE_BOOL(Expedition, EnableInDynamicZoneStatus, false, "Enables the 'In Dynamic Zone' member status in expedition window. If false (live-like) players inside the dz will show as 'Online'")
+RULE_INT(Expedition, WorldWriteBehindMS, 1000, "How long world holds expedition, dynamic zone and lockout changes before writing them to the database as one transaction. 0 writes them immediately")
 RULE_CATEGORY_END()
 
 RULE_CATEGORY(DynamicZone)
@@ -81,6 +81,9 @@
 #define ServerOP_SpawnStatusChange	0x0040
 #define ServerOP_DropClient         0x0041	// DropClient
 #define ServerOP_ChangeGroupLeader	0x0042
+#define ServerOP_ClientListDelta	0x0043	// Changed who fields of a client world already knows about
+#define ServerOP_ClientListSync		0x0044	// Zone's client list sequence, replaces ServerOP_ClientListKA
+#define ServerOP_ClientListResync	0x0045	// World lost track of a zone's client list, zone resends it in full
 #define ServerOP_ReloadTasks		0x0060
 #define ServerOP_DepopAllPlayersCorpses	0x0061
 #define ServerOP_ReloadTitles		0x0062
@@ -113,6 +116,9 @@
 #define ServerOP_GroupFollowAck		0x0111
 #define ServerOP_GroupCancelInvite	0x0112
 #define ServerOP_RaidMOTD			0x0113
+#define ServerOP_RaidMemberLevel	0x0114
+#define ServerOP_GroupRosterUpdate	0x0115	// zone asks world to change a group_id row, world persists it
+#define ServerOP_CharacterRoster	0x0116	// group and raid roster world sends along with a client entering a zone
 
 #define ServerOP_InstanceUpdateTime			0x014F
 #define ServerOP_AdventureRequest			0x0150
@@ -149,7 +155,6 @@
 #define ServerOP_ExpeditionMemberChange       0x0404
 #define ServerOP_ExpeditionMemberSwap         0x0405
 #define ServerOP_ExpeditionMemberStatus       0x0406
-#define ServerOP_ExpeditionGetOnlineMembers   0x0407
 #define ServerOP_ExpeditionDzAddPlayer        0x0408
 #define ServerOP_ExpeditionDzMakeLeader       0x0409
 #define ServerOP_ExpeditionDzCompass          0x040a
@@ -166,6 +171,12 @@
 #define ServerOP_ExpeditionSecondsRemaining   0x0415
 #define ServerOP_ExpeditionExpireWarning      0x0416
 #define ServerOP_ExpeditionChooseNewLeader    0x0417
+#define ServerOP_ExpeditionCreateRequest      0x0418
+#define ServerOP_ExpeditionCreateRejected     0x0419
+#define ServerOP_ExpeditionAddRejected        0x041a
+#define ServerOP_ExpeditionCharacterRequest   0x041b
+#define ServerOP_ExpeditionCharacterInfo      0x041c
+#define ServerOP_ExpeditionZoneRequest        0x041d
 
 #define ServerOP_DzCharacterChange            0x0450
 #define ServerOP_DzRemoveAllCharacters        0x0451
@@ -458,6 +469,7 @@ struct ServerGroupFollow_Struct {
 
 struct ServerGroupFollowAck_Struct {
 	char Name[64];
+	uint32 gid;
 };
 
 
@@ -521,6 +533,7 @@ struct ServerClientList_Struct {
 	uint8	LFGToLevel;
 	bool	LFGMatchFilter;
 	char	LFGComments[64];
+	uint32	sequence;
 };
 
 struct ServerClientListKeepAlive_Struct {
@@ -528,6 +541,48 @@ struct ServerClientListKeepAlive_Struct {
 	uint32	wid[0];
 };
 
+enum ClientListDeltaField : uint16 {
+	ClientListDeltaLevel    = 0x0001,
+	ClientListDeltaRace     = 0x0002,
+	ClientListDeltaClass    = 0x0004,
+	ClientListDeltaAnon     = 0x0008,
+	ClientListDeltaTellsOff = 0x0010,
+	ClientListDeltaGuild    = 0x0020,
+	ClientListDeltaLFG      = 0x0040,
+	ClientListDeltaGM       = 0x0080,
+	ClientListDeltaAdmin    = 0x0100
+};
+
+// only the fields flagged in changed are meaningful
+struct ServerClientListDelta_Struct {
+	uint32	sequence;
+	uint32	wid;
+	uint16	changed;
+	uint16	race;
+	int16	Admin;
+	uint8	class_;
+	uint8	level;
+	uint8	anon;
+	bool	tellsoff;
+	uint8	gm;
+	bool	LFG;
+	uint32	guild_id;
+	uint8	LFGFromLevel;
+	uint8	LFGToLevel;
+	bool	LFGMatchFilter;
+	char	LFGComments[64];
+};
+
+struct ServerClientListSync_Struct {
+	uint32	sequence;	// last ServerOP_ClientList or ServerOP_ClientListDelta sequence the zone sent
+	uint32	count;		// clients the zone has announced as in zone
+	uint8	resynced;	// sent after a full resend, world takes the sequence as is
+};
+
+struct ServerClientListResync_Struct {
+	uint32	sequence;	// last sequence world applied from the zone
+};
+
 struct ServerZonePlayer_Struct {
 	char	adminname[64];
 	int16	adminrank;
@@ -1020,6 +1075,42 @@ struct ServerRaidGeneralAction_Struct {
 	uint32 rid;
 	uint32 gid;
 	char playername[64];
+	uint32 char_id;
+	uint8 _class;          // member details so receiving zones update their roster without reloading it
+	uint8 level;
+	uint8 is_group_leader;
+	uint8 is_raid_leader;
+	uint8 is_looter;
+};
+
+struct ServerGroupRosterUpdate_Struct {
+	uint32 zoneid;
+	uint16 instance_id;
+	uint32 gid;            // 0 removes the member from their group
+	uint32 char_id;        // owner's character id for mercs, bot id for bots
+	uint8 is_merc;
+	char member_name[64];
+};
+
+struct ServerRosterMember_Struct {
+	char name[64];
+	uint32 char_id;
+	uint32 gid;            // raid group, raid members only
+	uint8 _class;
+	uint8 level;
+	uint8 is_group_leader;
+	uint8 is_raid_leader;
+	uint8 is_looter;
+	uint8 is_merc;         // group members only
+};
+
+struct ServerCharacterRoster_Struct {
+	uint32 char_id;
+	uint32 group_id;
+	uint32 group_member_count;
+	uint32 raid_id;
+	uint32 raid_member_count;
+	ServerRosterMember_Struct members[0]; // group members followed by raid members
 };
 
 struct ServerRaidGroupAction_Struct { //add / remove depends on opcode.
@@ -2024,6 +2115,7 @@ struct ServerExpeditionMemberChange_Struct {
 	uint32 sender_zone_id;
 	uint16 sender_instance_id;
 	uint8  removed; // 0: added, 1: removed
+	uint8  from_invite; // 1: added by an accepted invite, world enforces the lock state and max players
 	uint32 char_id;
 	char   char_name[64];
 };
@@ -2046,21 +2138,6 @@ struct ServerExpeditionMemberStatus_Struct {
 	uint32 character_id;
 };
 
-struct ServerExpeditionCharacterEntry_Struct {
-	uint32 expedition_id;
-	uint32 character_id;
-	uint32 character_zone_id;
-	uint16 character_instance_id;
-	uint8  character_online; // 0: offline 1: online
-};
-
-struct ServerExpeditionCharacters_Struct {
-	uint32 sender_zone_id;
-	uint16 sender_instance_id;
-	uint32 count;
-	ServerExpeditionCharacterEntry_Struct entries[0];
-};
-
 struct ServerExpeditionLockout_Struct {
 	uint32 expedition_id;
 	uint64 expire_time;
@@ -2090,6 +2167,7 @@ struct ServerExpeditionSetting_Struct {
 
 struct ServerExpeditionCharacterLockout_Struct {
 	uint8  remove;
+	uint8  update_client; // 0: world only stores it, 1: world forwards it to the character's zone
 	uint32 character_id;
 	uint64 expire_time;
 	uint32 duration;
@@ -2148,6 +2226,141 @@ struct ServerDzCharacter_Struct {
 	uint32 character_id;
 };
 
+struct ServerDzInfo_Struct {
+	uint32 dz_id;
+	uint16 zone_id;
+	uint16 instance_id;
+	uint32 version;
+	uint8  type;
+	uint8  never_expires;
+	uint8  has_zonein;
+	uint64 start_time;
+	uint32 duration;
+	uint32 compass_zone_id;
+	float  compass_x;
+	float  compass_y;
+	float  compass_z;
+	uint32 safereturn_zone_id;
+	float  safereturn_x;
+	float  safereturn_y;
+	float  safereturn_z;
+	float  safereturn_heading;
+	float  zonein_x;
+	float  zonein_y;
+	float  zonein_z;
+	float  zonein_heading;
+};
+
+struct ServerExpeditionMemberEntry_Struct {
+	uint32 char_id;
+	uint8  status; // filled by world, same values as ServerExpeditionMemberStatus_Struct
+	char   name[64];
+};
+
+struct ServerExpeditionLockoutEntry_Struct {
+	uint64 expire_time;
+	uint32 duration;
+	char   uuid[37];
+	char   event_name[256];
+};
+
+// full state of an expedition, sent by world to the zones that need to cache it
+struct ServerExpeditionCreate_Struct {
+	uint32 expedition_id;      // leading fields match ServerExpeditionID_Struct
+	uint32 sender_zone_id;
+	uint32 sender_instance_id;
+	char   uuid[37];
+	char   expedition_name[128];
+	uint32 leader_id;
+	char   leader_name[64];
+	uint32 min_players;
+	uint32 max_players;
+	uint8  add_replay_on_join;
+	uint8  is_locked;
+	ServerDzInfo_Struct dz;
+	uint32 member_count;
+	uint32 lockout_count;
+	char   entries[0]; // member_count ServerExpeditionMemberEntry_Struct then lockout_count ServerExpeditionLockoutEntry_Struct
+};
+
+// zone asks world to validate and create an expedition in one round trip
+struct ServerExpeditionCreateRequest_Struct {
+	uint32 sender_zone_id;
+	uint16 sender_instance_id;
+	uint8  disable_messages;
+	uint8  gm_bypass;          // requester may ignore the minimum player count
+	uint32 requester_id;
+	char   requester_name[64];
+	uint32 leader_id;
+	char   leader_name[64];
+	char   uuid[37];
+	char   expedition_name[128];
+	uint32 min_players;
+	uint32 max_players;
+	uint8  add_replay_on_join;
+	uint8  is_locked;
+	ServerDzInfo_Struct dz;
+	uint32 member_count;
+	ServerExpeditionMemberEntry_Struct members[0]; // char_id is 0 if the zone doesn't know it
+};
+
+struct ServerExpeditionConflictEntry_Struct {
+	uint8  type; // 0: in expedition, 1: replay timer, 2: event timer, 3: player count, 4: instance not created
+	char   character_name[64];
+	uint64 expire_time;
+	uint32 duration;
+	char   event_name[256];
+};
+
+struct ServerExpeditionCreateRejected_Struct {
+	char   uuid[37];
+	uint8  disable_messages;
+	uint8  is_solo;
+	char   requester_name[64];
+	char   leader_name[64];
+	uint32 member_count;
+	uint32 min_players;
+	uint32 max_players;
+	uint32 conflict_count;
+	ServerExpeditionConflictEntry_Struct conflicts[0];
+};
+
+struct ServerExpeditionAddRejected_Struct {
+	uint32 expedition_id;
+	uint8  reason; // 0: locked, 1: full, 2: already in an expedition, 3: swap member gone
+	char   char_name[64];
+};
+
+struct ServerExpeditionCharacterRequest_Struct {
+	uint32 sender_zone_id;
+	uint16 sender_instance_id;
+	uint32 character_id;
+	uint32 cached_expedition_id; // world sends the expedition first if this differs
+};
+
+struct ServerExpeditionCharacterLockoutEntry_Struct {
+	uint64 expire_time;
+	uint32 duration;
+	char   uuid[37];
+	char   expedition_name[128];
+	char   event_name[256];
+};
+
+struct ServerExpeditionCharacterInfo_Struct {
+	uint32 character_id;
+	uint32 expedition_id;
+	uint32 lockout_count;
+	ServerExpeditionCharacterLockoutEntry_Struct entries[0];
+};
+
+// zone asks world for the expeditions of its dz instance and of the listed characters
+struct ServerExpeditionZoneRequest_Struct {
+	uint32 sender_zone_id;
+	uint16 sender_instance_id;
+	uint32 count;
+	uint32 character_ids[0];
+};
+
 #pragma pack()
 
 #endif
@@ -0,0 +1,555 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2020 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+
+*/
+
+#include "../common/global_define.h"
+#include "../common/eqemu_logsys.h"
+#include "../common/string_util.h"
+#include "batch_writer.h"
+#include "database.h"
+
+#include <errmsg.h>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+BatchWriter batch_writer;
+
+/**
+ * Spool lines start with a tag:
+ *   Q standalone statement
+ *   E event insert, followed by the D line of its details if it has any
+ *   D detail insert taking the event id from LAST_INSERT_ID()
+ */
+static const char SpoolQuery  = 'Q';
+static const char SpoolEvent  = 'E';
+static const char SpoolDetail = 'D';
+
+static bool IsConnectionError(uint32 error_number)
+{
+	return (
+		error_number == CR_CONNECTION_ERROR ||
+		error_number == CR_CONN_HOST_ERROR ||
+		error_number == CR_SERVER_GONE_ERROR ||
+		error_number == CR_SERVER_LOST ||
+		error_number == CR_UNKNOWN_HOST
+	);
+}
+
+// spooled statements are line delimited, escaped values never hold a raw line break but generic queries might
+static std::string SpoolLine(char tag, std::string query)
+{
+	std::replace(query.begin(), query.end(), '\n', ' ');
+	std::replace(query.begin(), query.end(), '\r', ' ');
+
+	return std::string(1, tag) + " " + query;
+}
+
+static std::string BuildInsert(const std::string &table, const std::string &columns, const std::string &values)
+{
+	return fmt::format("INSERT INTO `{}` ({}) VALUES {}", table, columns, values);
+}
+
+BatchWriter::BatchWriter()
+{
+	m_database       = nullptr;
+	m_running        = false;
+	m_batch_size     = 100;
+	m_flush_ms       = 1000;
+	m_queued_rows    = 0;
+	m_spool_pending  = false;
+	m_database_down  = false;
+	m_auto_increment = 1;
+}
+
+BatchWriter::~BatchWriter()
+{
+	Stop();
+}
+
+bool BatchWriter::Start(
+	const char *host,
+	const char *user,
+	const char *password,
+	const char *database,
+	uint32 port,
+	uint32 batch_size,
+	uint32 flush_ms,
+	const std::string &spool_file
+)
+{
+	if (m_running) {
+		return true;
+	}
+
+	m_batch_size = std::max(batch_size, 1u);
+	m_flush_ms   = std::max(flush_ms, 1u);
+	m_spool_file = spool_file;
+
+	m_database = new Database();
+	if (!m_database->Connect(host, user, password, database, port)) {
+		LogError("QueryServ batch writer could not connect to the database, rows will be spooled until it can");
+		m_database_down = true;
+		m_retry_at      = Clock::now() + std::chrono::milliseconds(RetryIntervalMS);
+	}
+	else {
+		// event ids of a multi-row insert are spaced by this
+		auto results = m_database->QueryDatabase("SELECT @@auto_increment_increment");
+		if (results.Success() && results.RowCount() == 1) {
+			auto row         = results.begin();
+			m_auto_increment = std::max(static_cast<uint32>(atoi(row[0])), 1u);
+		}
+	}
+
+	if (!m_spool_file.empty()) {
+		std::ifstream spool(m_spool_file);
+		std::ifstream replay(m_spool_file + ".replay");
+		m_spool_pending = spool.good() || replay.good();
+		if (m_spool_pending) {
+			LogInfo("Found QueryServ spool [{}], it will be replayed once the database takes writes", m_spool_file);
+		}
+	}
+
+	LogInfo(
+		"QueryServ batch writer started, batch size [{}] flush interval [{}] ms spool [{}]",
+		m_batch_size,
+		m_flush_ms,
+		m_spool_file.empty() ? "disabled" : m_spool_file
+	);
+
+	m_running = true;
+	m_thread  = std::thread(&BatchWriter::Run, this);
+
+	return true;
+}
+
+void BatchWriter::Stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (!m_running) {
+			return;
+		}
+
+		m_running = false;
+	}
+
+	m_cv.notify_one();
+	if (m_thread.joinable()) {
+		m_thread.join();
+	}
+
+	safe_delete(m_database);
+}
+
+void BatchWriter::QueueEvent(
+	const std::string &table,
+	const std::string &columns,
+	std::string values,
+	const std::string &detail_table,
+	const std::string &detail_columns,
+	std::vector<std::string> details
+)
+{
+	Event event;
+	event.values  = std::move(values);
+	event.details = std::move(details);
+
+	uint32 rows = 1 + static_cast<uint32>(event.details.size());
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	// the database has fallen too far behind, keep memory bounded by sending the overflow straight to the spool
+	if (!m_spool_file.empty() && m_queued_rows >= m_batch_size * MaxBacklogBatches) {
+		lock.unlock();
+
+		Batch overflow;
+		overflow.columns        = columns;
+		overflow.detail_table   = detail_table;
+		overflow.detail_columns = detail_columns;
+		overflow.events.push_back(std::move(event));
+		SpoolBatch(table, overflow);
+		return;
+	}
+
+	auto &batch = m_batches[table];
+	if (batch.events.empty()) {
+		batch.columns        = columns;
+		batch.detail_table   = detail_table;
+		batch.detail_columns = detail_columns;
+	}
+
+	batch.events.push_back(std::move(event));
+	m_queued_rows += rows;
+
+	bool flush = m_queued_rows >= m_batch_size;
+	lock.unlock();
+
+	if (flush) {
+		m_cv.notify_one();
+	}
+}
+
+void BatchWriter::QueueQuery(std::string query)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_queries.push_back(std::move(query));
+	m_queued_rows++;
+
+	bool flush = m_queued_rows >= m_batch_size;
+	lock.unlock();
+
+	if (flush) {
+		m_cv.notify_one();
+	}
+}
+
+void BatchWriter::Run()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	for (;;) {
+		m_cv.wait_for(
+			lock,
+			std::chrono::milliseconds(m_flush_ms),
+			[this] { return !m_running || m_queued_rows >= m_batch_size; }
+		);
+
+		std::map<std::string, Batch> batches;
+		std::vector<std::string>     queries;
+		batches.swap(m_batches);
+		queries.swap(m_queries);
+		m_queued_rows = 0;
+
+		bool running = m_running;
+		lock.unlock();
+
+		Flush(batches, queries);
+
+		lock.lock();
+		if (!running) {
+			break;
+		}
+	}
+}
+
+void BatchWriter::Flush(std::map<std::string, Batch> &batches, std::vector<std::string> &queries)
+{
+	if (m_database_down && Clock::now() >= m_retry_at) {
+		m_database_down = false;
+	}
+
+	// rows spooled during an outage go in before anything newer
+	if (!m_database_down) {
+		ReplaySpool();
+	}
+
+	// while the spool still holds rows the new ones queue up behind them
+	if (m_database_down || SpoolPending()) {
+		std::vector<std::string> lines;
+		for (auto &query : queries) {
+			lines.push_back(SpoolLine(SpoolQuery, query));
+		}
+
+		WriteSpool(lines);
+
+		for (auto &batch : batches) {
+			SpoolBatch(batch.first, batch.second);
+		}
+
+		return;
+	}
+
+	for (size_t i = 0; i < queries.size(); ++i) {
+		uint32 last_insert_id = 0;
+		if (!m_database_down && Execute(queries[i], last_insert_id)) {
+			continue;
+		}
+
+		std::vector<std::string> lines;
+		for (size_t j = i; j < queries.size(); ++j) {
+			lines.push_back(SpoolLine(SpoolQuery, queries[j]));
+		}
+
+		WriteSpool(lines);
+		break;
+	}
+
+	for (auto &batch : batches) {
+		WriteBatch(batch.first, batch.second);
+	}
+}
+
+/**
+ * Writes every event of the batch with one insert and then every detail row with another
+ *
+ * @param table
+ * @param batch
+ */
+void BatchWriter::WriteBatch(const std::string &table, Batch &batch)
+{
+	if (batch.events.empty()) {
+		return;
+	}
+
+	if (m_database_down) {
+		SpoolBatch(table, batch);
+		return;
+	}
+
+	std::string values;
+	for (auto &event : batch.events) {
+		if (!values.empty()) {
+			values += ",";
+		}
+		values += event.values;
+	}
+
+	uint32 first_id = 0;
+	if (!Execute(BuildInsert(table, batch.columns, values), first_id)) {
+		SpoolBatch(table, batch);
+		return;
+	}
+
+	// one bad row fails the whole statement, retry the events one by one so only that row is lost
+	if (first_id == 0 && batch.events.size() > 1) {
+		Batch single;
+		single.columns        = batch.columns;
+		single.detail_table   = batch.detail_table;
+		single.detail_columns = batch.detail_columns;
+
+		for (auto &event : batch.events) {
+			single.events.clear();
+			single.events.push_back(std::move(event));
+			WriteBatch(table, single);
+		}
+		return;
+	}
+
+	if (batch.detail_table.empty() || first_id == 0) {
+		return;
+	}
+
+	std::string details;
+	for (size_t i = 0; i < batch.events.size(); ++i) {
+		uint32 event_id = first_id + static_cast<uint32>(i) * m_auto_increment;
+		for (auto &detail : batch.events[i].details) {
+			if (!details.empty()) {
+				details += ",";
+			}
+			details += fmt::format("({}, {})", event_id, detail);
+		}
+	}
+
+	if (details.empty()) {
+		return;
+	}
+
+	std::string query = BuildInsert(batch.detail_table, batch.detail_columns, details);
+
+	uint32 last_insert_id = 0;
+	if (!Execute(query, last_insert_id)) {
+		WriteSpool({SpoolLine(SpoolQuery, query)});
+	}
+}
+
+/**
+ * @param query
+ * @param last_insert_id
+ * @return false when the database could not be reached, statements it rejected are logged and dropped
+ */
+bool BatchWriter::Execute(const std::string &query, uint32 &last_insert_id)
+{
+	auto results = m_database->QueryDatabase(query);
+	if (results.Success()) {
+		last_insert_id = results.LastInsertedID();
+		return true;
+	}
+
+	last_insert_id = 0;
+
+	if (IsConnectionError(results.ErrorNumber())) {
+		LogError("QueryServ lost the database [{}], spooling writes", results.ErrorMessage());
+		m_database_down = true;
+		m_retry_at      = Clock::now() + std::chrono::milliseconds(RetryIntervalMS);
+		return false;
+	}
+
+	LogInfo("Failed QueryServ insert: [{}]", results.ErrorMessage());
+	LogInfo("[{}]", query);
+
+	return true;
+}
+
+/**
+ * @param lines
+ * @return false when there is no spool and the lines were dropped
+ */
+bool BatchWriter::WriteSpool(const std::vector<std::string> &lines)
+{
+	if (lines.empty()) {
+		return true;
+	}
+
+	if (m_spool_file.empty()) {
+		LogError("QueryServ has no spool file configured, dropping [{}] statements", lines.size());
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock(m_spool_mutex);
+
+	std::ofstream spool(m_spool_file, std::ios::out | std::ios::app | std::ios::binary);
+	if (!spool.good()) {
+		LogError("Could not open QueryServ spool [{}], dropping [{}] statements", m_spool_file, lines.size());
+		return false;
+	}
+
+	for (auto &line : lines) {
+		spool << line << '\n';
+	}
+
+	m_spool_pending = true;
+
+	return true;
+}
+
+/**
+ * Events without details share one statement, the others keep their event and detail insert next to each other
+ *
+ * @param table
+ * @param batch
+ */
+void BatchWriter::SpoolBatch(const std::string &table, const Batch &batch)
+{
+	std::vector<std::string> lines;
+	std::string              values;
+
+	for (auto &event : batch.events) {
+		if (event.details.empty()) {
+			if (!values.empty()) {
+				values += ",";
+			}
+			values += event.values;
+			continue;
+		}
+
+		lines.push_back(SpoolLine(SpoolEvent, BuildInsert(table, batch.columns, event.values)));
+
+		std::string details;
+		for (auto &detail : event.details) {
+			if (!details.empty()) {
+				details += ",";
+			}
+			details += fmt::format("(LAST_INSERT_ID(), {})", detail);
+		}
+
+		lines.push_back(SpoolLine(SpoolDetail, BuildInsert(batch.detail_table, batch.detail_columns, details)));
+	}
+
+	if (!values.empty()) {
+		lines.push_back(SpoolLine(SpoolQuery, BuildInsert(table, batch.columns, values)));
+	}
+
+	WriteSpool(lines);
+}
+
+void BatchWriter::ReplaySpool()
+{
+	if (m_spool_file.empty()) {
+		return;
+	}
+
+	std::string replay_file = m_spool_file + ".replay";
+
+	{
+		std::lock_guard<std::mutex> lock(m_spool_mutex);
+		if (!m_spool_pending) {
+			return;
+		}
+
+		// a replay file left behind by a crash goes first, the spool follows on the next flush
+		std::ifstream leftover(replay_file);
+		if (!leftover.good()) {
+			std::rename(m_spool_file.c_str(), replay_file.c_str());
+			m_spool_pending = false;
+		}
+	}
+
+	std::ifstream replay(replay_file, std::ios::in | std::ios::binary);
+	if (!replay.good()) {
+		return;
+	}
+
+	std::vector<std::string> lines;
+	std::string              line;
+	while (std::getline(replay, line)) {
+		if (line.length() > 2) {
+			lines.push_back(line);
+		}
+	}
+	replay.close();
+
+	LogInfo("Replaying [{}] spooled QueryServ statements", lines.size());
+
+	uint32 event_id = 0;
+	size_t replayed = 0;
+	for (; replayed < lines.size(); ++replayed) {
+		auto &entry = lines[replayed];
+		char tag    = entry[0];
+
+		uint32 last_insert_id = 0;
+		if (tag == SpoolDetail && event_id == 0) {
+			continue;
+		}
+
+		if (!Execute(entry.substr(2), last_insert_id)) {
+			break;
+		}
+
+		event_id = (tag == SpoolEvent) ? last_insert_id : 0;
+	}
+
+	if (replayed < lines.size()) {
+		std::vector<std::string> remaining(lines.begin() + replayed, lines.end());
+
+		// the event of this detail insert is already in, pin its id before it goes back to the spool
+		if (remaining.front()[0] == SpoolDetail && event_id != 0) {
+			std::string query = remaining.front().substr(2);
+			find_replace(query, "LAST_INSERT_ID()", std::to_string(event_id));
+			remaining.front() = SpoolLine(SpoolQuery, query);
+		}
+
+		WriteSpool(remaining);
+	}
+
+	std::remove(replay_file.c_str());
+
+	{
+		std::lock_guard<std::mutex> lock(m_spool_mutex);
+		std::ifstream               spool(m_spool_file);
+		m_spool_pending = m_spool_pending || spool.good();
+	}
+
+	LogInfo("Replayed [{}] spooled QueryServ statements, [{}] left", replayed, lines.size() - replayed);
+}
+
+bool BatchWriter::SpoolPending()
+{
+	std::lock_guard<std::mutex> lock(m_spool_mutex);
+	return m_spool_pending;
+}
@@ -0,0 +1,128 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2020 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+
+*/
+
+#ifndef QUERYSERV_BATCH_WRITER_H
+#define QUERYSERV_BATCH_WRITER_H
+
+#include "../common/types.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class Database;
+
+/**
+ * Buffers QueryServ log rows per table and writes them from its own thread and database connection as multi-row
+ * inserts once batch_size rows are waiting or flush_ms has passed. Detail rows are written right after their
+ * events and take the event ids from the event insert, QueryServ being the only writer of its tables.
+ *
+ * With a spool file configured, statements that can't reach the database, or rows queued past the backlog
+ * limit, are appended to it one per line and replayed in order once the database takes writes again
+ */
+class BatchWriter {
+public:
+	BatchWriter();
+	~BatchWriter();
+
+	bool Start(
+		const char *host,
+		const char *user,
+		const char *password,
+		const char *database,
+		uint32 port,
+		uint32 batch_size,
+		uint32 flush_ms,
+		const std::string &spool_file
+	);
+	void Stop();
+
+	/**
+	 * @param table
+	 * @param columns event table columns, without the auto increment id
+	 * @param values one escaped row in parentheses matching columns
+	 * @param detail_table
+	 * @param detail_columns detail table columns, the first one receives the event id
+	 * @param details escaped detail rows without parentheses or the event id
+	 */
+	void QueueEvent(
+		const std::string &table,
+		const std::string &columns,
+		std::string values,
+		const std::string &detail_table = std::string(),
+		const std::string &detail_columns = std::string(),
+		std::vector<std::string> details = std::vector<std::string>()
+	);
+	void QueueQuery(std::string query);
+
+private:
+	struct Event {
+		std::string              values;
+		std::vector<std::string> details;
+	};
+
+	struct Batch {
+		std::string        columns;
+		std::string        detail_table;
+		std::string        detail_columns;
+		std::vector<Event> events;
+	};
+
+	typedef std::chrono::steady_clock Clock;
+
+	static const uint32 MaxBacklogBatches = 100;
+	static const uint32 RetryIntervalMS   = 5000;
+
+	void Run();
+	void Flush(std::map<std::string, Batch> &batches, std::vector<std::string> &queries);
+	void WriteBatch(const std::string &table, Batch &batch);
+	bool Execute(const std::string &query, uint32 &last_insert_id);
+	bool WriteSpool(const std::vector<std::string> &lines);
+	void SpoolBatch(const std::string &table, const Batch &batch);
+	void ReplaySpool();
+	bool SpoolPending();
+
+	Database                *m_database;
+	std::thread             m_thread;
+	std::mutex              m_mutex;
+	std::condition_variable m_cv;
+	bool                    m_running;
+	uint32                  m_batch_size;
+	uint32                  m_flush_ms;
+	uint32                  m_queued_rows;
+	std::map<std::string, Batch> m_batches;
+	std::vector<std::string>     m_queries;
+
+	std::mutex  m_spool_mutex;
+	std::string m_spool_file;
+	bool        m_spool_pending;
+
+	// writer thread only
+	bool              m_database_down;
+	Clock::time_point m_retry_at;
+	uint32            m_auto_increment;
+};
+
+extern BatchWriter batch_writer;
+
+#endif
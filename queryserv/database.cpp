@@ -31,6 +31,7 @@
 #include <assert.h>
 #include <map>
 #include <vector>
+#include <time.h>
 
 // Disgrace: for windows compile
 #ifdef _WINDOWS
@@ -46,6 +47,7 @@
 #endif
 
 #include "database.h"
+#include "batch_writer.h"
 #include "../common/eq_packet_structs.h"
 #include "../common/string_util.h"
 #include "../common/servertalk.h"
@@ -99,6 +101,14 @@ Database::~Database()
 {
 }
 
+/**
+ * Rows are written by the batch writer a while after they are queued, stamp them with the time of the event
+ */
+static std::string EventTime()
+{
+	return StringFormat("FROM_UNIXTIME(%u)", static_cast<uint32>(time(nullptr)));
+}
+
 void Database::AddSpeech(
 	const char *from,
 	const char *to,
@@ -116,318 +126,223 @@ void Database::AddSpeech(
 	DoEscapeString(escapedTo, to, strlen(to));
 	DoEscapeString(escapedMessage, message, strlen(message));
 
-	std::string query = StringFormat(
-		"INSERT INTO `qs_player_speech` "
-		"SET `from` = '%s', `to` = '%s', `message`='%s', "
-		"`minstatus`='%i', `guilddbid`='%i', `type`='%i'",
-		escapedFrom, escapedTo, escapedMessage, minstatus, guilddbid, type
+	batch_writer.QueueEvent(
+		"qs_player_speech",
+		"`from`, `to`, `message`, `minstatus`, `guilddbid`, `type`, `timerecorded`",
+		StringFormat(
+			"('%s', '%s', '%s', '%i', '%i', '%i', %s)",
+			escapedFrom, escapedTo, escapedMessage, minstatus, guilddbid, type, EventTime().c_str()
+		)
 	);
+
 	safe_delete_array(escapedFrom);
 	safe_delete_array(escapedTo);
 	safe_delete_array(escapedMessage);
-	auto results = QueryDatabase(query);
-	if (!results.Success()) {
-		LogInfo("Failed Speech Entry Insert: [{}]", results.ErrorMessage().c_str());
-		LogInfo("[{}]", query.c_str());
-	}
-
-
 }
 
 void Database::LogPlayerDropItem(QSPlayerDropItem_Struct *QS)
 {
-
-	std::string query = StringFormat(
-		"INSERT INTO `qs_player_drop_record` SET `time` = NOW(), "
-		"`char_id` = '%i', `pickup` = '%i', "
-		"`zone_id` = '%i', `x` = '%i', `y` = '%i', `z` = '%i' ",
-		QS->char_id, QS->pickup, QS->zone_id, QS->x, QS->y, QS->z
-	);
-
-	auto results = QueryDatabase(query);
-	if (!results.Success()) {
-		LogInfo("Failed Drop Record Insert: [{}]", results.ErrorMessage().c_str());
-		LogInfo("[{}]", query.c_str());
-	}
-
-	if (QS->_detail_count == 0) {
-		return;
-	}
-
-	int lastIndex = results.LastInsertedID();
-
+	std::vector<std::string> details;
 	for (int i = 0; i < QS->_detail_count; i++) {
-		query   = StringFormat(
-			"INSERT INTO `qs_player_drop_record_entries` SET `event_id` = '%i', "
-			"`item_id` = '%i', `charges` = '%i', `aug_1` = '%i', `aug_2` = '%i', "
-			"`aug_3` = '%i', `aug_4` = '%i', `aug_5` = '%i'",
-			lastIndex, QS->items[i].item_id,
-			QS->items[i].charges, QS->items[i].aug_1, QS->items[i].aug_2,
-			QS->items[i].aug_3, QS->items[i].aug_4, QS->items[i].aug_5
+		details.push_back(
+			StringFormat(
+				"'%i', '%i', '%i', '%i', '%i', '%i', '%i'",
+				QS->items[i].item_id, QS->items[i].charges, QS->items[i].aug_1, QS->items[i].aug_2,
+				QS->items[i].aug_3, QS->items[i].aug_4, QS->items[i].aug_5
+			)
 		);
-		results = QueryDatabase(query);
-		if (!results.Success()) {
-			LogInfo("Failed Drop Record Entry Insert: [{}]", results.ErrorMessage().c_str());
-			LogInfo("[{}]", query.c_str());
-		}
 	}
+
+	batch_writer.QueueEvent(
+		"qs_player_drop_record",
+		"`time`, `char_id`, `pickup`, `zone_id`, `x`, `y`, `z`",
+		StringFormat(
+			"(%s, '%i', '%i', '%i', '%i', '%i', '%i')",
+			EventTime().c_str(), QS->char_id, QS->pickup, QS->zone_id, QS->x, QS->y, QS->z
+		),
+		"qs_player_drop_record_entries",
+		"`event_id`, `item_id`, `charges`, `aug_1`, `aug_2`, `aug_3`, `aug_4`, `aug_5`",
+		std::move(details)
+	);
 }
 
 void Database::LogPlayerTrade(QSPlayerLogTrade_Struct *QS, uint32 detailCount)
 {
-
-	std::string query   = StringFormat(
-		"INSERT INTO `qs_player_trade_record` SET `time` = NOW(), "
-		"`char1_id` = '%i', `char1_pp` = '%i', `char1_gp` = '%i', "
-		"`char1_sp` = '%i', `char1_cp` = '%i', `char1_items` = '%i', "
-		"`char2_id` = '%i', `char2_pp` = '%i', `char2_gp` = '%i', "
-		"`char2_sp` = '%i', `char2_cp` = '%i', `char2_items` = '%i'",
-		QS->char1_id, QS->char1_money.platinum, QS->char1_money.gold,
-		QS->char1_money.silver, QS->char1_money.copper, QS->char1_count,
-		QS->char2_id, QS->char2_money.platinum, QS->char2_money.gold,
-		QS->char2_money.silver, QS->char2_money.copper, QS->char2_count
-	);
-	auto        results = QueryDatabase(query);
-	if (!results.Success()) {
-		LogInfo("Failed Trade Log Record Insert: [{}]", results.ErrorMessage().c_str());
-		LogInfo("[{}]", query.c_str());
-	}
-
-	if (detailCount == 0) {
-		return;
-	}
-
-	int lastIndex = results.LastInsertedID();
-
+	std::vector<std::string> details;
 	for (int i = 0; i < detailCount; i++) {
-		query   = StringFormat(
-			"INSERT INTO `qs_player_trade_record_entries` SET `event_id` = '%i', "
-			"`from_id` = '%i', `from_slot` = '%i', `to_id` = '%i', `to_slot` = '%i', "
-			"`item_id` = '%i', `charges` = '%i', `aug_1` = '%i', `aug_2` = '%i', "
-			"`aug_3` = '%i', `aug_4` = '%i', `aug_5` = '%i'",
-			lastIndex, QS->items[i].from_id, QS->items[i].from_slot,
-			QS->items[i].to_id, QS->items[i].to_slot, QS->items[i].item_id,
-			QS->items[i].charges, QS->items[i].aug_1, QS->items[i].aug_2,
-			QS->items[i].aug_3, QS->items[i].aug_4, QS->items[i].aug_5
+		details.push_back(
+			StringFormat(
+				"'%i', '%i', '%i', '%i', '%i', '%i', '%i', '%i', '%i', '%i', '%i'",
+				QS->items[i].from_id, QS->items[i].from_slot,
+				QS->items[i].to_id, QS->items[i].to_slot, QS->items[i].item_id,
+				QS->items[i].charges, QS->items[i].aug_1, QS->items[i].aug_2,
+				QS->items[i].aug_3, QS->items[i].aug_4, QS->items[i].aug_5
+			)
 		);
-		results = QueryDatabase(query);
-		if (!results.Success()) {
-			LogInfo("Failed Trade Log Record Entry Insert: [{}]", results.ErrorMessage().c_str());
-			LogInfo("[{}]", query.c_str());
-		}
-
 	}
 
+	batch_writer.QueueEvent(
+		"qs_player_trade_record",
+		"`time`, `char1_id`, `char1_pp`, `char1_gp`, `char1_sp`, `char1_cp`, `char1_items`, "
+		"`char2_id`, `char2_pp`, `char2_gp`, `char2_sp`, `char2_cp`, `char2_items`",
+		StringFormat(
+			"(%s, '%i', '%i', '%i', '%i', '%i', '%i', '%i', '%i', '%i', '%i', '%i', '%i')",
+			EventTime().c_str(),
+			QS->char1_id, QS->char1_money.platinum, QS->char1_money.gold,
+			QS->char1_money.silver, QS->char1_money.copper, QS->char1_count,
+			QS->char2_id, QS->char2_money.platinum, QS->char2_money.gold,
+			QS->char2_money.silver, QS->char2_money.copper, QS->char2_count
+		),
+		"qs_player_trade_record_entries",
+		"`event_id`, `from_id`, `from_slot`, `to_id`, `to_slot`, `item_id`, `charges`, "
+		"`aug_1`, `aug_2`, `aug_3`, `aug_4`, `aug_5`",
+		std::move(details)
+	);
 }
 
 void Database::LogPlayerHandin(QSPlayerLogHandin_Struct *QS, uint32 detailCount)
 {
-
-	std::string query   = StringFormat(
-		"INSERT INTO `qs_player_handin_record` SET `time` = NOW(), "
-		"`quest_id` = '%i', `char_id` = '%i', `char_pp` = '%i', "
-		"`char_gp` = '%i', `char_sp` = '%i', `char_cp` = '%i', "
-		"`char_items` = '%i', `npc_id` = '%i', `npc_pp` = '%i', "
-		"`npc_gp` = '%i', `npc_sp` = '%i', `npc_cp` = '%i', "
-		"`npc_items`='%i'",
-		QS->quest_id, QS->char_id, QS->char_money.platinum,
-		QS->char_money.gold, QS->char_money.silver, QS->char_money.copper,
-		QS->char_count, QS->npc_id, QS->npc_money.platinum,
-		QS->npc_money.gold, QS->npc_money.silver, QS->npc_money.copper,
-		QS->npc_count
-	);
-	auto        results = QueryDatabase(query);
-	if (!results.Success()) {
-		LogInfo("Failed Handin Log Record Insert: [{}]", results.ErrorMessage().c_str());
-		LogInfo("[{}]", query.c_str());
-	}
-
-	if (detailCount == 0) {
-		return;
-	}
-
-	int lastIndex = results.LastInsertedID();
-
+	std::vector<std::string> details;
 	for (int i = 0; i < detailCount; i++) {
-		query = StringFormat(
-			"INSERT INTO `qs_player_handin_record_entries` SET `event_id` = '%i', "
-			"`action_type` = '%s', `char_slot` = '%i', `item_id` = '%i', "
-			"`charges` = '%i', `aug_1` = '%i', `aug_2` = '%i', `aug_3` = '%i', "
-			"`aug_4` = '%i', `aug_5` = '%i'",
-			lastIndex, QS->items[i].action_type, QS->items[i].char_slot,
-			QS->items[i].item_id, QS->items[i].charges, QS->items[i].aug_1,
-			QS->items[i].aug_2, QS->items[i].aug_3, QS->items[i].aug_4,
-			QS->items[i].aug_5
+		details.push_back(
+			StringFormat(
+				"'%s', '%i', '%i', '%i', '%i', '%i', '%i', '%i', '%i'",
+				QS->items[i].action_type, QS->items[i].char_slot,
+				QS->items[i].item_id, QS->items[i].charges, QS->items[i].aug_1,
+				QS->items[i].aug_2, QS->items[i].aug_3, QS->items[i].aug_4,
+				QS->items[i].aug_5
+			)
 		);
-		if (!results.Success()) {
-			LogInfo("Failed Handin Log Record Entry Insert: [{}]", results.ErrorMessage().c_str());
-			LogInfo("[{}]", query.c_str());
-		}
 	}
 
+	batch_writer.QueueEvent(
+		"qs_player_handin_record",
+		"`time`, `quest_id`, `char_id`, `char_pp`, `char_gp`, `char_sp`, `char_cp`, `char_items`, "
+		"`npc_id`, `npc_pp`, `npc_gp`, `npc_sp`, `npc_cp`, `npc_items`",
+		StringFormat(
+			"(%s, '%i', '%i', '%i', '%i', '%i', '%i', '%i', '%i', '%i', '%i', '%i', '%i', '%i')",
+			EventTime().c_str(),
+			QS->quest_id, QS->char_id, QS->char_money.platinum,
+			QS->char_money.gold, QS->char_money.silver, QS->char_money.copper,
+			QS->char_count, QS->npc_id, QS->npc_money.platinum,
+			QS->npc_money.gold, QS->npc_money.silver, QS->npc_money.copper,
+			QS->npc_count
+		),
+		"qs_player_handin_record_entries",
+		"`event_id`, `action_type`, `char_slot`, `item_id`, `charges`, "
+		"`aug_1`, `aug_2`, `aug_3`, `aug_4`, `aug_5`",
+		std::move(details)
+	);
 }
 
 void Database::LogPlayerNPCKill(QSPlayerLogNPCKill_Struct *QS, uint32 members)
 {
-
-	std::string query   = StringFormat(
-		"INSERT INTO `qs_player_npc_kill_record` "
-		"SET `npc_id` = '%i', `type` = '%i', "
-		"`zone_id` = '%i', `time` = NOW()",
-		QS->s1.NPCID, QS->s1.Type, QS->s1.ZoneID
-	);
-	auto        results = QueryDatabase(query);
-	if (!results.Success()) {
-		LogInfo("Failed NPC Kill Log Record Insert: [{}]", results.ErrorMessage().c_str());
-		LogInfo("[{}]", query.c_str());
-	}
-
-	if (members == 0) {
-		return;
-	}
-
-	int lastIndex = results.LastInsertedID();
-
+	std::vector<std::string> details;
 	for (int i = 0; i < members; i++) {
-		query = StringFormat(
-			"INSERT INTO `qs_player_npc_kill_record_entries` "
-			"SET `event_id` = '%i', `char_id` = '%i'",
-			lastIndex, QS->Chars[i].char_id
-		);
-		auto results = QueryDatabase(query);
-		if (!results.Success()) {
-			LogInfo("Failed NPC Kill Log Entry Insert: [{}]", results.ErrorMessage().c_str());
-			LogInfo("[{}]", query.c_str());
-		}
-
+		details.push_back(StringFormat("'%i'", QS->Chars[i].char_id));
 	}
 
+	batch_writer.QueueEvent(
+		"qs_player_npc_kill_record",
+		"`npc_id`, `type`, `zone_id`, `time`",
+		StringFormat(
+			"('%i', '%i', '%i', %s)",
+			QS->s1.NPCID, QS->s1.Type, QS->s1.ZoneID, EventTime().c_str()
+		),
+		"qs_player_npc_kill_record_entries",
+		"`event_id`, `char_id`",
+		std::move(details)
+	);
 }
 
 void Database::LogPlayerDelete(QSPlayerLogDelete_Struct *QS, uint32 items)
 {
-
-	std::string query   = StringFormat(
-		"INSERT INTO `qs_player_delete_record` SET `time` = NOW(), "
-		"`char_id` = '%i', `stack_size` = '%i', `char_items` = '%i'",
-		QS->char_id, QS->stack_size, QS->char_count, QS->char_count
-	);
-	auto        results = QueryDatabase(query);
-	if (!results.Success()) {
-		LogInfo("Failed Delete Log Record Insert: [{}]", results.ErrorMessage().c_str());
-		LogInfo("[{}]", query.c_str());
-	}
-
-	if (items == 0) {
-		return;
-	}
-
-	int lastIndex = results.LastInsertedID();
-
+	std::vector<std::string> details;
 	for (int i = 0; i < items; i++) {
-		query   = StringFormat(
-			"INSERT INTO `qs_player_delete_record_entries` SET `event_id` = '%i', "
-			"`char_slot` = '%i', `item_id` = '%i', `charges` = '%i', `aug_1` = '%i', "
-			"`aug_2` = '%i', `aug_3` = '%i', `aug_4` = '%i', `aug_5` = '%i'",
-			lastIndex, QS->items[i].char_slot, QS->items[i].item_id, QS->items[i].charges,
-			QS->items[i].aug_1, QS->items[i].aug_2, QS->items[i].aug_3, QS->items[i].aug_4,
-			QS->items[i].aug_5
+		details.push_back(
+			StringFormat(
+				"'%i', '%i', '%i', '%i', '%i', '%i', '%i', '%i'",
+				QS->items[i].char_slot, QS->items[i].item_id, QS->items[i].charges,
+				QS->items[i].aug_1, QS->items[i].aug_2, QS->items[i].aug_3, QS->items[i].aug_4,
+				QS->items[i].aug_5
+			)
 		);
-		results = QueryDatabase(query);
-		if (!results.Success()) {
-			LogInfo("Failed Delete Log Record Entry Insert: [{}]", results.ErrorMessage().c_str());
-			LogInfo("[{}]", query.c_str());
-		}
-
 	}
 
+	batch_writer.QueueEvent(
+		"qs_player_delete_record",
+		"`time`, `char_id`, `stack_size`, `char_items`",
+		StringFormat(
+			"(%s, '%i', '%i', '%i')",
+			EventTime().c_str(), QS->char_id, QS->stack_size, QS->char_count
+		),
+		"qs_player_delete_record_entries",
+		"`event_id`, `char_slot`, `item_id`, `charges`, `aug_1`, `aug_2`, `aug_3`, `aug_4`, `aug_5`",
+		std::move(details)
+	);
 }
 
 void Database::LogPlayerMove(QSPlayerLogMove_Struct *QS, uint32 items)
 {
 	/* These are item moves */
-
-	std::string query   = StringFormat(
-		"INSERT INTO `qs_player_move_record` SET `time` = NOW(), "
-		"`char_id` = '%i', `from_slot` = '%i', `to_slot` = '%i', "
-		"`stack_size` = '%i', `char_items` = '%i', `postaction` = '%i'",
-		QS->char_id, QS->from_slot, QS->to_slot, QS->stack_size,
-		QS->char_count, QS->postaction
-	);
-	auto        results = QueryDatabase(query);
-	if (!results.Success()) {
-		LogInfo("Failed Move Log Record Insert: [{}]", results.ErrorMessage().c_str());
-		LogInfo("[{}]", query.c_str());
-	}
-
-	if (items == 0) {
-		return;
-	}
-
-	int lastIndex = results.LastInsertedID();
-
+	std::vector<std::string> details;
 	for (int i = 0; i < items; i++) {
-		query   = StringFormat(
-			"INSERT INTO `qs_player_move_record_entries` SET `event_id` = '%i', "
-			"`from_slot` = '%i', `to_slot` = '%i', `item_id` = '%i', `charges` = '%i', "
-			"`aug_1` = '%i', `aug_2` = '%i', `aug_3` = '%i', `aug_4` = '%i', `aug_5` = '%i'",
-			lastIndex, QS->items[i].from_slot, QS->items[i].to_slot, QS->items[i].item_id,
-			QS->items[i].charges, QS->items[i].aug_1, QS->items[i].aug_2,
-			QS->items[i].aug_3, QS->items[i].aug_4, QS->items[i].aug_5
+		details.push_back(
+			StringFormat(
+				"'%i', '%i', '%i', '%i', '%i', '%i', '%i', '%i', '%i'",
+				QS->items[i].from_slot, QS->items[i].to_slot, QS->items[i].item_id,
+				QS->items[i].charges, QS->items[i].aug_1, QS->items[i].aug_2,
+				QS->items[i].aug_3, QS->items[i].aug_4, QS->items[i].aug_5
+			)
 		);
-		results = QueryDatabase(query);
-		if (!results.Success()) {
-			LogInfo("Failed Move Log Record Entry Insert: [{}]", results.ErrorMessage().c_str());
-			LogInfo("[{}]", query.c_str());
-		}
 	}
+
+	batch_writer.QueueEvent(
+		"qs_player_move_record",
+		"`time`, `char_id`, `from_slot`, `to_slot`, `stack_size`, `char_items`, `postaction`",
+		StringFormat(
+			"(%s, '%i', '%i', '%i', '%i', '%i', '%i')",
+			EventTime().c_str(), QS->char_id, QS->from_slot, QS->to_slot, QS->stack_size,
+			QS->char_count, QS->postaction
+		),
+		"qs_player_move_record_entries",
+		"`event_id`, `from_slot`, `to_slot`, `item_id`, `charges`, `aug_1`, `aug_2`, `aug_3`, `aug_4`, `aug_5`",
+		std::move(details)
+	);
 }
 
 void Database::LogMerchantTransaction(QSMerchantLogTransaction_Struct *QS, uint32 items)
 {
 	/* Merchant transactions are from the perspective of the merchant, not the player */
-	std::string query   = StringFormat(
-		"INSERT INTO `qs_merchant_transaction_record` SET `time` = NOW(), "
-		"`zone_id` = '%i', `merchant_id` = '%i', `merchant_pp` = '%i', "
-		"`merchant_gp` = '%i', `merchant_sp` = '%i', `merchant_cp` = '%i', "
-		"`merchant_items` = '%i', `char_id` = '%i', `char_pp` = '%i', "
-		"`char_gp` = '%i', `char_sp` = '%i', `char_cp` = '%i', "
-		"`char_items` = '%i'",
-		QS->zone_id, QS->merchant_id, QS->merchant_money.platinum,
-		QS->merchant_money.gold, QS->merchant_money.silver,
-		QS->merchant_money.copper, QS->merchant_count, QS->char_id,
-		QS->char_money.platinum, QS->char_money.gold, QS->char_money.silver,
-		QS->char_money.copper, QS->char_count
-	);
-	auto        results = QueryDatabase(query);
-	if (!results.Success()) {
-		LogInfo("Failed Transaction Log Record Insert: [{}]", results.ErrorMessage().c_str());
-		LogInfo("[{}]", query.c_str());
-	}
-
-	if (items == 0) {
-		return;
-	}
-
-	int lastIndex = results.LastInsertedID();
-
+	std::vector<std::string> details;
 	for (int i = 0; i < items; i++) {
-		query   = StringFormat(
-			"INSERT INTO `qs_merchant_transaction_record_entries` SET `event_id` = '%i', "
-			"`char_slot` = '%i', `item_id` = '%i', `charges` = '%i', `aug_1` = '%i', "
-			"`aug_2` = '%i', `aug_3` = '%i', `aug_4` = '%i', `aug_5` = '%i'",
-			lastIndex, QS->items[i].char_slot, QS->items[i].item_id, QS->items[i].charges,
-			QS->items[i].aug_1, QS->items[i].aug_2, QS->items[i].aug_3, QS->items[i].aug_4,
-			QS->items[i].aug_5
+		details.push_back(
+			StringFormat(
+				"'%i', '%i', '%i', '%i', '%i', '%i', '%i', '%i'",
+				QS->items[i].char_slot, QS->items[i].item_id, QS->items[i].charges,
+				QS->items[i].aug_1, QS->items[i].aug_2, QS->items[i].aug_3, QS->items[i].aug_4,
+				QS->items[i].aug_5
+			)
 		);
-		results = QueryDatabase(query);
-		if (!results.Success()) {
-			LogInfo("Failed Transaction Log Record Entry Insert: [{}]", results.ErrorMessage().c_str());
-			LogInfo("[{}]", query.c_str());
-		}
-
 	}
 
+	batch_writer.QueueEvent(
+		"qs_merchant_transaction_record",
+		"`time`, `zone_id`, `merchant_id`, `merchant_pp`, `merchant_gp`, `merchant_sp`, `merchant_cp`, "
+		"`merchant_items`, `char_id`, `char_pp`, `char_gp`, `char_sp`, `char_cp`, `char_items`",
+		StringFormat(
+			"(%s, '%i', '%i', '%i', '%i', '%i', '%i', '%i', '%i', '%i', '%i', '%i', '%i', '%i')",
+			EventTime().c_str(),
+			QS->zone_id, QS->merchant_id, QS->merchant_money.platinum,
+			QS->merchant_money.gold, QS->merchant_money.silver,
+			QS->merchant_money.copper, QS->merchant_count, QS->char_id,
+			QS->char_money.platinum, QS->char_money.gold, QS->char_money.silver,
+			QS->char_money.copper, QS->char_count
+		),
+		"qs_merchant_transaction_record_entries",
+		"`event_id`, `char_slot`, `item_id`, `charges`, `aug_1`, `aug_2`, `aug_3`, `aug_4`, `aug_5`",
+		std::move(details)
+	);
 }
 
 // this function does not delete the ServerPacket, so it must be handled at call site
@@ -439,12 +354,7 @@ void Database::GeneralQueryReceive(ServerPacket *pack)
 	auto queryBuffer    = new char[pack->ReadUInt32() + 1];
 	pack->ReadString(queryBuffer);
 
-	std::string query(queryBuffer);
-	auto        results = QueryDatabase(query);
-	if (!results.Success()) {
-		LogInfo("Failed Delete Log Record Insert: [{}]", results.ErrorMessage().c_str());
-		LogInfo("[{}]", query.c_str());
-	}
+	batch_writer.QueueQuery(queryBuffer);
 
 	safe_delete_array(queryBuffer);
 }
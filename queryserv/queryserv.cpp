@@ -26,6 +26,7 @@
 #include "../common/crash.h"
 #include "../common/event/event_loop.h"
 #include "../common/timer.h"
+#include "batch_writer.h"
 #include "database.h"
 #include "queryservconfig.h"
 #include "lfguild.h"
@@ -78,6 +79,18 @@ int main() {
 	database.LoadLogSettings(LogSys.log_settings);
 	LogSys.StartFileLogs();
 
+	/* Log rows are written in batches from their own connection */
+	batch_writer.Start(
+		Config->QSDatabaseHost.c_str(),
+		Config->QSDatabaseUsername.c_str(),
+		Config->QSDatabasePassword.c_str(),
+		Config->QSDatabaseDB.c_str(),
+		Config->QSDatabasePort,
+		Config->QSBatchSize,
+		Config->QSBatchFlushMS,
+		Config->QSSpoolFile
+	);
+
 	if (signal(SIGINT, CatchSignal) == SIG_ERR)	{
 		LogInfo("Could not set signal handler");
 		return 1;
@@ -102,6 +115,8 @@ int main() {
 		EQ::EventLoop::Get().Process();
 		Sleep(5);
 	}
+
+	batch_writer.Stop();
 	LogSys.CloseFileLogs();
 }
 
@@ -0,0 +1,211 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2020 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#ifndef __EQEMU_TESTS_CHAT_CHANNEL_FANOUT_H
+#define __EQEMU_TESTS_CHAT_CHANNEL_FANOUT_H
+
+#include "cppunit/cpptest.h"
+#include "../ucs/chatchannel.h"
+#include "../common/misc_functions.h"
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+
+// stands in for a UCS client, which needs a live stream
+struct FakeChannelMember {
+	EQ::versions::ClientVersion version;
+	uint32 packets;
+	uint32 bytes;
+
+	EQ::versions::ClientVersion GetClientVersion() { return version; }
+	void QueuePacket(const EQApplicationPacket *p, bool ack_req = true) {
+		packets++;
+		bytes += p->size;
+	}
+};
+
+inline void MakeFakeChannelMembers(size_t count, std::vector<std::unique_ptr<FakeChannelMember>> &storage, std::vector<FakeChannelMember*> &members) {
+	const EQ::versions::ClientVersion versions[] = {
+		EQ::versions::ClientVersion::Titanium,
+		EQ::versions::ClientVersion::SoF,
+		EQ::versions::ClientVersion::UF,
+		EQ::versions::ClientVersion::RoF2
+	};
+
+	for (size_t i = 0; i < count; ++i) {
+		std::unique_ptr<FakeChannelMember> m(new FakeChannelMember());
+		m->version = versions[i % 4];
+		m->packets = 0;
+		m->bytes   = 0;
+		members.push_back(m.get());
+		storage.push_back(std::move(m));
+	}
+}
+
+class ChatChannelFanoutTest : public Test::Suite {
+	typedef void(ChatChannelFanoutTest::*TestFunction)(void);
+public:
+	ChatChannelFanoutTest() {
+		TEST_ADD(ChatChannelFanoutTest::SharedPacketTest);
+		TEST_ADD(ChatChannelFanoutTest::UnknownVersionTest);
+	}
+
+	~ChatChannelFanoutTest() {
+	}
+
+	private:
+	typedef FakeChannelMember FakeMember;
+
+	static EQApplicationPacket *MakeMessage(const std::string &Message) {
+		auto outapp = new EQApplicationPacket(OP_ChannelMessage, Message.length() + 1);
+		memcpy(outapp->pBuffer, Message.c_str(), Message.length() + 1);
+		return outapp;
+	}
+
+	void SharedPacketTest() {
+		std::vector<std::unique_ptr<FakeMember>> storage;
+		std::vector<FakeMember*> members;
+		MakeFakeChannelMembers(100, storage, members);
+		members.push_back(nullptr);
+
+		int built = QueuePacketByClientVersion(members, [](FakeMember *m) {
+			return MakeMessage("Hail, Guard Bayle");
+		});
+
+		TEST_ASSERT(built == 4);
+		for (auto &m : storage) {
+			TEST_ASSERT(m->packets == 1);
+			TEST_ASSERT(m->bytes == 18);
+		}
+	}
+
+	void UnknownVersionTest() {
+		FakeMember odd;
+		odd.version = static_cast<EQ::versions::ClientVersion>(EQ::versions::ClientVersionCount + 3);
+		odd.packets = 0;
+		odd.bytes   = 0;
+
+		FakeMember unknown = odd;
+		unknown.version = EQ::versions::ClientVersion::Unknown;
+
+		std::vector<FakeMember*> members = { &odd, &unknown };
+
+		int built = QueuePacketByClientVersion(members, [](FakeMember *m) {
+			return MakeMessage("Hail");
+		});
+
+		TEST_ASSERT(built == 1);
+		TEST_ASSERT(odd.packets == 1);
+		TEST_ASSERT(unknown.packets == 1);
+	}
+};
+
+/**
+ * Times a 5000 member channel message, not part of the default run. Use tests --benchmark
+ */
+class ChatChannelFanoutBenchmark : public Test::Suite {
+	typedef void(ChatChannelFanoutBenchmark::*TestFunction)(void);
+public:
+	ChatChannelFanoutBenchmark() {
+		TEST_ADD(ChatChannelFanoutBenchmark::FiveThousandMemberBenchmark);
+	}
+
+	~ChatChannelFanoutBenchmark() {
+	}
+
+	private:
+	typedef FakeChannelMember FakeMember;
+
+	// the layout Client::MakeChannelMessagePacket writes
+	static EQApplicationPacket *MakeChannelMessage(const std::string &ChannelName, const std::string &SenderName, const std::string &Message, bool UnderfootOrLater) {
+		std::string FQSenderName = "worldshortname." + SenderName;
+
+		int PacketLength = ChannelName.length() + Message.length() + FQSenderName.length() + 3;
+
+		if (UnderfootOrLater)
+			PacketLength += 8;
+
+		auto outapp = new EQApplicationPacket(OP_ChannelMessage, PacketLength);
+
+		char *PacketBuffer = (char *)outapp->pBuffer;
+
+		VARSTRUCT_ENCODE_STRING(PacketBuffer, ChannelName.c_str());
+		VARSTRUCT_ENCODE_STRING(PacketBuffer, FQSenderName.c_str());
+		VARSTRUCT_ENCODE_STRING(PacketBuffer, Message.c_str());
+
+		if (UnderfootOrLater)
+			VARSTRUCT_ENCODE_STRING(PacketBuffer, "SPAM:0:");
+
+		return outapp;
+	}
+
+	static bool IsUnderfootOrLater(const FakeMember *m) {
+		return m->version >= EQ::versions::ClientVersion::UF;
+	}
+
+	void FiveThousandMemberBenchmark() {
+		const int Messages = 50;
+
+		std::vector<std::unique_ptr<FakeMember>> storage;
+		std::vector<FakeMember*> members;
+		MakeFakeChannelMembers(5000, storage, members);
+
+		std::string channel = "General";
+		std::string sender  = "Soandso";
+		std::string message = "WTS Fungus Covered Scale Tunic, /tell Soandso";
+
+		// what SendMessageToChannel did before, the text cached per client version and a packet formatted per member
+		auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < Messages; ++i) {
+			std::string cv_messages[EQ::versions::ClientVersionCount];
+			for (auto m : members) {
+				std::string &cv_message = cv_messages[static_cast<uint32>(m->version)];
+				if (cv_message.length() == 0)
+					cv_message = message;
+
+				auto outapp = MakeChannelMessage(channel, sender, cv_message, IsUnderfootOrLater(m));
+				m->QueuePacket(outapp);
+				safe_delete(outapp);
+			}
+		}
+		auto per_member = std::chrono::steady_clock::now() - start;
+
+		int built = 0;
+		start = std::chrono::steady_clock::now();
+		for (int i = 0; i < Messages; ++i) {
+			built += QueuePacketByClientVersion(members, [&](FakeMember *m) {
+				return MakeChannelMessage(channel, sender, message, IsUnderfootOrLater(m));
+			});
+		}
+		auto shared = std::chrono::steady_clock::now() - start;
+
+		TEST_ASSERT(built == Messages * 4);
+		for (auto &m : storage) {
+			TEST_ASSERT(m->packets == Messages * 2);
+		}
+
+		std::cout << "5000 member channel fan-out: "
+			<< std::chrono::duration_cast<std::chrono::microseconds>(per_member).count() / Messages
+			<< " us per message formatting a packet per member, "
+			<< std::chrono::duration_cast<std::chrono::microseconds>(shared).count() / Messages
+			<< " us per message formatting one per client version" << std::endl;
+	}
+};
+
+#endif
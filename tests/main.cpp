@@ -17,6 +17,7 @@
 */
 
 
+#include <cstring>
 #include <iostream>
 #include <fstream>
 #include <memory>
@@ -29,16 +30,26 @@
 #include "string_util_test.h"
 #include "data_verification_test.h"
 #include "skills_util_test.h"
+#include "servertalk_codec_test.h"
+#include "chat_channel_fanout_test.h"
 #include "../common/eqemu_config.h"
 
 const EQEmuConfig *Config;
 
-int main() {
+int main(int argc, char **argv) {
 	auto ConfigLoadResult = EQEmuConfig::LoadConfig();
         Config = EQEmuConfig::get();
 	try {
 		std::ofstream outfile("test_output.txt");
 		std::unique_ptr<Test::Output> output(new Test::TextOutput(Test::TextOutput::Verbose, outfile));
+
+		// benchmarks print their timings and only run on request
+		if (argc > 1 && strcmp(argv[1], "--benchmark") == 0) {
+			Test::Suite benchmarks;
+			benchmarks.add(new ChatChannelFanoutBenchmark());
+			return benchmarks.run(*output, true) ? 0 : 1;
+		}
+
 		Test::Suite tests;
 		tests.add(new MemoryMappedFileTest());
 		tests.add(new IPCMutexTest());
@@ -49,6 +60,8 @@ int main() {
 		tests.add(new StringUtilTest());
 		tests.add(new DataVerificationTest());
 		tests.add(new SkillsUtilsTest());
+		tests.add(new ServertalkCodecTest());
+		tests.add(new ChatChannelFanoutTest());
 		tests.run(*output, true);
 	} catch(...) {
 		return -1;
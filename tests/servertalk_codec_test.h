@@ -0,0 +1,128 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2020 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#ifndef __EQEMU_TESTS_SERVERTALK_CODEC_H
+#define __EQEMU_TESTS_SERVERTALK_CODEC_H
+
+#include "cppunit/cpptest.h"
+#include "../common/net/servertalk_codec.h"
+#include "../common/servertalk.h"
+
+class ServertalkCodecTest : public Test::Suite {
+	typedef void(ServertalkCodecTest::*TestFunction)(void);
+public:
+	ServertalkCodecTest() {
+		TEST_ADD(ServertalkCodecTest::PaddedStructTest);
+		TEST_ADD(ServertalkCodecTest::CompressedTest);
+		TEST_ADD(ServertalkCodecTest::DenseDataTest);
+		TEST_ADD(ServertalkCodecTest::TrailingZeroTest);
+		TEST_ADD(ServertalkCodecTest::MalformedTest);
+	}
+
+	~ServertalkCodecTest() {
+	}
+
+	private:
+	bool RoundTrip(EQ::Net::Packet &in, bool compress, size_t &encoded_length) {
+		EQ::Net::DynamicPacket encoded;
+		EQ::Net::DynamicPacket decoded;
+
+		EQ::Net::ServertalkCompactEncode(in, encoded, compress);
+		encoded_length = encoded.Length();
+
+		if (!EQ::Net::ServertalkCompactDecode(encoded, decoded)) {
+			return false;
+		}
+
+		return decoded.Length() == in.Length() && memcmp(decoded.Data(), in.Data(), in.Length()) == 0;
+	}
+
+	void PaddedStructTest() {
+		char buffer[sizeof(ServerChannelMessage_Struct) + 512];
+		memset(buffer, 0, sizeof(buffer));
+
+		auto scm = (ServerChannelMessage_Struct *) buffer;
+		strcpy(scm->from, "Soandso");
+		strcpy(scm->to, "Someone");
+		strcpy(scm->message, "Hail, Guard Bayle");
+		scm->chan_num = 7;
+
+		EQ::Net::StaticPacket in(buffer, sizeof(buffer));
+
+		size_t encoded_length = 0;
+		TEST_ASSERT(RoundTrip(in, false, encoded_length));
+		TEST_ASSERT(encoded_length < sizeof(buffer) / 8);
+	}
+
+	void CompressedTest() {
+		EQ::Net::DynamicPacket in;
+		for (size_t i = 0; i < 64; ++i) {
+			in.PutCString(in.Length(), "Guild MOTD: raid tonight at 8, bring potions");
+			in.PutUInt32(in.Length(), (uint32) i);
+		}
+
+		size_t runs_length = 0;
+		size_t compressed_length = 0;
+		TEST_ASSERT(RoundTrip(in, false, runs_length));
+		TEST_ASSERT(RoundTrip(in, true, compressed_length));
+		TEST_ASSERT(compressed_length < runs_length);
+	}
+
+	void DenseDataTest() {
+		EQ::Net::DynamicPacket in;
+		for (uint32 i = 0; i < 300; ++i) {
+			in.PutUInt8(i, (uint8) (i * 7 + 1) | 1);
+		}
+
+		size_t encoded_length = 0;
+		TEST_ASSERT(RoundTrip(in, true, encoded_length));
+		TEST_ASSERT(encoded_length <= in.Length() + 8);
+	}
+
+	void TrailingZeroTest() {
+		EQ::Net::DynamicPacket in;
+		in.PutUInt8(0, 1);
+		in.PutUInt8(1, 0);
+
+		size_t encoded_length = 0;
+		TEST_ASSERT(RoundTrip(in, false, encoded_length));
+
+		in.PutUInt8(2, 2);
+		in.PutUInt32(3, 0);
+		TEST_ASSERT(RoundTrip(in, false, encoded_length));
+	}
+
+	void MalformedTest() {
+		char buffer[sizeof(ServerChannelMessage_Struct) + 64];
+		memset(buffer, 0, sizeof(buffer));
+		strcpy(((ServerChannelMessage_Struct *) buffer)->message, "truncated");
+
+		EQ::Net::StaticPacket in(buffer, sizeof(buffer));
+		EQ::Net::DynamicPacket encoded;
+		EQ::Net::DynamicPacket decoded;
+		EQ::Net::ServertalkCompactEncode(in, encoded, false);
+
+		EQ::Net::StaticPacket truncated(encoded.Data(), encoded.Length() - 1);
+		TEST_ASSERT(!EQ::Net::ServertalkCompactDecode(truncated, decoded));
+
+		encoded.PutUInt8(encoded.Length(), 0);
+		TEST_ASSERT(!EQ::Net::ServertalkCompactDecode(encoded, decoded));
+	}
+};
+
+#endif
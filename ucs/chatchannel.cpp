@@ -59,42 +59,33 @@ ChatChannel::ChatChannel(std::string inName, std::string inOwner, std::string in
 
 ChatChannel::~ChatChannel() {
 
-	LinkedListIterator<Client*> iterator(ClientsInChannel);
-
-	iterator.Reset();
-
-	while(iterator.MoreElements())
-		iterator.RemoveCurrent(false);
+	ClientsInChannel.clear();
 }
 
 ChatChannel* ChatChannelList::CreateChannel(std::string Name, std::string Owner, std::string Password, bool Permanent, int MinimumStatus) {
 
-	ChatChannel *NewChannel = new ChatChannel(CapitaliseName(Name), Owner, Password, Permanent, MinimumStatus);
-
-	ChatChannels.Insert(NewChannel);
-
-	return NewChannel;
-}
+	std::string NormalisedName = CapitaliseName(Name);
 
-ChatChannel* ChatChannelList::FindChannel(std::string Name) {
+	auto it = ChatChannels.find(NormalisedName);
 
-	std::string NormalisedName = CapitaliseName(Name);
+	if(it != ChatChannels.end())
+		return it->second;
 
-	LinkedListIterator<ChatChannel*> iterator(ChatChannels);
+	ChatChannel *NewChannel = new ChatChannel(NormalisedName, Owner, Password, Permanent, MinimumStatus);
 
-	iterator.Reset();
+	ChatChannels[NormalisedName] = NewChannel;
 
-	while(iterator.MoreElements()) {
+	return NewChannel;
+}
 
-		ChatChannel *CurrentChannel = iterator.GetData();
+ChatChannel* ChatChannelList::FindChannel(std::string Name) {
 
-		if(CurrentChannel && (CurrentChannel->Name == NormalisedName))
-			return iterator.GetData();
+	auto it = ChatChannels.find(CapitaliseName(Name));
 
-		iterator.Advance();
-	}
+	if(it == ChatChannels.end())
+		return nullptr;
 
-	return nullptr;
+	return it->second;
 }
 
 void ChatChannelList::SendAllChannels(Client *c) {
@@ -110,24 +101,24 @@ void ChatChannelList::SendAllChannels(Client *c) {
 
 	int ChannelsInLine = 0;
 
-	LinkedListIterator<ChatChannel*> iterator(ChatChannels);
-
-	iterator.Reset();
-
 	std::string Message;
 
 	char CountString[10];
 
-	while(iterator.MoreElements()) {
+	// the map has no order of its own, list the channels by name so the output is stable
+	std::vector<ChatChannel*> VisibleChannels;
 
-		ChatChannel *CurrentChannel = iterator.GetData();
+	for(auto &Channel : ChatChannels) {
 
-		if(!CurrentChannel || (CurrentChannel->GetMinStatus() > c->GetAccountStatus())) {
+		if(Channel.second && (Channel.second->GetMinStatus() <= c->GetAccountStatus()))
+			VisibleChannels.push_back(Channel.second);
+	}
 
-			iterator.Advance();
+	std::sort(VisibleChannels.begin(), VisibleChannels.end(), [](ChatChannel *a, ChatChannel *b) {
+		return a->GetName() < b->GetName();
+	});
 
-			continue;
-		}
+	for(auto CurrentChannel : VisibleChannels) {
 
 		if(ChannelsInLine > 0)
 			Message += ", ";
@@ -148,8 +139,6 @@ void ChatChannelList::SendAllChannels(Client *c) {
 
 			Message.clear();
 		}
-
-		iterator.Advance();
 	}
 
 	if(ChannelsInLine > 0)
@@ -161,20 +150,13 @@ void ChatChannelList::RemoveChannel(ChatChannel *Channel) {
 
 	LogDebug("RemoveChannel ([{}])", Channel->GetName().c_str());
 
-	LinkedListIterator<ChatChannel*> iterator(ChatChannels);
+	auto it = ChatChannels.find(Channel->GetName());
 
-	iterator.Reset();
+	if((it != ChatChannels.end()) && (it->second == Channel)) {
 
-	while(iterator.MoreElements()) {
-
-		if(iterator.GetData() == Channel) {
-
-			iterator.RemoveCurrent();
-
-			return;
-		}
+		ChatChannels.erase(it);
 
-		iterator.Advance();
+		safe_delete(Channel);
 	}
 }
 
@@ -182,30 +164,20 @@ void ChatChannelList::RemoveAllChannels() {
 
 	LogDebug("RemoveAllChannels");
 
-	LinkedListIterator<ChatChannel*> iterator(ChatChannels);
+	for(auto &Channel : ChatChannels)
+		safe_delete(Channel.second);
 
-	iterator.Reset();
-
-	while(iterator.MoreElements())
-		iterator.RemoveCurrent();
+	ChatChannels.clear();
 }
 
 int ChatChannel::MemberCount(int Status) {
 
 	int Count = 0;
 
-	LinkedListIterator<Client*> iterator(ClientsInChannel);
-
-	iterator.Reset();
-
-	while(iterator.MoreElements()) {
-
-		Client *ChannelClient = iterator.GetData();
+	for(auto ChannelClient : ClientsInChannel) {
 
 		if(ChannelClient && (!ChannelClient->GetHideMe() || (ChannelClient->GetAccountStatus() < Status)))
 			Count++;
-
-		iterator.Advance();
 	}
 
 	return Count;
@@ -249,22 +221,14 @@ void ChatChannel::AddClient(Client *c) {
 
 	LogDebug("Adding [{}] to channel [{}]", c->GetName().c_str(), Name.c_str());
 
-	LinkedListIterator<Client*> iterator(ClientsInChannel);
-
-	iterator.Reset();
-
-	while(iterator.MoreElements()) {
-
-		Client *CurrentClient = iterator.GetData();
+	for(auto CurrentClient : ClientsInChannel) {
 
 		if(CurrentClient && CurrentClient->IsAnnounceOn())
 			if(!HideMe || (CurrentClient->GetAccountStatus() > AccountStatus))
 				CurrentClient->AnnounceJoin(this, c);
-
-		iterator.Advance();
 	}
 
-	ClientsInChannel.Insert(c);
+	ClientsInChannel.push_back(c);
 
 }
 
@@ -280,28 +244,21 @@ bool ChatChannel::RemoveClient(Client *c) {
 
 	int PlayersInChannel = 0;
 
-	LinkedListIterator<Client*> iterator(ClientsInChannel);
-
-	iterator.Reset();
-
-	while(iterator.MoreElements()) {
+	auto it = std::find(ClientsInChannel.begin(), ClientsInChannel.end(), c);
 
-		Client *CurrentClient = iterator.GetData();
-
-		if(CurrentClient == c) {
-			iterator.RemoveCurrent(false);
-		}
-		else if(CurrentClient) {
+	if(it != ClientsInChannel.end())
+		ClientsInChannel.erase(it);
 
-			PlayersInChannel++;
+	for(auto CurrentClient : ClientsInChannel) {
 
-			if(CurrentClient->IsAnnounceOn())
-				if(!HideMe || (CurrentClient->GetAccountStatus() > AccountStatus))
-					CurrentClient->AnnounceLeave(this, c);
+		if(!CurrentClient)
+			continue;
 
-			iterator.Advance();
-		}
+		PlayersInChannel++;
 
+		if(CurrentClient->IsAnnounceOn())
+			if(!HideMe || (CurrentClient->GetAccountStatus() > AccountStatus))
+				CurrentClient->AnnounceLeave(this, c);
 	}
 
 	if((PlayersInChannel == 0) && !Permanent) {
@@ -350,20 +307,12 @@ void ChatChannel::SendChannelMembers(Client *c) {
 
 	int MembersInLine = 0;
 
-	LinkedListIterator<Client*> iterator(ClientsInChannel);
-
-	iterator.Reset();
-
-	while(iterator.MoreElements()) {
-
-		Client *ChannelClient = iterator.GetData();
+	for(auto ChannelClient : ClientsInChannel) {
 
 		// Don't list hidden characters with status higher or equal than the character requesting the list.
 		//
-		if(!ChannelClient || (ChannelClient->GetHideMe() && (ChannelClient->GetAccountStatus() >= AccountStatus))) {
-			iterator.Advance();
+		if(!ChannelClient || (ChannelClient->GetHideMe() && (ChannelClient->GetAccountStatus() >= AccountStatus)))
 			continue;
-		}
 
 		if(MembersInLine > 0)
 			Message += ", ";
@@ -380,8 +329,6 @@ void ChatChannel::SendChannelMembers(Client *c) {
 
 			Message.clear();
 		}
-
-		iterator.Advance();
 	}
 
 	if(MembersInLine > 0)
@@ -393,61 +340,42 @@ void ChatChannel::SendMessageToChannel(std::string Message, Client* Sender) {
 
 	if(!Sender) return;
 
-	std::string cv_messages[EQ::versions::ClientVersionCount];
-
 	ChatMessagesSent++;
 
-	LinkedListIterator<Client*> iterator(ClientsInChannel);
-
-	iterator.Reset();
-
-	while(iterator.MoreElements()) {
-
-		Client *ChannelClient = iterator.GetData();
-
-		if(ChannelClient)
-		{
-			LogDebug("Sending message to [{}] from [{}]",
-				ChannelClient->GetName().c_str(), Sender->GetName().c_str());
-
-			if (cv_messages[static_cast<uint32>(ChannelClient->GetClientVersion())].length() == 0) {
-				switch (ChannelClient->GetClientVersion()) {
-				case EQ::versions::ClientVersion::Titanium:
-					ServerToClient45SayLink(cv_messages[static_cast<uint32>(ChannelClient->GetClientVersion())], Message);
-					break;
-				case EQ::versions::ClientVersion::SoF:
-				case EQ::versions::ClientVersion::SoD:
-				case EQ::versions::ClientVersion::UF:
-					ServerToClient50SayLink(cv_messages[static_cast<uint32>(ChannelClient->GetClientVersion())], Message);
-					break;
-				case EQ::versions::ClientVersion::RoF:
-					ServerToClient55SayLink(cv_messages[static_cast<uint32>(ChannelClient->GetClientVersion())], Message);
-					break;
-				case EQ::versions::ClientVersion::RoF2:
-				default:
-					cv_messages[static_cast<uint32>(ChannelClient->GetClientVersion())] = Message;
-					break;
-				}
-			}
-
-			ChannelClient->SendChannelMessage(Name, cv_messages[static_cast<uint32>(ChannelClient->GetClientVersion())], Sender);
+	LogDebug("Sending message to [{}] members of [{}] from [{}]",
+		ClientsInChannel.size(), Name.c_str(), Sender->GetName().c_str());
+
+	QueuePacketByClientVersion(ClientsInChannel, [&](Client *ChannelClient) {
+
+		std::string cv_message;
+
+		switch (ChannelClient->GetClientVersion()) {
+		case EQ::versions::ClientVersion::Titanium:
+			ServerToClient45SayLink(cv_message, Message);
+			break;
+		case EQ::versions::ClientVersion::SoF:
+		case EQ::versions::ClientVersion::SoD:
+		case EQ::versions::ClientVersion::UF:
+			ServerToClient50SayLink(cv_message, Message);
+			break;
+		case EQ::versions::ClientVersion::RoF:
+			ServerToClient55SayLink(cv_message, Message);
+			break;
+		case EQ::versions::ClientVersion::RoF2:
+		default:
+			cv_message = Message;
+			break;
 		}
 
-		iterator.Advance();
-	}
+		return Client::MakeChannelMessagePacket(Name, cv_message, Sender, ChannelClient->IsUnderfootOrLater());
+	});
 }
 
 void ChatChannel::SetModerated(bool inModerated) {
 
 	Moderated = inModerated;
 
-	LinkedListIterator<Client*> iterator(ClientsInChannel);
-
-	iterator.Reset();
-
-	while(iterator.MoreElements()) {
-
-		Client *ChannelClient = iterator.GetData();
+	for(auto ChannelClient : ClientsInChannel) {
 
 		if(ChannelClient) {
 
@@ -456,8 +384,6 @@ void ChatChannel::SetModerated(bool inModerated) {
 			else
 				ChannelClient->GeneralChannelMessage("Channel " + Name + " is no longer moderated.");
 		}
-
-		iterator.Advance();
 	}
 
 }
@@ -465,19 +391,7 @@ bool ChatChannel::IsClientInChannel(Client *c) {
 
 	if(!c) return false;
 
-	LinkedListIterator<Client*> iterator(ClientsInChannel);
-
-	iterator.Reset();
-
-	while(iterator.MoreElements()) {
-
-		if(iterator.GetData() == c)
-			return true;
-
-		iterator.Advance();
-	}
-
-	return false;
+	return std::find(ClientsInChannel.begin(), ClientsInChannel.end(), c) != ClientsInChannel.end();
 }
 
 ChatChannel *ChatChannelList::AddClientToChannel(std::string ChannelName, Client *c) {
@@ -576,24 +490,23 @@ ChatChannel *ChatChannelList::RemoveClientFromChannel(std::string inChannelName,
 
 void ChatChannelList::Process() {
 
-	LinkedListIterator<ChatChannel*> iterator(ChatChannels);
-
-	iterator.Reset();
-
-	while(iterator.MoreElements()) {
+	for(auto it = ChatChannels.begin(); it != ChatChannels.end();) {
 
-		ChatChannel *CurrentChannel = iterator.GetData();
+		ChatChannel *CurrentChannel = it->second;
 
 		if(CurrentChannel && CurrentChannel->ReadyToDelete()) {
 
 			LogDebug("Empty temporary password protected channel [{}] being destroyed",
 				CurrentChannel->GetName().c_str());
 
-			RemoveChannel(CurrentChannel);
-		}
+			it = ChatChannels.erase(it);
+
+			safe_delete(CurrentChannel);
 
-		iterator.Advance();
+			continue;
+		}
 
+		++it;
 	}
 }
 
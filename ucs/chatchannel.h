@@ -2,13 +2,55 @@
 #define CHATCHANNEL_H
 
 //#include "clientlist.h"
+#include "../common/emu_versions.h"
+#include "../common/eq_packet.h"
 #include "../common/linked_list.h"
 #include "../common/timer.h"
+#include "../common/types.h"
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 class Client;
 
+/**
+ * Queues a message to every member, the packet only differs by client version so it is built once per version
+ *
+ * @param Members
+ * @param MakePacket called with the first member of each client version, returns the packet all members of that version get
+ * @return number of packets built
+ */
+template<typename Member, typename PacketBuilder>
+int QueuePacketByClientVersion(const std::vector<Member*> &Members, PacketBuilder MakePacket) {
+
+	EQApplicationPacket *cv_packets[EQ::versions::ClientVersionCount] = { nullptr };
+
+	int PacketsBuilt = 0;
+
+	for(auto ChannelClient : Members) {
+
+		if(!ChannelClient)
+			continue;
+
+		uint32 Version = static_cast<uint32>(ChannelClient->GetClientVersion());
+
+		if(Version >= EQ::versions::ClientVersionCount)
+			Version = static_cast<uint32>(EQ::versions::ClientVersion::Unknown);
+
+		if(!cv_packets[Version]) {
+			cv_packets[Version] = MakePacket(ChannelClient);
+			PacketsBuilt++;
+		}
+
+		ChannelClient->QueuePacket(cv_packets[Version]);
+	}
+
+	for(auto &Packet : cv_packets)
+		safe_delete(Packet);
+
+	return PacketsBuilt;
+}
+
 class ChatChannel {
 
 public:
@@ -58,7 +100,7 @@ private:
 
 	Timer DeleteTimer;
 
-	LinkedList<Client*> ClientsInChannel;
+	std::vector<Client*> ClientsInChannel;
 
 	std::vector<std::string> Moderators;
 	std::vector<std::string> Invitees;
@@ -81,7 +123,8 @@ public:
 
 private:
 
-	LinkedList<ChatChannel*> ChatChannels;
+	// keyed by the capitalised channel name
+	std::unordered_map<std::string, ChatChannel*> ChatChannels;
 
 };
 
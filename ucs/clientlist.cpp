@@ -26,6 +26,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include "clientlist.h"
 #include "database.h"
 #include "chatchannel.h"
+#include "mailbox_cache.h"
 
 #include <list>
 #include <vector>
@@ -382,14 +383,14 @@ static void ProcessSetMessageStatus(std::string SetMessageCommand) {
 
 			MessageNumber = atoi(SetMessageCommand.substr(NumStart).c_str());
 
-			database.SetMessageStatus(MessageNumber, Status);
+			mailbox_cache.SetMessageStatus(MessageNumber, Status);
 
 			break;
 		}
 
 		MessageNumber = atoi(SetMessageCommand.substr(NumStart, NumEnd - NumStart).c_str());
 
-		database.SetMessageStatus(MessageNumber, Status);
+		mailbox_cache.SetMessageStatus(MessageNumber, Status);
 
 		NumStart = SetMessageCommand.find_first_of("123456789", NumEnd);
 	}
@@ -534,6 +535,8 @@ Client::~Client() {
 
 	LeaveAllChannels(false);
 
+	mailbox_cache.Release(this);
+
 	if (AccountGrabUpdateTimer)
 	{
 		delete AccountGrabUpdateTimer;
@@ -663,6 +666,8 @@ void Clientlist::Process()
 
 				(*it)->SetAccountID(database.FindAccount(CharacterName.c_str(), (*it)));
 
+				mailbox_cache.Load((*it));
+
 				database.GetAccountStatus((*it));
 
 				if ((*it)->GetConnectionType() == ConnectionTypeCombined) {
@@ -1472,6 +1477,15 @@ void Client::SendChannelMessage(std::string ChannelName, std::string Message, Cl
 
 	if (!Sender) return;
 
+	auto outapp = MakeChannelMessagePacket(ChannelName, Message, Sender, UnderfootOrLater);
+
+	QueuePacket(outapp);
+
+	safe_delete(outapp);
+}
+
+EQApplicationPacket *Client::MakeChannelMessagePacket(const std::string &ChannelName, const std::string &Message, Client *Sender, bool UnderfootOrLater) {
+
 	std::string FQSenderName = WorldShortName + "." + Sender->GetName();
 
 	int PacketLength = ChannelName.length() + Message.length() + FQSenderName.length() + 3;
@@ -1490,9 +1504,7 @@ void Client::SendChannelMessage(std::string ChannelName, std::string Message, Cl
 	if (UnderfootOrLater)
 		VARSTRUCT_ENCODE_STRING(PacketBuffer, "SPAM:0:");
 
-	QueuePacket(outapp);
-
-	safe_delete(outapp);
+	return outapp;
 }
 
 void Client::ToggleAnnounce(std::string State)
@@ -2382,6 +2394,16 @@ std::string Client::MailBoxName()
 
 }
 
+std::vector<int> Client::GetCharIDs()
+{
+	std::vector<int> char_ids;
+	for (auto &character : Characters) {
+		char_ids.push_back(character.CharID);
+	}
+
+	return char_ids;
+}
+
 int Client::GetCharID() {
 
 	if (Characters.empty())
@@ -99,6 +99,7 @@ public:
 	void RemoveFromChannelList(ChatChannel *JoinedChannel);
 	void SendChannelMessage(std::string Message);
 	void SendChannelMessage(std::string ChannelName, std::string Message, Client *Sender);
+	static EQApplicationPacket *MakeChannelMessagePacket(const std::string &ChannelName, const std::string &Message, Client *Sender, bool UnderfootOrLater);
 	void SendChannelMessageByNumber(std::string Message);
 	void SendChannelList();
 	void CloseConnection();
@@ -138,11 +139,17 @@ public:
 	inline bool GetForceDisconnect() { return ForceDisconnect; }
 	std::string MailBoxName();
 	int GetMailBoxNumber() { return CurrentMailBox; }
+	int GetMailBoxCharID() {
+		int mailbox = GetMailBoxNumber();
+		return (mailbox >= 0 && static_cast<size_t>(mailbox) < Characters.size()) ? Characters[mailbox].CharID : 0;
+	}
+	std::vector<int> GetCharIDs();
 	int GetMailBoxNumber(std::string CharacterName);
 
 	void SetConnectionType(char c);
 	ConnectionType GetConnectionType() { return TypeOfConnection; }
 	EQ::versions::ClientVersion GetClientVersion() { return ClientVersion_; }
+	inline bool IsUnderfootOrLater() const { return UnderfootOrLater; }
 
 	inline bool IsMailConnection() { return (TypeOfConnection == ConnectionTypeMail) || (TypeOfConnection == ConnectionTypeCombined); }
 	void SendNotification(int MailBoxNumber, std::string From, std::string Subject, int MessageID);
@@ -318,7 +318,7 @@ void Database::SendHeaders(Client *client)
 
 	int unknownField2 = 25015275;
 	int unknownField3 = 1;
-	int characterID   = FindCharacter(client->MailBoxName().c_str());
+	int characterID   = client->GetMailBoxCharID();
 
 	LogDebug("Sendheaders for [{}], CharID is [{}]", client->MailBoxName().c_str(), characterID);
 
@@ -326,12 +326,8 @@ void Database::SendHeaders(Client *client)
 		return;
 	}
 
-	std::string query   = StringFormat(
-		"SELECT `msgid`,`timestamp`, `from`, `subject`, `status` "
-		"FROM `mail` WHERE `charid`=%i", characterID
-	);
-	auto        results = QueryDatabase(query);
-	if (!results.Success()) {
+	auto headers = mailbox_cache.GetHeaders(characterID);
+	if (!headers) {
 		return;
 	}
 
@@ -348,7 +344,7 @@ void Database::SendHeaders(Client *client)
 	sprintf(buffer, "%i", unknownField3);
 	headerCountPacketLength += (strlen(buffer) + 1);
 
-	sprintf(buffer, "%i", results.RowCount());
+	sprintf(buffer, "%i", (int) headers->size());
 	headerCountPacketLength += (strlen(buffer) + 1);
 
 	auto outapp = new EQApplicationPacket(OP_MailHeaderCount, headerCountPacketLength);
@@ -358,15 +354,19 @@ void Database::SendHeaders(Client *client)
 	VARSTRUCT_ENCODE_INTSTRING(packetBuffer, client->GetMailBoxNumber());
 	VARSTRUCT_ENCODE_INTSTRING(packetBuffer, unknownField2);
 	VARSTRUCT_ENCODE_INTSTRING(packetBuffer, unknownField3);
-	VARSTRUCT_ENCODE_INTSTRING(packetBuffer, results.RowCount());
+	VARSTRUCT_ENCODE_INTSTRING(packetBuffer, (int) headers->size());
 
 
 	client->QueuePacket(outapp);
 
 	safe_delete(outapp);
 
-	int       rowIndex = 0;
-	for (auto row      = results.begin(); row != results.end(); ++row, ++rowIndex) {
+	int rowIndex = 0;
+	for (auto header = headers->begin(); header != headers->end(); ++header, ++rowIndex) {
+		std::string messageID = std::to_string(header->MessageID);
+		std::string timeStamp = std::to_string(header->TimeStamp);
+		std::string status    = std::to_string(header->Status);
+
 		int headerPacketLength = 0;
 
 		sprintf(buffer, "%i", client->GetMailBoxNumber());
@@ -376,11 +376,11 @@ void Database::SendHeaders(Client *client)
 		sprintf(buffer, "%i", rowIndex);
 		headerPacketLength += strlen(buffer) + 1;
 
-		headerPacketLength += strlen(row[0]) + 1;
-		headerPacketLength += strlen(row[1]) + 1;
-		headerPacketLength += strlen(row[4]) + 1;
-		headerPacketLength += GetMailPrefix().length() + strlen(row[2]) + 1;
-		headerPacketLength += strlen(row[3]) + 1;
+		headerPacketLength += messageID.length() + 1;
+		headerPacketLength += timeStamp.length() + 1;
+		headerPacketLength += status.length() + 1;
+		headerPacketLength += GetMailPrefix().length() + header->From.length() + 1;
+		headerPacketLength += header->Subject.length() + 1;
 
 		outapp = new EQApplicationPacket(OP_MailHeader, headerPacketLength);
 
@@ -389,13 +389,13 @@ void Database::SendHeaders(Client *client)
 		VARSTRUCT_ENCODE_INTSTRING(packetBuffer, client->GetMailBoxNumber());
 		VARSTRUCT_ENCODE_INTSTRING(packetBuffer, unknownField2);
 		VARSTRUCT_ENCODE_INTSTRING(packetBuffer, rowIndex);
-		VARSTRUCT_ENCODE_STRING(packetBuffer, row[0]);
-		VARSTRUCT_ENCODE_STRING(packetBuffer, row[1]);
-		VARSTRUCT_ENCODE_STRING(packetBuffer, row[4]);
+		VARSTRUCT_ENCODE_STRING(packetBuffer, messageID.c_str());
+		VARSTRUCT_ENCODE_STRING(packetBuffer, timeStamp.c_str());
+		VARSTRUCT_ENCODE_STRING(packetBuffer, status.c_str());
 		VARSTRUCT_ENCODE_STRING(packetBuffer, GetMailPrefix().c_str());
 		packetBuffer--;
-		VARSTRUCT_ENCODE_STRING(packetBuffer, row[2]);
-		VARSTRUCT_ENCODE_STRING(packetBuffer, row[3]);
+		VARSTRUCT_ENCODE_STRING(packetBuffer, header->From.c_str());
+		VARSTRUCT_ENCODE_STRING(packetBuffer, header->Subject.c_str());
 
 
 		client->QueuePacket(outapp);
@@ -408,11 +408,11 @@ void Database::SendHeaders(Client *client)
 void Database::SendBody(Client *client, int messageNumber)
 {
 
-	int characterID = FindCharacter(client->MailBoxName().c_str());
+	int characterID = client->GetMailBoxCharID();
 
 	LogInfo("SendBody: MsgID [{}], to [{}], CharID is [{}]", messageNumber, client->MailBoxName().c_str(), characterID);
 
-	if (characterID <= 0) {
+	if (characterID <= 0 || !mailbox_cache.HasMessage(characterID, messageNumber)) {
 		return;
 	}
 
@@ -521,6 +521,15 @@ bool Database::SendMail(
 
 	LogInfo("MessageID [{}] generated, from [{}], to [{}]", results.LastInsertedID(), from.c_str(), recipient.c_str());
 
+	MailHeader header;
+	header.MessageID = results.LastInsertedID();
+	header.TimeStamp = now;
+	header.From      = from;
+	header.Subject   = subject;
+	header.Status    = 1;
+
+	mailbox_cache.AddMessage(characterID, header);
+
 	Client *client = g_Clientlist->IsCharacterOnline(characterName);
 
 	if (client) {
@@ -533,77 +542,105 @@ bool Database::SendMail(
 	return true;
 }
 
-void Database::SetMessageStatus(int messageNumber, int status)
+bool Database::LoadMailHeaders(const std::vector<int> &charIDs, std::map<int, std::vector<MailHeader>> &mailboxes)
 {
+	if (charIDs.empty()) {
+		return true;
+	}
 
-	LogInfo("SetMessageStatus [{}] [{}]", messageNumber, status);
+	std::string query = fmt::format(
+		"SELECT `charid`, `msgid`, `timestamp`, `from`, `subject`, `status` FROM `mail` "
+		"WHERE `charid` IN ({}) ORDER BY `msgid`",
+		fmt::join(charIDs, ",")
+	);
 
-	if (status == 0) {
-		std::string query   = StringFormat("DELETE FROM `mail` WHERE `msgid` = %i", messageNumber);
-		auto        results = QueryDatabase(query);
-		return;
+	auto results = QueryDatabase(query);
+	if (!results.Success()) {
+		return false;
 	}
 
-	std::string query = StringFormat("UPDATE `mail` SET `status` = %i WHERE `msgid`=%i", status, messageNumber);
-	QueryDatabase(query);
+	for (auto charID : charIDs) {
+		mailboxes[charID];
+	}
+
+	for (auto row = results.begin(); row != results.end(); ++row) {
+		MailHeader header;
+		header.MessageID = atoi(row[1]);
+		header.TimeStamp = atoi(row[2]);
+		header.From      = row[3];
+		header.Subject   = row[4];
+		header.Status    = atoi(row[5]);
+
+		mailboxes[atoi(row[0])].push_back(header);
+	}
+
+	return true;
 }
 
-void Database::ExpireMail()
+bool Database::SetMessageStatus(const std::vector<int> &messageNumbers, int status)
 {
+	if (messageNumbers.empty()) {
+		return true;
+	}
 
-	LogInfo("Expiring mail");
+	LogInfo("SetMessageStatus [{}] messages to [{}]", messageNumbers.size(), status);
 
-	std::string query   = "SELECT COUNT(*) FROM `mail`";
-	auto        results = QueryDatabase(query);
-	if (!results.Success()) {
-		return;
+	std::string query;
+	if (status == 0) {
+		query = fmt::format("DELETE FROM `mail` WHERE `msgid` IN ({})", fmt::join(messageNumbers, ","));
+	}
+	else {
+		query = fmt::format(
+			"UPDATE `mail` SET `status` = {} WHERE `msgid` IN ({})",
+			status,
+			fmt::join(messageNumbers, ",")
+		);
 	}
 
-	auto row = results.begin();
+	return QueryDatabase(query).Success();
+}
 
-	LogInfo("There are [{}] messages in the database", row[0]);
+/**
+ * Deletes at most limit messages of one status older than expireSeconds
+ *
+ * @param status
+ * @param expireSeconds
+ * @param limit
+ * @param expired filled with the msgid and charid of each deleted message
+ * @return
+ */
+bool Database::ExpireMail(int status, int expireSeconds, int limit, std::vector<std::pair<int, int>> &expired)
+{
+	std::string query = StringFormat(
+		"SELECT `msgid`, `charid` FROM `mail` WHERE `status` = %i AND `timestamp` < %i LIMIT %i",
+		status,
+		(int) (time(nullptr) - expireSeconds),
+		limit
+	);
 
-	/**
-	 * Expire trash
-	 */
-	if (RuleI(Mail, ExpireTrash) >= 0) {
-		query   = StringFormat(
-			"DELETE FROM `mail` WHERE `status`=4 AND `timestamp` < %i",
-			time(nullptr) - RuleI(Mail, ExpireTrash));
-		results = QueryDatabase(query);
-		if (results.Success()) {
-			LogInfo("Expired [{}] trash messages", results.RowsAffected());
-		}
+	auto results = QueryDatabase(query);
+	if (!results.Success()) {
+		return false;
 	}
 
-	/**
-	 * Expire read
-	 */
-	if (RuleI(Mail, ExpireRead) >= 0) {
-		query = StringFormat(
-			"DELETE FROM `mail` WHERE `status` = 3 AND `timestamp` < %i",
-			time(nullptr) - RuleI(Mail, ExpireRead)
-		);
+	std::vector<int> messageNumbers;
+	for (auto row = results.begin(); row != results.end(); ++row) {
+		messageNumbers.push_back(atoi(row[0]));
+		expired.push_back(std::make_pair(atoi(row[0]), atoi(row[1])));
+	}
 
-		results = QueryDatabase(query);
-		if (results.Success())
-			LogInfo("Expired [{}] read messages", results.RowsAffected());
+	if (messageNumbers.empty()) {
+		return true;
 	}
 
-	/**
-	 * Expire unread
-	 */
-	if (RuleI(Mail, ExpireUnread) >= 0) {
-		query = StringFormat(
-			"DELETE FROM `mail` WHERE `status`=1 AND `timestamp` < %i",
-			time(nullptr) - RuleI(Mail, ExpireUnread)
-		);
+	query = fmt::format("DELETE FROM `mail` WHERE `msgid` IN ({})", fmt::join(messageNumbers, ","));
 
-		results = QueryDatabase(query);
-		if (results.Success()) {
-			LogInfo("Expired [{}] unread messages", results.RowsAffected());
-		}
+	if (!QueryDatabase(query).Success()) {
+		expired.clear();
+		return false;
 	}
+
+	return true;
 }
 
 void Database::AddFriendOrIgnore(int charID, int type, std::string name)
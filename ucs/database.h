@@ -28,6 +28,7 @@
 #include "../common/dbcore.h"
 #include "../common/linked_list.h"
 #include "clientlist.h"
+#include "mailbox_cache.h"
 #include <string>
 #include <vector>
 #include <map>
@@ -53,8 +54,9 @@ public:
 	void SendHeaders(Client *c);
 	void SendBody(Client *c, int MessageNumber);
 	bool SendMail(std::string Recipient, std::string From, std::string Subject, std::string Body, std::string RecipientsString);
-	void SetMessageStatus(int MessageNumber, int Status);
-	void ExpireMail();
+	bool LoadMailHeaders(const std::vector<int> &CharIDs, std::map<int, std::vector<MailHeader>> &Mailboxes);
+	bool SetMessageStatus(const std::vector<int> &MessageNumbers, int Status);
+	bool ExpireMail(int Status, int ExpireSeconds, int Limit, std::vector<std::pair<int, int>> &Expired);
 	void AddFriendOrIgnore(int CharID, int Type, std::string Name);
 	void RemoveFriendOrIgnore(int CharID, int Type, std::string Name);
 	void GetFriendsAndIgnore(int CharID, std::vector<std::string> &Friends, std::vector<std::string> &Ignorees); 
@@ -0,0 +1,379 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2020 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+
+*/
+
+#include "../common/eqemu_logsys.h"
+#include "../common/rulesys.h"
+#include "mailbox_cache.h"
+#include "clientlist.h"
+#include "database.h"
+
+#include <algorithm>
+
+extern Database database;
+
+MailboxCache mailbox_cache;
+
+MailboxCache::MailboxCache()
+	: FlushTimer(0), ExpireTimer(ExpireStepMS), ExpireCheckTimer(0), PurgeTimer(PurgeIntervalMS)
+{
+	FlushTimer.Disable();
+	ExpireTimer.Disable();
+	ExpireCheckTimer.Disable();
+
+	Stage = ExpireDone;
+}
+
+/**
+ * @param c
+ */
+void MailboxCache::Load(Client *c)
+{
+	Release(c);
+
+	std::vector<int> char_ids = c->GetCharIDs();
+	std::vector<int> missing;
+
+	for (auto char_id : char_ids) {
+		auto mailbox = Mailboxes.find(char_id);
+		if (mailbox == Mailboxes.end()) {
+			missing.push_back(char_id);
+		}
+	}
+
+	if (!LoadMailboxes(missing)) {
+		return;
+	}
+
+	for (auto char_id : char_ids) {
+		Mailboxes[char_id].References++;
+	}
+
+	ClientMailboxes[c] = char_ids;
+
+	LogDebug("Cached mailboxes for [{}] characters of [{}]", char_ids.size(), c->GetName());
+}
+
+/**
+ * @param c
+ */
+void MailboxCache::Release(Client *c)
+{
+	auto client_mailboxes = ClientMailboxes.find(c);
+	if (client_mailboxes == ClientMailboxes.end()) {
+		return;
+	}
+
+	for (auto char_id : client_mailboxes->second) {
+		auto mailbox = Mailboxes.find(char_id);
+		if (mailbox != Mailboxes.end() && --mailbox->second.References <= 0) {
+			DropMailbox(char_id);
+		}
+	}
+
+	ClientMailboxes.erase(client_mailboxes);
+}
+
+/**
+ * @param CharID
+ * @return
+ */
+const std::vector<MailHeader> *MailboxCache::GetHeaders(int CharID)
+{
+	auto mailbox = Mailboxes.find(CharID);
+	if (mailbox == Mailboxes.end()) {
+		if (!LoadMailboxes(std::vector<int>{CharID})) {
+			return nullptr;
+		}
+
+		mailbox = Mailboxes.find(CharID);
+	}
+
+	return &mailbox->second.Headers;
+}
+
+/**
+ * @param CharID
+ * @param MessageID
+ * @return
+ */
+bool MailboxCache::HasMessage(int CharID, int MessageID)
+{
+	if (Mailboxes.find(CharID) == Mailboxes.end()) {
+		GetHeaders(CharID);
+	}
+
+	auto owner = MessageOwners.find(MessageID);
+
+	return owner != MessageOwners.end() && owner->second == CharID;
+}
+
+/**
+ * @param CharID
+ * @param Header
+ */
+void MailboxCache::AddMessage(int CharID, const MailHeader &Header)
+{
+	auto mailbox = Mailboxes.find(CharID);
+	if (mailbox == Mailboxes.end()) {
+		return;
+	}
+
+	// new mail has the highest msgid, so appending keeps the headers in order
+	mailbox->second.Headers.push_back(Header);
+	MessageOwners[Header.MessageID] = CharID;
+}
+
+/**
+ * @param MessageID
+ * @param Status
+ */
+void MailboxCache::SetMessageStatus(int MessageID, int Status)
+{
+	LogInfo("SetMessageStatus [{}] [{}]", MessageID, Status);
+
+	if (Status == 0) {
+		RemoveMessage(MessageID);
+	}
+	else {
+		auto owner = MessageOwners.find(MessageID);
+		if (owner != MessageOwners.end()) {
+			auto &headers = Mailboxes[owner->second].Headers;
+			auto header   = std::lower_bound(
+				headers.begin(), headers.end(), MessageID,
+				[](const MailHeader &h, int id) { return h.MessageID < id; }
+			);
+
+			if (header != headers.end() && header->MessageID == MessageID) {
+				header->Status = Status;
+			}
+		}
+	}
+
+	PendingStatus[MessageID] = Status;
+
+	if (RuleI(Mail, WriteBehindMS) <= 0) {
+		Flush();
+	}
+	else if (!FlushTimer.Enabled()) {
+		FlushTimer.Start(RuleI(Mail, WriteBehindMS));
+	}
+}
+
+void MailboxCache::Flush()
+{
+	FlushTimer.Disable();
+
+	if (PendingStatus.empty()) {
+		return;
+	}
+
+	std::map<int, std::vector<int>> by_status;
+	for (auto &pending : PendingStatus) {
+		by_status[pending.second].push_back(pending.first);
+	}
+
+	PendingStatus.clear();
+
+	for (auto &status : by_status) {
+		if (!database.SetMessageStatus(status.second, status.first)) {
+			LogError("Failed to write status [{}] for [{}] messages", status.first, status.second.size());
+		}
+	}
+}
+
+void MailboxCache::StartExpiry()
+{
+	Stage = ExpireTrash;
+	ExpireTimer.Start();
+
+	if (RuleI(Mail, ExpireCheckIntervalS) > 0) {
+		ExpireCheckTimer.Start(RuleI(Mail, ExpireCheckIntervalS) * 1000);
+	}
+}
+
+void MailboxCache::Process()
+{
+	if (FlushTimer.Enabled() && FlushTimer.Check()) {
+		Flush();
+	}
+
+	if (ExpireCheckTimer.Enabled() && ExpireCheckTimer.Check() && Stage == ExpireDone) {
+		StartExpiry();
+	}
+
+	if (ExpireTimer.Enabled() && ExpireTimer.Check() && !ExpireStep()) {
+		ExpireTimer.Disable();
+	}
+
+	// mailboxes loaded on demand rather than at login belong to no client
+	if (PurgeTimer.Check()) {
+		for (auto mailbox = Mailboxes.begin(); mailbox != Mailboxes.end();) {
+			if (mailbox->second.References > 0) {
+				++mailbox;
+				continue;
+			}
+
+			for (auto &header : mailbox->second.Headers) {
+				MessageOwners.erase(header.MessageID);
+			}
+
+			mailbox = Mailboxes.erase(mailbox);
+		}
+	}
+}
+
+/**
+ * @param CharIDs
+ * @return
+ */
+bool MailboxCache::LoadMailboxes(const std::vector<int> &CharIDs)
+{
+	if (CharIDs.empty()) {
+		return true;
+	}
+
+	std::map<int, std::vector<MailHeader>> loaded;
+	if (!database.LoadMailHeaders(CharIDs, loaded)) {
+		return false;
+	}
+
+	for (auto &headers : loaded) {
+		// a status write still waiting to be flushed is newer than what was just read
+		auto &mailbox = Mailboxes[headers.first];
+		for (auto &header : headers.second) {
+			auto pending = PendingStatus.find(header.MessageID);
+			if (pending != PendingStatus.end()) {
+				if (pending->second == 0) {
+					continue;
+				}
+
+				header.Status = pending->second;
+			}
+
+			mailbox.Headers.push_back(header);
+			MessageOwners[header.MessageID] = headers.first;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * @param CharID
+ */
+void MailboxCache::DropMailbox(int CharID)
+{
+	auto mailbox = Mailboxes.find(CharID);
+	if (mailbox == Mailboxes.end()) {
+		return;
+	}
+
+	for (auto &header : mailbox->second.Headers) {
+		MessageOwners.erase(header.MessageID);
+	}
+
+	Mailboxes.erase(mailbox);
+}
+
+/**
+ * @param MessageID
+ */
+void MailboxCache::RemoveMessage(int MessageID)
+{
+	auto owner = MessageOwners.find(MessageID);
+	if (owner == MessageOwners.end()) {
+		return;
+	}
+
+	auto &headers = Mailboxes[owner->second].Headers;
+	auto header   = std::lower_bound(
+		headers.begin(), headers.end(), MessageID,
+		[](const MailHeader &h, int id) { return h.MessageID < id; }
+	);
+
+	if (header != headers.end() && header->MessageID == MessageID) {
+		headers.erase(header);
+	}
+
+	MessageOwners.erase(owner);
+}
+
+/**
+ * Deletes one batch of expired mail
+ *
+ * @return false once every stage has run dry
+ */
+bool MailboxCache::ExpireStep()
+{
+	// expiry works from the table, so it must see the statuses players have already set
+	Flush();
+
+	while (Stage != ExpireDone) {
+		int        status         = 0;
+		int        expire_seconds = 0;
+		const char *label         = "";
+
+		switch (Stage) {
+			case ExpireTrash:
+				status         = 4;
+				expire_seconds = RuleI(Mail, ExpireTrash);
+				label          = "trash";
+				break;
+			case ExpireRead:
+				status         = 3;
+				expire_seconds = RuleI(Mail, ExpireRead);
+				label          = "read";
+				break;
+			default:
+				status         = 1;
+				expire_seconds = RuleI(Mail, ExpireUnread);
+				label          = "unread";
+				break;
+		}
+
+		if (expire_seconds < 0) {
+			Stage++;
+			continue;
+		}
+
+		int batch_size = std::max(1, RuleI(Mail, ExpireBatchSize));
+
+		std::vector<std::pair<int, int>> expired;
+		if (!database.ExpireMail(status, expire_seconds, batch_size, expired)) {
+			Stage = ExpireDone;
+			return false;
+		}
+
+		for (auto &message : expired) {
+			RemoveMessage(message.first);
+		}
+
+		if (!expired.empty()) {
+			LogInfo("Expired [{}] {} messages", expired.size(), label);
+		}
+
+		if (static_cast<int>(expired.size()) < batch_size) {
+			Stage++;
+		}
+
+		return true;
+	}
+
+	return false;
+}
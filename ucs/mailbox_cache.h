@@ -0,0 +1,106 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2020 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+
+*/
+
+#ifndef UCS_MAILBOX_CACHE_H
+#define UCS_MAILBOX_CACHE_H
+
+#include "../common/timer.h"
+#include "../common/types.h"
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class Client;
+
+struct MailHeader {
+	int         MessageID;
+	int         TimeStamp;
+	std::string From;
+	std::string Subject;
+	int         Status;
+};
+
+/**
+ * Mail headers of every character on a logged in account, loaded with one query at login and kept in msgid order.
+ * Header listings are served from here, status changes and deletes update it straight away and reach the database
+ * in batches, and expired mail is removed a few hundred rows at a time from the main loop
+ */
+class MailboxCache {
+public:
+	MailboxCache();
+
+	void Load(Client *c);
+	void Release(Client *c);
+
+	/**
+	 * @param CharID
+	 * @return headers of the mailbox, loaded from the database if no client holds it, nullptr on a database error
+	 */
+	const std::vector<MailHeader> *GetHeaders(int CharID);
+	bool HasMessage(int CharID, int MessageID);
+	void AddMessage(int CharID, const MailHeader &Header);
+
+	/**
+	 * @param MessageID
+	 * @param Status 0 deletes the message
+	 */
+	void SetMessageStatus(int MessageID, int Status);
+
+	void StartExpiry();
+	void Process();
+	void Flush();
+
+private:
+	enum ExpireStage {
+		ExpireTrash = 0,
+		ExpireRead,
+		ExpireUnread,
+		ExpireDone
+	};
+
+	struct Mailbox {
+		std::vector<MailHeader> Headers;
+		int                     References = 0;
+	};
+
+	static const uint32 ExpireStepMS    = 250;
+	static const uint32 PurgeIntervalMS = 60000;
+
+	bool LoadMailboxes(const std::vector<int> &CharIDs);
+	void DropMailbox(int CharID);
+	void RemoveMessage(int MessageID);
+	bool ExpireStep();
+
+	std::unordered_map<int, Mailbox>                  Mailboxes;
+	std::unordered_map<int, int>                      MessageOwners;
+	std::unordered_map<Client *, std::vector<int>>    ClientMailboxes;
+	std::map<int, int>                                PendingStatus;
+
+	Timer FlushTimer;
+	Timer ExpireTimer;
+	Timer ExpireCheckTimer;
+	Timer PurgeTimer;
+	int   Stage;
+};
+
+extern MailboxCache mailbox_cache;
+
+#endif
@@ -30,6 +30,7 @@
 #include "ucsconfig.h"
 #include "chatchannel.h"
 #include "worldserver.h"
+#include "mailbox_cache.h"
 #include <list>
 #include <signal.h>
 
@@ -120,7 +121,7 @@ int main() {
 	EQ::InitializeDynamicLookups();
 	LogInfo("Initialized dynamic dictionary entries");
 
-	database.ExpireMail();
+	mailbox_cache.StartExpiry();
 
 	if(Config->ChatPort != Config->MailPort)
 	{
@@ -151,6 +152,8 @@ int main() {
 
 		g_Clientlist->Process();
 
+		mailbox_cache.Process();
+
 		if (ChannelListProcessTimer.Check()) {
 			ChannelList->Process();
 		}
@@ -170,6 +173,8 @@ int main() {
 
 	g_Clientlist->CloseAllConnections();
 
+	mailbox_cache.Flush();
+
 	LogSys.CloseFileLogs();
 
 }
@@ -47,6 +47,7 @@
 #include "wguild_mgr.h"
 #include "sof_char_create_data.h"
 #include "world_store.h"
+#include "group_raid_state.h"
 
 #include <iostream>
 #include <iomanip>
@@ -821,15 +822,15 @@ bool Client::HandleEnterWorldPacket(const EQApplicationPacket *app) {
 	}
 
 	if(!is_player_zoning) {
-		database.SetGroupID(char_name, 0, charid);
+		group_raid_state.RemoveGroupMember(char_name, charid, false);
 		database.SetLoginFlags(charid, false, false, 1);
 	}
 	else{
-		uint32 groupid = database.GetGroupID(char_name);
+		uint32 groupid = group_raid_state.GetGroupID(char_name);
 		if(groupid > 0){
 			char* leader = 0;
 			char leaderbuf[64] = {0};
-			if((leader = database.GetGroupLeaderForLogin(char_name, leaderbuf)) && strlen(leader)>1){
+			if((leader = database.GetGroupLeadershipInfo(groupid, leaderbuf)) && strlen(leader)>1 && strcmp(leader, "UNKNOWN") != 0){
 				auto outapp3 = new EQApplicationPacket(OP_GroupUpdate, sizeof(GroupJoin_Struct));
 				GroupJoin_Struct* gj=(GroupJoin_Struct*)outapp3->pBuffer;
 				gj->action=8;
@@ -242,6 +242,45 @@ void ClientListEntry::Update(ZoneServer *iZS, ServerClientList_Struct *scl, CLE_
 	SetOnline(iOnline);
 }
 
+void ClientListEntry::Update(ServerClientListDelta_Struct *delta)
+{
+	if (delta->changed & ClientListDeltaLevel) {
+		plevel = delta->level;
+	}
+	if (delta->changed & ClientListDeltaRace) {
+		prace = delta->race;
+	}
+	if (delta->changed & ClientListDeltaClass) {
+		pclass_ = delta->class_;
+	}
+	if (delta->changed & ClientListDeltaAnon) {
+		panon = delta->anon;
+	}
+	if (delta->changed & ClientListDeltaTellsOff) {
+		ptellsoff = delta->tellsoff;
+	}
+	if (delta->changed & ClientListDeltaGuild) {
+		pguild_id = delta->guild_id;
+	}
+	if (delta->changed & ClientListDeltaGM) {
+		gm = delta->gm;
+	}
+	if (delta->changed & ClientListDeltaAdmin) {
+		padmin = delta->Admin;
+	}
+	if (delta->changed & ClientListDeltaLFG) {
+		pLFG = delta->LFG;
+
+		// Fields from the LFG Window
+		if ((delta->LFGFromLevel != 0) && (delta->LFGToLevel != 0)) {
+			pLFGFromLevel   = delta->LFGFromLevel;
+			pLFGToLevel     = delta->LFGToLevel;
+			pLFGMatchFilter = delta->LFGMatchFilter;
+			memcpy(pLFGComments, delta->LFGComments, sizeof(pLFGComments));
+		}
+	}
+}
+
 void ClientListEntry::LeavingZone(ZoneServer *iZS, CLE_Status iOnline)
 {
 	if (iZS != 0 && iZS != pzoneserver) {
@@ -29,6 +29,7 @@ static const char * CLEStatusString[] = {
 
 class ZoneServer;
 struct ServerClientList_Struct;
+struct ServerClientListDelta_Struct;
 
 class ClientListEntry {
 public:
@@ -65,6 +66,7 @@ public:
 	~ClientListEntry();
 	bool	CheckStale();
 	void	Update(ZoneServer* zoneserver, ServerClientList_Struct* scl, CLE_Status iOnline = CLE_Status::InZone);
+	void	Update(ServerClientListDelta_Struct* delta);
 	void	LSUpdate(ZoneServer* zoneserver);
 	void	LSZoneChange(ZoneToZone_Struct* ztz);
 	bool	CheckAuth(uint32 loginserver_account_id, const char* key_password);
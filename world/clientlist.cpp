@@ -35,6 +35,7 @@
 #include "wguild_mgr.h"
 #include "world_store.h"
 #include <set>
+#include <algorithm>
 
 extern WebInterfaceList web_interface;
 
@@ -46,6 +47,9 @@ ClientList::ClientList()
 {
 	NextCLEID = 1;
 
+	m_who_index_dirty = true;
+	m_who_index_time  = 0;
+
 	m_tick.reset(new EQ::Timer(5000, true, std::bind(&ClientList::OnTick, this, std::placeholders::_1)));
 }
 
@@ -319,6 +323,7 @@ void ClientList::CLEAdd(uint32 iLSID, const char *iLoginServerName, const char*
 	auto tmp = new ClientListEntry(GetNextCLEID(), iLSID, iLoginServerName, iLoginName, iLoginKey, iWorldAdmin, ip, local);
 
 	clientlist.Append(tmp);
+	m_who_index_dirty = true;
 }
 
 void ClientList::CLCheckStale() {
@@ -346,8 +351,22 @@ void ClientList::ClientUpdate(ZoneServer* zoneserver, ServerClientList_Struct* s
 			}
 			else if (scl->remove == 1)
 				cle->LeavingZone(zoneserver, CLE_Status::Zoning);
-			else
+			else {
+				uint32 zone     = cle->zone();
+				uint32 guild_id = cle->GuildID();
+				uint8  class_   = cle->class_();
+				uint8  level    = cle->level();
+				bool   lfg      = cle->LFG();
+
 				cle->Update(zoneserver, scl);
+
+				if (
+					zone != cle->zone() || guild_id != cle->GuildID() || class_ != cle->class_() ||
+					level / WhoLevelBucketSize != cle->level() / WhoLevelBucketSize || lfg != cle->LFG()
+					) {
+					m_who_index_dirty = true;
+				}
+			}
 			return;
 		}
 		iterator.Advance();
@@ -359,6 +378,7 @@ void ClientList::ClientUpdate(ZoneServer* zoneserver, ServerClientList_Struct* s
 	else
 		cle = new ClientListEntry(GetNextCLEID(), zoneserver, scl, CLE_Status::InZone);
 	clientlist.Insert(cle);
+	m_who_index_dirty = true;
 	zoneserver->ChangeWID(scl->charid, cle->GetID());
 }
 
@@ -376,6 +396,59 @@ void ClientList::CLEKeepAlive(uint32 numupdates, uint32* wid) {
 	}
 }
 
+void ClientList::CLEKeepAlive(ZoneServer* zoneserver) {
+	LinkedListIterator<ClientListEntry*> iterator(clientlist);
+
+	iterator.Reset();
+	while(iterator.MoreElements()) {
+		if (iterator.GetData()->Server() == zoneserver)
+			iterator.GetData()->KeepAlive();
+		iterator.Advance();
+	}
+}
+
+uint32 ClientList::CountZoneServerCLEs(ZoneServer* zoneserver) {
+	LinkedListIterator<ClientListEntry*> iterator(clientlist);
+	uint32 count = 0;
+
+	iterator.Reset();
+	while(iterator.MoreElements()) {
+		if (iterator.GetData()->Server() == zoneserver)
+			count++;
+		iterator.Advance();
+	}
+
+	return count;
+}
+
+/**
+ * @param zoneserver
+ * @param delta
+ * @return false when the client is not one world has in this zone and the zone needs to resync
+ */
+bool ClientList::ClientDelta(ZoneServer* zoneserver, ServerClientListDelta_Struct* delta) {
+	ClientListEntry* cle = GetCLE(delta->wid);
+	if (!cle || cle->Server() != zoneserver) {
+		return false;
+	}
+
+	uint32 guild_id = cle->GuildID();
+	uint8  class_   = cle->class_();
+	uint8  level    = cle->level();
+	bool   lfg      = cle->LFG();
+
+	cle->Update(delta);
+
+	if (
+		guild_id != cle->GuildID() || class_ != cle->class_() ||
+		level / WhoLevelBucketSize != cle->level() / WhoLevelBucketSize || lfg != cle->LFG()
+		) {
+		m_who_index_dirty = true;
+	}
+
+	return true;
+}
+
 ClientListEntry *ClientList::CheckAuth(uint32 iLSID, const char *iKey)
 {
 	LinkedListIterator<ClientListEntry *> iterator(clientlist);
@@ -450,8 +523,6 @@ void ClientList::SendOnlineGuildMembers(uint32 FromID, uint32 GuildID)
 
 void ClientList::SendWhoAll(uint32 fromid,const char* to, int16 admin, Who_All_Struct* whom, WorldTCPConnection* connection) {
 	try{
-	LinkedListIterator<ClientListEntry*> iterator(clientlist);
-	LinkedListIterator<ClientListEntry*> countclients(clientlist);
 	ClientListEntry* cle = 0;
 	ClientListEntry* countcle = 0;
 	//char tmpgm[25] = "";
@@ -489,6 +560,41 @@ void ClientList::SendWhoAll(uint32 fromid,const char* to, int16 admin, Who_All_S
 			whom->wrace = FROGLOK; // This is what EQEmu uses for the Froglok Race number.
 	}
 
+	// identical queries from the same status level get the same reply, only the requester id differs
+	std::string reply_key;
+	uint32      reply_ttl = static_cast<uint32>(std::max(RuleI(World, WhoCacheTTLMS), 0));
+	if (reply_ttl > 0) {
+		if (whom) {
+			reply_key = fmt::format(
+				"{}:{}:{}:{}:{}:{}:{}",
+				admin,
+				std::string(whom->whom, whomlen),
+				whom->wrace,
+				whom->wclass,
+				whom->lvllow,
+				whom->lvlhigh,
+				whom->gmlookup
+			);
+		}
+		else {
+			reply_key = fmt::format("{}", admin);
+		}
+
+		auto cached = m_who_replies.find(reply_key);
+		if (cached != m_who_replies.end() && Timer::GetCurrentTime() < cached->second.expires) {
+			auto pack = new ServerPacket(ServerOP_WhoAllReply, cached->second.data.size());
+			memcpy(pack->pBuffer, cached->second.data.data(), cached->second.data.size());
+			memcpy(pack->pBuffer, &fromid, sizeof(uint32));
+			SendPacket(to, pack);
+			safe_delete(pack);
+			return;
+		}
+	}
+
+	std::vector<ClientListEntry *> candidates;
+	std::vector<ClientListEntry *> matches;
+	GetWhoCandidates(whom, whomlen, admin, candidates);
+
 	char* output = 0;
 	uint32 outsize = 0, outlen = 0;
 	uint32 totalusers=0;
@@ -498,9 +604,8 @@ void ClientList::SendWhoAll(uint32 fromid,const char* to, int16 admin, Who_All_S
 		AppendAnyLenString(&output, &outsize, &outlen, "\r\n");
 	else
 		AppendAnyLenString(&output, &outsize, &outlen, "\n");
-	countclients.Reset();
-	while(countclients.MoreElements()){
-		countcle = countclients.GetData();
+	for (auto candidate : candidates) {
+		countcle = candidate;
 		const char* tmpZone = ZoneName(countcle->zone());
 		if (
 	(countcle->Online() >= CLE_Status::Zoning) &&
@@ -518,6 +623,7 @@ void ClientList::SendWhoAll(uint32 fromid,const char* to, int16 admin, Who_All_S
 		))
 	))
 ) {
+			matches.push_back(countcle);
 			if((countcle->Anon()>0 && admin>=countcle->Admin() && admin>0) || countcle->Anon()==0 ){
 				totalusers++;
 				if(totalusers<=20 || admin>=100)
@@ -529,7 +635,6 @@ void ClientList::SendWhoAll(uint32 fromid,const char* to, int16 admin, Who_All_S
 					totallength=totallength+strlen(countcle->name())+strlen(guild_mgr.GetGuildName(countcle->GuildID()))+5;
 			}
 		}
-		countclients.Advance();
 	}
 	uint32 plid=fromid;
 	uint32 playerineqstring=5001;
@@ -576,33 +681,14 @@ void ClientList::SendWhoAll(uint32 fromid,const char* to, int16 admin, Who_All_S
 	memcpy(bufptr,&totalusers, sizeof(uint32));
 	bufptr+=sizeof(uint32);
 
-	iterator.Reset();
 	int idx=-1;
-	while(iterator.MoreElements()) {
-		cle = iterator.GetData();
-
-		const char* tmpZone = ZoneName(cle->zone());
-		if (
-	(cle->Online() >= CLE_Status::Zoning) &&
-	(!cle->GetGM() || cle->Anon() != 1 || admin >= cle->Admin()) &&
-	(whom == 0 || (
-		((cle->Admin() >= 80 && cle->GetGM()) || whom->gmlookup == 0xFFFF) &&
-		(whom->lvllow == 0xFFFF || (cle->level() >= whom->lvllow && cle->level() <= whom->lvlhigh && (cle->Anon()==0 || admin>cle->Admin()))) &&
-		(whom->wclass == 0xFFFF || (cle->class_() == whom->wclass && (cle->Anon()==0 || admin>cle->Admin()))) &&
-		(whom->wrace == 0xFFFF || (cle->race() == whom->wrace && (cle->Anon()==0 || admin>cle->Admin()))) &&
-		(whomlen == 0 || (
-			(tmpZone != 0 && strncasecmp(tmpZone, whom->whom, whomlen) == 0) ||
-			strncasecmp(cle->name(),whom->whom, whomlen) == 0 ||
-			(strncasecmp(guild_mgr.GetGuildName(cle->GuildID()), whom->whom, whomlen) == 0) ||
-			(admin >= 100 && strncasecmp(cle->AccountName(), whom->whom, whomlen) == 0)
-		))
-	))
-) {
+	for (auto match : matches) {
+		cle = match;
+		{
 			line[0] = 0;
 			uint32 rankstring=0xFFFFFFFF;
 				if((cle->Anon()==1 && cle->GetGM() && cle->Admin()>admin) || (idx>=20 && admin<100)){ //hide gms that are anon from lesser gms and normal players, cut off at 20
 					rankstring=0;
-					iterator.Advance();
 					continue;
 				} else if (cle->GetGM()) {
 					if (cle->Admin() >=250)
@@ -717,8 +803,25 @@ void ClientList::SendWhoAll(uint32 fromid,const char* to, int16 admin, Who_All_S
 	memcpy(bufptr,&ending, sizeof(uint32));
 	bufptr+=sizeof(uint32);
 		}
-		iterator.Advance();
 	}
+
+	if (reply_ttl > 0) {
+		if (m_who_replies.size() >= 256) {
+			for (auto iter = m_who_replies.begin(); iter != m_who_replies.end();) {
+				if (Timer::GetCurrentTime() >= iter->second.expires) {
+					iter = m_who_replies.erase(iter);
+				}
+				else {
+					++iter;
+				}
+			}
+		}
+
+		auto &reply = m_who_replies[reply_key];
+		reply.expires = Timer::GetCurrentTime() + reply_ttl;
+		reply.data.assign(pack2->pBuffer, pack2->pBuffer + pack2->size);
+	}
+
 	//zoneserver_list.SendPacket(pack2); // NO NO NO WHY WOULD YOU SEND IT TO EVERY ZONE SERVER?!?
 	SendPacket(to,pack2);
 	safe_delete(pack2);
@@ -755,7 +858,7 @@ void ClientList::SendFriendsWho(ServerFriendsWho_Struct *FriendsWho, WorldTCPCon
 		strncpy(Friend_, FriendsPointer, Seperator - FriendsPointer);
 		Friend_[Seperator - FriendsPointer] = 0;
 
-		ClientListEntry* CLE = FindCharacter(Friend_);
+		ClientListEntry* CLE = FindWhoCharacter(Friend_);
 		if(CLE && CLE->name() && (CLE->Online() >= CLE_Status::Zoning) && !(CLE->GetGM() && CLE->Anon())) {
 			FriendsCLEs.push_back(CLE);
 			TotalLength += strlen(CLE->name());
@@ -877,15 +980,14 @@ void ClientList::SendLFGMatches(ServerLFGMatchesRequest_Struct *smrs) {
 
 	// Send back matches when someone searches player's Looking For A Group.
 
-	LinkedListIterator<ClientListEntry*> Iterator(clientlist);
 	ClientListEntry* CLE = 0;
 	int Matches = 0;
 
-	Iterator.Reset();
+	ValidateWhoIndex();
 
-	// We run the ClientList twice. The first time is to determine how big the outgoing packet needs to be.
-	while(Iterator.MoreElements()) {
-		CLE = Iterator.GetData();
+	// We run the LFG index twice. The first time is to determine how big the outgoing packet needs to be.
+	for (auto pos : m_who_lfg) {
+		CLE = m_who_entries[pos];
 		if(CLE->LFG()) {
 			unsigned int BitMask = 1 << CLE->class_();
 			// First we check that the player meets the level and class criteria of the person
@@ -903,7 +1005,6 @@ void ClientList::SendLFGMatches(ServerLFGMatchesRequest_Struct *smrs) {
 								(smrs->QuerierLevel <= CLE->GetLFGToLevel())))
 					Matches++;
 		}
-		Iterator.Advance();
 	}
 	auto Pack = new ServerPacket(ServerOP_LFGMatches, (sizeof(ServerLFGMatchesResponse_Struct) * Matches) + 4);
 
@@ -913,11 +1014,13 @@ void ClientList::SendLFGMatches(ServerLFGMatchesRequest_Struct *smrs) {
 
 	ServerLFGMatchesResponse_Struct* Buffer = (ServerLFGMatchesResponse_Struct*)Buf;
 
-	Iterator.Reset();
-
 	if(Matches) {
-		while(Iterator.MoreElements() && (Matches > 0)) {
-			CLE = Iterator.GetData();
+		for (auto pos : m_who_lfg) {
+			if (Matches <= 0) {
+				break;
+			}
+
+			CLE = m_who_entries[pos];
 			if(CLE->LFG()) {
 				unsigned int BitMask = 1 << CLE->class_();
 				if((CLE->level() >= smrs->FromLevel) && (CLE->level() <= smrs->ToLevel) &&
@@ -936,7 +1039,6 @@ void ClientList::SendLFGMatches(ServerLFGMatchesRequest_Struct *smrs) {
 					Buffer++;
 				}
 			}
-			Iterator.Advance();
 		}
 	}
 	SendPacket(smrs->FromName,Pack);
@@ -944,7 +1046,6 @@ void ClientList::SendLFGMatches(ServerLFGMatchesRequest_Struct *smrs) {
 }
 
 void ClientList::ConsoleSendWhoAll(const char* to, int16 admin, Who_All_Struct* whom, WorldTCPConnection* connection) {
-	LinkedListIterator<ClientListEntry*> iterator(clientlist);
 	ClientListEntry* cle = 0;
 	char tmpgm[25] = "";
 	char accinfo[150] = "";
@@ -963,9 +1064,12 @@ void ClientList::ConsoleSendWhoAll(const char* to, int16 admin, Who_All_Struct*
 		AppendAnyLenString(&output, &outsize, &outlen, "\r\n");
 	else
 		AppendAnyLenString(&output, &outsize, &outlen, "\n");
-	iterator.Reset();
-	while (iterator.MoreElements()) {
-		cle = iterator.GetData();
+
+	std::vector<ClientListEntry *> candidates;
+	GetWhoCandidates(whom, whomlen, admin, candidates);
+
+	for (auto candidate : candidates) {
+		cle = candidate;
 		const char* tmpZone = ZoneName(cle->zone());
 		if (
 			(cle->Online() >= CLE_Status::Zoning)
@@ -1039,7 +1143,6 @@ void ClientList::ConsoleSendWhoAll(const char* to, int16 admin, Who_All_Struct*
 				if (admin >= 100 && admin >= cle->Admin())
 					sprintf(line, "  %s[RolePlay %i %s] %s (%s)%s zone: %s%s%s", tmpgm, cle->level(), GetClassIDName(cle->class_(), cle->level()), cle->name(), GetRaceIDName(cle->race()), tmpguild, tmpZone, LFG, accinfo);
 				else if (cle->Admin() >= 80 && admin < 80 && cle->GetGM()) {
-					iterator.Advance();
 					continue;
 				}
 				else
@@ -1049,7 +1152,6 @@ void ClientList::ConsoleSendWhoAll(const char* to, int16 admin, Who_All_Struct*
 				if (admin >= 100 && admin >= cle->Admin())
 					sprintf(line, "  %s[ANON %i %s] %s (%s)%s zone: %s%s%s", tmpgm, cle->level(), GetClassIDName(cle->class_(), cle->level()), cle->name(), GetRaceIDName(cle->race()), tmpguild, tmpZone, LFG, accinfo);
 				else if (cle->Admin() >= 80 && cle->GetGM()) {
-					iterator.Advance();
 					continue;
 				}
 				else
@@ -1075,7 +1177,6 @@ void ClientList::ConsoleSendWhoAll(const char* to, int16 admin, Who_All_Struct*
 			if (x >= 20 && admin < 80)
 				break;
 		}
-		iterator.Advance();
 	}
 
 	if (x >= 20 && admin < 80)
@@ -1163,6 +1264,8 @@ void ClientList::ZoneBootup(ZoneServer* zs) {
 }
 
 void ClientList::RemoveCLEReferances(ClientListEntry* cle) {
+	m_who_index_dirty = true;
+
 	LinkedListIterator<Client*> iterator(list);
 
 	iterator.Reset();
@@ -1227,6 +1330,23 @@ void ClientList::SendGuildPacket(uint32 guild_id, ServerPacket* pack) {
 	}
 }
 
+/**
+ * @param guild_id
+ * @param into zone servers with at least one member of the guild in zone
+ */
+void ClientList::GetGuildZoneServers(uint32 guild_id, std::set<ZoneServer*> &into) {
+	LinkedListIterator<ClientListEntry*> iterator(clientlist);
+
+	iterator.Reset();
+	while(iterator.MoreElements()) {
+		ClientListEntry *cle = iterator.GetData();
+		if (cle->GuildID() == guild_id && cle->Server()) {
+			into.insert(cle->Server());
+		}
+		iterator.Advance();
+	}
+}
+
 void ClientList::UpdateClientGuild(uint32 char_id, uint32 guild_id) {
 	LinkedListIterator<ClientListEntry*> iterator(clientlist);
 
@@ -1235,6 +1355,7 @@ void ClientList::UpdateClientGuild(uint32 char_id, uint32 guild_id) {
 		ClientListEntry *cle = iterator.GetData();
 		if (cle->CharID() == char_id) {
 			cle->SetGuild(guild_id);
+			m_who_index_dirty = true;
 		}
 		iterator.Advance();
 	}
@@ -1521,3 +1642,164 @@ void ClientList::GetClientList(Json::Value &response)
 		Iterator.Advance();
 	}
 }
+
+void ClientList::ValidateWhoIndex()
+{
+	uint32 now = Timer::GetCurrentTime();
+	if (!m_who_index_dirty && now - m_who_index_time < static_cast<uint32>(RuleI(World, WhoIndexRefreshMS))) {
+		return;
+	}
+
+	m_who_index_dirty = false;
+	m_who_index_time  = now;
+
+	m_who_entries.clear();
+	m_who_by_name.clear();
+	m_who_by_zone.clear();
+	m_who_by_guild.clear();
+	m_who_by_class.clear();
+	m_who_lfg.clear();
+	for (auto &bucket : m_who_by_level) {
+		bucket.clear();
+	}
+
+	LinkedListIterator<ClientListEntry *> iterator(clientlist);
+
+	iterator.Reset();
+	while (iterator.MoreElements()) {
+		ClientListEntry *cle = iterator.GetData();
+		auto            pos  = static_cast<uint32>(m_who_entries.size());
+
+		m_who_entries.push_back(cle);
+
+		if (cle->name()[0] != '\0') {
+			m_who_by_name.emplace_back(str_tolower(cle->name()), pos);
+		}
+
+		m_who_by_zone[cle->zone()].push_back(pos);
+		m_who_by_guild[cle->GuildID()].push_back(pos);
+		m_who_by_class[cle->class_()].push_back(pos);
+		m_who_by_level[std::min(cle->level() / WhoLevelBucketSize, WhoLevelBuckets - 1)].push_back(pos);
+
+		if (cle->LFG()) {
+			m_who_lfg.push_back(pos);
+		}
+
+		iterator.Advance();
+	}
+
+	std::sort(m_who_by_name.begin(), m_who_by_name.end());
+}
+
+/**
+ * Picks the smallest index that every /who match has to be in and returns its entries in clientlist order
+ *
+ * @param whom
+ * @param whomlen
+ * @param admin
+ * @param into
+ */
+void ClientList::GetWhoCandidates(Who_All_Struct *whom, int whomlen, int16 admin, std::vector<ClientListEntry *> &into)
+{
+	ValidateWhoIndex();
+
+	into.clear();
+
+	const std::vector<uint32> *best = nullptr;
+	std::vector<uint32>       level_matches;
+	std::vector<uint32>       string_matches;
+	static const std::vector<uint32> none;
+
+	if (whom) {
+		if (whom->wclass != 0xFFFF) {
+			auto iter = m_who_by_class.find(whom->wclass);
+			best = iter != m_who_by_class.end() ? &iter->second : &none;
+		}
+
+		if (whom->lvllow != 0xFFFF) {
+			if (whom->lvllow <= whom->lvlhigh) {
+				uint32 low  = std::min(whom->lvllow / WhoLevelBucketSize, static_cast<uint32>(WhoLevelBuckets - 1));
+				uint32 high = std::min(whom->lvlhigh / WhoLevelBucketSize, static_cast<uint32>(WhoLevelBuckets - 1));
+				for (uint32 i = low; i <= high; ++i) {
+					level_matches.insert(level_matches.end(), m_who_by_level[i].begin(), m_who_by_level[i].end());
+				}
+			}
+
+			if (!best || level_matches.size() < best->size()) {
+				std::sort(level_matches.begin(), level_matches.end());
+				best = &level_matches;
+			}
+		}
+
+		// the string also matches account names for admins, which are not indexed
+		if (whomlen > 0 && admin < 100) {
+			std::string prefix = str_tolower(std::string(whom->whom, whomlen));
+
+			auto name = std::lower_bound(
+				m_who_by_name.begin(),
+				m_who_by_name.end(),
+				std::make_pair(prefix, static_cast<uint32>(0))
+			);
+			for (; name != m_who_by_name.end() && name->first.compare(0, prefix.size(), prefix) == 0; ++name) {
+				string_matches.push_back(name->second);
+			}
+
+			for (auto &zone : m_who_by_zone) {
+				const char *zone_name = ZoneName(zone.first);
+				if (zone_name && strncasecmp(zone_name, whom->whom, whomlen) == 0) {
+					string_matches.insert(string_matches.end(), zone.second.begin(), zone.second.end());
+				}
+			}
+
+			for (auto &guild : m_who_by_guild) {
+				if (strncasecmp(guild_mgr.GetGuildName(guild.first), whom->whom, whomlen) == 0) {
+					string_matches.insert(string_matches.end(), guild.second.begin(), guild.second.end());
+				}
+			}
+
+			if (!best || string_matches.size() < best->size()) {
+				std::sort(string_matches.begin(), string_matches.end());
+				string_matches.erase(std::unique(string_matches.begin(), string_matches.end()), string_matches.end());
+				best = &string_matches;
+			}
+		}
+	}
+
+	if (!best) {
+		into = m_who_entries;
+		return;
+	}
+
+	into.reserve(best->size());
+	for (auto pos : *best) {
+		into.push_back(m_who_entries[pos]);
+	}
+}
+
+/**
+ * @param name
+ * @return entry whose character name matches case insensitively, first in clientlist order
+ */
+ClientListEntry *ClientList::FindWhoCharacter(const char *name)
+{
+	ValidateWhoIndex();
+
+	std::string key  = str_tolower(name);
+	auto        iter = std::lower_bound(
+		m_who_by_name.begin(),
+		m_who_by_name.end(),
+		std::make_pair(key, static_cast<uint32>(0))
+	);
+
+	if (iter == m_who_by_name.end() || iter->first != key) {
+		return nullptr;
+	}
+
+	// the snapshot may predate a SetChar on this entry
+	ClientListEntry *cle = m_who_entries[iter->second];
+	if (strcasecmp(cle->name(), name) != 0) {
+		return nullptr;
+	}
+
+	return cle;
+}
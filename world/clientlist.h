@@ -11,6 +11,9 @@
 #include "../common/net/console_server_connection.h"
 #include <vector>
 #include <string>
+#include <unordered_map>
+#include <set>
+#include <utility>
 
 class Client;
 class ZoneServer;
@@ -48,6 +51,7 @@ public:
 
 	bool	SendPacket(const char* to, ServerPacket* pack);
 	void	SendGuildPacket(uint32 guild_id, ServerPacket* pack);
+	void	GetGuildZoneServers(uint32 guild_id, std::set<ZoneServer*> &into);
 
 	void	ClientUpdate(ZoneServer* zoneserver, ServerClientList_Struct* scl);
 	void	CLERemoveZSRef(ZoneServer* iZS);
@@ -62,6 +66,9 @@ public:
 	void	DisconnectByIP(uint32 iIP);
 	void	CLCheckStale();
 	void	CLEKeepAlive(uint32 numupdates, uint32* wid);
+	void	CLEKeepAlive(ZoneServer* zoneserver);
+	uint32	CountZoneServerCLEs(ZoneServer* zoneserver);
+	bool	ClientDelta(ZoneServer* zoneserver, ServerClientListDelta_Struct* delta);
 	void	CLEAdd(uint32 iLSID, const char* iLoginServerName, const char* iLoginName, const char* iLoginKey, int16 iWorldAdmin = 0, uint32 ip = 0, uint8 local=0);
 	void	UpdateClientGuild(uint32 char_id, uint32 guild_id);
 	void	RemoveCLEByLSID(uint32 iLSID);
@@ -76,6 +83,34 @@ private:
 	void OnTick(EQ::Timer *t);
 	inline uint32 GetNextCLEID() { return NextCLEID++; }
 
+	/**
+	 * Secondary indexes over clientlist used to narrow /who, friends who and LFG searches. They are a snapshot
+	 * rebuilt when entries are added or destroyed and at most every World:WhoIndexRefreshMS otherwise, so
+	 * candidates are always re-checked against the live entry
+	 */
+	static const int WhoLevelBucketSize = 10;
+	static const int WhoLevelBuckets    = 256 / WhoLevelBucketSize + 1;
+
+	struct WhoReply {
+		uint32             expires;
+		std::vector<uchar> data;
+	};
+
+	void ValidateWhoIndex();
+	void GetWhoCandidates(Who_All_Struct *whom, int whomlen, int16 admin, std::vector<ClientListEntry *> &into);
+	ClientListEntry *FindWhoCharacter(const char *name);
+
+	bool                                                 m_who_index_dirty;
+	uint32                                               m_who_index_time;
+	std::vector<ClientListEntry *>                       m_who_entries; // clientlist order
+	std::vector<std::pair<std::string, uint32>>          m_who_by_name; // sorted lowercase name
+	std::unordered_map<uint32, std::vector<uint32>>      m_who_by_zone;
+	std::unordered_map<uint32, std::vector<uint32>>      m_who_by_guild;
+	std::unordered_map<uint32, std::vector<uint32>>      m_who_by_class;
+	std::vector<uint32>                                  m_who_by_level[WhoLevelBuckets];
+	std::vector<uint32>                                  m_who_lfg;
+	std::unordered_map<std::string, WhoReply>            m_who_replies;
+
 	//this is the list of people actively connected to zone
 	LinkedList<Client*> list;
 
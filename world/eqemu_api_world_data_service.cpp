@@ -118,6 +118,12 @@ void callGetDatabaseSchema(Json::Value &response)
 	response.append(schema);
 }
 
+void callGetPacketRoutingStats(Json::Value &response)
+{
+	response["routed_packets"]     = static_cast<Json::UInt64>(zoneserver_list.GetRoutedPackets());
+	response["routed_sends_saved"] = static_cast<Json::UInt64>(zoneserver_list.GetRoutedSendsSaved());
+}
+
 void callGetClientList(Json::Value &response)
 {
 	client_list.GetClientList(response);
@@ -136,4 +142,7 @@ void EQEmuApiWorldDataService::get(Json::Value &response, const std::vector<std:
 	if (method == "get_client_list") {
 		callGetClientList(response);
 	}
+	if (method == "get_packet_routing_stats") {
+		callGetPacketRoutingStats(response);
+	}
 }
@@ -25,49 +25,53 @@
 #include "zonelist.h"
 #include "zoneserver.h"
 #include "../common/eqemu_logsys.h"
+#include "../common/string_util.h"
+#include <algorithm>
 
 extern ClientList client_list;
 extern ZSList zoneserver_list;
 
-Expedition::Expedition(uint32_t expedition_id, uint32_t dz_id, uint32_t dz_instance_id,
-	uint32_t dz_zone_id, uint32_t start_time, uint32_t duration, uint32_t leader_id
+Expedition::Expedition(uint32_t expedition_id, const std::string& uuid, const std::string& expedition_name,
+	uint32_t leader_id, uint32_t min_players, uint32_t max_players, const ServerDzInfo_Struct& dz
 ) :
 	m_expedition_id(expedition_id),
-	m_dz_id(dz_id),
-	m_dz_instance_id(dz_instance_id),
-	m_dz_zone_id(dz_zone_id),
-	m_start_time(std::chrono::system_clock::from_time_t(start_time)),
-	m_duration(duration),
-	m_leader_id(leader_id)
+	m_dz_id(dz.dz_id),
+	m_dz_instance_id(dz.instance_id),
+	m_dz_zone_id(dz.zone_id),
+	m_leader_id(leader_id),
+	m_min_players(min_players),
+	m_max_players(max_players),
+	m_uuid(uuid),
+	m_expedition_name(expedition_name),
+	m_dz_info(dz),
+	m_duration(dz.duration),
+	m_start_time(std::chrono::system_clock::from_time_t(dz.start_time))
 {
 	m_expire_time = m_start_time + m_duration;
 	m_warning_cooldown_timer.Enable();
 }
 
-void Expedition::AddMember(uint32_t character_id)
+void Expedition::AddMember(uint32_t character_id, const std::string& character_name)
 {
-	auto it = std::find_if(m_member_ids.begin(), m_member_ids.end(),
-		[&](uint32_t member_id) { return member_id == character_id; });
-
-	if (it == m_member_ids.end())
+	if (!HasMember(character_id))
 	{
-		m_member_ids.emplace_back(character_id);
+		m_members.emplace_back(character_id, character_name);
 	}
 }
 
-bool Expedition::HasMember(uint32_t character_id)
+bool Expedition::HasMember(uint32_t character_id) const
 {
-	return std::any_of(m_member_ids.begin(), m_member_ids.end(),
-		[&](uint32_t member_id) { return member_id == character_id; });
+	return std::any_of(m_members.begin(), m_members.end(),
+		[&](const ExpeditionMember& member) { return member.char_id == character_id; });
 }
 
 void Expedition::RemoveMember(uint32_t character_id)
 {
-	m_member_ids.erase(std::remove_if(m_member_ids.begin(), m_member_ids.end(),
-		[&](uint32_t member_id) { return member_id == character_id; }
-	), m_member_ids.end());
+	m_members.erase(std::remove_if(m_members.begin(), m_members.end(),
+		[&](const ExpeditionMember& member) { return member.char_id == character_id; }
+	), m_members.end());
 
-	if (!m_member_ids.empty() && character_id == m_leader_id)
+	if (!m_members.empty() && character_id == m_leader_id)
 	{
 		ChooseNewLeader();
 	}
@@ -77,21 +81,21 @@ void Expedition::ChooseNewLeader()
 {
 	// we don't track expedition member status in world so may choose a linkdead member
 	// this is fine since it will trigger another change when that member goes offline
-	auto it = std::find_if(m_member_ids.begin(), m_member_ids.end(), [&](uint32_t member_id) {
-		auto member_cle = (member_id != m_leader_id) ? client_list.FindCLEByCharacterID(member_id) : nullptr;
-		return (member_id != m_leader_id && member_cle && member_cle->GetOnline() == CLE_Status::InZone);
+	auto it = std::find_if(m_members.begin(), m_members.end(), [&](const ExpeditionMember& member) {
+		auto member_cle = (member.char_id != m_leader_id) ? client_list.FindCLEByCharacterID(member.char_id) : nullptr;
+		return (member.char_id != m_leader_id && member_cle && member_cle->GetOnline() == CLE_Status::InZone);
 	});
 
-	if (it == m_member_ids.end())
+	if (it == m_members.end())
 	{
 		// no online members found, fallback to choosing any member
-		it = std::find_if(m_member_ids.begin(), m_member_ids.end(),
-			[&](uint32_t member_id) { return (member_id != m_leader_id); });
+		it = std::find_if(m_members.begin(), m_members.end(),
+			[&](const ExpeditionMember& member) { return (member.char_id != m_leader_id); });
 	}
 
-	if (it != m_member_ids.end())
+	if (it != m_members.end())
 	{
-		SetNewLeader(*it);
+		SetNewLeader(it->char_id);
 	}
 }
 
@@ -164,6 +168,7 @@ void Expedition::UpdateDzSecondsRemaining(uint32_t seconds_remaining)
 		// preserve original start time and adjust duration instead
 		m_expire_time = now + update_time;
 		m_duration = std::chrono::duration_cast<std::chrono::seconds>(m_expire_time - m_start_time);
+		m_dz_info.duration = static_cast<uint32_t>(m_duration.count());
 
 		ExpeditionDatabase::UpdateDzDuration(GetInstanceID(), static_cast<uint32_t>(m_duration.count()));
 
@@ -193,3 +198,123 @@ void Expedition::CheckExpireWarning()
 		}
 	}
 }
+
+void Expedition::UpdateDzLocation(uint16_t server_opcode, const ServerDzLocation_Struct& location)
+{
+	if (server_opcode == ServerOP_ExpeditionDzCompass)
+	{
+		m_dz_info.compass_zone_id = location.zone_id;
+		m_dz_info.compass_x       = location.x;
+		m_dz_info.compass_y       = location.y;
+		m_dz_info.compass_z       = location.z;
+		ExpeditionDatabase::UpdateDzCompass(m_dz_id, m_dz_info);
+	}
+	else if (server_opcode == ServerOP_ExpeditionDzSafeReturn)
+	{
+		m_dz_info.safereturn_zone_id = location.zone_id;
+		m_dz_info.safereturn_x       = location.x;
+		m_dz_info.safereturn_y       = location.y;
+		m_dz_info.safereturn_z       = location.z;
+		m_dz_info.safereturn_heading = location.heading;
+		ExpeditionDatabase::UpdateDzSafeReturn(m_dz_id, m_dz_info);
+	}
+	else if (server_opcode == ServerOP_ExpeditionDzZoneIn)
+	{
+		m_dz_info.zonein_x       = location.x;
+		m_dz_info.zonein_y       = location.y;
+		m_dz_info.zonein_z       = location.z;
+		m_dz_info.zonein_heading = location.heading;
+		m_dz_info.has_zonein     = true;
+		ExpeditionDatabase::UpdateDzZoneIn(m_dz_id, m_dz_info);
+	}
+}
+
+void Expedition::UpdateLockout(const ExpeditionLockoutTimer& lockout, bool remove, bool update_db)
+{
+	if (remove)
+	{
+		m_lockouts.erase(lockout.GetEventName());
+		if (update_db)
+		{
+			ExpeditionDatabase::DeleteLockout(m_expedition_id, lockout.GetEventName());
+		}
+	}
+	else
+	{
+		m_lockouts[lockout.GetEventName()] = lockout;
+		if (update_db)
+		{
+			ExpeditionDatabase::InsertLockout(m_expedition_id, lockout);
+		}
+	}
+}
+
+void Expedition::UpdateLockoutDuration(const ExpeditionLockoutTimer& lockout, int seconds)
+{
+	auto it = m_lockouts.find(lockout.GetEventName());
+	if (it != m_lockouts.end())
+	{
+		it->second.AddLockoutTime(seconds);
+		ExpeditionDatabase::InsertLockout(m_expedition_id, it->second); // replaces current one
+	}
+	else
+	{
+		m_lockouts[lockout.GetEventName()] = lockout;
+		ExpeditionDatabase::InsertLockout(m_expedition_id, lockout);
+	}
+}
+
+std::unique_ptr<ServerPacket> Expedition::CreateCachePacket() const
+{
+	uint32_t pack_size = sizeof(ServerExpeditionCreate_Struct) +
+		m_members.size() * sizeof(ServerExpeditionMemberEntry_Struct) +
+		m_lockouts.size() * sizeof(ServerExpeditionLockoutEntry_Struct);
+
+	auto pack = std::unique_ptr<ServerPacket>(new ServerPacket(ServerOP_ExpeditionCreate, pack_size));
+	auto buf = reinterpret_cast<ServerExpeditionCreate_Struct*>(pack->pBuffer);
+	buf->expedition_id      = m_expedition_id;
+	buf->leader_id          = m_leader_id;
+	buf->min_players        = m_min_players;
+	buf->max_players        = m_max_players;
+	buf->add_replay_on_join = m_add_replay_on_join;
+	buf->is_locked          = m_is_locked;
+	buf->member_count       = static_cast<uint32_t>(m_members.size());
+	buf->lockout_count      = static_cast<uint32_t>(m_lockouts.size());
+	buf->dz                 = m_dz_info;
+	strn0cpy(buf->uuid, m_uuid.c_str(), sizeof(buf->uuid));
+	strn0cpy(buf->expedition_name, m_expedition_name.c_str(), sizeof(buf->expedition_name));
+
+	auto members = reinterpret_cast<ServerExpeditionMemberEntry_Struct*>(buf->entries);
+	for (const auto& member : m_members)
+	{
+		// member statuses are filled in here so zones don't have to ask for them after caching
+		auto cle = client_list.FindCLEByCharacterID(member.char_id);
+		bool is_online = (cle && cle->GetOnline() >= CLE_Status::Online);
+
+		members->char_id = member.char_id;
+		members->status = 2; // offline
+		if (is_online)
+		{
+			members->status = (cle->instance() != 0 && cle->instance() == m_dz_instance_id) ? 3 : 1;
+		}
+		strn0cpy(members->name, member.name.c_str(), sizeof(members->name));
+
+		if (member.char_id == m_leader_id)
+		{
+			strn0cpy(buf->leader_name, member.name.c_str(), sizeof(buf->leader_name));
+		}
+		++members;
+	}
+
+	auto lockouts = reinterpret_cast<ServerExpeditionLockoutEntry_Struct*>(members);
+	for (const auto& lockout : m_lockouts)
+	{
+		lockouts->expire_time = lockout.second.GetExpireTime();
+		lockouts->duration    = lockout.second.GetDuration();
+		strn0cpy(lockouts->uuid, lockout.second.GetExpeditionUUID().c_str(), sizeof(lockouts->uuid));
+		strn0cpy(lockouts->event_name, lockout.second.GetEventName().c_str(), sizeof(lockouts->event_name));
+		++lockouts;
+	}
+
+	return pack;
+}
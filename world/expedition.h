@@ -21,50 +21,88 @@
 #ifndef WORLD_EXPEDITION_H
 #define WORLD_EXPEDITION_H
 
+#include "../common/expedition_lockout_timer.h"
+#include "../common/servertalk.h"
 #include "../common/timer.h"
 #include <chrono>
 #include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
+struct ExpeditionMember
+{
+	uint32_t char_id = 0;
+	std::string name;
+
+	ExpeditionMember() = default;
+	ExpeditionMember(uint32_t char_id_, const std::string& name_) : char_id(char_id_), name(name_) {}
+};
+
 class Expedition
 {
 public:
 	Expedition() = default;
-	Expedition(uint32_t expedition_id, uint32_t dz_id, uint32_t dz_instance_id,
-		uint32_t dz_zone_id, uint32_t expire_time, uint32_t duration, uint32_t leader_id);
+	Expedition(uint32_t expedition_id, const std::string& uuid, const std::string& expedition_name,
+		uint32_t leader_id, uint32_t min_players, uint32_t max_players, const ServerDzInfo_Struct& dz);
 
-	void AddMember(uint32_t character_id);
+	void AddMember(uint32_t character_id, const std::string& character_name);
 	void RemoveMember(uint32_t character_id);
-	void RemoveAllMembers() { m_member_ids.clear(); }
+	void RemoveAllMembers() { m_members.clear(); }
 	void CheckExpireWarning();
 	void ChooseNewLeader();
 	uint32_t GetID() const { return m_expedition_id; }
+	uint32_t GetDynamicZoneID() const { return m_dz_id; }
 	uint16_t GetInstanceID() const { return static_cast<uint16_t>(m_dz_instance_id); }
 	uint16_t GetZoneID() const { return static_cast<uint16_t>(m_dz_zone_id); }
-	bool HasMember(uint32_t character_id);
-	bool IsEmpty() const { return m_member_ids.empty(); }
+	uint32_t GetLeaderID() const { return m_leader_id; }
+	uint32_t GetMaxPlayers() const { return m_max_players; }
+	uint32_t GetMinPlayers() const { return m_min_players; }
+	const std::string& GetName() const { return m_expedition_name; }
+	const std::string& GetUUID() const { return m_uuid; }
+	const std::vector<ExpeditionMember>& GetMembers() const { return m_members; }
+	const std::unordered_map<std::string, ExpeditionLockoutTimer>& GetLockouts() const { return m_lockouts; }
+	bool HasMember(uint32_t character_id) const;
+	bool IsAddingReplayOnJoin() const { return m_add_replay_on_join; }
+	bool IsEmpty() const { return m_members.empty(); }
 	bool IsExpired() const { return m_expire_time < std::chrono::system_clock::now(); }
+	bool IsLocked() const { return m_is_locked; }
 	bool IsPendingDelete() const { return m_pending_delete; }
 	bool IsValid() const { return m_expedition_id != 0; }
 	void SendZonesDurationUpdate();
 	void SendZonesExpeditionDeleted();
 	void SendZonesExpireWarning(uint32_t minutes_remaining);
 	bool SetNewLeader(uint32_t new_leader_id);
+	void SetLocked(bool is_locked) { m_is_locked = is_locked; }
 	void SetPendingDelete(bool pending) { m_pending_delete = pending; }
+	void SetReplayLockoutOnMemberJoin(bool add_on_join) { m_add_replay_on_join = add_on_join; }
+	void UpdateDzLocation(uint16_t server_opcode, const ServerDzLocation_Struct& location);
 	void UpdateDzSecondsRemaining(uint32_t seconds_remaining);
+	void UpdateLockout(const ExpeditionLockoutTimer& lockout, bool remove, bool update_db = true);
+	void UpdateLockoutDuration(const ExpeditionLockoutTimer& lockout, int seconds);
 	std::chrono::system_clock::duration GetRemainingDuration() const;
+	std::unique_ptr<ServerPacket> CreateCachePacket() const;
 
 private:
 	void SendZonesLeaderChanged();
 
-	uint32_t m_expedition_id  = 0;
-	uint32_t m_dz_id          = 0;
-	uint32_t m_dz_instance_id = 0;
-	uint32_t m_dz_zone_id     = 0;
-	uint32_t m_leader_id      = 0;
-	bool     m_pending_delete = false;
+	uint32_t m_expedition_id      = 0;
+	uint32_t m_dz_id              = 0;
+	uint32_t m_dz_instance_id     = 0;
+	uint32_t m_dz_zone_id         = 0;
+	uint32_t m_leader_id          = 0;
+	uint32_t m_min_players        = 0;
+	uint32_t m_max_players        = 0;
+	bool     m_add_replay_on_join = true;
+	bool     m_is_locked          = false;
+	bool     m_pending_delete     = false;
+	std::string m_uuid;
+	std::string m_expedition_name;
+	ServerDzInfo_Struct m_dz_info{}; // zone caches are sent this with the current duration
 	Timer    m_warning_cooldown_timer;
-	std::vector<uint32_t> m_member_ids;
+	std::vector<ExpeditionMember> m_members;
+	std::unordered_map<std::string, ExpeditionLockoutTimer> m_lockouts;
 	std::chrono::seconds m_duration;
 	std::chrono::time_point<std::chrono::system_clock> m_start_time;
 	std::chrono::time_point<std::chrono::system_clock> m_expire_time;
@@ -21,6 +21,67 @@
 #include "expedition_database.h"
 #include "expedition.h"
 #include "worlddb.h"
+#include "../common/expedition_lockout_timer.h"
+#include "../common/rulesys.h"
+#include "../common/string_util.h"
+#include "../common/timer.h"
+#include <chrono>
+#include <fmt/core.h>
+
+namespace
+{
+	std::vector<std::string> pending_writes;
+	Timer flush_timer;
+
+	void QueueWrite(std::string query)
+	{
+		pending_writes.emplace_back(std::move(query));
+
+		if (RuleI(Expedition, WorldWriteBehindMS) <= 0)
+		{
+			ExpeditionDatabase::FlushPendingWrites();
+		}
+		else if (!flush_timer.Enabled())
+		{
+			flush_timer.Start(RuleI(Expedition, WorldWriteBehindMS));
+		}
+	}
+}
+
+void ExpeditionDatabase::FlushPendingWrites()
+{
+	flush_timer.Disable();
+
+	if (pending_writes.empty())
+	{
+		return;
+	}
+
+	LogExpeditionsDetail("Writing [{}] queued expedition changes", pending_writes.size());
+
+	// swapped out first since a failed query shouldn't be retried forever
+	std::vector<std::string> queries;
+	queries.swap(pending_writes);
+
+	database.TransactionBegin();
+	for (const auto& query : queries)
+	{
+		auto results = database.QueryDatabase(query);
+		if (!results.Success())
+		{
+			LogExpeditions("Failed to write queued expedition change: [{}]", results.ErrorMessage());
+		}
+	}
+	database.TransactionCommit();
+}
+
+void ExpeditionDatabase::ProcessPendingWrites()
+{
+	if (flush_timer.Enabled() && flush_timer.Check())
+	{
+		FlushPendingWrites();
+	}
+}
 
 void ExpeditionDatabase::PurgeExpiredExpeditions()
 {
@@ -71,81 +132,273 @@ void ExpeditionDatabase::PurgeExpiredCharacterLockouts()
 	database.QueryDatabase(query);
 }
 
-std::vector<Expedition> ExpeditionDatabase::LoadExpeditions(uint32_t select_expedition_id)
+void ExpeditionDatabase::MoveMembersToSafeReturn(const std::vector<uint32_t>& expedition_ids)
 {
+	LogExpeditionsDetail("Moving members from [{}] expedition(s) to safereturn", expedition_ids.size());
+
+	// only offline members still in expired dz zones should be updated here
+	std::string query = fmt::format(SQL(
+		UPDATE character_data
+			INNER JOIN expedition_members ON character_data.id = expedition_members.character_id
+			INNER JOIN expeditions ON expedition_members.expedition_id = expeditions.id
+			INNER JOIN dynamic_zones ON expeditions.dynamic_zone_id = dynamic_zones.id
+			INNER JOIN instance_list ON dynamic_zones.instance_id = instance_list.id
+				AND character_data.zone_instance = instance_list.id
+				AND character_data.zone_id = instance_list.zone
+		SET
+			zone_id       = IF(safe_return_zone_id > 0, safe_return_zone_id, zone_id),
+			zone_instance = IF(safe_return_zone_id > 0, 0, zone_instance),
+			x             = IF(safe_return_zone_id > 0, safe_return_x, x),
+			y             = IF(safe_return_zone_id > 0, safe_return_y, y),
+			z             = IF(safe_return_zone_id > 0, safe_return_z, z),
+			heading       = IF(safe_return_zone_id > 0, safe_return_heading, heading)
+		WHERE expeditions.id IN ({});
+	), fmt::join(expedition_ids, ","));
+
+	// queued so it stays ahead of the expedition deletes that follow it
+	QueueWrite(query);
+}
+
+std::vector<Expedition> ExpeditionDatabase::LoadExpeditions()
+{
+	LogExpeditionsDetail("Loading all expeditions from database");
+
 	std::vector<Expedition> expeditions;
 
 	std::string query = SQL(
 		SELECT
 			expeditions.id,
-			expeditions.dynamic_zone_id,
+			expeditions.uuid,
+			expeditions.expedition_name,
+			expeditions.leader_id,
+			expeditions.min_players,
+			expeditions.max_players,
+			expeditions.add_replay_on_join,
+			expeditions.is_locked,
+			dynamic_zones.id,
+			dynamic_zones.type,
+			dynamic_zones.compass_zone_id,
+			dynamic_zones.compass_x,
+			dynamic_zones.compass_y,
+			dynamic_zones.compass_z,
+			dynamic_zones.safe_return_zone_id,
+			dynamic_zones.safe_return_x,
+			dynamic_zones.safe_return_y,
+			dynamic_zones.safe_return_z,
+			dynamic_zones.safe_return_heading,
+			dynamic_zones.zone_in_x,
+			dynamic_zones.zone_in_y,
+			dynamic_zones.zone_in_z,
+			dynamic_zones.zone_in_heading,
+			dynamic_zones.has_zone_in,
 			instance_list.id,
 			instance_list.zone,
+			instance_list.version,
 			instance_list.start_time,
 			instance_list.duration,
-			expeditions.leader_id,
-			expedition_members.character_id
+			instance_list.never_expires,
+			expedition_members.character_id,
+			character_data.name
 		FROM expeditions
 			INNER JOIN dynamic_zones ON expeditions.dynamic_zone_id = dynamic_zones.id
 			INNER JOIN instance_list ON dynamic_zones.instance_id = instance_list.id
 			INNER JOIN expedition_members ON expedition_members.expedition_id = expeditions.id
 				AND expedition_members.is_current_member = TRUE
+			INNER JOIN character_data ON expedition_members.character_id = character_data.id
+		ORDER BY expeditions.id;
 	);
 
-	if (select_expedition_id != 0)
+	auto results = database.QueryDatabase(query);
+	if (!results.Success())
 	{
-		query.append(fmt::format(" WHERE expeditions.id = {};", select_expedition_id));
+		return expeditions;
 	}
-	else
+
+	using col = LoadExpeditionColumns::eLoadExpeditionColumns;
+
+	uint32_t last_expedition_id = 0;
+	for (auto row = results.begin(); row != results.end(); ++row)
 	{
-		query.append(" ORDER BY expeditions.id;");
+		uint32_t expedition_id = strtoul(row[col::id], nullptr, 10);
+
+		if (last_expedition_id != expedition_id)
+		{
+			ServerDzInfo_Struct dz{};
+			dz.dz_id              = strtoul(row[col::dz_id], nullptr, 10);
+			dz.type               = static_cast<uint8_t>(strtoul(row[col::dz_type], nullptr, 10));
+			dz.compass_zone_id    = strtoul(row[col::compass_zone_id], nullptr, 10);
+			dz.compass_x          = strtof(row[col::compass_x], nullptr);
+			dz.compass_y          = strtof(row[col::compass_y], nullptr);
+			dz.compass_z          = strtof(row[col::compass_z], nullptr);
+			dz.safereturn_zone_id = strtoul(row[col::safe_return_zone_id], nullptr, 10);
+			dz.safereturn_x       = strtof(row[col::safe_return_x], nullptr);
+			dz.safereturn_y       = strtof(row[col::safe_return_y], nullptr);
+			dz.safereturn_z       = strtof(row[col::safe_return_z], nullptr);
+			dz.safereturn_heading = strtof(row[col::safe_return_heading], nullptr);
+			dz.zonein_x           = strtof(row[col::zone_in_x], nullptr);
+			dz.zonein_y           = strtof(row[col::zone_in_y], nullptr);
+			dz.zonein_z           = strtof(row[col::zone_in_z], nullptr);
+			dz.zonein_heading     = strtof(row[col::zone_in_heading], nullptr);
+			dz.has_zonein         = (strtoul(row[col::has_zone_in], nullptr, 10) != 0);
+			dz.instance_id        = static_cast<uint16_t>(strtoul(row[col::instance_id], nullptr, 10));
+			dz.zone_id            = static_cast<uint16_t>(strtoul(row[col::zone_id], nullptr, 10));
+			dz.version            = strtoul(row[col::zone_version], nullptr, 10);
+			dz.start_time         = strtoull(row[col::start_time], nullptr, 10);
+			dz.duration           = strtoul(row[col::duration], nullptr, 10);
+			dz.never_expires      = (strtoul(row[col::never_expires], nullptr, 10) != 0);
+
+			expeditions.emplace_back(
+				expedition_id,
+				row[col::uuid],
+				row[col::expedition_name],
+				static_cast<uint32_t>(strtoul(row[col::leader_id], nullptr, 10)),
+				static_cast<uint32_t>(strtoul(row[col::min_players], nullptr, 10)),
+				static_cast<uint32_t>(strtoul(row[col::max_players], nullptr, 10)),
+				dz
+			);
+
+			expeditions.back().SetReplayLockoutOnMemberJoin(strtoul(row[col::add_replay_on_join], nullptr, 10) != 0);
+			expeditions.back().SetLocked(strtoul(row[col::is_locked], nullptr, 10) != 0);
+		}
+
+		last_expedition_id = expedition_id;
+
+		uint32_t member_id = static_cast<uint32_t>(strtoul(row[col::member_id], nullptr, 10));
+		expeditions.back().AddMember(member_id, row[col::member_name]);
 	}
 
-	auto results = database.QueryDatabase(query);
+	// lockouts are a separate query so they aren't repeated for every member row
+	query = SQL(
+		SELECT
+			expedition_lockouts.expedition_id,
+			expedition_lockouts.from_expedition_uuid,
+			expeditions.expedition_name,
+			expedition_lockouts.event_name,
+			UNIX_TIMESTAMP(expedition_lockouts.expire_time),
+			expedition_lockouts.duration
+		FROM expedition_lockouts
+			INNER JOIN expeditions ON expedition_lockouts.expedition_id = expeditions.id
+		ORDER BY expedition_lockouts.expedition_id;
+	);
+
+	results = database.QueryDatabase(query);
 	if (results.Success())
 	{
-		uint32_t last_expedition_id = 0;
-
+		auto expedition = expeditions.begin();
 		for (auto row = results.begin(); row != results.end(); ++row)
 		{
 			uint32_t expedition_id = strtoul(row[0], nullptr, 10);
 
-			if (last_expedition_id != expedition_id)
+			// both result sets are ordered by expedition id
+			while (expedition != expeditions.end() && expedition->GetID() < expedition_id)
 			{
-				expeditions.emplace_back(
-					static_cast<uint32_t>(strtoul(row[0], nullptr, 10)), // expedition_id
-					static_cast<uint32_t>(strtoul(row[1], nullptr, 10)), // dz_id
-					static_cast<uint32_t>(strtoul(row[2], nullptr, 10)), // dz_instance_id
-					static_cast<uint32_t>(strtoul(row[3], nullptr, 10)), // dz_zone_id
-					static_cast<uint32_t>(strtoul(row[4], nullptr, 10)), // start_time
-					static_cast<uint32_t>(strtoul(row[5], nullptr, 10)), // duration
-					static_cast<uint32_t>(strtoul(row[6], nullptr, 10))  // leader_id
-				);
+				++expedition;
 			}
 
-			last_expedition_id = expedition_id;
-
-			uint32_t member_id = static_cast<uint32_t>(strtoul(row[7], nullptr, 10));
-			expeditions.back().AddMember(member_id);
+			if (expedition != expeditions.end() && expedition->GetID() == expedition_id)
+			{
+				expedition->UpdateLockout(ExpeditionLockoutTimer{
+					row[1],                                             // expedition_uuid
+					row[2],                                             // expedition_name
+					row[3],                                             // event_name
+					strtoull(row[4], nullptr, 10),                      // expire_time
+					static_cast<uint32_t>(strtoul(row[5], nullptr, 10)) // original duration
+				}, false, false);
+			}
 		}
 	}
 
 	return expeditions;
 }
 
-Expedition ExpeditionDatabase::LoadExpedition(uint32_t expedition_id)
+std::unordered_map<uint32_t, std::vector<ExpeditionLockoutTimer>> ExpeditionDatabase::LoadCharacterLockouts()
 {
-	LogExpeditions("Loading expedition [{}] for world cache", expedition_id);
+	LogExpeditionsDetail("Loading all character lockouts from database");
+
+	std::unordered_map<uint32_t, std::vector<ExpeditionLockoutTimer>> lockouts;
 
-	Expedition expedition;
+	std::string query = SQL(
+		SELECT
+			character_id,
+			from_expedition_uuid,
+			expedition_name,
+			event_name,
+			UNIX_TIMESTAMP(expire_time),
+			duration
+		FROM character_expedition_lockouts
+		WHERE expire_time > NOW();
+	);
 
-	auto expeditions = LoadExpeditions(expedition_id);
-	if (!expeditions.empty())
+	auto results = database.QueryDatabase(query);
+	if (results.Success())
 	{
-		expedition = expeditions.front();
+		for (auto row = results.begin(); row != results.end(); ++row)
+		{
+			uint32_t character_id = strtoul(row[0], nullptr, 10);
+			lockouts[character_id].emplace_back(
+				row[1],                                             // expedition_uuid
+				row[2],                                             // expedition_name
+				row[3],                                             // event_name
+				strtoull(row[4], nullptr, 10),                      // expire_time
+				static_cast<uint32_t>(strtoul(row[5], nullptr, 10)) // duration
+			);
+		}
 	}
 
-	return expedition;
+	return lockouts;
+}
+
+uint32_t ExpeditionDatabase::GetMaxExpeditionID()
+{
+	auto results = database.QueryDatabase("SELECT IFNULL(MAX(id), 0) FROM expeditions;");
+	if (results.Success() && results.RowCount() > 0)
+	{
+		auto row = results.begin();
+		return strtoul(row[0], nullptr, 10);
+	}
+	return 0;
+}
+
+uint32_t ExpeditionDatabase::GetMaxDynamicZoneID()
+{
+	auto results = database.QueryDatabase("SELECT IFNULL(MAX(id), 0) FROM dynamic_zones;");
+	if (results.Success() && results.RowCount() > 0)
+	{
+		auto row = results.begin();
+		return strtoul(row[0], nullptr, 10);
+	}
+	return 0;
+}
+
+bool ExpeditionDatabase::CreateInstance(ServerDzInfo_Struct& dz)
+{
+	// not queued, the instance id has to be reserved before the zones are told about it
+	uint16_t instance_id = 0;
+	if (!database.GetUnusedInstanceID(instance_id))
+	{
+		LogDynamicZones("Failed to find unused instance id");
+		return false;
+	}
+
+	dz.start_time = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+
+	std::string query = fmt::format(SQL(
+		INSERT INTO instance_list
+			(id, zone, version, start_time, duration)
+		VALUES
+			({}, {}, {}, {}, {})
+	), instance_id, dz.zone_id, dz.version, dz.start_time, dz.duration);
+
+	auto results = database.QueryDatabase(query);
+	if (!results.Success())
+	{
+		LogDynamicZones("Failed to create instance [{}] for Dynamic Zone [{}]", instance_id, dz.zone_id);
+		return false;
+	}
+
+	dz.instance_id   = instance_id;
+	dz.never_expires = false;
+	return true;
 }
 
 void ExpeditionDatabase::DeleteExpeditions(const std::vector<uint32_t>& expedition_ids)
@@ -156,60 +409,415 @@ void ExpeditionDatabase::DeleteExpeditions(const std::vector<uint32_t>& expediti
 
 	if (!expedition_ids_query.empty())
 	{
-		auto query = fmt::format("DELETE FROM expeditions WHERE id IN ({});", expedition_ids_query);
-		database.QueryDatabase(query);
-
-		query = fmt::format("DELETE FROM expedition_members WHERE expedition_id IN ({});", expedition_ids_query);
-		database.QueryDatabase(query);
-
-		query = fmt::format("DELETE FROM expedition_lockouts WHERE expedition_id IN ({});", expedition_ids_query);
-		database.QueryDatabase(query);
+		QueueWrite(fmt::format("DELETE FROM expeditions WHERE id IN ({});", expedition_ids_query));
+		QueueWrite(fmt::format("DELETE FROM expedition_members WHERE expedition_id IN ({});", expedition_ids_query));
+		QueueWrite(fmt::format("DELETE FROM expedition_lockouts WHERE expedition_id IN ({});", expedition_ids_query));
 	}
 }
 
 void ExpeditionDatabase::UpdateDzDuration(uint16_t instance_id, uint32_t new_duration)
 {
-	std::string query = fmt::format(
+	QueueWrite(fmt::format(
 		"UPDATE instance_list SET duration = {} WHERE id = {};",
 		new_duration, instance_id
-	);
-
-	database.QueryDatabase(query);
+	));
 }
 
 void ExpeditionDatabase::UpdateLeaderID(uint32_t expedition_id, uint32_t leader_id)
 {
 	LogExpeditionsDetail("Updating leader [{}] for expedition [{}]", leader_id, expedition_id);
 
-	auto query = fmt::format(SQL(
+	QueueWrite(fmt::format(SQL(
 		UPDATE expeditions SET leader_id = {} WHERE id = {};
-	), leader_id, expedition_id);
+	), leader_id, expedition_id));
+}
 
-	database.QueryDatabase(query);
+void ExpeditionDatabase::InsertExpedition(const Expedition& expedition)
+{
+	LogExpeditionsDetail(
+		"Inserting new expedition [{}] [{}] leader [{}] uuid [{}]",
+		expedition.GetID(), expedition.GetName(), expedition.GetLeaderID(), expedition.GetUUID()
+	);
+
+	QueueWrite(fmt::format(SQL(
+		INSERT INTO expeditions
+			(id, uuid, dynamic_zone_id, expedition_name, leader_id, min_players, max_players, add_replay_on_join, is_locked)
+		VALUES
+			({}, '{}', {}, '{}', {}, {}, {}, {}, {});
+	),
+		expedition.GetID(),
+		expedition.GetUUID(),
+		expedition.GetDynamicZoneID(),
+		EscapeString(expedition.GetName()),
+		expedition.GetLeaderID(),
+		expedition.GetMinPlayers(),
+		expedition.GetMaxPlayers(),
+		expedition.IsAddingReplayOnJoin(),
+		expedition.IsLocked()
+	));
 }
 
-void ExpeditionDatabase::MoveMembersToSafeReturn(const std::vector<uint32_t>& expedition_ids)
+void ExpeditionDatabase::InsertDynamicZone(const ServerDzInfo_Struct& dz)
 {
-	LogExpeditionsDetail("Moving members from [{}] expedition(s) to safereturn", expedition_ids.size());
+	LogDynamicZonesDetail("Inserting dz [{}] for instance [{}]", dz.dz_id, dz.instance_id);
+
+	QueueWrite(fmt::format(SQL(
+		INSERT INTO dynamic_zones
+			(
+				id,
+				instance_id,
+				type,
+				compass_zone_id,
+				compass_x,
+				compass_y,
+				compass_z,
+				safe_return_zone_id,
+				safe_return_x,
+				safe_return_y,
+				safe_return_z,
+				safe_return_heading,
+				zone_in_x,
+				zone_in_y,
+				zone_in_z,
+				zone_in_heading,
+				has_zone_in
+			)
+		VALUES
+			({}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {});
+	),
+		dz.dz_id,
+		dz.instance_id,
+		dz.type,
+		dz.compass_zone_id,
+		dz.compass_x,
+		dz.compass_y,
+		dz.compass_z,
+		dz.safereturn_zone_id,
+		dz.safereturn_x,
+		dz.safereturn_y,
+		dz.safereturn_z,
+		dz.safereturn_heading,
+		dz.zonein_x,
+		dz.zonein_y,
+		dz.zonein_z,
+		dz.zonein_heading,
+		dz.has_zonein
+	));
+}
 
-	// only offline members still in expired dz zones should be updated here
-	std::string query = fmt::format(SQL(
-		UPDATE character_data
-			INNER JOIN expedition_members ON character_data.id = expedition_members.character_id
-			INNER JOIN expeditions ON expedition_members.expedition_id = expeditions.id
-			INNER JOIN dynamic_zones ON expeditions.dynamic_zone_id = dynamic_zones.id
-			INNER JOIN instance_list ON dynamic_zones.instance_id = instance_list.id
-				AND character_data.zone_instance = instance_list.id
-				AND character_data.zone_id = instance_list.zone
-		SET
-			zone_id       = IF(safe_return_zone_id > 0, safe_return_zone_id, zone_id),
-			zone_instance = IF(safe_return_zone_id > 0, 0, zone_instance),
-			x             = IF(safe_return_zone_id > 0, safe_return_x, x),
-			y             = IF(safe_return_zone_id > 0, safe_return_y, y),
-			z             = IF(safe_return_zone_id > 0, safe_return_z, z),
-			heading       = IF(safe_return_zone_id > 0, safe_return_heading, heading)
-		WHERE expeditions.id IN ({});
-	), fmt::join(expedition_ids, ","));
+void ExpeditionDatabase::InsertMembers(
+	uint32_t expedition_id, uint16_t instance_id, const std::vector<ExpeditionMember>& members)
+{
+	LogExpeditionsDetail("Inserting [{}] characters into expedition [{}]", members.size(), expedition_id);
 
-	database.QueryDatabase(query);
+	std::string member_values;
+	std::string instance_values;
+	for (const auto& member : members)
+	{
+		fmt::format_to(std::back_inserter(member_values), "({}, {}),", expedition_id, member.char_id);
+		fmt::format_to(std::back_inserter(instance_values), "({}, {}),", instance_id, member.char_id);
+	}
+
+	if (!member_values.empty())
+	{
+		member_values.pop_back(); // trailing comma
+		instance_values.pop_back();
+
+		QueueWrite(fmt::format(SQL(
+			INSERT INTO expedition_members
+				(expedition_id, character_id)
+			VALUES {}
+			ON DUPLICATE KEY UPDATE is_current_member = TRUE;
+		), member_values));
+
+		QueueWrite(fmt::format(SQL(
+			REPLACE INTO instance_list_player (id, charid) VALUES {};
+		), instance_values));
+
+		// zones check instance_list_player when members zone into the dz so new
+		// members can't wait behind the write timer
+		FlushPendingWrites();
+	}
+}
+
+void ExpeditionDatabase::DeleteMember(uint32_t expedition_id, uint16_t instance_id, uint32_t character_id)
+{
+	LogExpeditionsDetail("Removing member [{}] from expedition [{}]", character_id, expedition_id);
+
+	QueueWrite(fmt::format(SQL(
+		UPDATE expedition_members SET is_current_member = FALSE
+		WHERE expedition_id = {} AND character_id = {};
+	), expedition_id, character_id));
+
+	QueueWrite(fmt::format(SQL(
+		DELETE FROM instance_list_player WHERE id = {} AND charid = {};
+	), instance_id, character_id));
+}
+
+void ExpeditionDatabase::DeleteAllMembers(uint32_t expedition_id, uint16_t instance_id)
+{
+	LogExpeditionsDetail("Removing all members of expedition [{}]", expedition_id);
+
+	QueueWrite(fmt::format(SQL(
+		UPDATE expedition_members SET is_current_member = FALSE WHERE expedition_id = {};
+	), expedition_id));
+
+	QueueWrite(fmt::format(SQL(
+		DELETE FROM instance_list_player WHERE id = {};
+	), instance_id));
+}
+
+void ExpeditionDatabase::InsertLockout(uint32_t expedition_id, const ExpeditionLockoutTimer& lockout)
+{
+	std::unordered_map<std::string, ExpeditionLockoutTimer> lockouts{ { lockout.GetEventName(), lockout } };
+	InsertLockouts(expedition_id, lockouts);
+}
+
+void ExpeditionDatabase::InsertLockouts(
+	uint32_t expedition_id, const std::unordered_map<std::string, ExpeditionLockoutTimer>& lockouts)
+{
+	LogExpeditionsDetail("Inserting [{}] expedition [{}] lockouts", lockouts.size(), expedition_id);
+
+	std::string insert_values;
+	for (const auto& lockout : lockouts)
+	{
+		fmt::format_to(std::back_inserter(insert_values),
+			"({}, '{}', '{}', FROM_UNIXTIME({}), {}),",
+			expedition_id,
+			lockout.second.GetExpeditionUUID(),
+			EscapeString(lockout.second.GetEventName()),
+			lockout.second.GetExpireTime(),
+			lockout.second.GetDuration()
+		);
+	}
+
+	if (!insert_values.empty())
+	{
+		insert_values.pop_back(); // trailing comma
+
+		QueueWrite(fmt::format(SQL(
+			INSERT INTO expedition_lockouts
+				(expedition_id, from_expedition_uuid, event_name, expire_time, duration)
+			VALUES {}
+			ON DUPLICATE KEY UPDATE
+				from_expedition_uuid = VALUES(from_expedition_uuid),
+				expire_time = VALUES(expire_time),
+				duration = VALUES(duration);
+		), insert_values));
+	}
+}
+
+void ExpeditionDatabase::DeleteLockout(uint32_t expedition_id, const std::string& event_name)
+{
+	LogExpeditionsDetail("Deleting expedition [{}] lockout event [{}]", expedition_id, event_name);
+
+	QueueWrite(fmt::format(SQL(
+		DELETE FROM expedition_lockouts
+		WHERE expedition_id = {} AND event_name = '{}';
+	), expedition_id, EscapeString(event_name)));
+}
+
+void ExpeditionDatabase::InsertCharacterLockouts(
+	uint32_t character_id, const std::vector<ExpeditionLockoutTimer>& lockouts)
+{
+	LogExpeditionsDetail("Inserting [{}] lockouts for character [{}]", lockouts.size(), character_id);
+
+	std::string insert_values;
+	for (const auto& lockout : lockouts)
+	{
+		fmt::format_to(std::back_inserter(insert_values),
+			"({}, FROM_UNIXTIME({}), {}, '{}', '{}', '{}'),",
+			character_id,
+			lockout.GetExpireTime(),
+			lockout.GetDuration(),
+			lockout.GetExpeditionUUID(),
+			EscapeString(lockout.GetExpeditionName()),
+			EscapeString(lockout.GetEventName())
+		);
+	}
+
+	if (!insert_values.empty())
+	{
+		insert_values.pop_back(); // trailing comma
+
+		QueueWrite(fmt::format(SQL(
+			INSERT INTO character_expedition_lockouts
+				(character_id, expire_time, duration, from_expedition_uuid, expedition_name, event_name)
+			VALUES {}
+			ON DUPLICATE KEY UPDATE
+				from_expedition_uuid = VALUES(from_expedition_uuid),
+				expire_time = VALUES(expire_time),
+				duration = VALUES(duration);
+		), insert_values));
+	}
+}
+
+void ExpeditionDatabase::InsertMembersLockout(
+	const std::vector<uint32_t>& character_ids, const ExpeditionLockoutTimer& lockout)
+{
+	LogExpeditionsDetail(
+		"Inserting [{}] members lockout [{}]:[{}] with expire time [{}]",
+		character_ids.size(), lockout.GetExpeditionName(), lockout.GetEventName(), lockout.GetExpireTime()
+	);
+
+	std::string insert_values;
+	for (const auto& character_id : character_ids)
+	{
+		fmt::format_to(std::back_inserter(insert_values),
+			"({}, FROM_UNIXTIME({}), {}, '{}', '{}', '{}'),",
+			character_id,
+			lockout.GetExpireTime(),
+			lockout.GetDuration(),
+			lockout.GetExpeditionUUID(),
+			EscapeString(lockout.GetExpeditionName()),
+			EscapeString(lockout.GetEventName())
+		);
+	}
+
+	if (!insert_values.empty())
+	{
+		insert_values.pop_back(); // trailing comma
+
+		QueueWrite(fmt::format(SQL(
+			INSERT INTO character_expedition_lockouts
+				(character_id, expire_time, duration, from_expedition_uuid, expedition_name, event_name)
+			VALUES {}
+			ON DUPLICATE KEY UPDATE
+				from_expedition_uuid = VALUES(from_expedition_uuid),
+				expire_time = VALUES(expire_time),
+				duration = VALUES(duration);
+		), insert_values));
+	}
+}
+
+void ExpeditionDatabase::DeleteAllCharacterLockouts(uint32_t character_id)
+{
+	LogExpeditionsDetail("Deleting all character [{}] lockouts", character_id);
+
+	if (character_id != 0)
+	{
+		QueueWrite(fmt::format(SQL(
+			DELETE FROM character_expedition_lockouts
+			WHERE character_id = {};
+		), character_id));
+	}
+}
+
+void ExpeditionDatabase::DeleteAllCharacterLockouts(uint32_t character_id, const std::string& expedition_name)
+{
+	LogExpeditionsDetail("Deleting all character [{}] lockouts for [{}]", character_id, expedition_name);
+
+	if (character_id != 0 && !expedition_name.empty())
+	{
+		QueueWrite(fmt::format(SQL(
+			DELETE FROM character_expedition_lockouts
+			WHERE character_id = {} AND expedition_name = '{}';
+		), character_id, EscapeString(expedition_name)));
+	}
+}
+
+void ExpeditionDatabase::DeleteCharacterLockout(
+	uint32_t character_id, const std::string& expedition_name, const std::string& event_name)
+{
+	LogExpeditionsDetail(
+		"Deleting character [{}] lockout: [{}]:[{}]", character_id, expedition_name, event_name
+	);
+
+	QueueWrite(fmt::format(SQL(
+		DELETE FROM character_expedition_lockouts
+		WHERE
+			character_id = {}
+			AND expedition_name = '{}'
+			AND event_name = '{}';
+	), character_id, EscapeString(expedition_name), EscapeString(event_name)));
+}
+
+void ExpeditionDatabase::DeleteMembersLockout(const std::vector<uint32_t>& character_ids,
+	const std::string& expedition_name, const std::string& event_name)
+{
+	LogExpeditionsDetail("Deleting members lockout: [{}]:[{}]", expedition_name, event_name);
+
+	std::string query_character_ids = fmt::format("{}", fmt::join(character_ids, ","));
+
+	if (!query_character_ids.empty())
+	{
+		QueueWrite(fmt::format(SQL(
+			DELETE FROM character_expedition_lockouts
+			WHERE character_id
+				IN ({})
+				AND expedition_name = '{}'
+				AND event_name = '{}';
+		), query_character_ids, EscapeString(expedition_name), EscapeString(event_name)));
+	}
+}
+
+void ExpeditionDatabase::UpdateLockState(uint32_t expedition_id, bool is_locked)
+{
+	LogExpeditionsDetail("Updating lock state [{}] for expedition [{}]", is_locked, expedition_id);
+
+	QueueWrite(fmt::format(SQL(
+		UPDATE expeditions SET is_locked = {} WHERE id = {};
+	), is_locked, expedition_id));
+}
+
+void ExpeditionDatabase::UpdateReplayLockoutOnJoin(uint32_t expedition_id, bool add_on_join)
+{
+	LogExpeditionsDetail("Updating replay lockout on join [{}] for expedition [{}]", add_on_join, expedition_id);
+
+	QueueWrite(fmt::format(SQL(
+		UPDATE expeditions SET add_replay_on_join = {} WHERE id = {};
+	), add_on_join, expedition_id));
+}
+
+void ExpeditionDatabase::UpdateDzCompass(uint32_t dz_id, const ServerDzInfo_Struct& dz)
+{
+	LogDynamicZonesDetail(
+		"Dz [{}] saving compass zone: [{}] xyz: ([{}], [{}], [{}])",
+		dz_id, dz.compass_zone_id, dz.compass_x, dz.compass_y, dz.compass_z
+	);
+
+	QueueWrite(fmt::format(SQL(
+		UPDATE dynamic_zones SET
+			compass_zone_id = {},
+			compass_x = {},
+			compass_y = {},
+			compass_z = {}
+		WHERE id = {};
+	), dz.compass_zone_id, dz.compass_x, dz.compass_y, dz.compass_z, dz_id));
+}
+
+void ExpeditionDatabase::UpdateDzSafeReturn(uint32_t dz_id, const ServerDzInfo_Struct& dz)
+{
+	LogDynamicZonesDetail(
+		"Dz [{}] saving safereturn zone: [{}] xyzh: ([{}], [{}], [{}], [{}])",
+		dz_id, dz.safereturn_zone_id, dz.safereturn_x, dz.safereturn_y, dz.safereturn_z, dz.safereturn_heading
+	);
+
+	QueueWrite(fmt::format(SQL(
+		UPDATE dynamic_zones SET
+			safe_return_zone_id = {},
+			safe_return_x = {},
+			safe_return_y = {},
+			safe_return_z = {},
+			safe_return_heading = {}
+		WHERE id = {};
+	), dz.safereturn_zone_id, dz.safereturn_x, dz.safereturn_y, dz.safereturn_z, dz.safereturn_heading, dz_id));
+}
+
+void ExpeditionDatabase::UpdateDzZoneIn(uint32_t dz_id, const ServerDzInfo_Struct& dz)
+{
+	LogDynamicZonesDetail(
+		"Dz [{}] saving zonein xyzh: ([{}], [{}], [{}], [{}]) has: [{}]",
+		dz_id, dz.zonein_x, dz.zonein_y, dz.zonein_z, dz.zonein_heading, dz.has_zonein
+	);
+
+	QueueWrite(fmt::format(SQL(
+		UPDATE dynamic_zones SET
+			zone_in_x = {},
+			zone_in_y = {},
+			zone_in_z = {},
+			zone_in_heading = {},
+			has_zone_in = {}
+		WHERE id = {};
+	), dz.zonein_x, dz.zonein_y, dz.zonein_z, dz.zonein_heading, dz.has_zonein, dz_id));
 }
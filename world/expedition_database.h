@@ -22,20 +22,95 @@
 #define WORLD_EXPEDITION_DATABASE_H
 
 #include <cstdint>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 class Expedition;
+class ExpeditionLockoutTimer;
+struct ExpeditionMember;
+struct ServerDzInfo_Struct;
 
+// world holds expedition state in memory. writes are queued and flushed in one
+// transaction every Expedition:WorldWriteBehindMS so the database is only used
+// to recover that state after a restart
 namespace ExpeditionDatabase
 {
+	bool CreateInstance(ServerDzInfo_Struct& dz);
 	void DeleteExpeditions(const std::vector<uint32_t>& expedition_ids);
-	std::vector<Expedition> LoadExpeditions(uint32_t select_expedition_id = 0);
-	Expedition LoadExpedition(uint32_t expedition_id);
+	void FlushPendingWrites();
+	uint32_t GetMaxDynamicZoneID();
+	uint32_t GetMaxExpeditionID();
+	std::unordered_map<uint32_t, std::vector<ExpeditionLockoutTimer>> LoadCharacterLockouts();
+	std::vector<Expedition> LoadExpeditions();
 	void MoveMembersToSafeReturn(const std::vector<uint32_t>& expedition_ids);
+	void ProcessPendingWrites();
 	void PurgeExpiredExpeditions();
 	void PurgeExpiredCharacterLockouts();
 	void UpdateDzDuration(uint16_t instance_id, uint32_t new_duration);
 	void UpdateLeaderID(uint32_t expedition_id, uint32_t leader_id);
+
+	void InsertExpedition(const Expedition& expedition);
+	void InsertDynamicZone(const ServerDzInfo_Struct& dz);
+	void InsertMembers(uint32_t expedition_id, uint16_t instance_id, const std::vector<ExpeditionMember>& members);
+	void DeleteMember(uint32_t expedition_id, uint16_t instance_id, uint32_t character_id);
+	void DeleteAllMembers(uint32_t expedition_id, uint16_t instance_id);
+	void InsertLockout(uint32_t expedition_id, const ExpeditionLockoutTimer& lockout);
+	void InsertLockouts(uint32_t expedition_id,
+		const std::unordered_map<std::string, ExpeditionLockoutTimer>& lockouts);
+	void DeleteLockout(uint32_t expedition_id, const std::string& event_name);
+	void InsertCharacterLockouts(uint32_t character_id, const std::vector<ExpeditionLockoutTimer>& lockouts);
+	void InsertMembersLockout(const std::vector<uint32_t>& character_ids, const ExpeditionLockoutTimer& lockout);
+	void DeleteAllCharacterLockouts(uint32_t character_id);
+	void DeleteAllCharacterLockouts(uint32_t character_id, const std::string& expedition_name);
+	void DeleteCharacterLockout(uint32_t character_id, const std::string& expedition_name,
+		const std::string& event_name);
+	void DeleteMembersLockout(const std::vector<uint32_t>& character_ids,
+		const std::string& expedition_name, const std::string& event_name);
+	void UpdateLockState(uint32_t expedition_id, bool is_locked);
+	void UpdateReplayLockoutOnJoin(uint32_t expedition_id, bool add_on_join);
+	void UpdateDzCompass(uint32_t dz_id, const ServerDzInfo_Struct& dz);
+	void UpdateDzSafeReturn(uint32_t dz_id, const ServerDzInfo_Struct& dz);
+	void UpdateDzZoneIn(uint32_t dz_id, const ServerDzInfo_Struct& dz);
+};
+
+namespace LoadExpeditionColumns
+{
+	enum eLoadExpeditionColumns
+	{
+		id = 0,
+		uuid,
+		expedition_name,
+		leader_id,
+		min_players,
+		max_players,
+		add_replay_on_join,
+		is_locked,
+		dz_id,
+		dz_type,
+		compass_zone_id,
+		compass_x,
+		compass_y,
+		compass_z,
+		safe_return_zone_id,
+		safe_return_x,
+		safe_return_y,
+		safe_return_z,
+		safe_return_heading,
+		zone_in_x,
+		zone_in_y,
+		zone_in_z,
+		zone_in_heading,
+		has_zone_in,
+		instance_id,
+		zone_id,
+		zone_version,
+		start_time,
+		duration,
+		never_expires,
+		member_id,
+		member_name
+	};
 };
 
 #endif
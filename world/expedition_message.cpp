@@ -26,7 +26,6 @@
 #include "zonelist.h"
 #include "zoneserver.h"
 #include "../common/servertalk.h"
-#include <algorithm>
 
 extern ClientList client_list;
 extern ZSList zoneserver_list;
@@ -40,26 +39,28 @@ void ExpeditionMessage::HandleZoneMessage(ServerPacket* pack)
 		ExpeditionMessage::ChooseNewLeader(pack);
 		break;
 	}
-	case ServerOP_ExpeditionCreate:
+	case ServerOP_ExpeditionCreateRequest:
 	{
-		auto buf = reinterpret_cast<ServerExpeditionID_Struct*>(pack->pBuffer);
-		expedition_state.AddExpedition(buf->expedition_id);
-		zoneserver_list.SendPacket(pack);
+		expedition_state.CreateExpedition(pack);
 		break;
 	}
 	case ServerOP_ExpeditionMemberChange:
 	{
 		auto buf = reinterpret_cast<ServerExpeditionMemberChange_Struct*>(pack->pBuffer);
-		expedition_state.MemberChange(buf->expedition_id, buf->char_id, buf->removed);
-		zoneserver_list.SendPacket(pack);
+		if (buf->removed)
+		{
+			expedition_state.MemberRemoved(buf->expedition_id, buf->char_id);
+			zoneserver_list.SendPacket(pack);
+		}
+		else
+		{
+			expedition_state.AddMember(pack);
+		}
 		break;
 	}
 	case ServerOP_ExpeditionMemberSwap:
 	{
-		auto buf = reinterpret_cast<ServerExpeditionMemberSwap_Struct*>(pack->pBuffer);
-		expedition_state.MemberChange(buf->expedition_id, buf->add_char_id, false);
-		expedition_state.MemberChange(buf->expedition_id, buf->remove_char_id, true);
-		zoneserver_list.SendPacket(pack);
+		expedition_state.AddMember(pack);
 		break;
 	}
 	case ServerOP_ExpeditionMembersRemoved:
@@ -69,9 +70,23 @@ void ExpeditionMessage::HandleZoneMessage(ServerPacket* pack)
 		zoneserver_list.SendPacket(pack);
 		break;
 	}
-	case ServerOP_ExpeditionGetOnlineMembers:
+	case ServerOP_ExpeditionLockout:
+	case ServerOP_ExpeditionLockoutDuration:
 	{
-		ExpeditionMessage::GetOnlineMembers(pack);
+		expedition_state.UpdateExpeditionLockout(pack);
+		break;
+	}
+	case ServerOP_ExpeditionLockState:
+	case ServerOP_ExpeditionReplayOnJoin:
+	{
+		expedition_state.UpdateSetting(pack);
+		break;
+	}
+	case ServerOP_ExpeditionDzCompass:
+	case ServerOP_ExpeditionDzSafeReturn:
+	case ServerOP_ExpeditionDzZoneIn:
+	{
+		expedition_state.UpdateDzLocation(pack);
 		break;
 	}
 	case ServerOP_ExpeditionDzAddPlayer:
@@ -87,13 +102,25 @@ void ExpeditionMessage::HandleZoneMessage(ServerPacket* pack)
 	case ServerOP_ExpeditionCharacterLockout:
 	{
 		auto buf = reinterpret_cast<ServerExpeditionCharacterLockout_Struct*>(pack->pBuffer);
+		expedition_state.UpdateCharacterLockout(buf);
+
 		auto cle = client_list.FindCLEByCharacterID(buf->character_id);
-		if (cle && cle->Server())
+		if (buf->update_client && cle && cle->Server())
 		{
 			cle->Server()->SendPacket(pack);
 		}
 		break;
 	}
+	case ServerOP_ExpeditionCharacterRequest:
+	{
+		expedition_state.SendCharacterInfo(pack);
+		break;
+	}
+	case ServerOP_ExpeditionZoneRequest:
+	{
+		expedition_state.SendZoneExpeditions(pack);
+		break;
+	}
 	case ServerOP_ExpeditionSaveInvite:
 	{
 		ExpeditionMessage::SaveInvite(pack);
@@ -120,7 +147,13 @@ void ExpeditionMessage::AddPlayer(ServerPacket* pack)
 	ClientListEntry* invited_cle = client_list.FindCharacter(buf->target_name);
 	if (invited_cle && invited_cle->Server())
 	{
-		// continue in the add target's zone
+		// continue in the add target's zone, which may not have the expedition cached yet
+		auto expedition = expedition_state.GetExpedition(buf->expedition_id);
+		if (expedition)
+		{
+			invited_cle->Server()->SendPacket(expedition->CreateCachePacket().get());
+		}
+
 		buf->is_char_online = true;
 		invited_cle->Server()->SendPacket(pack);
 	}
@@ -163,33 +196,6 @@ void ExpeditionMessage::MakeLeader(ServerPacket* pack)
 	}
 }
 
-void ExpeditionMessage::GetOnlineMembers(ServerPacket* pack)
-{
-	auto buf = reinterpret_cast<ServerExpeditionCharacters_Struct*>(pack->pBuffer);
-
-	// not efficient but only requested during caching
-	char zone_name[64] = {0};
-	std::vector<ClientListEntry*> all_clients;
-	all_clients.reserve(client_list.GetClientCount());
-	client_list.GetClients(zone_name, all_clients);
-
-	for (uint32_t i = 0; i < buf->count; ++i)
-	{
-		auto it = std::find_if(all_clients.begin(), all_clients.end(), [&](const ClientListEntry* cle) {
-			return (cle && cle->CharID() == buf->entries[i].character_id);
-		});
-
-		if (it != all_clients.end())
-		{
-			buf->entries[i].character_zone_id = (*it)->zone();
-			buf->entries[i].character_instance_id = (*it)->instance();
-			buf->entries[i].character_online = true;
-		}
-	}
-
-	zoneserver_list.SendPacket(buf->sender_zone_id, buf->sender_instance_id, pack);
-}
-
 void ExpeditionMessage::SaveInvite(ServerPacket* pack)
 {
 	auto buf = reinterpret_cast<ServerDzCommand_Struct*>(pack->pBuffer);
@@ -213,6 +219,13 @@ void ExpeditionMessage::RequestInvite(ServerPacket* pack)
 		auto invite_pack = cle->GetPendingExpeditionInvite();
 		if (invite_pack && cle->Server())
 		{
+			auto invite_buf = reinterpret_cast<ServerDzCommand_Struct*>(invite_pack->pBuffer);
+			auto expedition = expedition_state.GetExpedition(invite_buf->expedition_id);
+			if (expedition)
+			{
+				cle->Server()->SendPacket(expedition->CreateCachePacket().get());
+			}
+
 			cle->Server()->SendPacket(invite_pack.get());
 		}
 	}
@@ -27,7 +27,6 @@ namespace ExpeditionMessage
 {
 	void AddPlayer(ServerPacket* pack);
 	void ChooseNewLeader(ServerPacket* pack);
-	void GetOnlineMembers(ServerPacket* pack);
 	void HandleZoneMessage(ServerPacket* pack);
 	void MakeLeader(ServerPacket* pack);
 	void RequestInvite(ServerPacket* pack);
@@ -21,15 +21,77 @@
 #include "expedition_state.h"
 #include "expedition.h"
 #include "expedition_database.h"
+#include "cliententry.h"
+#include "clientlist.h"
+#include "worlddb.h"
 #include "zonelist.h"
 #include "zoneserver.h"
 #include "../common/eqemu_logsys.h"
+#include "../common/servertalk.h"
+#include "../common/string_util.h"
 #include <algorithm>
 
+extern ClientList client_list;
 extern ZSList zoneserver_list;
 
 ExpeditionState expedition_state;
 
+namespace
+{
+	ZoneServer* FindZoneServer(uint32_t zone_id, uint16_t instance_id)
+	{
+		return instance_id != 0 ? zoneserver_list.FindByInstanceID(instance_id) : zoneserver_list.FindByZoneID(zone_id);
+	}
+
+	ZoneServer* FindCharacterZoneServer(uint32_t character_id)
+	{
+		auto cle = client_list.FindCLEByCharacterID(character_id);
+		return (cle && cle->Server()) ? cle->Server() : nullptr;
+	}
+
+	uint32_t GetCharacterID(uint32_t character_id, const char* character_name)
+	{
+		// zones only know the ids of characters they hold
+		if (character_id == 0 && character_name[0] != '\0')
+		{
+			auto cle = client_list.FindCharacter(character_name);
+			character_id = cle ? cle->CharID() : database.GetCharacterID(character_name);
+		}
+		return character_id;
+	}
+
+	void SendCachePacket(const Expedition& expedition, std::vector<ZoneServer*> zone_servers)
+	{
+		zone_servers.erase(std::remove(zone_servers.begin(), zone_servers.end(), nullptr), zone_servers.end());
+		std::sort(zone_servers.begin(), zone_servers.end());
+		zone_servers.erase(std::unique(zone_servers.begin(), zone_servers.end()), zone_servers.end());
+
+		if (!zone_servers.empty())
+		{
+			auto pack = expedition.CreateCachePacket();
+			for (auto zone_server : zone_servers)
+			{
+				zone_server->SendPacket(pack.get());
+			}
+		}
+	}
+
+	ServerExpeditionConflictEntry_Struct MakeConflict(
+		uint8_t type, const std::string& character_name, const ExpeditionLockoutTimer* lockout = nullptr)
+	{
+		ServerExpeditionConflictEntry_Struct conflict{};
+		conflict.type = type;
+		strn0cpy(conflict.character_name, character_name.c_str(), sizeof(conflict.character_name));
+		if (lockout)
+		{
+			conflict.expire_time = lockout->GetExpireTime();
+			conflict.duration    = lockout->GetDuration();
+			strn0cpy(conflict.event_name, lockout->GetEventName().c_str(), sizeof(conflict.event_name));
+		}
+		return conflict;
+	}
+}
+
 Expedition* ExpeditionState::GetExpedition(uint32_t expedition_id)
 {
 	auto it = std::find_if(m_expeditions.begin(), m_expeditions.end(),
@@ -38,33 +100,346 @@ Expedition* ExpeditionState::GetExpedition(uint32_t expedition_id)
 	return (it != m_expeditions.end()) ? &(*it) : nullptr;
 }
 
+Expedition* ExpeditionState::GetExpeditionByCharacterID(uint32_t character_id)
+{
+	auto it = std::find_if(m_expeditions.begin(), m_expeditions.end(),
+		[&](const Expedition& expedition) { return expedition.HasMember(character_id); });
+
+	return (it != m_expeditions.end()) ? &(*it) : nullptr;
+}
+
 void ExpeditionState::LoadActiveExpeditions()
 {
 	BenchTimer benchmark;
 
 	m_expeditions = ExpeditionDatabase::LoadExpeditions();
+	m_character_lockouts = ExpeditionDatabase::LoadCharacterLockouts();
+
+	// world hands out ids now that zones no longer insert expeditions
+	m_next_expedition_id = ExpeditionDatabase::GetMaxExpeditionID() + 1;
+	m_next_dz_id = ExpeditionDatabase::GetMaxDynamicZoneID() + 1;
 
 	auto elapsed = benchmark.elapsed();
-	LogExpeditions("World caching [{}] expeditions took [{}s]", m_expeditions.size(), elapsed);
+	LogExpeditions(
+		"World caching [{}] expeditions and lockouts for [{}] characters took [{}s]",
+		m_expeditions.size(), m_character_lockouts.size(), elapsed
+	);
 }
 
-void ExpeditionState::AddExpedition(uint32_t expedition_id)
+void ExpeditionState::CreateExpedition(ServerPacket* pack)
 {
-	if (expedition_id == 0)
+	auto buf = reinterpret_cast<ServerExpeditionCreateRequest_Struct*>(pack->pBuffer);
+	if (pack->size < sizeof(ServerExpeditionCreateRequest_Struct) ||
+	    pack->size < sizeof(ServerExpeditionCreateRequest_Struct) + buf->member_count * sizeof(ServerExpeditionMemberEntry_Struct))
 	{
 		return;
 	}
 
-	auto expedition = ExpeditionDatabase::LoadExpedition(expedition_id);
+	BenchTimer benchmark;
+
+	std::string expedition_name = buf->expedition_name;
+	uint32_t leader_id = GetCharacterID(buf->leader_id, buf->leader_name);
+	bool is_solo = (buf->member_count == 1);
+
+	// leader's lockouts are used to check member conflicts and later stored in expedition
+	std::unordered_map<std::string, ExpeditionLockoutTimer> leader_lockouts;
+	bool check_event_lockouts = true;
 
-	if (expedition.IsValid())
+	auto leader_it = m_character_lockouts.find(leader_id);
+	if (leader_it != m_character_lockouts.end())
 	{
-		auto existing_expedition = GetExpedition(expedition_id);
-		if (!existing_expedition)
+		for (const auto& lockout : leader_it->second)
 		{
-			m_expeditions.emplace_back(expedition);
+			if (lockout.GetExpeditionName() == expedition_name && !lockout.IsExpired())
+			{
+				leader_lockouts.emplace(lockout.GetEventName(), lockout);
+
+				// on live if leader has a replay lockout it never bothers checking for event conflicts
+				if (lockout.IsReplayTimer())
+				{
+					check_event_lockouts = false;
+				}
+			}
 		}
 	}
+
+	std::vector<ExpeditionMember> members;
+	std::vector<ServerExpeditionConflictEntry_Struct> conflicts;
+
+	for (uint32_t i = 0; i < buf->member_count; ++i)
+	{
+		std::string character_name = buf->members[i].name;
+		uint32_t character_id = GetCharacterID(buf->members[i].char_id, buf->members[i].name);
+		if (character_id == 0)
+		{
+			continue;
+		}
+
+		members.emplace_back(character_id, character_name);
+
+		if (GetExpeditionByCharacterID(character_id))
+		{
+			conflicts.emplace_back(MakeConflict(0, character_name));
+
+			// solo requests break out early if requester in an expedition
+			if (is_solo)
+			{
+				break;
+			}
+		}
+
+		auto it = m_character_lockouts.find(character_id);
+		if (it == m_character_lockouts.end())
+		{
+			continue;
+		}
+
+		// event conflicts are queued so they're reported after this member's replay conflicts
+		std::vector<ServerExpeditionConflictEntry_Struct> event_conflicts;
+		for (const auto& lockout : it->second)
+		{
+			if (lockout.GetExpeditionName() != expedition_name || lockout.IsExpired())
+			{
+				continue;
+			}
+
+			if (lockout.IsReplayTimer())
+			{
+				conflicts.emplace_back(MakeConflict(1, character_name, &lockout));
+			}
+			else if (check_event_lockouts && character_id != leader_id &&
+			         leader_lockouts.find(lockout.GetEventName()) == leader_lockouts.end())
+			{
+				event_conflicts.emplace_back(MakeConflict(2, character_name, &lockout));
+			}
+		}
+		conflicts.insert(conflicts.end(), event_conflicts.begin(), event_conflicts.end());
+	}
+
+	// live only checks player count requirement after other expensive checks pass
+	if (conflicts.empty())
+	{
+		if (members.size() > buf->max_players)
+		{
+			// members were sorted by the zone, truncate after conflict checks to act like live
+			members.resize(buf->max_players);
+		}
+		else if (!buf->gm_bypass && members.size() < buf->min_players)
+		{
+			conflicts.emplace_back(MakeConflict(3, buf->leader_name));
+		}
+	}
+
+	ServerDzInfo_Struct dz = buf->dz;
+	if (conflicts.empty() && !ExpeditionDatabase::CreateInstance(dz))
+	{
+		conflicts.emplace_back(MakeConflict(4, buf->leader_name));
+	}
+
+	if (!conflicts.empty())
+	{
+		LogExpeditionsModerate("[{}] request by [{}] denied", expedition_name, buf->requester_name);
+
+		uint32_t pack_size = sizeof(ServerExpeditionCreateRejected_Struct) +
+			static_cast<uint32_t>(conflicts.size()) * sizeof(ServerExpeditionConflictEntry_Struct);
+		auto reply = std::unique_ptr<ServerPacket>(new ServerPacket(ServerOP_ExpeditionCreateRejected, pack_size));
+		auto reply_buf = reinterpret_cast<ServerExpeditionCreateRejected_Struct*>(reply->pBuffer);
+		strn0cpy(reply_buf->uuid, buf->uuid, sizeof(reply_buf->uuid));
+		strn0cpy(reply_buf->requester_name, buf->requester_name, sizeof(reply_buf->requester_name));
+		strn0cpy(reply_buf->leader_name, buf->leader_name, sizeof(reply_buf->leader_name));
+		reply_buf->disable_messages = buf->disable_messages;
+		reply_buf->is_solo          = is_solo;
+		reply_buf->member_count     = static_cast<uint32_t>(members.size());
+		reply_buf->min_players      = buf->min_players;
+		reply_buf->max_players      = buf->max_players;
+		reply_buf->conflict_count   = static_cast<uint32_t>(conflicts.size());
+		std::copy(conflicts.begin(), conflicts.end(), reply_buf->conflicts);
+
+		zoneserver_list.SendPacket(buf->sender_zone_id, buf->sender_instance_id, reply.get());
+		return;
+	}
+
+	dz.dz_id = m_next_dz_id++;
+
+	Expedition expedition{
+		m_next_expedition_id++, buf->uuid, expedition_name, leader_id, buf->min_players, buf->max_players, dz
+	};
+	expedition.SetLocked(buf->is_locked != 0);
+	expedition.SetReplayLockoutOnMemberJoin(buf->add_replay_on_join != 0);
+	for (const auto& member : members)
+	{
+		expedition.AddMember(member.char_id, member.name);
+	}
+	for (const auto& lockout : leader_lockouts)
+	{
+		expedition.UpdateLockout(lockout.second, false, false);
+	}
+
+	ExpeditionDatabase::InsertDynamicZone(dz);
+	ExpeditionDatabase::InsertExpedition(expedition);
+	ExpeditionDatabase::InsertLockouts(expedition.GetID(), expedition.GetLockouts());
+	ExpeditionDatabase::InsertMembers(expedition.GetID(), expedition.GetInstanceID(), expedition.GetMembers());
+
+	m_expeditions.emplace_back(expedition);
+
+	LogExpeditions(
+		"Created [{}] [{}] instance id: [{}] leader: [{}] members: [{}] took [{}s]",
+		expedition.GetID(), expedition.GetName(), expedition.GetInstanceID(), leader_id,
+		members.size(), benchmark.elapsed()
+	);
+
+	// only the requesting zone, the member zones and the dz cache the new expedition
+	std::vector<ZoneServer*> zone_servers;
+	zone_servers.emplace_back(FindZoneServer(buf->sender_zone_id, buf->sender_instance_id));
+	zone_servers.emplace_back(zoneserver_list.FindByInstanceID(expedition.GetInstanceID()));
+	for (const auto& member : members)
+	{
+		zone_servers.emplace_back(FindCharacterZoneServer(member.char_id));
+	}
+
+	SendCachePacket(m_expeditions.back(), zone_servers);
+}
+
+void ExpeditionState::AddMember(ServerPacket* pack)
+{
+	uint32_t expedition_id  = 0;
+	uint32_t sender_zone_id = 0;
+	uint16_t sender_instance_id = 0;
+	uint32_t add_char_id    = 0;
+	uint32_t remove_char_id = 0;
+	bool from_invite        = true;
+	std::string add_char_name;
+
+	if (pack->opcode == ServerOP_ExpeditionMemberSwap)
+	{
+		auto buf = reinterpret_cast<ServerExpeditionMemberSwap_Struct*>(pack->pBuffer);
+		expedition_id      = buf->expedition_id;
+		sender_zone_id     = buf->sender_zone_id;
+		sender_instance_id = buf->sender_instance_id;
+		add_char_id        = buf->add_char_id;
+		add_char_name      = buf->add_char_name;
+		remove_char_id     = buf->remove_char_id;
+	}
+	else
+	{
+		auto buf = reinterpret_cast<ServerExpeditionMemberChange_Struct*>(pack->pBuffer);
+		expedition_id      = buf->expedition_id;
+		sender_zone_id     = buf->sender_zone_id;
+		sender_instance_id = buf->sender_instance_id;
+		add_char_id        = buf->char_id;
+		add_char_name      = buf->char_name;
+		from_invite        = (buf->from_invite != 0);
+	}
+
+	auto expedition = GetExpedition(expedition_id);
+	if (!expedition)
+	{
+		return;
+	}
+
+	// zones check these against their cache first but only world can see every change.
+	// quest api adds ignore the lock state and max players like they always have
+	int reason = -1;
+	if (from_invite && expedition->IsLocked())
+	{
+		reason = 0;
+	}
+	else if (from_invite && remove_char_id == 0 && expedition->GetMembers().size() >= expedition->GetMaxPlayers())
+	{
+		reason = 1;
+	}
+	else if (GetExpeditionByCharacterID(add_char_id))
+	{
+		reason = 2;
+	}
+	else if (remove_char_id != 0 && !expedition->HasMember(remove_char_id))
+	{
+		reason = 3;
+	}
+
+	if (reason != -1)
+	{
+		LogExpeditionsModerate("Rejected adding [{}] to expedition [{}] reason [{}]", add_char_name, expedition_id, reason);
+		if (!from_invite)
+		{
+			return;
+		}
+
+		uint32_t pack_size = sizeof(ServerExpeditionAddRejected_Struct);
+		auto reply = std::unique_ptr<ServerPacket>(new ServerPacket(ServerOP_ExpeditionAddRejected, pack_size));
+		auto reply_buf = reinterpret_cast<ServerExpeditionAddRejected_Struct*>(reply->pBuffer);
+		reply_buf->expedition_id = expedition_id;
+		reply_buf->reason = static_cast<uint8_t>(reason);
+		strn0cpy(reply_buf->char_name, add_char_name.c_str(), sizeof(reply_buf->char_name));
+		zoneserver_list.SendPacket(sender_zone_id, sender_instance_id, reply.get());
+		return;
+	}
+
+	if (remove_char_id != 0)
+	{
+		expedition->RemoveMember(remove_char_id);
+		ExpeditionDatabase::DeleteMember(expedition_id, expedition->GetInstanceID(), remove_char_id);
+	}
+
+	expedition->AddMember(add_char_id, add_char_name);
+	ExpeditionDatabase::InsertMembers(expedition_id, expedition->GetInstanceID(), { ExpeditionMember{ add_char_id, add_char_name } });
+
+	if (expedition->IsAddingReplayOnJoin())
+	{
+		AddReplayLockoutOnJoin(expedition, add_char_id);
+	}
+
+	// quest api adds may target characters in zones that don't have it cached
+	auto add_zone_server = FindCharacterZoneServer(add_char_id);
+	if (add_zone_server && add_zone_server != FindZoneServer(sender_zone_id, sender_instance_id))
+	{
+		SendCachePacket(*expedition, { add_zone_server });
+	}
+
+	// the sending zone processes the add from this relay once world accepts it
+	zoneserver_list.SendPacket(pack);
+}
+
+void ExpeditionState::AddReplayLockoutOnJoin(Expedition* expedition, uint32_t character_id)
+{
+	// replay timers are optionally added to new members on join with fresh expire time
+	auto replay_it = expedition->GetLockouts().find(DZ_REPLAY_TIMER_NAME);
+	if (replay_it == expedition->GetLockouts().end() || !replay_it->second.IsFromExpedition(expedition->GetUUID()))
+	{
+		return;
+	}
+
+	auto it = m_character_lockouts.find(character_id);
+	if (it != m_character_lockouts.end() &&
+	    std::any_of(it->second.begin(), it->second.end(), [&](const ExpeditionLockoutTimer& lockout) {
+	        return !lockout.IsExpired() && lockout.IsSameLockout(replay_it->second);
+	    }))
+	{
+		return;
+	}
+
+	ExpeditionLockoutTimer replay_timer = replay_it->second; // copy
+	replay_timer.Reset();
+
+	AddCharacterLockout(character_id, replay_timer);
+	ExpeditionDatabase::InsertCharacterLockouts(character_id, { replay_timer });
+
+	auto zone_server = FindCharacterZoneServer(character_id);
+	if (zone_server)
+	{
+		uint32_t pack_size = sizeof(ServerExpeditionCharacterLockout_Struct);
+		auto pack = std::unique_ptr<ServerPacket>(new ServerPacket(ServerOP_ExpeditionCharacterLockout, pack_size));
+		auto buf = reinterpret_cast<ServerExpeditionCharacterLockout_Struct*>(pack->pBuffer);
+		buf->remove        = false;
+		buf->update_client = true;
+		buf->character_id  = character_id;
+		buf->expire_time   = replay_timer.GetExpireTime();
+		buf->duration      = replay_timer.GetDuration();
+		strn0cpy(buf->uuid, replay_timer.GetExpeditionUUID().c_str(), sizeof(buf->uuid));
+		strn0cpy(buf->expedition_name, replay_timer.GetExpeditionName().c_str(), sizeof(buf->expedition_name));
+		strn0cpy(buf->event_name, replay_timer.GetEventName().c_str(), sizeof(buf->event_name));
+		zone_server->SendPacket(pack.get());
+	}
 }
 
 void ExpeditionState::RemoveExpedition(uint32_t expedition_id)
@@ -76,16 +451,13 @@ void ExpeditionState::RemoveExpedition(uint32_t expedition_id)
 	), m_expeditions.end());
 }
 
-void ExpeditionState::MemberChange(uint32_t expedition_id, uint32_t character_id, bool remove)
+void ExpeditionState::MemberRemoved(uint32_t expedition_id, uint32_t character_id)
 {
 	auto expedition = GetExpedition(expedition_id);
-	if (expedition)
+	if (expedition && expedition->HasMember(character_id))
 	{
-		if (remove) {
-			expedition->RemoveMember(character_id);
-		} else {
-			expedition->AddMember(character_id);
-		}
+		expedition->RemoveMember(character_id);
+		ExpeditionDatabase::DeleteMember(expedition_id, expedition->GetInstanceID(), character_id);
 	}
 }
 
@@ -95,6 +467,7 @@ void ExpeditionState::RemoveAllMembers(uint32_t expedition_id)
 	if (expedition)
 	{
 		expedition->RemoveAllMembers();
+		ExpeditionDatabase::DeleteAllMembers(expedition_id, expedition->GetInstanceID());
 	}
 }
 
@@ -107,13 +480,294 @@ void ExpeditionState::SetSecondsRemaining(uint32_t expedition_id, uint32_t secon
 	}
 }
 
+void ExpeditionState::UpdateExpeditionLockout(ServerPacket* pack)
+{
+	auto buf = reinterpret_cast<ServerExpeditionLockout_Struct*>(pack->pBuffer);
+	auto expedition = GetExpedition(buf->expedition_id);
+	if (expedition)
+	{
+		ExpeditionLockoutTimer lockout{
+			expedition->GetUUID(), expedition->GetName(), buf->event_name, buf->expire_time, buf->duration
+		};
+
+		std::vector<uint32_t> member_ids;
+		for (const auto& member : expedition->GetMembers())
+		{
+			member_ids.emplace_back(member.char_id);
+		}
+
+		if (pack->opcode == ServerOP_ExpeditionLockout)
+		{
+			if (!buf->members_only)
+			{
+				expedition->UpdateLockout(lockout, buf->remove);
+			}
+
+			for (const auto& member_id : member_ids)
+			{
+				if (buf->remove)
+				{
+					RemoveCharacterLockouts(member_id, lockout.GetExpeditionName(), lockout.GetEventName());
+				}
+				else
+				{
+					AddCharacterLockout(member_id, lockout);
+				}
+			}
+
+			if (buf->remove)
+			{
+				ExpeditionDatabase::DeleteMembersLockout(member_ids, lockout.GetExpeditionName(), lockout.GetEventName());
+			}
+			else
+			{
+				ExpeditionDatabase::InsertMembersLockout(member_ids, lockout);
+			}
+		}
+		else if (pack->opcode == ServerOP_ExpeditionLockoutDuration)
+		{
+			if (!buf->members_only)
+			{
+				expedition->UpdateLockoutDuration(lockout, buf->seconds_adjust);
+			}
+
+			// same as Client::AddExpeditionLockoutDuration so stored and client timers agree
+			for (const auto& member_id : member_ids)
+			{
+				auto& lockouts = m_character_lockouts[member_id];
+				auto it = std::find_if(lockouts.begin(), lockouts.end(),
+					[&](const ExpeditionLockoutTimer& member_lockout) { return member_lockout.IsSameLockout(lockout); });
+
+				if (it != lockouts.end())
+				{
+					it->AddLockoutTime(buf->seconds_adjust);
+					it->SetUUID(lockout.GetExpeditionUUID());
+					ExpeditionDatabase::InsertCharacterLockouts(member_id, { *it });
+				}
+				else if (buf->seconds_adjust > 0)
+				{
+					lockouts.emplace_back(lockout);
+					ExpeditionDatabase::InsertCharacterLockouts(member_id, { lockout });
+				}
+			}
+		}
+	}
+
+	zoneserver_list.SendPacket(pack);
+}
+
+void ExpeditionState::UpdateSetting(ServerPacket* pack)
+{
+	if (pack->opcode == ServerOP_ExpeditionLockState)
+	{
+		auto buf = reinterpret_cast<ServerExpeditionLockState_Struct*>(pack->pBuffer);
+		auto expedition = GetExpedition(buf->expedition_id);
+		if (expedition)
+		{
+			expedition->SetLocked(buf->enabled != 0);
+			ExpeditionDatabase::UpdateLockState(buf->expedition_id, buf->enabled != 0);
+		}
+	}
+	else if (pack->opcode == ServerOP_ExpeditionReplayOnJoin)
+	{
+		auto buf = reinterpret_cast<ServerExpeditionSetting_Struct*>(pack->pBuffer);
+		auto expedition = GetExpedition(buf->expedition_id);
+		if (expedition)
+		{
+			expedition->SetReplayLockoutOnMemberJoin(buf->enabled != 0);
+			ExpeditionDatabase::UpdateReplayLockoutOnJoin(buf->expedition_id, buf->enabled != 0);
+		}
+	}
+
+	zoneserver_list.SendPacket(pack);
+}
+
+void ExpeditionState::UpdateDzLocation(ServerPacket* pack)
+{
+	auto buf = reinterpret_cast<ServerDzLocation_Struct*>(pack->pBuffer);
+	auto expedition = GetExpedition(buf->owner_id);
+	if (expedition)
+	{
+		expedition->UpdateDzLocation(pack->opcode, *buf);
+	}
+
+	zoneserver_list.SendPacket(pack);
+}
+
+void ExpeditionState::AddCharacterLockout(uint32_t character_id, const ExpeditionLockoutTimer& lockout)
+{
+	// replaces any existing lockout for the same event
+	auto& lockouts = m_character_lockouts[character_id];
+	lockouts.erase(std::remove_if(lockouts.begin(), lockouts.end(),
+		[&](const ExpeditionLockoutTimer& existing) { return existing.IsSameLockout(lockout); }
+	), lockouts.end());
+
+	lockouts.emplace_back(lockout);
+}
+
+void ExpeditionState::RemoveCharacterLockouts(
+	uint32_t character_id, const std::string& expedition_name, const std::string& event_name)
+{
+	auto it = m_character_lockouts.find(character_id);
+	if (it == m_character_lockouts.end())
+	{
+		return;
+	}
+
+	// an empty event removes all lockouts of the expedition, an empty expedition removes all
+	it->second.erase(std::remove_if(it->second.begin(), it->second.end(),
+		[&](const ExpeditionLockoutTimer& lockout) {
+			return expedition_name.empty() ||
+			       (lockout.GetExpeditionName() == expedition_name &&
+			       (event_name.empty() || lockout.GetEventName() == event_name));
+		}
+	), it->second.end());
+
+	if (it->second.empty())
+	{
+		m_character_lockouts.erase(it);
+	}
+}
+
+void ExpeditionState::UpdateCharacterLockout(const ServerExpeditionCharacterLockout_Struct* buf)
+{
+	if (!buf->remove)
+	{
+		ExpeditionLockoutTimer lockout{
+			buf->uuid, buf->expedition_name, buf->event_name, buf->expire_time, buf->duration
+		};
+		AddCharacterLockout(buf->character_id, lockout);
+		ExpeditionDatabase::InsertCharacterLockouts(buf->character_id, { lockout });
+		return;
+	}
+
+	RemoveCharacterLockouts(buf->character_id, buf->expedition_name, buf->event_name);
+
+	if (buf->event_name[0] != '\0')
+	{
+		ExpeditionDatabase::DeleteCharacterLockout(buf->character_id, buf->expedition_name, buf->event_name);
+	}
+	else if (buf->expedition_name[0] != '\0')
+	{
+		ExpeditionDatabase::DeleteAllCharacterLockouts(buf->character_id, buf->expedition_name);
+	}
+	else
+	{
+		ExpeditionDatabase::DeleteAllCharacterLockouts(buf->character_id);
+	}
+}
+
+void ExpeditionState::PruneExpiredCharacterLockouts()
+{
+	for (auto it = m_character_lockouts.begin(); it != m_character_lockouts.end();)
+	{
+		it->second.erase(std::remove_if(it->second.begin(), it->second.end(),
+			[](const ExpeditionLockoutTimer& lockout) { return lockout.IsExpired(); }
+		), it->second.end());
+
+		it = it->second.empty() ? m_character_lockouts.erase(it) : std::next(it);
+	}
+}
+
+void ExpeditionState::SendCharacterInfo(ServerPacket* pack)
+{
+	auto buf = reinterpret_cast<ServerExpeditionCharacterRequest_Struct*>(pack->pBuffer);
+	auto zone_server = FindZoneServer(buf->sender_zone_id, buf->sender_instance_id);
+	SendCharacterInfo(zone_server, buf->character_id, buf->cached_expedition_id);
+}
+
+void ExpeditionState::SendCharacterInfo(ZoneServer* zone_server, uint32_t character_id, uint32_t cached_expedition_id)
+{
+	if (!zone_server)
+	{
+		return;
+	}
+
+	// the expedition is sent first so the zone has it cached when it processes the reply
+	auto expedition = GetExpeditionByCharacterID(character_id);
+	if (expedition && expedition->GetID() != cached_expedition_id)
+	{
+		zone_server->SendPacket(expedition->CreateCachePacket().get());
+	}
+
+	std::vector<const ExpeditionLockoutTimer*> lockouts;
+	auto it = m_character_lockouts.find(character_id);
+	if (it != m_character_lockouts.end())
+	{
+		for (const auto& lockout : it->second)
+		{
+			if (!lockout.IsExpired())
+			{
+				lockouts.emplace_back(&lockout);
+			}
+		}
+	}
+
+	uint32_t pack_size = sizeof(ServerExpeditionCharacterInfo_Struct) +
+		static_cast<uint32_t>(lockouts.size()) * sizeof(ServerExpeditionCharacterLockoutEntry_Struct);
+	auto reply = std::unique_ptr<ServerPacket>(new ServerPacket(ServerOP_ExpeditionCharacterInfo, pack_size));
+	auto reply_buf = reinterpret_cast<ServerExpeditionCharacterInfo_Struct*>(reply->pBuffer);
+	reply_buf->character_id  = character_id;
+	reply_buf->expedition_id = expedition ? expedition->GetID() : 0;
+	reply_buf->lockout_count = static_cast<uint32_t>(lockouts.size());
+
+	for (size_t i = 0; i < lockouts.size(); ++i)
+	{
+		auto& entry = reply_buf->entries[i];
+		entry.expire_time = lockouts[i]->GetExpireTime();
+		entry.duration    = lockouts[i]->GetDuration();
+		strn0cpy(entry.uuid, lockouts[i]->GetExpeditionUUID().c_str(), sizeof(entry.uuid));
+		strn0cpy(entry.expedition_name, lockouts[i]->GetExpeditionName().c_str(), sizeof(entry.expedition_name));
+		strn0cpy(entry.event_name, lockouts[i]->GetEventName().c_str(), sizeof(entry.event_name));
+	}
+
+	zone_server->SendPacket(reply.get());
+}
+
+void ExpeditionState::SendZoneExpeditions(ServerPacket* pack)
+{
+	auto buf = reinterpret_cast<ServerExpeditionZoneRequest_Struct*>(pack->pBuffer);
+	if (pack->size < sizeof(ServerExpeditionZoneRequest_Struct) + buf->count * sizeof(uint32_t))
+	{
+		return;
+	}
+
+	auto zone_server = FindZoneServer(buf->sender_zone_id, buf->sender_instance_id);
+	if (!zone_server)
+	{
+		return;
+	}
+
+	uint32_t count = 0;
+	for (const auto& expedition : m_expeditions)
+	{
+		bool is_needed = (buf->sender_instance_id != 0 && expedition.GetInstanceID() == buf->sender_instance_id);
+		for (uint32_t i = 0; !is_needed && i < buf->count; ++i)
+		{
+			is_needed = expedition.HasMember(buf->character_ids[i]);
+		}
+
+		if (is_needed)
+		{
+			zone_server->SendPacket(expedition.CreateCachePacket().get());
+			++count;
+		}
+	}
+
+	LogExpeditionsModerate("Sent [{}] expeditions to zone [{}]:[{}]", count, buf->sender_zone_id, buf->sender_instance_id);
+}
+
 void ExpeditionState::Process()
 {
+	ExpeditionDatabase::ProcessPendingWrites();
+
 	if (!m_process_throttle_timer.Check())
 	{
 		return;
 	}
 
+	PruneExpiredCharacterLockouts();
+
 	std::vector<uint32_t> expedition_ids;
 
 	for (auto it = m_expeditions.begin(); it != m_expeditions.end();)
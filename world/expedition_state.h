@@ -21,29 +21,54 @@
 #ifndef WORLD_EXPEDITION_STATE_H
 #define WORLD_EXPEDITION_STATE_H
 
+#include "../common/expedition_lockout_timer.h"
 #include "../common/rulesys.h"
 #include "../common/timer.h"
 #include <cstdint>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 extern class ExpeditionState expedition_state;
 
 class Expedition;
+class ServerPacket;
+class ZoneServer;
+struct ServerExpeditionCharacterLockout_Struct;
 
+// world owns expedition membership and lockouts. zones ask world to create and
+// add to expeditions and are sent the state of the expeditions they need
 class ExpeditionState
 {
 public:
-	void AddExpedition(uint32_t expedition_id);
+	void AddMember(ServerPacket* pack);
+	void CreateExpedition(ServerPacket* pack);
 	Expedition* GetExpedition(uint32_t expedition_id);
+	Expedition* GetExpeditionByCharacterID(uint32_t character_id);
 	void LoadActiveExpeditions();
-	void MemberChange(uint32_t expedition_id, uint32_t character_id, bool remove);
+	void MemberRemoved(uint32_t expedition_id, uint32_t character_id);
 	void Process();
 	void RemoveAllMembers(uint32_t expedition_id);
 	void RemoveExpedition(uint32_t expedition_id);
+	void SendCharacterInfo(ServerPacket* pack);
+	void SendCharacterInfo(ZoneServer* zone_server, uint32_t character_id, uint32_t cached_expedition_id = 0);
+	void SendZoneExpeditions(ServerPacket* pack);
 	void SetSecondsRemaining(uint32_t expedition_id, uint32_t seconds_remaining);
+	void UpdateCharacterLockout(const ServerExpeditionCharacterLockout_Struct* buf);
+	void UpdateDzLocation(ServerPacket* pack);
+	void UpdateExpeditionLockout(ServerPacket* pack);
+	void UpdateSetting(ServerPacket* pack);
 
 private:
+	void AddCharacterLockout(uint32_t character_id, const ExpeditionLockoutTimer& lockout);
+	void AddReplayLockoutOnJoin(Expedition* expedition, uint32_t character_id);
+	void PruneExpiredCharacterLockouts();
+	void RemoveCharacterLockouts(uint32_t character_id, const std::string& expedition_name, const std::string& event_name);
+
+	uint32_t m_next_expedition_id = 0;
+	uint32_t m_next_dz_id         = 0;
 	std::vector<Expedition> m_expeditions;
+	std::unordered_map<uint32_t, std::vector<ExpeditionLockoutTimer>> m_character_lockouts;
 	Timer m_process_throttle_timer{static_cast<uint32_t>(RuleI(Expedition, WorldExpeditionProcessRateMS))};
 };
 
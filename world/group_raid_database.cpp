@@ -0,0 +1,165 @@
+/**
+ * EQEmulator: Everquest Server Emulator
+ * Copyright (C) 2001-2020 EQEmulator Development Team (https://github.com/EQEmu/Server)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 2 of the License.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY except by those people which sell it, which
+ * are required to give you total support for your newly bought product;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ */
+
+#include "group_raid_database.h"
+#include "group_raid_state.h"
+#include "worlddb.h"
+#include "../common/eqemu_logsys.h"
+#include "../common/rulesys.h"
+#include "../common/string_util.h"
+#include "../common/timer.h"
+#include <fmt/core.h>
+#include <vector>
+
+namespace
+{
+	std::vector<std::string> pending_writes;
+	Timer flush_timer;
+
+	void QueueWrite(std::string query)
+	{
+		pending_writes.emplace_back(std::move(query));
+
+		if (RuleI(World, GroupRaidWriteBehindMS) <= 0)
+		{
+			GroupRaidDatabase::FlushPendingWrites();
+		}
+		else if (!flush_timer.Enabled())
+		{
+			flush_timer.Start(RuleI(World, GroupRaidWriteBehindMS));
+		}
+	}
+}
+
+void GroupRaidDatabase::FlushPendingWrites()
+{
+	flush_timer.Disable();
+
+	if (pending_writes.empty())
+	{
+		return;
+	}
+
+	LogGroupDetail("Writing [{}] queued group and raid roster changes", pending_writes.size());
+
+	// swapped out first since a failed query shouldn't be retried forever
+	std::vector<std::string> queries;
+	queries.swap(pending_writes);
+
+	database.TransactionBegin();
+	for (const auto& query : queries)
+	{
+		auto results = database.QueryDatabase(query);
+		if (!results.Success())
+		{
+			LogGroup("Failed to write queued roster change: [{}]", results.ErrorMessage());
+		}
+	}
+	database.TransactionCommit();
+}
+
+void GroupRaidDatabase::ProcessPendingWrites()
+{
+	if (flush_timer.Enabled() && flush_timer.Check())
+	{
+		FlushPendingWrites();
+	}
+}
+
+void GroupRaidDatabase::InsertGroupMember(
+	uint32_t group_id, const std::string& name, uint32_t character_id, bool is_merc)
+{
+	QueueWrite(fmt::format(SQL(
+		REPLACE INTO group_id (charid, groupid, name, ismerc) VALUES ({}, {}, '{}', {});
+	), character_id, group_id, EscapeString(name), is_merc));
+}
+
+void GroupRaidDatabase::DeleteGroupMember(const std::string& name, uint32_t character_id, bool is_merc)
+{
+	QueueWrite(fmt::format(SQL(
+		DELETE FROM group_id WHERE charid = {} AND name = '{}' AND ismerc = {};
+	), character_id, EscapeString(name), is_merc));
+}
+
+void GroupRaidDatabase::DeleteGroup(uint32_t group_id)
+{
+	QueueWrite(fmt::format(SQL(
+		DELETE FROM group_id WHERE groupid = {};
+	), group_id));
+}
+
+void GroupRaidDatabase::InsertRaidMember(uint32_t raid_id, const RaidRosterMember& member)
+{
+	QueueWrite(fmt::format(SQL(
+		INSERT INTO raid_members
+			(raidid, charid, groupid, _class, level, name, isgroupleader, israidleader, islooter)
+		VALUES ({}, {}, {}, {}, {}, '{}', {}, {}, {});
+	), raid_id, member.char_id, member.raid_group, member.class_id, member.level,
+		EscapeString(member.name), member.is_group_leader, member.is_raid_leader, member.is_looter));
+}
+
+void GroupRaidDatabase::DeleteRaidMember(const std::string& name)
+{
+	QueueWrite(fmt::format(SQL(
+		DELETE FROM raid_members WHERE name = '{}';
+	), EscapeString(name)));
+}
+
+void GroupRaidDatabase::DeleteRaid(uint32_t raid_id)
+{
+	QueueWrite(fmt::format(SQL(
+		DELETE FROM raid_members WHERE raidid = {};
+	), raid_id));
+}
+
+void GroupRaidDatabase::UpdateRaidMemberGroup(const std::string& name, uint32_t raid_group)
+{
+	QueueWrite(fmt::format(SQL(
+		UPDATE raid_members SET groupid = {} WHERE name = '{}';
+	), raid_group, EscapeString(name)));
+}
+
+void GroupRaidDatabase::UpdateRaidGroupLeader(const std::string& name, bool is_group_leader)
+{
+	QueueWrite(fmt::format(SQL(
+		UPDATE raid_members SET isgroupleader = {} WHERE name = '{}';
+	), is_group_leader, EscapeString(name)));
+}
+
+void GroupRaidDatabase::UpdateRaidLeader(uint32_t raid_id, const std::string& leader_name)
+{
+	QueueWrite(fmt::format(SQL(
+		UPDATE raid_members SET israidleader = (name = '{}') WHERE raidid = {};
+	), EscapeString(leader_name), raid_id));
+}
+
+void GroupRaidDatabase::UpdateRaidLooter(const std::string& name, bool is_looter)
+{
+	QueueWrite(fmt::format(SQL(
+		UPDATE raid_members SET islooter = {} WHERE name = '{}';
+	), is_looter, EscapeString(name)));
+}
+
+void GroupRaidDatabase::UpdateRaidMemberLevel(const std::string& name, uint8_t level)
+{
+	QueueWrite(fmt::format(SQL(
+		UPDATE raid_members SET level = {} WHERE name = '{}';
+	), level, EscapeString(name)));
+}
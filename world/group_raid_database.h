@@ -0,0 +1,50 @@
+/**
+ * EQEmulator: Everquest Server Emulator
+ * Copyright (C) 2001-2020 EQEmulator Development Team (https://github.com/EQEmu/Server)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 2 of the License.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY except by those people which sell it, which
+ * are required to give you total support for your newly bought product;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ */
+
+#ifndef WORLD_GROUP_RAID_DATABASE_H
+#define WORLD_GROUP_RAID_DATABASE_H
+
+#include <cstdint>
+#include <string>
+
+struct RaidRosterMember;
+
+// group_id and raid_members mirror the rosters world holds in memory. writes are
+// queued and flushed in one transaction every World:GroupRaidWriteBehindMS
+namespace GroupRaidDatabase
+{
+	void FlushPendingWrites();
+	void ProcessPendingWrites();
+
+	void InsertGroupMember(uint32_t group_id, const std::string& name, uint32_t character_id, bool is_merc);
+	void DeleteGroupMember(const std::string& name, uint32_t character_id, bool is_merc);
+	void DeleteGroup(uint32_t group_id);
+
+	void InsertRaidMember(uint32_t raid_id, const RaidRosterMember& member);
+	void DeleteRaidMember(const std::string& name);
+	void DeleteRaid(uint32_t raid_id);
+	void UpdateRaidMemberGroup(const std::string& name, uint32_t raid_group);
+	void UpdateRaidGroupLeader(const std::string& name, bool is_group_leader);
+	void UpdateRaidLeader(uint32_t raid_id, const std::string& leader_name);
+	void UpdateRaidLooter(const std::string& name, bool is_looter);
+	void UpdateRaidMemberLevel(const std::string& name, uint8_t level);
+};
+
+#endif
@@ -0,0 +1,466 @@
+/**
+ * EQEmulator: Everquest Server Emulator
+ * Copyright (C) 2001-2020 EQEmulator Development Team (https://github.com/EQEmu/Server)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 2 of the License.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY except by those people which sell it, which
+ * are required to give you total support for your newly bought product;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ */
+
+#include "group_raid_state.h"
+#include "group_raid_database.h"
+#include "cliententry.h"
+#include "clientlist.h"
+#include "zonelist.h"
+#include "zoneserver.h"
+#include "../common/eqemu_logsys.h"
+#include "../common/servertalk.h"
+#include "../common/string_util.h"
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
+extern ClientList client_list;
+extern ZSList zoneserver_list;
+
+GroupRaidState group_raid_state;
+
+void GroupRaidState::Process()
+{
+	GroupRaidDatabase::ProcessPendingWrites();
+}
+
+uint32_t GroupRaidState::GetGroupID(const std::string& name) const
+{
+	auto it = m_group_ids.find(name);
+	return it != m_group_ids.end() ? it->second : 0;
+}
+
+void GroupRaidState::GetMemberZones(uint32_t zone_id, uint16_t instance_id, std::set<ZoneServer*>& into) const
+{
+	if (zone_id == 0)
+	{
+		return;
+	}
+
+	ZoneServer* zone_server = instance_id != 0 ?
+		zoneserver_list.FindByInstanceID(instance_id) : zoneserver_list.FindByZoneID(zone_id);
+
+	if (zone_server)
+	{
+		into.insert(zone_server);
+	}
+}
+
+void GroupRaidState::SendToZones(const std::set<ZoneServer*>& zones, ServerPacket* pack) const
+{
+	for (auto zone_server : zones)
+	{
+		zone_server->SendPacket(pack);
+	}
+}
+
+void GroupRaidState::SendToGroupZones(uint32_t group_id, ServerPacket* pack)
+{
+	auto group = m_groups.find(group_id);
+	if (group == m_groups.end())
+	{
+		// not a group world knows about, leave it to every zone as before
+		zoneserver_list.SendPacket(pack);
+		return;
+	}
+
+	std::set<ZoneServer*> zones;
+	for (const auto& member : group->second)
+	{
+		GetMemberZones(member.zone_id, member.instance_id, zones);
+	}
+
+	SendToZones(zones, pack);
+}
+
+void GroupRaidState::SendToRaidZones(uint32_t raid_id, ServerPacket* pack)
+{
+	auto raid = m_raids.find(raid_id);
+	if (raid == m_raids.end())
+	{
+		zoneserver_list.SendPacket(pack);
+		return;
+	}
+
+	std::set<ZoneServer*> zones;
+	for (const auto& member : raid->second)
+	{
+		GetMemberZones(member.zone_id, member.instance_id, zones);
+	}
+
+	SendToZones(zones, pack);
+}
+
+void GroupRaidState::EraseGroupMember(const std::string& name)
+{
+	auto group_id = m_group_ids.find(name);
+	if (group_id == m_group_ids.end())
+	{
+		return;
+	}
+
+	auto group = m_groups.find(group_id->second);
+	if (group != m_groups.end())
+	{
+		auto& members = group->second;
+		members.erase(std::remove_if(members.begin(), members.end(),
+			[&](const GroupRosterMember& member) { return member.name == name; }), members.end());
+
+		if (members.empty())
+		{
+			m_groups.erase(group);
+		}
+	}
+
+	m_group_ids.erase(group_id);
+}
+
+void GroupRaidState::EraseRaidMember(const std::string& name)
+{
+	auto raid_id = m_raid_ids.find(name);
+	if (raid_id == m_raid_ids.end())
+	{
+		return;
+	}
+
+	auto raid = m_raids.find(raid_id->second);
+	if (raid != m_raids.end())
+	{
+		auto& members = raid->second;
+		members.erase(std::remove_if(members.begin(), members.end(),
+			[&](const RaidRosterMember& member) { return member.name == name; }), members.end());
+
+		if (members.empty())
+		{
+			m_raids.erase(raid);
+		}
+	}
+
+	m_raid_ids.erase(raid_id);
+}
+
+RaidRosterMember* GroupRaidState::FindRaidMember(uint32_t raid_id, const std::string& name)
+{
+	auto raid = m_raids.find(raid_id);
+	if (raid != m_raids.end())
+	{
+		for (auto& member : raid->second)
+		{
+			if (member.name == name)
+			{
+				return &member;
+			}
+		}
+	}
+	return nullptr;
+}
+
+void GroupRaidState::RemoveGroupMember(const std::string& name, uint32_t char_id, bool is_merc)
+{
+	EraseGroupMember(name);
+	GroupRaidDatabase::DeleteGroupMember(name, char_id, is_merc);
+}
+
+void GroupRaidState::UpdateGroupMember(ServerPacket* pack)
+{
+	auto buf = reinterpret_cast<ServerGroupRosterUpdate_Struct*>(pack->pBuffer);
+	std::string name = buf->member_name;
+
+	if (buf->gid == 0)
+	{
+		RemoveGroupMember(name, buf->char_id, buf->is_merc);
+		return;
+	}
+
+	if (GetGroupID(name) != buf->gid)
+	{
+		EraseGroupMember(name);
+	}
+
+	GroupRosterMember member;
+	member.name        = name;
+	member.char_id     = buf->char_id;
+	member.is_merc     = buf->is_merc;
+	member.zone_id     = buf->zoneid;
+	member.instance_id = buf->instance_id;
+
+	// members added from another zone's invite are wherever their client is
+	auto cle = member.is_merc ? nullptr : client_list.FindCharacter(name.c_str());
+	if (cle && cle->Server())
+	{
+		member.zone_id     = cle->zone();
+		member.instance_id = cle->instance();
+	}
+
+	auto& members = m_groups[buf->gid];
+	auto it = std::find_if(members.begin(), members.end(),
+		[&](const GroupRosterMember& existing) { return existing.name == name; });
+
+	if (it != members.end())
+	{
+		*it = member;
+	}
+	else
+	{
+		members.emplace_back(member);
+	}
+
+	m_group_ids[name] = buf->gid;
+	GroupRaidDatabase::InsertGroupMember(buf->gid, name, member.char_id, member.is_merc);
+}
+
+void GroupRaidState::DisbandGroup(ServerPacket* pack)
+{
+	auto buf = reinterpret_cast<ServerDisbandGroup_Struct*>(pack->pBuffer);
+
+	// relayed before the roster is dropped so the members' zones still get it
+	SendToGroupZones(buf->groupid, pack);
+
+	auto group = m_groups.find(buf->groupid);
+	if (group != m_groups.end())
+	{
+		for (const auto& member : group->second)
+		{
+			m_group_ids.erase(member.name);
+		}
+		m_groups.erase(group);
+	}
+
+	if (buf->groupid != 0)
+	{
+		GroupRaidDatabase::DeleteGroup(buf->groupid);
+	}
+}
+
+void GroupRaidState::SendGroupFollowAck(ServerPacket* pack)
+{
+	auto buf = reinterpret_cast<ServerGroupFollowAck_Struct*>(pack->pBuffer);
+
+	// the invitee's zone builds the group from this instead of group_id
+	auto cle = client_list.FindCharacter(buf->Name);
+	if (cle && cle->Server())
+	{
+		SendCharacterRoster(cle->Server(), cle->CharID(), buf->Name);
+	}
+
+	client_list.SendPacket(buf->Name, pack);
+}
+
+void GroupRaidState::UpdateRaid(ServerPacket* pack)
+{
+	auto buf = reinterpret_cast<ServerRaidGeneralAction_Struct*>(pack->pBuffer);
+	std::string name = buf->playername;
+
+	switch (pack->opcode)
+	{
+	case ServerOP_RaidAdd:
+	{
+		if (m_raid_ids.find(name) != m_raid_ids.end())
+		{
+			EraseRaidMember(name);
+		}
+
+		RaidRosterMember member;
+		member.name            = name;
+		member.char_id         = buf->char_id;
+		member.raid_group      = buf->gid;
+		member.class_id        = buf->_class;
+		member.level           = buf->level;
+		member.is_group_leader = buf->is_group_leader;
+		member.is_raid_leader  = buf->is_raid_leader;
+		member.is_looter       = buf->is_looter;
+		member.zone_id         = buf->zoneid;
+		member.instance_id     = buf->instance_id;
+
+		m_raids[buf->rid].emplace_back(member);
+		m_raid_ids[name] = buf->rid;
+		GroupRaidDatabase::InsertRaidMember(buf->rid, member);
+		SendToRaidZones(buf->rid, pack);
+		break;
+	}
+	case ServerOP_RaidRemove:
+	{
+		SendToRaidZones(buf->rid, pack);
+		EraseRaidMember(name);
+		GroupRaidDatabase::DeleteRaidMember(name);
+		break;
+	}
+	case ServerOP_RaidDisband:
+	{
+		SendToRaidZones(buf->rid, pack);
+
+		auto raid = m_raids.find(buf->rid);
+		if (raid != m_raids.end())
+		{
+			for (const auto& member : raid->second)
+			{
+				m_raid_ids.erase(member.name);
+			}
+			m_raids.erase(raid);
+		}
+
+		GroupRaidDatabase::DeleteRaid(buf->rid);
+		break;
+	}
+	case ServerOP_RaidChangeGroup:
+	{
+		if (auto member = FindRaidMember(buf->rid, name))
+		{
+			member->raid_group = buf->gid;
+		}
+		GroupRaidDatabase::UpdateRaidMemberGroup(name, buf->gid);
+		SendToRaidZones(buf->rid, pack);
+		break;
+	}
+	case ServerOP_RaidGroupLeader:
+	{
+		if (auto member = FindRaidMember(buf->rid, name))
+		{
+			member->is_group_leader = buf->is_group_leader;
+		}
+		GroupRaidDatabase::UpdateRaidGroupLeader(name, buf->is_group_leader);
+		SendToRaidZones(buf->rid, pack);
+		break;
+	}
+	case ServerOP_RaidLeader:
+	{
+		auto raid = m_raids.find(buf->rid);
+		if (raid != m_raids.end())
+		{
+			for (auto& member : raid->second)
+			{
+				member.is_raid_leader = (member.name == name);
+			}
+		}
+		GroupRaidDatabase::UpdateRaidLeader(buf->rid, name);
+		SendToRaidZones(buf->rid, pack);
+		break;
+	}
+	case ServerOP_DetailsChange:
+	{
+		// loot type changes carry no member
+		if (!name.empty())
+		{
+			if (auto member = FindRaidMember(buf->rid, name))
+			{
+				member->is_looter = buf->is_looter;
+			}
+			GroupRaidDatabase::UpdateRaidLooter(name, buf->is_looter);
+		}
+		SendToRaidZones(buf->rid, pack);
+		break;
+	}
+	case ServerOP_RaidMemberLevel:
+	{
+		if (auto member = FindRaidMember(buf->rid, name))
+		{
+			member->level = buf->level;
+		}
+		GroupRaidDatabase::UpdateRaidMemberLevel(name, buf->level);
+		SendToRaidZones(buf->rid, pack);
+		break;
+	}
+	default:
+		SendToRaidZones(buf->rid, pack);
+		break;
+	}
+}
+
+void GroupRaidState::SendCharacterRoster(ZoneServer* zone_server, uint32_t char_id, const std::string& name)
+{
+	if (!zone_server)
+	{
+		return;
+	}
+
+	uint32_t zone_id     = zone_server->GetZoneID();
+	uint16_t instance_id = static_cast<uint16_t>(zone_server->GetInstanceID());
+
+	std::vector<ServerRosterMember_Struct> entries;
+
+	uint32_t group_id = GetGroupID(name);
+	auto group = m_groups.find(group_id);
+	if (group != m_groups.end())
+	{
+		for (auto& member : group->second)
+		{
+			// the character's merc travels with them
+			if (member.char_id == char_id && (member.is_merc || member.name == name))
+			{
+				member.zone_id     = zone_id;
+				member.instance_id = instance_id;
+			}
+
+			ServerRosterMember_Struct entry = {};
+			strn0cpy(entry.name, member.name.c_str(), sizeof(entry.name));
+			entry.char_id = member.char_id;
+			entry.is_merc = member.is_merc;
+			entries.emplace_back(entry);
+		}
+	}
+	else
+	{
+		group_id = 0;
+	}
+
+	uint32_t group_member_count = static_cast<uint32_t>(entries.size());
+
+	auto raid_id = m_raid_ids.find(name);
+	auto raid    = raid_id != m_raid_ids.end() ? m_raids.find(raid_id->second) : m_raids.end();
+	if (raid != m_raids.end())
+	{
+		for (auto& member : raid->second)
+		{
+			if (member.name == name)
+			{
+				member.zone_id     = zone_id;
+				member.instance_id = instance_id;
+			}
+
+			ServerRosterMember_Struct entry = {};
+			strn0cpy(entry.name, member.name.c_str(), sizeof(entry.name));
+			entry.char_id         = member.char_id;
+			entry.gid             = member.raid_group;
+			entry._class          = member.class_id;
+			entry.level           = member.level;
+			entry.is_group_leader = member.is_group_leader;
+			entry.is_raid_leader  = member.is_raid_leader;
+			entry.is_looter       = member.is_looter;
+			entries.emplace_back(entry);
+		}
+	}
+
+	uint32_t pack_size = sizeof(ServerCharacterRoster_Struct) +
+		static_cast<uint32_t>(entries.size() * sizeof(ServerRosterMember_Struct));
+
+	auto pack = std::unique_ptr<ServerPacket>(new ServerPacket(ServerOP_CharacterRoster, pack_size));
+	auto buf = reinterpret_cast<ServerCharacterRoster_Struct*>(pack->pBuffer);
+	buf->char_id            = char_id;
+	buf->group_id           = group_id;
+	buf->group_member_count = group_member_count;
+	buf->raid_id            = raid != m_raids.end() ? raid->first : 0;
+	buf->raid_member_count  = static_cast<uint32_t>(entries.size()) - group_member_count;
+	if (!entries.empty())
+	{
+		memcpy(buf->members, entries.data(), entries.size() * sizeof(ServerRosterMember_Struct));
+	}
+
+	zone_server->SendPacket(pack.get());
+}
@@ -0,0 +1,89 @@
+/**
+ * EQEmulator: Everquest Server Emulator
+ * Copyright (C) 2001-2020 EQEmulator Development Team (https://github.com/EQEmu/Server)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 2 of the License.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY except by those people which sell it, which
+ * are required to give you total support for your newly bought product;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ */
+
+#ifndef WORLD_GROUP_RAID_STATE_H
+#define WORLD_GROUP_RAID_STATE_H
+
+#include <cstdint>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+extern class GroupRaidState group_raid_state;
+
+class ServerPacket;
+class ZoneServer;
+
+struct GroupRosterMember
+{
+	std::string name;
+	uint32_t char_id     = 0; // owner's character id for mercs, bot id for bots
+	bool     is_merc     = false;
+	uint32_t zone_id     = 0; // zone the member was last sent to, deltas for the group go there
+	uint16_t instance_id = 0;
+};
+
+struct RaidRosterMember
+{
+	std::string name;
+	uint32_t char_id         = 0;
+	uint32_t raid_group      = 0;
+	uint8_t  class_id        = 0;
+	uint8_t  level           = 0;
+	bool     is_group_leader = false;
+	bool     is_raid_leader  = false;
+	bool     is_looter       = false;
+	uint32_t zone_id         = 0;
+	uint16_t instance_id     = 0;
+};
+
+// world owns group and raid rosters. zones send it their changes, world applies
+// them, queues the group_id / raid_members writes and relays each change only to
+// the zones that hold a member. a client entering a zone is sent its rosters
+// along with the incoming client packet so zones never read them from the database
+class GroupRaidState
+{
+public:
+	void DisbandGroup(ServerPacket* pack);
+	uint32_t GetGroupID(const std::string& name) const;
+	void Process();
+	void RemoveGroupMember(const std::string& name, uint32_t char_id, bool is_merc);
+	void SendCharacterRoster(ZoneServer* zone_server, uint32_t char_id, const std::string& name);
+	void SendGroupFollowAck(ServerPacket* pack);
+	void SendToGroupZones(uint32_t group_id, ServerPacket* pack);
+	void SendToRaidZones(uint32_t raid_id, ServerPacket* pack);
+	void UpdateGroupMember(ServerPacket* pack);
+	void UpdateRaid(ServerPacket* pack);
+
+private:
+	void EraseGroupMember(const std::string& name);
+	void EraseRaidMember(const std::string& name);
+	RaidRosterMember* FindRaidMember(uint32_t raid_id, const std::string& name);
+	void GetMemberZones(uint32_t zone_id, uint16_t instance_id, std::set<ZoneServer*>& into) const;
+	void SendToZones(const std::set<ZoneServer*>& zones, ServerPacket* pack) const;
+
+	std::unordered_map<uint32_t, std::vector<GroupRosterMember>> m_groups;
+	std::unordered_map<uint32_t, std::vector<RaidRosterMember>> m_raids;
+	std::unordered_map<std::string, uint32_t> m_group_ids; // member name to group id
+	std::unordered_map<std::string, uint32_t> m_raid_ids;  // member name to raid id
+};
+
+#endif
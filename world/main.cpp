@@ -90,6 +90,8 @@ union semun {
 #include "console.h"
 #include "expedition_database.h"
 #include "expedition_state.h"
+#include "group_raid_database.h"
+#include "group_raid_state.h"
 
 #include "../common/net/servertalk_server.h"
 #include "../zone/data_bucket.h"
@@ -428,6 +430,7 @@ int main(int argc, char** argv) {
 	LogInfo("Purging expired expeditions");
 	ExpeditionDatabase::PurgeExpiredExpeditions();
 	ExpeditionDatabase::PurgeExpiredCharacterLockouts();
+	ExpeditionDatabase::FlushPendingWrites();
 
 	LogInfo("Purging expired instances");
 	database.PurgeExpiredInstances();
@@ -456,6 +459,8 @@ int main(int argc, char** argv) {
 	EQ::Net::ServertalkServerOptions server_opts;
 	server_opts.port = Config->WorldTCPPort;
 	server_opts.ipv6 = false;
+	server_opts.compact = Config->WorldTCPCompact;
+	server_opts.compress = Config->WorldTCPCompress;
 	server_opts.credentials = Config->SharedKey;
 	server_connection->Listen(server_opts);
 	LogInfo("Server (TCP) listener started");
@@ -625,6 +630,7 @@ int main(int argc, char** argv) {
 		LFPGroupList.Process();
 		adventure_manager.Process();
 		expedition_state.Process();
+		group_raid_state.Process();
 
 		if (InterserverTimer.Check()) {
 			InterserverTimer.Start();
@@ -639,6 +645,10 @@ int main(int argc, char** argv) {
 		Sleep(5);
 	}
 	LogInfo("World main loop completed");
+	LogInfo("Writing queued expedition changes");
+	ExpeditionDatabase::FlushPendingWrites();
+	LogInfo("Writing queued group and raid roster changes");
+	GroupRaidDatabase::FlushPendingWrites();
 	LogInfo("Shutting down zone connections (if any)");
 	zoneserver_list.KillAll();
 	LogInfo("Zone (TCP) listener stopped");
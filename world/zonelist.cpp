@@ -18,6 +18,8 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include "../common/global_define.h"
 #include "zonelist.h"
 #include "zoneserver.h"
+#include "clientlist.h"
+#include "cliententry.h"
 #include "worlddb.h"
 #include "world_config.h"
 #include "../common/misc_functions.h"
@@ -28,11 +30,16 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include "../common/event_sub.h"
 #include "web_interface.h"
 #include "world_store.h"
+#include "../common/rulesys.h"
+
+#include <algorithm>
+#include <set>
 
 extern uint32 numzones;
 extern bool holdzones;
 extern EQ::Random emu_random;
 extern WebInterfaceList web_interface;
+extern ClientList client_list;
 volatile bool UCSServerAvailable_ = false;
 void CatchSignal(int sig_num);
 
@@ -40,6 +47,9 @@ ZSList::ZSList()
 {
 	NextID = 1;
 	CurGroupID = 1;
+	m_routed_packets = 0;
+	m_routed_sends_saved = 0;
+	m_next_list_order = 0;
 	memset(pLockedZones, 0, sizeof(pLockedZones));
 
 	m_tick.reset(new EQ::Timer(5000, true, std::bind(&ZSList::OnTick, this, std::placeholders::_1)));
@@ -66,17 +76,178 @@ void ZSList::ShowUpTime(WorldTCPConnection* con, const char* adminname) {
 		con->SendEmoteMessage(adminname, 0, 0, 0, "Worldserver Uptime: %02im %02is", m, s);
 }
 
+template<typename Key, typename Compare>
+static void IndexInsert(std::unordered_map<Key, std::vector<ZoneServer *>> &index, const Key &key, ZoneServer *zoneserver, Compare in_list_order)
+{
+	auto &servers = index[key];
+	servers.insert(std::upper_bound(servers.begin(), servers.end(), zoneserver, in_list_order), zoneserver);
+}
+
+template<typename Key>
+static void IndexErase(std::unordered_map<Key, std::vector<ZoneServer *>> &index, const Key &key, ZoneServer *zoneserver)
+{
+	auto entry = index.find(key);
+	if (entry == index.end()) {
+		return;
+	}
+
+	auto &servers = entry->second;
+	servers.erase(std::remove(servers.begin(), servers.end(), zoneserver), servers.end());
+	if (servers.empty()) {
+		index.erase(entry);
+	}
+}
+
+template<typename Key>
+static ZoneServer *IndexFind(const std::unordered_map<Key, std::vector<ZoneServer *>> &index, const Key &key)
+{
+	auto entry = index.find(key);
+	if (entry == index.end()) {
+		return nullptr;
+	}
+
+	return entry->second.front();
+}
+
 void ZSList::Add(ZoneServer* zoneserver) {
 	zone_server_list.push_back(std::unique_ptr<ZoneServer>(zoneserver));
+
+	m_indexed[zoneserver]            = IndexedKeys{};
+	m_indexed[zoneserver].list_order = m_next_list_order++;
+	m_id_index[zoneserver->GetID()] = zoneserver;
+	Reindex(zoneserver);
+
 	zoneserver->SendGroupIDs();
 }
 
+/**
+ * Moves a zone server to the index entries for its current zone, instance and port
+ *
+ * @param zoneserver
+ */
+void ZSList::Reindex(ZoneServer *zoneserver)
+{
+	auto indexed = m_indexed.find(zoneserver);
+	if (indexed == m_indexed.end()) {
+		return;
+	}
+
+	auto &keys = indexed->second;
+	Unindex(zoneserver, keys);
+
+	keys.zone_id     = zoneserver->GetZoneID();
+	keys.instance_id = zoneserver->GetInstanceID();
+	keys.port        = zoneserver->GetCPort();
+	keys.zone_name   = zoneserver->GetZoneName();
+
+	// servers are appended to zone_server_list and never moved, so Add order is list order
+	auto in_list_order = [this](ZoneServer *a, ZoneServer *b) {
+		return m_indexed[a].list_order < m_indexed[b].list_order;
+	};
+
+	if (keys.zone_id != 0) {
+		IndexInsert(m_zone_index, keys.zone_id, zoneserver, in_list_order);
+	}
+
+	if (keys.instance_id != 0) {
+		IndexInsert(m_instance_index, keys.instance_id, zoneserver, in_list_order);
+	}
+
+	if (keys.port != 0) {
+		IndexInsert(m_port_index, static_cast<uint32>(keys.port), zoneserver, in_list_order);
+	}
+
+	if (!keys.zone_name.empty()) {
+		IndexInsert(m_name_index, keys.zone_name, zoneserver, in_list_order);
+	}
+
+	if (keys.zone_id == 0 && !zoneserver->IsBootingUp() && !keys.idle_queued) {
+		m_idle_zone_servers.push_back(zoneserver);
+		keys.idle_queued = true;
+	}
+}
+
+/**
+ * @param zoneserver
+ * @param keys
+ */
+void ZSList::Unindex(ZoneServer *zoneserver, IndexedKeys &keys)
+{
+	if (keys.zone_id != 0) {
+		IndexErase(m_zone_index, keys.zone_id, zoneserver);
+	}
+
+	if (keys.instance_id != 0) {
+		IndexErase(m_instance_index, keys.instance_id, zoneserver);
+	}
+
+	if (keys.port != 0) {
+		IndexErase(m_port_index, static_cast<uint32>(keys.port), zoneserver);
+	}
+
+	if (!keys.zone_name.empty()) {
+		IndexErase(m_name_index, keys.zone_name, zoneserver);
+	}
+}
+
+/**
+ * Takes an idle zone server off the free list, preferring one that last ran zone_id
+ *
+ * @param zone_id
+ * @return
+ */
+ZoneServer *ZSList::PopIdleZoneServer(uint32 zone_id)
+{
+	auto chosen = m_idle_zone_servers.end();
+
+	auto iter = m_idle_zone_servers.begin();
+	while (iter != m_idle_zone_servers.end()) {
+		ZoneServer *zs = *iter;
+		if (zs->GetZoneID() != 0 || zs->IsBootingUp()) {
+			m_indexed[zs].idle_queued = false;
+			iter = m_idle_zone_servers.erase(iter);
+			continue;
+		}
+
+		if (chosen == m_idle_zone_servers.end()) {
+			chosen = iter;
+		}
+
+		if (zs->GetPrevZoneID() == zone_id) {
+			chosen = iter;
+			break;
+		}
+
+		iter++;
+	}
+
+	if (chosen == m_idle_zone_servers.end()) {
+		return nullptr;
+	}
+
+	ZoneServer *zs = *chosen;
+	m_indexed[zs].idle_queued = false;
+	m_idle_zone_servers.erase(chosen);
+
+	return zs;
+}
+
 void ZSList::Remove(const std::string &uuid)
 {
 	auto iter = zone_server_list.begin();
 	while (iter != zone_server_list.end()) {
 		if ((*iter)->GetUUID().compare(uuid) == 0) {
 			auto port = (*iter)->GetCPort();
+			ZoneServer *zs = (*iter).get();
+
+			auto indexed = m_indexed.find(zs);
+			if (indexed != m_indexed.end()) {
+				Unindex(zs, indexed->second);
+				m_indexed.erase(indexed);
+			}
+
+			m_id_index.erase(zs->GetID());
+			m_idle_zone_servers.remove(zs);
 			zone_server_list.erase(iter);
 
 			if (port != 0) {
@@ -89,6 +260,14 @@ void ZSList::Remove(const std::string &uuid)
 }
 
 void ZSList::KillAll() {
+	m_indexed.clear();
+	m_id_index.clear();
+	m_zone_index.clear();
+	m_instance_index.clear();
+	m_port_index.clear();
+	m_name_index.clear();
+	m_idle_zone_servers.clear();
+
 	auto iterator = zone_server_list.begin();
 	while (iterator != zone_server_list.end()) {
 		(*iterator)->Disconnect();
@@ -124,106 +303,116 @@ bool ZSList::SendPacket(ServerPacket* pack) {
 }
 
 bool ZSList::SendPacket(uint32 ZoneID, ServerPacket* pack) {
-	auto iterator = zone_server_list.begin();
-	while (iterator != zone_server_list.end()) {
-		if ((*iterator)->GetZoneID() == ZoneID) {
-			ZoneServer* tmp = (*iterator).get();
-			tmp->SendPacket(pack);
-			return true;
-		}
-		iterator++;
+	ZoneServer* tmp = IndexFind(m_zone_index, ZoneID);
+	if (tmp) {
+		tmp->SendPacket(pack);
+		return true;
 	}
 	return(false);
 }
 
 bool ZSList::SendPacket(uint32 ZoneID, uint16 instanceID, ServerPacket* pack) {
-	if (instanceID != 0)
-	{
-		auto iterator = zone_server_list.begin();
-		while (iterator != zone_server_list.end()) {
-			if ((*iterator)->GetInstanceID() == instanceID) {
-				ZoneServer* tmp = (*iterator).get();
-				tmp->SendPacket(pack);
-				return true;
-			}
-			iterator++;
+	ZoneServer* tmp = instanceID != 0 ? FindByInstanceID(instanceID) : FindByZoneID(ZoneID);
+	if (tmp) {
+		tmp->SendPacket(pack);
+		return true;
+	}
+	return(false);
+}
+
+/**
+ * Sends a broadcast that only players can act on, channel messages and emotes, to the zones that currently have
+ * players in them. Group and raid updates are not routed here, zones build their group and raid state while a member
+ * is still loading in and before world counts the player
+ *
+ * @param pack
+ * @return
+ */
+bool ZSList::SendPacketToPopulatedZones(ServerPacket* pack) {
+	if (!RuleB(World, RouteBroadcastPackets)) {
+		return SendPacket(pack);
+	}
+
+	m_routed_packets++;
+	for (auto &zs : zone_server_list) {
+		if (zs->NumPlayers() == 0) {
+			m_routed_sends_saved++;
+			continue;
 		}
+
+		zs->SendPacket(pack);
 	}
-	else
-	{
-		auto iterator = zone_server_list.begin();
-		while (iterator != zone_server_list.end()) {
-			if ((*iterator)->GetZoneID() == ZoneID
-				&& (*iterator)->GetInstanceID() == 0) {
-				ZoneServer* tmp = (*iterator).get();
-				tmp->SendPacket(pack);
-				return true;
-			}
-			iterator++;
+
+	return true;
+}
+
+/**
+ * Sends a guild broadcast to the zones that currently hold a member of the guild
+ *
+ * @param guild_id
+ * @param pack
+ * @return
+ */
+bool ZSList::SendPacketToGuild(uint32 guild_id, ServerPacket* pack) {
+	if (!RuleB(World, RouteBroadcastPackets)) {
+		return SendPacket(pack);
+	}
+
+	std::set<ZoneServer *> guild_zones;
+	client_list.GetGuildZoneServers(guild_id, guild_zones);
+
+	m_routed_packets++;
+	for (auto &zs : zone_server_list) {
+		if (guild_zones.find(zs.get()) == guild_zones.end()) {
+			m_routed_sends_saved++;
+			continue;
 		}
+
+		zs->SendPacket(pack);
 	}
-	return(false);
+
+	return true;
 }
 
 ZoneServer* ZSList::FindByName(const char* zonename) {
-	auto iterator = zone_server_list.begin();
-	while (iterator != zone_server_list.end()) {
-		if (strcasecmp((*iterator)->GetZoneName(), zonename) == 0) {
-			ZoneServer* tmp = (*iterator).get();
-			return tmp;
-		}
-		iterator++;
+	if (zonename == nullptr || zonename[0] == '\0') {
+		return 0;
 	}
-	return 0;
+
+	// zone names are stored lower case by ZoneServer::SetZone
+	return IndexFind(m_name_index, str_tolower(zonename));
 }
 
 ZoneServer* ZSList::FindByID(uint32 ZoneID) {
-	auto iterator = zone_server_list.begin();
-	while (iterator != zone_server_list.end()) {
-		if ((*iterator)->GetID() == ZoneID) {
-			ZoneServer* tmp = (*iterator).get();
-			return tmp;
-		}
-		iterator++;
+	auto entry = m_id_index.find(ZoneID);
+	if (entry == m_id_index.end()) {
+		return 0;
 	}
-	return 0;
+
+	return entry->second;
 }
 
 ZoneServer* ZSList::FindByZoneID(uint32 ZoneID) {
-	auto iterator = zone_server_list.begin();
-	while (iterator != zone_server_list.end()) {
-		ZoneServer* tmp = (*iterator).get();
-		if (tmp->GetZoneID() == ZoneID && tmp->GetInstanceID() == 0) {
-			return tmp;
+	auto entry = m_zone_index.find(ZoneID);
+	if (entry == m_zone_index.end()) {
+		return 0;
+	}
+
+	for (auto zs : entry->second) {
+		if (zs->GetInstanceID() == 0) {
+			return zs;
 		}
-		iterator++;
 	}
 	return 0;
 }
 
 ZoneServer* ZSList::FindByPort(uint16 port) {
-	auto iterator = zone_server_list.begin();
-	while (iterator != zone_server_list.end()) {
-		if ((*iterator)->GetCPort() == port) {
-			ZoneServer* tmp = (*iterator).get();
-			return tmp;
-		}
-		iterator++;
-	}
-	return 0;
+	return IndexFind(m_port_index, static_cast<uint32>(port));
 }
 
 ZoneServer* ZSList::FindByInstanceID(uint32 InstanceID)
 {
-	auto iterator = zone_server_list.begin();
-	while (iterator != zone_server_list.end()) {
-		if ((*iterator)->GetInstanceID() == InstanceID) {
-			ZoneServer* tmp = (*iterator).get();
-			return tmp;
-		}
-		iterator++;
-	}
-	return 0;
+	return IndexFind(m_instance_index, InstanceID);
 }
 
 bool ZSList::SetLockedZone(uint16 iZoneID, bool iLock) {
@@ -449,7 +638,14 @@ void ZSList::SendChannelMessageRaw(const char* from, const char* to, uint8 chan_
 	scm->chan_num = chan_num;
 	strcpy(&scm->message[0], message);
 
-	SendPacket(pack);
+	ClientListEntry* cle = 0;
+	if (scm->deliverto[0] != 0 && RuleB(World, RouteBroadcastPackets))
+		cle = client_list.FindCharacter(scm->deliverto);
+
+	if (cle && cle->Server())
+		cle->Server()->SendPacket(pack);
+	else
+		SendPacketToPopulatedZones(pack);
 	delete pack;
 }
 
@@ -494,15 +690,24 @@ void ZSList::SendEmoteMessageRaw(const char* to, uint32 to_guilddbid, int16 to_m
 		strn0cpy(tempto, to, 64);
 
 	if (tempto[0] == 0) {
-		SendPacket(pack);
+		if (to_guilddbid != 0)
+			SendPacketToGuild(to_guilddbid, pack);
+		else
+			SendPacketToPopulatedZones(pack);
 	}
 	else {
 		ZoneServer* zs = FindByName(to);
+		if (zs == 0) {
+			// not a zone, zones only deliver it to a client by this name
+			ClientListEntry* cle = client_list.FindCharacter(to);
+			if (cle && cle->Server() && RuleB(World, RouteBroadcastPackets))
+				zs = cle->Server();
+		}
 
 		if (zs != 0)
 			zs->SendPacket(pack);
 		else
-			SendPacket(pack);
+			SendPacketToPopulatedZones(pack);
 	}
 	delete pack;
 }
@@ -602,50 +807,18 @@ uint16 ZSList::GetAvailableZonePort()
 }
 
 uint32 ZSList::TriggerBootup(uint32 iZoneID, uint32 iInstanceID) {
-	if (iInstanceID > 0)
-	{
-		auto iterator = zone_server_list.begin();
-		while (iterator != zone_server_list.end()) {
-			if ((*iterator)->GetInstanceID() == iInstanceID)
-			{
-				return (*iterator)->GetID();
-			}
-			iterator++;
-		}
-
-		iterator = zone_server_list.begin();
-		while (iterator != zone_server_list.end()) {
-			if ((*iterator)->GetZoneID() == 0 && !(*iterator)->IsBootingUp()) {
-				ZoneServer* zone = (*iterator).get();
-				zone->TriggerBootup(iZoneID, iInstanceID);
-				return zone->GetID();
-			}
-			iterator++;
-		}
-		return 0;
+	ZoneServer* running = iInstanceID > 0 ? FindByInstanceID(iInstanceID) : FindByZoneID(iZoneID);
+	if (running) {
+		return running->GetID();
 	}
-	else
-	{
-		auto iterator = zone_server_list.begin();
-		while (iterator != zone_server_list.end()) {
-			if ((*iterator)->GetZoneID() == iZoneID && (*iterator)->GetInstanceID() == 0)
-			{
-				return (*iterator)->GetID();
-			}
-			iterator++;
-		}
 
-		iterator = zone_server_list.begin();
-		while (iterator != zone_server_list.end()) {
-			if ((*iterator)->GetZoneID() == 0 && !(*iterator)->IsBootingUp()) {
-				ZoneServer* zone = (*iterator).get();
-				zone->TriggerBootup(iZoneID);
-				return zone->GetID();
-			}
-			iterator++;
-		}
+	ZoneServer* zone = PopIdleZoneServer(iZoneID);
+	if (!zone) {
 		return 0;
 	}
+
+	zone->TriggerBootup(iZoneID, iInstanceID);
+	return zone->GetID();
 }
 
 void ZSList::SendLSZones() {
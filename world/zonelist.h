@@ -8,6 +8,9 @@
 #include <vector>
 #include <memory>
 #include <deque>
+#include <list>
+#include <string>
+#include <unordered_map>
 
 class WorldTCPConnection;
 class ServerPacket;
@@ -28,6 +31,8 @@ public:
 	bool SendPacket(ServerPacket *pack);
 	bool SendPacket(uint32 zoneid, ServerPacket *pack);
 	bool SendPacket(uint32 zoneid, uint16 instanceid, ServerPacket *pack);
+	bool SendPacketToPopulatedZones(ServerPacket *pack);
+	bool SendPacketToGuild(uint32 guild_id, ServerPacket *pack);
 	bool SetLockedZone(uint16 iZoneID, bool iLock);
 
 	EQTime worldclock;
@@ -49,6 +54,7 @@ public:
 	void Process();
 	void RebootZone(const char *ip1, uint16 port, const char *ip2, uint32 skipid, uint32 zoneid = 0);
 	void Remove(const std::string &uuid);
+	void Reindex(ZoneServer *zoneserver);
 	void SendChannelMessage(const char *from, const char *to, uint8 chan_num, uint8 language, const char *message, ...);
 	void SendChannelMessageRaw(const char *from, const char *to, uint8 chan_num, uint8 language, const char *message);
 	void SendEmoteMessage(const char *to, uint32 to_guilddbid, int16 to_minstatus, uint32 type, const char *message, ...);
@@ -69,6 +75,9 @@ public:
 
 	const std::list<std::unique_ptr<ZoneServer>> &getZoneServerList() const;
 
+	uint64 GetRoutedPackets() const { return m_routed_packets; }
+	uint64 GetRoutedSendsSaved() const { return m_routed_sends_saved; }
+
 private:
 	void OnTick(EQ::Timer *t);
 	void OnKeepAlive(EQ::Timer *t);
@@ -79,7 +88,41 @@ private:
 	std::unique_ptr<EQ::Timer> m_tick;
 	std::unique_ptr<EQ::Timer> m_keepalive;
 
+	// broadcasts sent through SendPacketToPopulatedZones / SendPacketToGuild and the zone writes they skipped
+	uint64 m_routed_packets;
+	uint64 m_routed_sends_saved;
+
 	std::list<std::unique_ptr<ZoneServer>> zone_server_list;
+
+	/**
+	 * Lookup indexes over zone_server_list, refreshed through Reindex whenever a zone server changes zone,
+	 * instance or port. Each key can map to more than one server while a boot races a shutdown. Entries stay
+	 * in zone_server_list order, so the lookups return the server the list walk they replace did
+	 */
+	typedef std::unordered_map<uint32, std::vector<ZoneServer *>> ZoneServerIndex;
+
+	struct IndexedKeys {
+		uint64      list_order;
+		uint32      zone_id;
+		uint32      instance_id;
+		uint16      port;
+		std::string zone_name;
+		bool        idle_queued;
+	};
+
+	void Unindex(ZoneServer *zoneserver, IndexedKeys &keys);
+	ZoneServer *PopIdleZoneServer(uint32 zone_id);
+
+	std::unordered_map<ZoneServer *, IndexedKeys>                        m_indexed;
+	uint64                                                               m_next_list_order;
+	std::unordered_map<uint32, ZoneServer *>                             m_id_index;
+	ZoneServerIndex                                                      m_zone_index;
+	ZoneServerIndex                                                      m_instance_index;
+	ZoneServerIndex                                                      m_port_index;
+	std::unordered_map<std::string, std::vector<ZoneServer *>>           m_name_index;
+
+	// booted zone servers not running a zone, entries are checked when taken and dropped if they went busy
+	std::list<ZoneServer *> m_idle_zone_servers;
 };
 
 #endif /*ZONELIST_H_*/
@@ -37,6 +37,8 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include "queryserv.h"
 #include "world_store.h"
 #include "expedition_message.h"
+#include "expedition_state.h"
+#include "group_raid_state.h"
 
 extern ClientList client_list;
 extern GroupLFPList LFPGroupList;
@@ -67,6 +69,7 @@ ZoneServer::ZoneServer(std::shared_ptr<EQ::Net::ServertalkServerConnection> conn
 	is_authenticated = false;
 	is_static_zone = false;
 	zone_player_count = 0;
+	client_list_sequence = 0;
 
 	tcpc->OnMessage(std::bind(&ZoneServer::HandleMessage, this, std::placeholders::_1, std::placeholders::_2));
 
@@ -124,6 +127,8 @@ bool ZoneServer::SetZone(uint32 iZoneID, uint32 iInstanceID, bool iStaticZone) {
 		strcpy(long_name, "");
 	}
 
+	zoneserver_list.Reindex(this);
+
 	client_list.ZoneBootup(this);
 	zone_boot_timer.Start();
 
@@ -226,9 +231,7 @@ void ZoneServer::HandleMessage(uint16 opcode, const EQ::Net::Packet &p) {
 		if (pack->size != sizeof(ServerGroupFollowAck_Struct))
 			break;
 
-		ServerGroupFollowAck_Struct *sgfas = (ServerGroupFollowAck_Struct *)pack->pBuffer;
-
-		client_list.SendPacket(sgfas->Name, pack);
+		group_raid_state.SendGroupFollowAck(pack);
 		break;
 	}
 	case ServerOP_GroupCancelInvite: {
@@ -244,36 +247,45 @@ void ZoneServer::HandleMessage(uint16 opcode, const EQ::Net::Packet &p) {
 		SendGroupIDs();
 		break;
 	}
+	case ServerOP_GroupRosterUpdate: {
+		if (pack->size != sizeof(ServerGroupRosterUpdate_Struct))
+			break;
+
+		group_raid_state.UpdateGroupMember(pack);
+		break;
+	}
 	case ServerOP_GroupLeave: {
 		if (pack->size != sizeof(ServerGroupLeave_Struct))
 			break;
-		zoneserver_list.SendPacket(pack); //bounce it to all zones
+		group_raid_state.SendToGroupZones(((ServerGroupLeave_Struct *)pack->pBuffer)->gid, pack);
 		break;
 	}
 
 	case ServerOP_GroupJoin: {
 		if (pack->size != sizeof(ServerGroupJoin_Struct))
 			break;
-		zoneserver_list.SendPacket(pack); //bounce it to all zones
+		group_raid_state.SendToGroupZones(((ServerGroupJoin_Struct *)pack->pBuffer)->gid, pack);
 		break;
 	}
 
 	case ServerOP_ForceGroupUpdate: {
 		if (pack->size != sizeof(ServerForceGroupUpdate_Struct))
 			break;
-		zoneserver_list.SendPacket(pack); //bounce it to all zones
+		group_raid_state.SendToGroupZones(((ServerForceGroupUpdate_Struct *)pack->pBuffer)->gid, pack);
 		break;
 	}
 
 	case ServerOP_OOZGroupMessage: {
-		zoneserver_list.SendPacket(pack); //bounce it to all zones
+		if (pack->size < sizeof(ServerGroupChannelMessage_Struct))
+			break;
+		group_raid_state.SendToGroupZones(((ServerGroupChannelMessage_Struct *)pack->pBuffer)->groupid, pack);
 		break;
 	}
 
 	case ServerOP_DisbandGroup: {
 		if (pack->size != sizeof(ServerDisbandGroup_Struct))
 			break;
-		zoneserver_list.SendPacket(pack); //bounce it to all zones
+		group_raid_state.DisbandGroup(pack);
 		break;
 	}
 
@@ -281,113 +293,43 @@ void ZoneServer::HandleMessage(uint16 opcode, const EQ::Net::Packet &p) {
 		if (pack->size != sizeof(ServerGroupLeader_Struct)) {
 			break;
 		}
-		zoneserver_list.SendPacket(pack); //bounce it to all zones
-		break;
-	}
-
-	case ServerOP_RaidAdd: {
-		if (pack->size != sizeof(ServerRaidGeneralAction_Struct))
-			break;
-
-		zoneserver_list.SendPacket(pack);
-		break;
-	}
-
-	case ServerOP_RaidRemove: {
-		if (pack->size != sizeof(ServerRaidGeneralAction_Struct))
-			break;
-
-		zoneserver_list.SendPacket(pack);
-		break;
-	}
-
-	case ServerOP_RaidDisband: {
-		if (pack->size != sizeof(ServerRaidGeneralAction_Struct))
-			break;
-
-		zoneserver_list.SendPacket(pack);
-		break;
-	}
-
-	case ServerOP_RaidLockFlag: {
-		if (pack->size != sizeof(ServerRaidGeneralAction_Struct))
-			break;
-
-		zoneserver_list.SendPacket(pack);
-		break;
-	}
-
-	case ServerOP_RaidChangeGroup: {
-		if (pack->size != sizeof(ServerRaidGeneralAction_Struct))
-			break;
-
-		zoneserver_list.SendPacket(pack);
+		group_raid_state.SendToGroupZones(((ServerGroupLeader_Struct *)pack->pBuffer)->gid, pack);
 		break;
 	}
 
-	case ServerOP_UpdateGroup: {
+	case ServerOP_RaidAdd:
+	case ServerOP_RaidRemove:
+	case ServerOP_RaidDisband:
+	case ServerOP_RaidLockFlag:
+	case ServerOP_RaidChangeGroup:
+	case ServerOP_UpdateGroup:
+	case ServerOP_RaidGroupDisband:
+	case ServerOP_RaidGroupLeader:
+	case ServerOP_RaidLeader:
+	case ServerOP_DetailsChange:
+	case ServerOP_RaidMemberLevel: {
 		if (pack->size != sizeof(ServerRaidGeneralAction_Struct))
 			break;
 
-		zoneserver_list.SendPacket(pack);
-		break;
-	}
-
-	case ServerOP_RaidGroupDisband: {
-		if (pack->size != sizeof(ServerRaidGeneralAction_Struct))
-			break;
-
-		zoneserver_list.SendPacket(pack);
-		break;
-	}
-
-	case ServerOP_RaidGroupAdd: {
-		if (pack->size != sizeof(ServerRaidGroupAction_Struct))
-			break;
-
-		zoneserver_list.SendPacket(pack);
+		group_raid_state.UpdateRaid(pack);
 		break;
 	}
 
+	case ServerOP_RaidGroupAdd:
 	case ServerOP_RaidGroupRemove: {
 		if (pack->size != sizeof(ServerRaidGroupAction_Struct))
 			break;
 
-		zoneserver_list.SendPacket(pack);
-		break;
-	}
-
-	case ServerOP_RaidGroupSay: {
-		zoneserver_list.SendPacket(pack);
+		group_raid_state.SendToRaidZones(((ServerRaidGroupAction_Struct *)pack->pBuffer)->rid, pack);
 		break;
 	}
 
+	case ServerOP_RaidGroupSay:
 	case ServerOP_RaidSay: {
-		zoneserver_list.SendPacket(pack);
-		break;
-	}
-
-	case ServerOP_RaidGroupLeader: {
-		if (pack->size != sizeof(ServerRaidGeneralAction_Struct))
-			break;
-
-		zoneserver_list.SendPacket(pack);
-		break;
-	}
-
-	case ServerOP_RaidLeader: {
-		if (pack->size != sizeof(ServerRaidGeneralAction_Struct))
+		if (pack->size < sizeof(ServerRaidMessage_Struct))
 			break;
 
-		zoneserver_list.SendPacket(pack);
-		break;
-	}
-
-	case ServerOP_DetailsChange: {
-		if (pack->size != sizeof(ServerRaidGeneralAction_Struct))
-			break;
-
-		zoneserver_list.SendPacket(pack);
+		group_raid_state.SendToRaidZones(((ServerRaidMessage_Struct *)pack->pBuffer)->rid, pack);
 		break;
 	}
 
@@ -395,7 +337,7 @@ void ZoneServer::HandleMessage(uint16 opcode, const EQ::Net::Packet &p) {
 		if (pack->size < sizeof(ServerRaidMOTD_Struct))
 			break;
 
-		zoneserver_list.SendPacket(pack);
+		group_raid_state.SendToRaidZones(((ServerRaidMOTD_Struct *)pack->pBuffer)->rid, pack);
 		break;
 	}
 
@@ -511,7 +453,11 @@ void ZoneServer::HandleMessage(uint16 opcode, const EQ::Net::Packet &p) {
 					});
 				}
 			}
-			zoneserver_list.SendPacket(pack);
+
+			if (scm->chan_num == ChatChannel_Guild)
+				zoneserver_list.SendPacketToGuild(scm->guilddbid, pack);
+			else
+				zoneserver_list.SendPacketToPopulatedZones(pack);
 		}
 		break;
 	}
@@ -606,6 +552,8 @@ void ZoneServer::HandleMessage(uint16 opcode, const EQ::Net::Packet &p) {
 			LogInfo("Zone specified port [{}]", client_port);
 		}
 
+		zoneserver_list.Reindex(this);
+
 		if (sci->address[0]) {
 			strn0cpy(client_address, sci->address, 250);
 			LogInfo("Zone specified address [{}]", sci->address);
@@ -782,6 +730,38 @@ void ZoneServer::HandleMessage(uint16 opcode, const EQ::Net::Packet &p) {
 			break;
 		}
 		client_list.ClientUpdate(this, (ServerClientList_Struct*)pack->pBuffer);
+		client_list_sequence = ((ServerClientList_Struct*)pack->pBuffer)->sequence;
+		break;
+	}
+	case ServerOP_ClientListDelta: {
+		if (pack->size != sizeof(ServerClientListDelta_Struct)) {
+			LogInfo("Wrong size on ServerOP_ClientListDelta. Got: [{}], Expected: [{}]", pack->size, sizeof(ServerClientListDelta_Struct));
+			break;
+		}
+		auto delta = (ServerClientListDelta_Struct*)pack->pBuffer;
+		client_list_sequence = delta->sequence;
+		if (!client_list.ClientDelta(this, delta)) {
+			RequestClientListResync();
+		}
+		break;
+	}
+	case ServerOP_ClientListSync: {
+		if (pack->size != sizeof(ServerClientListSync_Struct)) {
+			LogInfo("Wrong size on ServerOP_ClientListSync. Got: [{}], Expected: [{}]", pack->size, sizeof(ServerClientListSync_Struct));
+			break;
+		}
+		auto sync = (ServerClientListSync_Struct*)pack->pBuffer;
+		if (sync->resynced) {
+			// the zone's full list and its wid keepalive came in ahead of this
+			client_list_sequence = sync->sequence;
+			break;
+		}
+		if (sync->sequence != client_list_sequence || sync->count != client_list.CountZoneServerCLEs(this)) {
+			// let anything the zone no longer has go stale, the zone answers with its full list
+			RequestClientListResync();
+			break;
+		}
+		client_list.CLEKeepAlive(this);
 		break;
 	}
 	case ServerOP_ClientListKA: {
@@ -1370,28 +1350,29 @@ void ZoneServer::HandleMessage(uint16 opcode, const EQ::Net::Packet &p) {
 		client_list.SendPacket(buf->character_name, pack);
 		break;
 	}
-	case ServerOP_ExpeditionLockout:
-	case ServerOP_ExpeditionLockoutDuration:
-	case ServerOP_ExpeditionLockState:
 	case ServerOP_ExpeditionMemberStatus:
-	case ServerOP_ExpeditionReplayOnJoin:
-	case ServerOP_ExpeditionDzCompass:
-	case ServerOP_ExpeditionDzSafeReturn:
-	case ServerOP_ExpeditionDzZoneIn:
 	case ServerOP_ExpeditionExpireWarning:
 	{
 		zoneserver_list.SendPacket(pack);
 		break;
 	}
 	case ServerOP_ExpeditionChooseNewLeader:
-	case ServerOP_ExpeditionCreate:
-	case ServerOP_ExpeditionGetOnlineMembers:
+	case ServerOP_ExpeditionCreateRequest:
+	case ServerOP_ExpeditionLockout:
+	case ServerOP_ExpeditionLockoutDuration:
+	case ServerOP_ExpeditionLockState:
+	case ServerOP_ExpeditionReplayOnJoin:
 	case ServerOP_ExpeditionMemberChange:
 	case ServerOP_ExpeditionMemberSwap:
 	case ServerOP_ExpeditionMembersRemoved:
 	case ServerOP_ExpeditionDzAddPlayer:
 	case ServerOP_ExpeditionDzMakeLeader:
+	case ServerOP_ExpeditionDzCompass:
+	case ServerOP_ExpeditionDzSafeReturn:
+	case ServerOP_ExpeditionDzZoneIn:
 	case ServerOP_ExpeditionCharacterLockout:
+	case ServerOP_ExpeditionCharacterRequest:
+	case ServerOP_ExpeditionZoneRequest:
 	case ServerOP_ExpeditionSaveInvite:
 	case ServerOP_ExpeditionRequestInvite:
 	case ServerOP_ExpeditionSecondsRemaining:
@@ -1473,6 +1454,16 @@ void ZoneServer::SendKeepAlive()
 	SendPacket(&pack);
 }
 
+void ZoneServer::RequestClientListResync()
+{
+	LogInfo("Requesting a client list resync from zone [{}] at sequence [{}]", zone_server_id, client_list_sequence);
+
+	ServerPacket pack(ServerOP_ClientListResync, sizeof(ServerClientListResync_Struct));
+	auto resync = (ServerClientListResync_Struct*)pack.pBuffer;
+	resync->sequence = client_list_sequence;
+	SendPacket(&pack);
+}
+
 void ZoneServer::ChangeWID(uint32 iCharID, uint32 iWID) {
 	auto pack = new ServerPacket(ServerOP_ChangeWID, sizeof(ServerChangeWID_Struct));
 	ServerChangeWID_Struct* scw = (ServerChangeWID_Struct*)pack->pBuffer;
@@ -1487,6 +1478,7 @@ void ZoneServer::TriggerBootup(uint32 iZoneID, uint32 iInstanceID, const char* a
 	is_booting_up = true;
 	zone_server_zone_id = iZoneID;
 	instance_id = iInstanceID;
+	zoneserver_list.Reindex(this);
 
 	auto pack = new ServerPacket(ServerOP_ZoneBootup, sizeof(ServerZoneStateChange_struct));
 	ServerZoneStateChange_struct* s = (ServerZoneStateChange_struct *)pack->pBuffer;
@@ -1506,6 +1498,11 @@ void ZoneServer::TriggerBootup(uint32 iZoneID, uint32 iInstanceID, const char* a
 	LSBootUpdate(iZoneID, iInstanceID);
 }
 
+void ZoneServer::SetInstanceID(uint32 i) {
+	instance_id = i;
+	zoneserver_list.Reindex(this);
+}
+
 void ZoneServer::IncomingClient(Client* client) {
 	is_booting_up = true;
 	auto pack = new ServerPacket(ServerOP_ZoneIncClient, sizeof(ServerZoneIncomingClient_Struct));
@@ -1524,4 +1521,10 @@ void ZoneServer::IncomingClient(Client* client) {
 	strn0cpy(s->lskey, client->GetLSKey(), sizeof(s->lskey));
 	SendPacket(pack);
 	delete pack;
+
+	// zones build the client's group and raid from this, world is the only one that knows them
+	group_raid_state.SendCharacterRoster(this, client->GetCharID(), client->GetCharName());
+
+	// and its expedition and lockouts, so they're known before the client enters the zone
+	expedition_state.SendCharacterInfo(this, client->GetCharID());
 }
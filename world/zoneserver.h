@@ -40,6 +40,7 @@ public:
 	void		SendEmoteMessage(const char* to, uint32 to_guilddbid, int16 to_minstatus, uint32 type, const char* message, ...);
 	void		SendEmoteMessageRaw(const char* to, uint32 to_guilddbid, int16 to_minstatus, uint32 type, const char* message);
 	void		SendKeepAlive();
+	void		RequestClientListResync();
 	bool		SetZone(uint32 iZoneID, uint32 iInstanceID = 0, bool iStaticZone = false);
 	void		TriggerBootup(uint32 iZoneID = 0, uint32 iInstanceID = 0, const char* iAdminName = 0, bool iMakeStatic = false);
 	void		Disconnect() { auto handle = tcpc->Handle(); if (handle) { handle->Disconnect(); } }
@@ -69,12 +70,14 @@ public:
 	inline uint32		NumPlayers() const	{ return zone_player_count; }
 	inline void			AddPlayer()			{ zone_player_count++; }
 	inline void			RemovePlayer()		{ zone_player_count--; }
+	inline uint32		GetClientListSequence() const { return client_list_sequence; }
+	inline void			SetClientListSequence(uint32 sequence) { client_list_sequence = sequence; }
 	inline const char * GetLaunchName() const { return(launcher_name.c_str()); }
 	inline const char * GetLaunchedName() const { return(launched_name.c_str()); }
 	std::string         GetUUID() const { return tcpc->GetUUID(); }
 
 	inline uint32		GetInstanceID() { return instance_id; }
-	inline void			SetInstanceID(uint32 i) { instance_id = i; }
+	void				SetInstanceID(uint32 i);
 
 	inline uint32		GetZoneOSProcessID() { return zone_os_process_id; }
 
@@ -90,6 +93,7 @@ private:
 	bool	is_static_zone;
 	bool	is_authenticated;
 	uint32	zone_player_count;
+	uint32	client_list_sequence; // last client list update applied from this zone
 	char	compiled[25];
 	char	zone_name[32];
 	char	long_name[256];
@@ -34,7 +34,7 @@
 #include "map.h"
 #include "water_map.h"
 
-extern Zone* zone;
+extern Zone*& zone;
 //#define LOSDEBUG 6
 
 void EntityList::DescribeAggro(Client *towho, NPC *from_who, float d, bool verbose) {
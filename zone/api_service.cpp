@@ -31,9 +31,12 @@
 #include "object.h"
 #include "zone.h"
 #include "doors.h"
+#include "map.h"
+#include "zone_profiler.h"
+#include "zone_map_cache.h"
 #include <iostream>
 
-extern Zone *zone;
+extern Zone *&zone;
 
 /**
  * @param connection
@@ -829,6 +832,97 @@ Json::Value ApiGetZoneAttributes(EQ::Net::WebsocketServerConnection *connection,
 	return response;
 }
 
+Json::Value ApiGetLoSCacheStatistics(EQ::Net::WebsocketServerConnection *connection, Json::Value params)
+{
+	if (zone->GetZoneID() == 0) {
+		throw EQ::Net::WebsocketException("Zone must be loaded to invoke this call");
+	}
+
+	if (!zone->zonemap) {
+		throw EQ::Net::WebsocketException("Zone has no map loaded");
+	}
+
+	Json::Value response;
+	auto        stats   = zone->zonemap->GetLoSCacheStats();
+	auto        lookups = stats.hits + stats.misses;
+
+	response["enabled"]       = RuleB(Map, UseLoSCache);
+	response["entries"]       = stats.entries;
+	response["capacity"]      = RuleI(Map, LoSCacheSize);
+	response["hits"]          = static_cast<Json::UInt64>(stats.hits);
+	response["misses"]        = static_cast<Json::UInt64>(stats.misses);
+	response["evictions"]     = static_cast<Json::UInt64>(stats.evictions);
+	response["invalidations"] = static_cast<Json::UInt64>(stats.invalidations);
+	response["hit_rate"]      = lookups ? static_cast<double>(stats.hits) / static_cast<double>(lookups) : 0.0;
+
+	return response;
+}
+
+Json::Value ApiGetTickStatistics(EQ::Net::WebsocketServerConnection *connection, Json::Value params)
+{
+	if (zone->GetZoneID() == 0) {
+		throw EQ::Net::WebsocketException("Zone must be loaded to invoke this call");
+	}
+
+	Json::Value response;
+
+	response["enabled"]                = zone_profiler.IsEnabled();
+	response["ticks"]                  = static_cast<Json::UInt64>(zone_profiler.GetTicks());
+	response["slow_ticks"]             = static_cast<Json::UInt64>(zone_profiler.GetSlowTicks());
+	response["slow_tick_threshold_ms"] = RuleI(Zone, SlowTickThresholdMS);
+
+	for (int i = 0; i < ZoneProfiler::MaxPhase; i++) {
+		auto        phase     = static_cast<ZoneProfiler::Phase>(i);
+		const auto  &histogram = zone_profiler.GetHistogram(phase);
+		Json::Value row;
+
+		row["phase"]   = ZoneProfiler::GetPhaseName(phase);
+		row["count"]   = static_cast<Json::UInt64>(histogram.GetCount());
+		row["mean_us"] = histogram.GetMean();
+		row["p50_us"]  = static_cast<Json::UInt64>(histogram.GetPercentile(50));
+		row["p90_us"]  = static_cast<Json::UInt64>(histogram.GetPercentile(90));
+		row["p99_us"]  = static_cast<Json::UInt64>(histogram.GetPercentile(99));
+		row["p999_us"] = static_cast<Json::UInt64>(histogram.GetPercentile(99.9));
+		row["max_us"]  = static_cast<Json::UInt64>(histogram.GetMax());
+
+		response["phases"].append(row);
+	}
+
+	const auto &zone_in_packets = zone_profiler.GetZoneInPackets();
+	const auto &zone_in_time    = zone_profiler.GetZoneInTime();
+
+	response["zone_in"]["count"]        = static_cast<Json::UInt64>(zone_in_time.GetCount());
+	response["zone_in"]["packets_mean"] = zone_in_packets.GetMean();
+	response["zone_in"]["packets_max"]  = static_cast<Json::UInt64>(zone_in_packets.GetMax());
+	response["zone_in"]["time_p50_ms"]  = static_cast<Json::UInt64>(zone_in_time.GetPercentile(50));
+	response["zone_in"]["time_p99_ms"]  = static_cast<Json::UInt64>(zone_in_time.GetPercentile(99));
+	response["zone_in"]["time_max_ms"]  = static_cast<Json::UInt64>(zone_in_time.GetMax());
+
+	const auto &zone_boot_time = zone_profiler.GetZoneBootTime();
+
+	response["zone_boot"]["count"]       = static_cast<Json::UInt64>(zone_boot_time.GetCount());
+	response["zone_boot"]["time_p50_ms"] = static_cast<Json::UInt64>(zone_boot_time.GetPercentile(50));
+	response["zone_boot"]["time_max_ms"] = static_cast<Json::UInt64>(zone_boot_time.GetMax());
+	response["zone_boot"]["cached_maps"] = static_cast<Json::UInt64>(ZoneMapCache::Instance().Size());
+
+	for (auto &trace : zone_profiler.GetSlowTickTraces()) {
+		Json::Value row;
+
+		row["time"] = static_cast<Json::Int64>(trace.time_stamp);
+		row["tick"] = static_cast<Json::UInt64>(trace.tick_number);
+		for (int i = 0; i < ZoneProfiler::MaxPhase; i++) {
+			if (trace.phase_us[i] > 0) {
+				row["phases_us"][ZoneProfiler::GetPhaseName(static_cast<ZoneProfiler::Phase>(i))] =
+					static_cast<Json::UInt64>(trace.phase_us[i]);
+			}
+		}
+
+		response["slow_tick_traces"].append(row);
+	}
+
+	return response;
+}
+
 Json::Value ApiGetLogsysCategories(EQ::Net::WebsocketServerConnection *connection, Json::Value params)
 {
 	if (zone->GetZoneID() == 0) {
@@ -912,6 +1006,8 @@ void RegisterApiService(std::unique_ptr<EQ::Net::WebsocketServer> &server)
 	server->SetMethodHandler("get_mob_list_detail", &ApiGetMobListDetail, 50);
 	server->SetMethodHandler("get_client_list_detail", &ApiGetClientListDetail, 50);
 	server->SetMethodHandler("get_zone_attributes", &ApiGetZoneAttributes, 50);
+	server->SetMethodHandler("get_los_cache_statistics", &ApiGetLoSCacheStatistics, 50);
+	server->SetMethodHandler("get_tick_statistics", &ApiGetTickStatistics, 50);
 	server->SetMethodHandler("get_logsys_categories", &ApiGetLogsysCategories, 50);
 	server->SetMethodHandler("set_logging_level", &ApiSetLoggingLevel, 50);
 
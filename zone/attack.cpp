@@ -47,7 +47,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #endif
 
 extern QueryServ* QServ;
-extern WorldServer worldserver;
+extern WorldServer &worldserver;
 extern FastMath g_Math;
 
 #ifdef _WINDOWS
@@ -56,8 +56,8 @@ extern FastMath g_Math;
 #define strcasecmp	_stricmp
 #endif
 
-extern EntityList entity_list;
-extern Zone* zone;
+extern EntityList &entity_list;
+extern Zone*& zone;
 
 EQ::skills::SkillType Mob::AttackAnimation(int Hand, const EQ::ItemInstance* weapon, EQ::skills::SkillType skillinuse)
 {
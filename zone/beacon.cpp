@@ -47,8 +47,8 @@ class Zone;
 
 #include "../common/spdat.h"
 
-extern EntityList entity_list;
-extern Zone* zone;
+extern EntityList &entity_list;
+extern Zone*& zone;
 
 // if lifetime is 0 this is a permanent beacon.. not sure if that'll be
 // useful for anything
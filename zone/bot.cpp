@@ -45,6 +45,7 @@ Bot::Bot(NPCType *npcTypeData, Client* botOwner) : NPC(npcTypeData, nullptr, glm
 
 	_guildRank = 0;
 	_guildId = 0;
+	m_spell_index_generation = 0;
 	_lastTotalPlayTime = 0;
 	_startTotalPlayTime = time(&_startTotalPlayTime);
 	_lastZoneId = 0;
@@ -137,6 +138,7 @@ Bot::Bot(uint32 botID, uint32 botOwnerCharacterID, uint32 botSpellsID, double to
 
 	_guildRank = 0;
 	_guildId = 0;
+	m_spell_index_generation = 0;
 	_lastTotalPlayTime = totalPlayTime;
 	_startTotalPlayTime = time(&_startTotalPlayTime);
 	_lastZoneId = lastZoneId;
@@ -4208,7 +4210,7 @@ void Bot::LoadAndSpawnAllZonedBots(Client* botOwner) {
 							activeBot->SetFollowID(botOwner->GetID());
 
 						if(!botOwner->HasGroup())
-							database.SetGroupID(activeBot->GetCleanName(), 0, activeBot->GetBotID());
+							Group::SendWorldGroupID(activeBot->GetCleanName(), 0, activeBot->GetBotID());
 					}
 				}
 			}
@@ -4485,7 +4487,7 @@ bool Bot::RemoveBotFromGroup(Bot* bot, Group* group) {
 			if(!group->IsLeader(bot)) {
 				bot->SetFollowID(0);
 				if(group->DelMember(bot))
-					database.SetGroupID(bot->GetCleanName(), 0, bot->GetBotID());
+					Group::SendWorldGroupID(bot->GetCleanName(), 0, bot->GetBotID());
 			} else {
 				for(int i = 0; i < MAX_GROUP_MEMBERS; i++) {
 					if(!group->members[i])
@@ -4494,7 +4496,7 @@ bool Bot::RemoveBotFromGroup(Bot* bot, Group* group) {
 					group->members[i]->SetFollowID(0);
 				}
 				group->DisbandGroup();
-				database.SetGroupID(bot->GetCleanName(), 0, bot->GetBotID());
+				Group::SendWorldGroupID(bot->GetCleanName(), 0, bot->GetBotID());
 			}
 			Result = true;
 		}
@@ -8603,12 +8605,12 @@ void Bot::ProcessBotGroupInvite(Client* c, std::string botName) {
 					entity_list.AddGroup(g);
 					database.SetGroupLeaderName(g->GetID(), c->GetName());
 					g->SaveGroupLeaderAA();
-					database.SetGroupID(c->GetName(), g->GetID(), c->CharacterID());
-					database.SetGroupID(invitedBot->GetCleanName(), g->GetID(), invitedBot->GetBotID());
+					Group::SendWorldGroupID(c->GetName(), g->GetID(), c->CharacterID());
+					Group::SendWorldGroupID(invitedBot->GetCleanName(), g->GetID(), invitedBot->GetBotID());
 				}
 			} else {
 				AddBotToGroup(invitedBot, c->GetGroup());
-				database.SetGroupID(invitedBot->GetCleanName(), c->GetGroup()->GetID(), invitedBot->GetBotID());
+				Group::SendWorldGroupID(invitedBot->GetCleanName(), c->GetGroup()->GetID(), invitedBot->GetBotID());
 			}
 		}
 	}
@@ -47,7 +47,7 @@ constexpr uint32 BOT_KEEP_ALIVE_INTERVAL = 5000; // 5 seconds
 //constexpr uint32 BOT_COMBAT_JITTER_INTERVAL_MIN = 5000; // 5 seconds
 //constexpr uint32 BOT_COMBAT_JITTER_INTERVAL_MAX = 20000; // 20 seconds
 
-extern WorldServer worldserver;
+extern WorldServer &worldserver;
 
 constexpr int BotAISpellRange = 100; // TODO: Write a method that calcs what the bot's spell range is based on spell, equipment, AA, whatever and replace this
 constexpr int MaxSpellTimer = 15;
@@ -221,7 +221,7 @@ public:
 	virtual void AddToHateList(Mob* other, uint32 hate = 0, int32 damage = 0, bool iYellForHelp = true, bool bFrenzy = false, bool iBuffTic = false, bool pet_command = false);
 	virtual void SetTarget(Mob* mob);
 	virtual void Zone();
-	std::vector<AISpells_Struct> GetBotSpells() { return AIspells; }
+	const std::vector<AISpells_Struct>& GetBotSpells() const { return AIspells; }
 	bool IsArcheryRange(Mob* target);
 	void ChangeBotArcherWeapons(bool isArcher);
 	void Sit();
@@ -379,10 +379,11 @@ public:
 	static bool CheckDisciplineRecastTimers(Bot *caster, int timer_index);
 	static uint32 GetDisciplineRemainingTime(Bot *caster, int timer_index);
 
-	static std::list<BotSpell> GetBotSpellsForSpellEffect(Bot* botCaster, int spellEffect);
-	static std::list<BotSpell> GetBotSpellsForSpellEffectAndTargetType(Bot* botCaster, int spellEffect, SpellTargetType targetType);
-	static std::list<BotSpell> GetBotSpellsBySpellType(Bot* botCaster, uint32 spellType);
-	static std::list<BotSpell_wPriority> GetPrioritizedBotSpellsBySpellType(Bot* botCaster, uint32 spellType);
+	// These return views into the caster's spell index; they stay valid until its spell list changes
+	static const std::vector<BotSpell>& GetBotSpellsForSpellEffect(Bot* botCaster, int spellEffect);
+	static const std::vector<BotSpell>& GetBotSpellsForSpellEffectAndTargetType(Bot* botCaster, int spellEffect, SpellTargetType targetType);
+	static const std::vector<BotSpell>& GetBotSpellsBySpellType(Bot* botCaster, uint32 spellType);
+	static const std::vector<BotSpell_wPriority>& GetPrioritizedBotSpellsBySpellType(Bot* botCaster, uint32 spellType);
 
 	static BotSpell GetFirstBotSpellBySpellType(Bot* botCaster, uint32 spellType);
 	static BotSpell GetBestBotSpellForFastHeal(Bot* botCaster);
@@ -702,8 +703,16 @@ private:
 	uint16 _baseRace;	// Necessary to preserve the race otherwise bots get their race updated in the db when they get an illusion.
 	uint8 _baseGender;	// Bots gender. Necessary to preserve the original value otherwise it can be changed by illusions.
 
+	// Spell index, filled per query key and flushed when AIspells_generation moves
+	uint32 m_spell_index_generation;
+	std::unordered_map<int, std::vector<BotSpell>> m_spells_by_effect;
+	std::unordered_map<uint64, std::vector<BotSpell>> m_spells_by_effect_and_target;
+	std::unordered_map<uint32, std::vector<BotSpell>> m_spells_by_type;
+	std::unordered_map<uint32, std::vector<BotSpell_wPriority>> m_prioritized_spells_by_type;
+
 	// Class Methods
 	void LoadAAs();
+	void ValidateBotSpellIndex();
 	int32 acmod();
 	void GenerateBaseStats();
 	void GenerateAppearance();
@@ -75,7 +75,7 @@
 #include <fmt/format.h>
 
 extern QueryServ* QServ;
-extern WorldServer worldserver;
+extern WorldServer &worldserver;
 extern TaskManager *taskmanager;
 void CatchSignal(int sig_num);
 
@@ -6619,7 +6619,7 @@ void bot_subcommand_botgroup_add_member(Client *c, const Seperator *sep)
 		return;
 	}
 
-	database.SetGroupID(new_member->GetName(), group_inst->GetID(), new_member->GetBotID());
+	Group::SendWorldGroupID(new_member->GetName(), group_inst->GetID(), new_member->GetBotID());
 
 	if (!database.botdb.AddMemberToBotGroup(botgroup_leader->GetBotID(), new_member->GetBotID())) {
 		c->Message(m_fail, "%s - %s->%s", BotDatabase::fail::AddMemberToBotGroup(), new_member->GetCleanName(), botgroup_leader->GetCleanName());
@@ -6712,7 +6712,7 @@ void bot_subcommand_botgroup_create(Client *c, const Seperator *sep)
 	}
 
 	entity_list.AddGroup(group_inst);
-	database.SetGroupID(botgroup_leader->GetCleanName(), group_inst->GetID(), botgroup_leader->GetBotID());
+	Group::SendWorldGroupID(botgroup_leader->GetCleanName(), group_inst->GetID(), botgroup_leader->GetBotID());
 	database.SetGroupLeaderName(group_inst->GetID(), botgroup_leader->GetCleanName());
 	botgroup_leader->SetFollowID(c->GetID());
 
@@ -6930,7 +6930,7 @@ void bot_subcommand_botgroup_load(Client *c, const Seperator *sep)
 	Group* group_inst = new Group(botgroup_leader);
 
 	entity_list.AddGroup(group_inst);
-	database.SetGroupID(botgroup_leader->GetCleanName(), group_inst->GetID(), botgroup_leader->GetBotID());
+	Group::SendWorldGroupID(botgroup_leader->GetCleanName(), group_inst->GetID(), botgroup_leader->GetBotID());
 	database.SetGroupLeaderName(group_inst->GetID(), botgroup_leader->GetCleanName());
 	botgroup_leader->SetFollowID(c->GetID());
 
@@ -314,9 +314,9 @@ bool Bot::AICastSpell(Mob* tar, uint8 iChance, uint32 iSpellTypes) {
 		}
 		case SpellType_Buff: {
 			if (tar->DontBuffMeBefore() < Timer::GetCurrentTime()) {
-				std::list<BotSpell> buffSpellList = GetBotSpellsBySpellType(this, SpellType_Buff);
+				const std::vector<BotSpell> &buffSpellList = GetBotSpellsBySpellType(this, SpellType_Buff);
 
-				for(std::list<BotSpell>::iterator itr = buffSpellList.begin(); itr != buffSpellList.end(); ++itr) {
+				for(std::vector<BotSpell>::const_iterator itr = buffSpellList.begin(); itr != buffSpellList.end(); ++itr) {
 					BotSpell selectedBotSpell = *itr;
 
 					if(selectedBotSpell.SpellId == 0)
@@ -596,9 +596,9 @@ bool Bot::AICastSpell(Mob* tar, uint8 iChance, uint32 iSpellTypes) {
 			if(botClass == SHAMAN) {
 				checked_los = true;
 
-				std::list<BotSpell> inCombatBuffList = GetBotSpellsBySpellType(this, SpellType_InCombatBuff);
+				const std::vector<BotSpell> &inCombatBuffList = GetBotSpellsBySpellType(this, SpellType_InCombatBuff);
 
-				for(std::list<BotSpell>::iterator itr = inCombatBuffList.begin(); itr != inCombatBuffList.end(); ++itr) {
+				for(std::vector<BotSpell>::const_iterator itr = inCombatBuffList.begin(); itr != inCombatBuffList.end(); ++itr) {
 					BotSpell selectedBotSpell = *itr;
 
 					if(selectedBotSpell.SpellId == 0)
@@ -624,9 +624,9 @@ bool Bot::AICastSpell(Mob* tar, uint8 iChance, uint32 iSpellTypes) {
 			}
 			else if(botClass == BARD) { 
 				if (tar->DontBuffMeBefore() < Timer::GetCurrentTime()) {
-					std::list<BotSpell> inCombatBuffList = GetBotSpellsBySpellType(this, SpellType_InCombatBuff);
+					const std::vector<BotSpell> &inCombatBuffList = GetBotSpellsBySpellType(this, SpellType_InCombatBuff);
 
-					for(std::list<BotSpell>::iterator itr = inCombatBuffList.begin(); itr != inCombatBuffList.end(); ++itr) {
+					for(std::vector<BotSpell>::const_iterator itr = inCombatBuffList.begin(); itr != inCombatBuffList.end(); ++itr) {
 						BotSpell selectedBotSpell = *itr;
 
 						if(selectedBotSpell.SpellId == 0)
@@ -761,12 +761,12 @@ bool Bot::AICastSpell(Mob* tar, uint8 iChance, uint32 iSpellTypes) {
 				}
 
 				if (GetClass() == BARD) {
-					std::list<BotSpell_wPriority> dotList = GetPrioritizedBotSpellsBySpellType(this, SpellType_DOT);
+					const std::vector<BotSpell_wPriority> &dotList = GetPrioritizedBotSpellsBySpellType(this, SpellType_DOT);
 
 					const int maxDotSelect = 5;
 					int dotSelectCounter = 0;
 
-					for (std::list<BotSpell_wPriority>::iterator itr = dotList.begin(); itr != dotList.end(); ++itr) {
+					for (std::vector<BotSpell_wPriority>::const_iterator itr = dotList.begin(); itr != dotList.end(); ++itr) {
 						BotSpell selectedBotSpell = *itr;
 
 						if (selectedBotSpell.SpellId == 0)
@@ -793,12 +793,12 @@ bool Bot::AICastSpell(Mob* tar, uint8 iChance, uint32 iSpellTypes) {
 					}
 				}
 				else {
-					std::list<BotSpell> dotList = GetBotSpellsBySpellType(this, SpellType_DOT);
+					const std::vector<BotSpell> &dotList = GetBotSpellsBySpellType(this, SpellType_DOT);
 
 					const int maxDotSelect = 5;
 					int dotSelectCounter = 0;
 
-					for (std::list<BotSpell>::iterator itr = dotList.begin(); itr != dotList.end(); ++itr) {
+					for (std::vector<BotSpell>::const_iterator itr = dotList.begin(); itr != dotList.end(); ++itr) {
 						BotSpell selectedBotSpell = *itr;
 
 						if (selectedBotSpell.SpellId == 0)
@@ -840,7 +840,7 @@ bool Bot::AICastSpell(Mob* tar, uint8 iChance, uint32 iSpellTypes) {
 				switch (botClass) {
 					case BARD: {
 						// probably needs attackable check
-						std::list<BotSpell_wPriority> botSongList = GetPrioritizedBotSpellsBySpellType(this, SpellType_Slow);
+						const std::vector<BotSpell_wPriority> &botSongList = GetPrioritizedBotSpellsBySpellType(this, SpellType_Slow);
 						for (auto iter : botSongList) {
 							if (!iter.SpellId)
 								continue;
@@ -956,7 +956,7 @@ bool Bot::AICastSpell(Mob* tar, uint8 iChance, uint32 iSpellTypes) {
 		case SpellType_HateRedux: {
 			// assumed group member at this point
 			if (GetClass() == BARD) {
-				std::list<BotSpell_wPriority> botSongList = GetPrioritizedBotSpellsBySpellType(this, SpellType_HateRedux);
+				const std::vector<BotSpell_wPriority> &botSongList = GetPrioritizedBotSpellsBySpellType(this, SpellType_HateRedux);
 				for (auto iter : botSongList) {
 					if (!iter.SpellId)
 						continue;
@@ -983,7 +983,7 @@ bool Bot::AICastSpell(Mob* tar, uint8 iChance, uint32 iSpellTypes) {
 			if (GetClass() != BARD || tar != this) // In-Combat songs can be cast Out-of-Combat in preparation for battle
 				break;
 
-			std::list<BotSpell_wPriority> botSongList = GetPrioritizedBotSpellsBySpellType(this, SpellType_InCombatBuffSong);
+			const std::vector<BotSpell_wPriority> &botSongList = GetPrioritizedBotSpellsBySpellType(this, SpellType_InCombatBuffSong);
 			for (auto iter : botSongList) {
 				if (!iter.SpellId)
 					continue;
@@ -1015,7 +1015,7 @@ bool Bot::AICastSpell(Mob* tar, uint8 iChance, uint32 iSpellTypes) {
 			if (GetClass() != BARD || tar != this || IsEngaged()) // Out-of-Combat songs can not be cast in combat
 				break;
 
-			std::list<BotSpell_wPriority> botSongList = GetPrioritizedBotSpellsBySpellType(this, SpellType_OutOfCombatBuffSong);
+			const std::vector<BotSpell_wPriority> &botSongList = GetPrioritizedBotSpellsBySpellType(this, SpellType_OutOfCombatBuffSong);
 			for (auto iter : botSongList) {
 				if (!iter.SpellId)
 					continue;
@@ -1589,117 +1589,149 @@ bool Bot::AIHealRotation(Mob* tar, bool useFastHeals) {
 	return castedSpell;
 }
 
-std::list<BotSpell> Bot::GetBotSpellsForSpellEffect(Bot* botCaster, int spellEffect) {
-	std::list<BotSpell> result;
+// Drops every cached spell view once the underlying AIspells list has been reloaded or edited
+void Bot::ValidateBotSpellIndex() {
+	if (m_spell_index_generation == AIspells_generation)
+		return;
 
-	if(botCaster && botCaster->AI_HasSpells()) {
-		std::vector<AISpells_Struct> botSpellList = botCaster->GetBotSpells();
+	m_spells_by_effect.clear();
+	m_spells_by_effect_and_target.clear();
+	m_spells_by_type.clear();
+	m_prioritized_spells_by_type.clear();
+	m_spell_index_generation = AIspells_generation;
+}
 
-		for (int i = botSpellList.size() - 1; i >= 0; i--) {
-			if (botSpellList[i].spellid <= 0 || botSpellList[i].spellid >= SPDAT_RECORDS) {
-				// this is both to quit early to save cpu and to avoid casting bad spells
-				// Bad info from database can trigger this incorrectly, but that should be fixed in DB, not here
-				continue;
-			}
+// Views are filled on first use and preserve the old reverse list order, which is descending by level
+const std::vector<BotSpell>& Bot::GetBotSpellsForSpellEffect(Bot* botCaster, int spellEffect) {
+	static const std::vector<BotSpell> empty;
 
-			if(IsEffectInSpell(botSpellList[i].spellid, spellEffect)) {
-				BotSpell botSpell;
-				botSpell.SpellId = botSpellList[i].spellid;
-				botSpell.SpellIndex = i;
-				botSpell.ManaCost = botSpellList[i].manacost;
+	if (!botCaster || !botCaster->AI_HasSpells())
+		return empty;
 
-				result.push_back(botSpell);
-			}
+	botCaster->ValidateBotSpellIndex();
+
+	auto iter = botCaster->m_spells_by_effect.find(spellEffect);
+	if (iter != botCaster->m_spells_by_effect.end())
+		return iter->second;
+
+	std::vector<BotSpell> &result = botCaster->m_spells_by_effect[spellEffect];
+	const std::vector<AISpells_Struct> &botSpellList = botCaster->AIspells;
+
+	for (int i = botSpellList.size() - 1; i >= 0; i--) {
+		if (botSpellList[i].spellid <= 0 || botSpellList[i].spellid >= SPDAT_RECORDS) {
+			// this is both to quit early to save cpu and to avoid casting bad spells
+			// Bad info from database can trigger this incorrectly, but that should be fixed in DB, not here
+			continue;
+		}
+
+		if(IsEffectInSpell(botSpellList[i].spellid, spellEffect)) {
+			BotSpell botSpell;
+			botSpell.SpellId = botSpellList[i].spellid;
+			botSpell.SpellIndex = i;
+			botSpell.ManaCost = botSpellList[i].manacost;
+
+			result.push_back(botSpell);
 		}
 	}
 
 	return result;
 }
 
-std::list<BotSpell> Bot::GetBotSpellsForSpellEffectAndTargetType(Bot* botCaster, int spellEffect, SpellTargetType targetType) {
-	std::list<BotSpell> result;
+const std::vector<BotSpell>& Bot::GetBotSpellsForSpellEffectAndTargetType(Bot* botCaster, int spellEffect, SpellTargetType targetType) {
+	static const std::vector<BotSpell> empty;
 
-	if(botCaster && botCaster->AI_HasSpells()) {
-		std::vector<AISpells_Struct> botSpellList = botCaster->GetBotSpells();
+	if (!botCaster || !botCaster->AI_HasSpells())
+		return empty;
 
-		for (int i = botSpellList.size() - 1; i >= 0; i--) {
-			if (botSpellList[i].spellid <= 0 || botSpellList[i].spellid >= SPDAT_RECORDS) {
-				// this is both to quit early to save cpu and to avoid casting bad spells
-				// Bad info from database can trigger this incorrectly, but that should be fixed in DB, not here
-				continue;
-			}
+	botCaster->ValidateBotSpellIndex();
 
-			if(IsEffectInSpell(botSpellList[i].spellid, spellEffect)) {
-				if(spells[botSpellList[i].spellid].targettype == targetType) {
-					BotSpell botSpell;
-					botSpell.SpellId = botSpellList[i].spellid;
-					botSpell.SpellIndex = i;
-					botSpell.ManaCost = botSpellList[i].manacost;
+	uint64 key = (static_cast<uint64>(static_cast<uint32>(spellEffect)) << 32) | static_cast<uint32>(targetType);
+	auto iter = botCaster->m_spells_by_effect_and_target.find(key);
+	if (iter != botCaster->m_spells_by_effect_and_target.end())
+		return iter->second;
 
-					result.push_back(botSpell);
-				}
-			}
-		}
+	const std::vector<BotSpell> &effectList = GetBotSpellsForSpellEffect(botCaster, spellEffect);
+	std::vector<BotSpell> &result = botCaster->m_spells_by_effect_and_target[key];
+
+	for (const auto &botSpell : effectList) {
+		if(spells[botSpell.SpellId].targettype == targetType)
+			result.push_back(botSpell);
 	}
 
 	return result;
 }
 
-std::list<BotSpell> Bot::GetBotSpellsBySpellType(Bot* botCaster, uint32 spellType) {
-	std::list<BotSpell> result;
+const std::vector<BotSpell>& Bot::GetBotSpellsBySpellType(Bot* botCaster, uint32 spellType) {
+	static const std::vector<BotSpell> empty;
 
-	if(botCaster && botCaster->AI_HasSpells()) {
-		std::vector<AISpells_Struct> botSpellList = botCaster->GetBotSpells();
+	if (!botCaster || !botCaster->AI_HasSpells())
+		return empty;
 
-		for (int i = botSpellList.size() - 1; i >= 0; i--) {
-			if (botSpellList[i].spellid <= 0 || botSpellList[i].spellid >= SPDAT_RECORDS) {
-				// this is both to quit early to save cpu and to avoid casting bad spells
-				// Bad info from database can trigger this incorrectly, but that should be fixed in DB, not here
-				continue;
-			}
+	botCaster->ValidateBotSpellIndex();
 
-			if(botSpellList[i].type & spellType) {
-				BotSpell botSpell;
-				botSpell.SpellId = botSpellList[i].spellid;
-				botSpell.SpellIndex = i;
-				botSpell.ManaCost = botSpellList[i].manacost;
+	auto iter = botCaster->m_spells_by_type.find(spellType);
+	if (iter != botCaster->m_spells_by_type.end())
+		return iter->second;
 
-				result.push_back(botSpell);
-			}
+	std::vector<BotSpell> &result = botCaster->m_spells_by_type[spellType];
+	const std::vector<AISpells_Struct> &botSpellList = botCaster->AIspells;
+
+	for (int i = botSpellList.size() - 1; i >= 0; i--) {
+		if (botSpellList[i].spellid <= 0 || botSpellList[i].spellid >= SPDAT_RECORDS) {
+			// this is both to quit early to save cpu and to avoid casting bad spells
+			// Bad info from database can trigger this incorrectly, but that should be fixed in DB, not here
+			continue;
+		}
+
+		if(botSpellList[i].type & spellType) {
+			BotSpell botSpell;
+			botSpell.SpellId = botSpellList[i].spellid;
+			botSpell.SpellIndex = i;
+			botSpell.ManaCost = botSpellList[i].manacost;
+
+			result.push_back(botSpell);
 		}
 	}
 
 	return result;
 }
 
-std::list<BotSpell_wPriority> Bot::GetPrioritizedBotSpellsBySpellType(Bot* botCaster, uint32 spellType) {
-	std::list<BotSpell_wPriority> result;
+const std::vector<BotSpell_wPriority>& Bot::GetPrioritizedBotSpellsBySpellType(Bot* botCaster, uint32 spellType) {
+	static const std::vector<BotSpell_wPriority> empty;
 
-	if (botCaster && botCaster->AI_HasSpells()) {
-		std::vector<AISpells_Struct> botSpellList = botCaster->GetBotSpells();
+	if (!botCaster || !botCaster->AI_HasSpells())
+		return empty;
 
-		for (int i = botSpellList.size() - 1; i >= 0; i--) {
-			if (botSpellList[i].spellid <= 0 || botSpellList[i].spellid >= SPDAT_RECORDS) {
-				// this is both to quit early to save cpu and to avoid casting bad spells
-				// Bad info from database can trigger this incorrectly, but that should be fixed in DB, not here
-				continue;
-			}
+	botCaster->ValidateBotSpellIndex();
 
-			if (botSpellList[i].type & spellType) {
-				BotSpell_wPriority botSpell;
-				botSpell.SpellId = botSpellList[i].spellid;
-				botSpell.SpellIndex = i;
-				botSpell.ManaCost = botSpellList[i].manacost;
-				botSpell.Priority = botSpellList[i].priority;
+	auto iter = botCaster->m_prioritized_spells_by_type.find(spellType);
+	if (iter != botCaster->m_prioritized_spells_by_type.end())
+		return iter->second;
 
-				result.push_back(botSpell);
-			}
+	std::vector<BotSpell_wPriority> &result = botCaster->m_prioritized_spells_by_type[spellType];
+	const std::vector<AISpells_Struct> &botSpellList = botCaster->AIspells;
+
+	for (int i = botSpellList.size() - 1; i >= 0; i--) {
+		if (botSpellList[i].spellid <= 0 || botSpellList[i].spellid >= SPDAT_RECORDS) {
+			// this is both to quit early to save cpu and to avoid casting bad spells
+			// Bad info from database can trigger this incorrectly, but that should be fixed in DB, not here
+			continue;
 		}
 
-		if (result.size() > 1)
-			result.sort([](BotSpell_wPriority& l, BotSpell_wPriority& r) { return l.Priority < r.Priority; });
+		if (botSpellList[i].type & spellType) {
+			BotSpell_wPriority botSpell;
+			botSpell.SpellId = botSpellList[i].spellid;
+			botSpell.SpellIndex = i;
+			botSpell.ManaCost = botSpellList[i].manacost;
+			botSpell.Priority = botSpellList[i].priority;
+
+			result.push_back(botSpell);
+		}
 	}
 
+	if (result.size() > 1)
+		std::stable_sort(result.begin(), result.end(), [](const BotSpell_wPriority& l, const BotSpell_wPriority& r) { return l.Priority < r.Priority; });
+
 	return result;
 }
 
@@ -1710,20 +1742,12 @@ BotSpell Bot::GetFirstBotSpellBySpellType(Bot* botCaster, uint32 spellType) {
 	result.SpellIndex = 0;
 	result.ManaCost = 0;
 
-	if(botCaster && botCaster->AI_HasSpells()) {
-		std::vector<AISpells_Struct> botSpellList = botCaster->GetBotSpells();
-
-		for (int i = botSpellList.size() - 1; i >= 0; i--) {
-			if (botSpellList[i].spellid <= 0 || botSpellList[i].spellid >= SPDAT_RECORDS) {
-				// this is both to quit early to save cpu and to avoid casting bad spells
-				// Bad info from database can trigger this incorrectly, but that should be fixed in DB, not here
-				continue;
-			}
+	if(botCaster) {
+		const std::vector<BotSpell> &botSpellList = GetBotSpellsBySpellType(botCaster, spellType);
 
-			if((botSpellList[i].type & spellType) && CheckSpellRecastTimers(botCaster, i)) {
-				result.SpellId = botSpellList[i].spellid;
-				result.SpellIndex = i;
-				result.ManaCost = botSpellList[i].manacost;
+		for (const auto &botSpell : botSpellList) {
+			if(CheckSpellRecastTimers(botCaster, botSpell.SpellIndex)) {
+				result = botSpell;
 
 				break;
 			}
@@ -1741,9 +1765,9 @@ BotSpell Bot::GetBestBotSpellForFastHeal(Bot *botCaster) {
 	result.ManaCost = 0;
 
 	if(botCaster) {
-		std::list<BotSpell> botSpellList = GetBotSpellsForSpellEffect(botCaster, SE_CurrentHP);
+		const std::vector<BotSpell> &botSpellList = GetBotSpellsForSpellEffect(botCaster, SE_CurrentHP);
 
-		for(std::list<BotSpell>::iterator botSpellListItr = botSpellList.begin(); botSpellListItr != botSpellList.end(); ++botSpellListItr) {
+		for(std::vector<BotSpell>::const_iterator botSpellListItr = botSpellList.begin(); botSpellListItr != botSpellList.end(); ++botSpellListItr) {
 			// Assuming all the spells have been loaded into this list by level and in descending order
 			if(IsFastHealSpell(botSpellListItr->SpellId) && CheckSpellRecastTimers(botCaster, botSpellListItr->SpellIndex)) {
 				result.SpellId = botSpellListItr->SpellId;
@@ -1766,10 +1790,10 @@ BotSpell Bot::GetBestBotSpellForHealOverTime(Bot* botCaster) {
 	result.ManaCost = 0;
 
 	if(botCaster) {
-		std::list<BotSpell> botHoTSpellList = GetBotSpellsForSpellEffect(botCaster, SE_HealOverTime);
-		std::vector<AISpells_Struct> botSpellList = botCaster->GetBotSpells();
+		const std::vector<BotSpell> &botHoTSpellList = GetBotSpellsForSpellEffect(botCaster, SE_HealOverTime);
+		const std::vector<AISpells_Struct> &botSpellList = botCaster->GetBotSpells();
 
-		for(std::list<BotSpell>::iterator botSpellListItr = botHoTSpellList.begin(); botSpellListItr != botHoTSpellList.end(); ++botSpellListItr) {
+		for(std::vector<BotSpell>::const_iterator botSpellListItr = botHoTSpellList.begin(); botSpellListItr != botHoTSpellList.end(); ++botSpellListItr) {
 			// Assuming all the spells have been loaded into this list by level and in descending order
 			if(IsHealOverTimeSpell(botSpellListItr->SpellId)) {
 
@@ -1803,7 +1827,7 @@ BotSpell Bot::GetBestBotSpellForPercentageHeal(Bot *botCaster) {
 	result.ManaCost = 0;
 
 	if(botCaster && botCaster->AI_HasSpells()) {
-		std::vector<AISpells_Struct> botSpellList = botCaster->GetBotSpells();
+		const std::vector<AISpells_Struct> &botSpellList = botCaster->GetBotSpells();
 
 		for (int i = botSpellList.size() - 1; i >= 0; i--) {
 			if (botSpellList[i].spellid <= 0 || botSpellList[i].spellid >= SPDAT_RECORDS) {
@@ -1833,9 +1857,9 @@ BotSpell Bot::GetBestBotSpellForRegularSingleTargetHeal(Bot* botCaster) {
 	result.ManaCost = 0;
 
 	if(botCaster) {
-		std::list<BotSpell> botSpellList = GetBotSpellsForSpellEffect(botCaster, SE_CurrentHP);
+		const std::vector<BotSpell> &botSpellList = GetBotSpellsForSpellEffect(botCaster, SE_CurrentHP);
 
-		for(std::list<BotSpell>::iterator botSpellListItr = botSpellList.begin(); botSpellListItr != botSpellList.end(); ++botSpellListItr) {
+		for(std::vector<BotSpell>::const_iterator botSpellListItr = botSpellList.begin(); botSpellListItr != botSpellList.end(); ++botSpellListItr) {
 			// Assuming all the spells have been loaded into this list by level and in descending order
 			if(IsRegularSingleTargetHealSpell(botSpellListItr->SpellId) && CheckSpellRecastTimers(botCaster, botSpellListItr->SpellIndex)) {
 				result.SpellId = botSpellListItr->SpellId;
@@ -1858,9 +1882,9 @@ BotSpell Bot::GetFirstBotSpellForSingleTargetHeal(Bot* botCaster) {
 	result.ManaCost = 0;
 
 	if(botCaster) {
-		std::list<BotSpell> botSpellList = GetBotSpellsForSpellEffect(botCaster, SE_CurrentHP);
+		const std::vector<BotSpell> &botSpellList = GetBotSpellsForSpellEffect(botCaster, SE_CurrentHP);
 
-		for(std::list<BotSpell>::iterator botSpellListItr = botSpellList.begin(); botSpellListItr != botSpellList.end(); ++botSpellListItr) {
+		for(std::vector<BotSpell>::const_iterator botSpellListItr = botSpellList.begin(); botSpellListItr != botSpellList.end(); ++botSpellListItr) {
 			// Assuming all the spells have been loaded into this list by level and in descending order
 			if((IsRegularSingleTargetHealSpell(botSpellListItr->SpellId) || IsFastHealSpell(botSpellListItr->SpellId)) && CheckSpellRecastTimers(botCaster, botSpellListItr->SpellIndex)) {
 				result.SpellId = botSpellListItr->SpellId;
@@ -1883,9 +1907,9 @@ BotSpell Bot::GetBestBotSpellForGroupHeal(Bot* botCaster) {
 	result.ManaCost = 0;
 
 	if(botCaster) {
-		std::list<BotSpell> botSpellList = GetBotSpellsForSpellEffect(botCaster, SE_CurrentHP);
+		const std::vector<BotSpell> &botSpellList = GetBotSpellsForSpellEffect(botCaster, SE_CurrentHP);
 
-		for(std::list<BotSpell>::iterator botSpellListItr = botSpellList.begin(); botSpellListItr != botSpellList.end(); ++botSpellListItr) {
+		for(std::vector<BotSpell>::const_iterator botSpellListItr = botSpellList.begin(); botSpellListItr != botSpellList.end(); ++botSpellListItr) {
 			// Assuming all the spells have been loaded into this list by level and in descending order
 			if(IsRegularGroupHealSpell(botSpellListItr->SpellId) && CheckSpellRecastTimers(botCaster, botSpellListItr->SpellIndex)) {
 				result.SpellId = botSpellListItr->SpellId;
@@ -1908,10 +1932,10 @@ BotSpell Bot::GetBestBotSpellForGroupHealOverTime(Bot* botCaster) {
 	result.ManaCost = 0;
 
 	if(botCaster) {
-		std::list<BotSpell> botHoTSpellList = GetBotSpellsForSpellEffect(botCaster, SE_HealOverTime);
-		std::vector<AISpells_Struct> botSpellList = botCaster->GetBotSpells();
+		const std::vector<BotSpell> &botHoTSpellList = GetBotSpellsForSpellEffect(botCaster, SE_HealOverTime);
+		const std::vector<AISpells_Struct> &botSpellList = botCaster->GetBotSpells();
 
-		for(std::list<BotSpell>::iterator botSpellListItr = botHoTSpellList.begin(); botSpellListItr != botHoTSpellList.end(); ++botSpellListItr) {
+		for(std::vector<BotSpell>::const_iterator botSpellListItr = botHoTSpellList.begin(); botSpellListItr != botHoTSpellList.end(); ++botSpellListItr) {
 			// Assuming all the spells have been loaded into this list by level and in descending order
 			if(IsGroupHealOverTimeSpell(botSpellListItr->SpellId)) {
 
@@ -1945,9 +1969,9 @@ BotSpell Bot::GetBestBotSpellForGroupCompleteHeal(Bot* botCaster) {
 	result.ManaCost = 0;
 
 	if(botCaster) {
-		std::list<BotSpell> botSpellList = GetBotSpellsForSpellEffect(botCaster, SE_CompleteHeal);
+		const std::vector<BotSpell> &botSpellList = GetBotSpellsForSpellEffect(botCaster, SE_CompleteHeal);
 
-		for(std::list<BotSpell>::iterator botSpellListItr = botSpellList.begin(); botSpellListItr != botSpellList.end(); ++botSpellListItr) {
+		for(std::vector<BotSpell>::const_iterator botSpellListItr = botSpellList.begin(); botSpellListItr != botSpellList.end(); ++botSpellListItr) {
 			// Assuming all the spells have been loaded into this list by level and in descending order
 			if(IsGroupCompleteHealSpell(botSpellListItr->SpellId) && CheckSpellRecastTimers(botCaster, botSpellListItr->SpellIndex)) {
 				result.SpellId = botSpellListItr->SpellId;
@@ -1970,9 +1994,9 @@ BotSpell Bot::GetBestBotSpellForMez(Bot* botCaster) {
 	result.ManaCost = 0;
 
 	if(botCaster) {
-		std::list<BotSpell> botSpellList = GetBotSpellsForSpellEffect(botCaster, SE_Mez);
+		const std::vector<BotSpell> &botSpellList = GetBotSpellsForSpellEffect(botCaster, SE_Mez);
 
-		for(std::list<BotSpell>::iterator botSpellListItr = botSpellList.begin(); botSpellListItr != botSpellList.end(); ++botSpellListItr) {
+		for(std::vector<BotSpell>::const_iterator botSpellListItr = botSpellList.begin(); botSpellListItr != botSpellList.end(); ++botSpellListItr) {
 			// Assuming all the spells have been loaded into this list by level and in descending order
 			if(IsMezSpell(botSpellListItr->SpellId) && CheckSpellRecastTimers(botCaster, botSpellListItr->SpellIndex)) {
 				result.SpellId = botSpellListItr->SpellId;
@@ -1995,9 +2019,9 @@ BotSpell Bot::GetBestBotSpellForMagicBasedSlow(Bot* botCaster) {
 	result.ManaCost = 0;
 
 	if(botCaster) {
-		std::list<BotSpell> botSpellList = GetBotSpellsForSpellEffect(botCaster, SE_AttackSpeed);
+		const std::vector<BotSpell> &botSpellList = GetBotSpellsForSpellEffect(botCaster, SE_AttackSpeed);
 
-		for (std::list<BotSpell>::iterator botSpellListItr = botSpellList.begin(); botSpellListItr != botSpellList.end(); ++botSpellListItr) {
+		for (std::vector<BotSpell>::const_iterator botSpellListItr = botSpellList.begin(); botSpellListItr != botSpellList.end(); ++botSpellListItr) {
 			// Assuming all the spells have been loaded into this list by level and in descending order
 			if (IsSlowSpell(botSpellListItr->SpellId) && spells[botSpellListItr->SpellId].resisttype == RESIST_MAGIC && CheckSpellRecastTimers(botCaster, botSpellListItr->SpellIndex)) {
 				result.SpellId = botSpellListItr->SpellId;
@@ -2020,9 +2044,9 @@ BotSpell Bot::GetBestBotSpellForDiseaseBasedSlow(Bot* botCaster) {
 	result.ManaCost = 0;
 
 	if(botCaster) {
-		std::list<BotSpell> botSpellList = GetBotSpellsForSpellEffect(botCaster, SE_AttackSpeed);
+		const std::vector<BotSpell> &botSpellList = GetBotSpellsForSpellEffect(botCaster, SE_AttackSpeed);
 
-		for(std::list<BotSpell>::iterator botSpellListItr = botSpellList.begin(); botSpellListItr != botSpellList.end(); ++botSpellListItr) {
+		for(std::vector<BotSpell>::const_iterator botSpellListItr = botSpellList.begin(); botSpellListItr != botSpellList.end(); ++botSpellListItr) {
 			// Assuming all the spells have been loaded into this list by level and in descending order
 			if(IsSlowSpell(botSpellListItr->SpellId) && spells[botSpellListItr->SpellId].resisttype == RESIST_DISEASE && CheckSpellRecastTimers(botCaster, botSpellListItr->SpellIndex)) {
 				result.SpellId = botSpellListItr->SpellId;
@@ -2081,11 +2105,11 @@ BotSpell Bot::GetBestBotMagicianPetSpell(Bot *botCaster) {
 	result.ManaCost = 0;
 
 	if(botCaster) {
-		std::list<BotSpell> botSpellList = GetBotSpellsForSpellEffect(botCaster, SE_SummonPet);
+		const std::vector<BotSpell> &botSpellList = GetBotSpellsForSpellEffect(botCaster, SE_SummonPet);
 
 		std::string petType = GetBotMagicianPetType(botCaster);
 
-		for(std::list<BotSpell>::iterator botSpellListItr = botSpellList.begin(); botSpellListItr != botSpellList.end(); ++botSpellListItr) {
+		for(std::vector<BotSpell>::const_iterator botSpellListItr = botSpellList.begin(); botSpellListItr != botSpellList.end(); ++botSpellListItr) {
 			// Assuming all the spells have been loaded into this list by level and in descending order
 			if(IsSummonPetSpell(botSpellListItr->SpellId) && CheckSpellRecastTimers(botCaster, botSpellListItr->SpellIndex)) {
 				if(!strncmp(spells[botSpellListItr->SpellId].teleport_zone, petType.c_str(), petType.length())) {
@@ -2192,9 +2216,9 @@ BotSpell Bot::GetBestBotSpellForNukeByTargetType(Bot* botCaster, SpellTargetType
 	result.ManaCost = 0;
 
 	if(botCaster) {
-		std::list<BotSpell> botSpellList = GetBotSpellsForSpellEffectAndTargetType(botCaster, SE_CurrentHP, targetType);
+		const std::vector<BotSpell> &botSpellList = GetBotSpellsForSpellEffectAndTargetType(botCaster, SE_CurrentHP, targetType);
 
-		for(std::list<BotSpell>::iterator botSpellListItr = botSpellList.begin(); botSpellListItr != botSpellList.end(); ++botSpellListItr) {
+		for(std::vector<BotSpell>::const_iterator botSpellListItr = botSpellList.begin(); botSpellListItr != botSpellList.end(); ++botSpellListItr) {
 			// Assuming all the spells have been loaded into this list by level and in descending order
 			if(IsPureNukeSpell(botSpellListItr->SpellId) && IsDamageSpell(botSpellListItr->SpellId) && CheckSpellRecastTimers(botCaster, botSpellListItr->SpellIndex)) {
 				result.SpellId = botSpellListItr->SpellId;
@@ -2219,9 +2243,9 @@ BotSpell Bot::GetBestBotSpellForStunByTargetType(Bot* botCaster, SpellTargetType
 
 	if(botCaster)
 	{
-		std::list<BotSpell> botSpellList = GetBotSpellsForSpellEffectAndTargetType(botCaster, SE_Stun, targetType);
+		const std::vector<BotSpell> &botSpellList = GetBotSpellsForSpellEffectAndTargetType(botCaster, SE_Stun, targetType);
 
-		for(std::list<BotSpell>::iterator botSpellListItr = botSpellList.begin(); botSpellListItr != botSpellList.end(); ++botSpellListItr)
+		for(std::vector<BotSpell>::const_iterator botSpellListItr = botSpellList.begin(); botSpellListItr != botSpellList.end(); ++botSpellListItr)
 		{
 			// Assuming all the spells have been loaded into this list by level and in descending order
 			if(IsStunSpell(botSpellListItr->SpellId) && CheckSpellRecastTimers(botCaster, botSpellListItr->SpellIndex))
@@ -2253,14 +2277,14 @@ BotSpell Bot::GetBestBotWizardNukeSpellByTargetResists(Bot* botCaster, Mob* targ
 			selectLureNuke = true;
 
 
-		std::list<BotSpell> botSpellList = GetBotSpellsForSpellEffectAndTargetType(botCaster, SE_CurrentHP, ST_Target);
+		const std::vector<BotSpell> &botSpellList = GetBotSpellsForSpellEffectAndTargetType(botCaster, SE_CurrentHP, ST_Target);
 
 		BotSpell firstWizardMagicNukeSpellFound;
 		firstWizardMagicNukeSpellFound.SpellId = 0;
 		firstWizardMagicNukeSpellFound.SpellIndex = 0;
 		firstWizardMagicNukeSpellFound.ManaCost = 0;
 
-		for(std::list<BotSpell>::iterator botSpellListItr = botSpellList.begin(); botSpellListItr != botSpellList.end(); ++botSpellListItr) {
+		for(std::vector<BotSpell>::const_iterator botSpellListItr = botSpellList.begin(); botSpellListItr != botSpellList.end(); ++botSpellListItr) {
 			// Assuming all the spells have been loaded into this list by level and in descending order
 			bool spellSelected = false;
 
@@ -2320,7 +2344,7 @@ BotSpell Bot::GetDebuffBotSpell(Bot* botCaster, Mob *tar) {
 		return result;
 
 	if(botCaster && botCaster->AI_HasSpells()) {
-		std::vector<AISpells_Struct> botSpellList = botCaster->GetBotSpells();
+		const std::vector<AISpells_Struct> &botSpellList = botCaster->GetBotSpells();
 
 		for (int i = botSpellList.size() - 1; i >= 0; i--) {
 			if (botSpellList[i].spellid <= 0 || botSpellList[i].spellid >= SPDAT_RECORDS) {
@@ -2367,7 +2391,7 @@ BotSpell Bot::GetBestBotSpellForResistDebuff(Bot* botCaster, Mob *tar) {
 	bool needsDiseaseResistDebuff = (tar->GetDR() + level_mod) > 100 ? true: false;
 
 	if(botCaster && botCaster->AI_HasSpells()) {
-		std::vector<AISpells_Struct> botSpellList = botCaster->GetBotSpells();
+		const std::vector<AISpells_Struct> &botSpellList = botCaster->GetBotSpells();
 
 		for (int i = botSpellList.size() - 1; i >= 0; i--) {
 			if (botSpellList[i].spellid <= 0 || botSpellList[i].spellid >= SPDAT_RECORDS) {
@@ -2415,7 +2439,7 @@ BotSpell Bot::GetBestBotSpellForCure(Bot* botCaster, Mob *tar) {
 	bool isCorrupted = tar->FindType(SE_CorruptionCounter);
 
 	if(botCaster && botCaster->AI_HasSpells()) {
-		std::list<BotSpell_wPriority> cureList = GetPrioritizedBotSpellsBySpellType(botCaster, SpellType_Cure);
+		const std::vector<BotSpell_wPriority> &cureList = GetPrioritizedBotSpellsBySpellType(botCaster, SpellType_Cure);
 
 		if(tar->HasGroup()) {
 			Group *g = tar->GetGroup();
@@ -2432,7 +2456,7 @@ BotSpell Bot::GetBestBotSpellForCure(Bot* botCaster, Mob *tar) {
 
 		//Check for group cure first
 		if(countNeedsCured > 2) {
-			for (std::list<BotSpell_wPriority>::iterator itr = cureList.begin(); itr != cureList.end(); ++itr) {
+			for (std::vector<BotSpell_wPriority>::const_iterator itr = cureList.begin(); itr != cureList.end(); ++itr) {
 				BotSpell selectedBotSpell = *itr;
 
 				if(IsGroupSpell(itr->SpellId) && CheckSpellRecastTimers(botCaster, itr->SpellIndex)) {
@@ -2469,7 +2493,7 @@ BotSpell Bot::GetBestBotSpellForCure(Bot* botCaster, Mob *tar) {
 
 		//no group cure for target- try to find single target spell
 		if(!spellSelected) {
-			for(std::list<BotSpell_wPriority>::iterator itr = cureList.begin(); itr != cureList.end(); ++itr) {
+			for(std::vector<BotSpell_wPriority>::const_iterator itr = cureList.begin(); itr != cureList.end(); ++itr) {
 				BotSpell selectedBotSpell = *itr;
 
 				if(CheckSpellRecastTimers(botCaster, itr->SpellIndex)) {
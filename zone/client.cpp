@@ -41,8 +41,7 @@ extern volatile bool RunLoops;
 #include "../common/profanity_manager.h"
 #include "data_bucket.h"
 #include "expedition.h"
-#include "expedition_database.h"
-#include "expedition_lockout_timer.h"
+#include "../common/expedition_lockout_timer.h"
 #include "expedition_request.h"
 #include "position.h"
 #include "worldserver.h"
@@ -60,13 +59,14 @@ extern volatile bool RunLoops;
 #include "quest_parser_collection.h"
 #include "queryserv.h"
 #include "mob_movement_manager.h"
+#include "zone_profiler.h"
 #include "../common/content/world_content_service.h"
 
 extern QueryServ* QServ;
-extern EntityList entity_list;
-extern Zone* zone;
+extern EntityList &entity_list;
+extern Zone*& zone;
 extern volatile bool is_zone_loaded;
-extern WorldServer worldserver;
+extern WorldServer &worldserver;
 extern uint32 numclients;
 extern PetitionList petition_list;
 bool commandlogged;
@@ -218,6 +218,8 @@ Client::Client(EQStreamInterface* ieqs)
 	LFGToLevel = 0;
 	LFGMatchFilter = false;
 	LFGComments[0] = '\0';
+	memset(&m_who_sent, 0, sizeof(m_who_sent));
+	m_who_sent_valid = false;
 	LFP = false;
 	gmspeed = 0;
 	playeraction = 0;
@@ -235,6 +237,8 @@ Client::Client(EQStreamInterface* ieqs)
 	npclevel = 0;
 	pQueuedSaveWorkID = 0;
 	position_update_same_count = 0;
+	zone_in_spawn_packets = 0;
+	zone_in_spawn_start = 0;
 	fishing_timer.Disable();
 	shield_timer.Disable();
 	dead_timer.Disable();
@@ -795,6 +799,64 @@ bool Client::SendAllPackets() {
 	return true;
 }
 
+/**
+ * @param spawns ordered nearest first
+ * @param packets_sent spawn packets already queued during zone in
+ */
+void Client::StartZoneInSpawnStream(std::deque<ZoneInSpawn> &&spawns, uint32 packets_sent)
+{
+	zone_in_spawns        = std::move(spawns);
+	zone_in_spawn_packets = packets_sent;
+	zone_in_spawn_start   = Timer::GetCurrentTime();
+}
+
+// Sends the next slice of owed spawns and wear changes, at most Zone:ZoneInSpawnPacketBudget packets per call
+void Client::ProcessZoneInSpawnStream()
+{
+	if (zone_in_spawns.empty()) {
+		return;
+	}
+
+	const int budget = RuleI(Zone, ZoneInSpawnPacketBudget);
+	uint32    sent   = 0;
+
+	while (!zone_in_spawns.empty() && (budget <= 0 || sent < static_cast<uint32>(budget))) {
+		ZoneInSpawn next = zone_in_spawns.front();
+		zone_in_spawns.pop_front();
+
+		// spawn ids are recycled, the serial makes sure this is still the mob we meant to send
+		Mob *spawn = entity_list.GetMobBySerial(next.entity_id, next.serial);
+		if (!spawn || !spawn->Spawned() || !spawn->ShouldISpawnFor(this)) {
+			continue;
+		}
+
+		if (next.send_spawn) {
+			auto app = new EQApplicationPacket;
+			spawn->CreateSpawnPacket(app);
+			QueuePacket(app, true, Client::CLIENT_CONNECTED);
+			safe_delete(app);
+			sent++;
+		}
+
+		sent += spawn->SendArmorAppearance(this);
+	}
+
+	zone_in_spawn_packets += sent;
+
+	if (zone_in_spawns.empty()) {
+		uint32 elapsed = Timer::GetCurrentTime() - zone_in_spawn_start;
+
+		LogDebug(
+			"Zone in spawn stream for [{}] complete, [{}] packets in [{}] ms",
+			GetCleanName(),
+			zone_in_spawn_packets,
+			elapsed
+		);
+
+		zone_profiler.RecordZoneIn(zone_in_spawn_packets, elapsed);
+	}
+}
+
 void Client::QueuePacket(const EQApplicationPacket* app, bool ack_req, CLIENT_CONN_STATUS required_state, eqFilterType filter) {
 	if(filter!=FilterNone){
 		//this is incomplete... no support for FilterShowGroupOnly or FilterShowSelfOnly
@@ -1589,8 +1651,10 @@ void Client::UpdateWho(uint8 remove) {
 		return;
 	if (!worldserver.Connected())
 		return;
-	auto pack = new ServerPacket(ServerOP_ClientList, sizeof(ServerClientList_Struct));
-	ServerClientList_Struct* scl = (ServerClientList_Struct*) pack->pBuffer;
+
+	ServerClientList_Struct who;
+	memset(&who, 0, sizeof(who));
+	ServerClientList_Struct* scl = &who;
 	scl->remove = remove;
 	scl->wid = this->GetWID();
 	scl->IP = this->GetIP();
@@ -1626,8 +1690,69 @@ void Client::UpdateWho(uint8 remove) {
 		memcpy(scl->LFGComments, LFGComments, sizeof(scl->LFGComments));
 	}
 
+	// world already has this client from us, send only what changed since then
+	if (remove == 0 && m_who_sent_valid && RuleB(Zone, DeltaClientList) &&
+		scl->wid == m_who_sent.wid && scl->charid == m_who_sent.charid && strcmp(scl->name, m_who_sent.name) == 0) {
+		uint16 changed = 0;
+		if (scl->level != m_who_sent.level)
+			changed |= ClientListDeltaLevel;
+		if (scl->race != m_who_sent.race)
+			changed |= ClientListDeltaRace;
+		if (scl->class_ != m_who_sent.class_)
+			changed |= ClientListDeltaClass;
+		if (scl->anon != m_who_sent.anon)
+			changed |= ClientListDeltaAnon;
+		if (scl->tellsoff != m_who_sent.tellsoff)
+			changed |= ClientListDeltaTellsOff;
+		if (scl->guild_id != m_who_sent.guild_id)
+			changed |= ClientListDeltaGuild;
+		if (scl->gm != m_who_sent.gm)
+			changed |= ClientListDeltaGM;
+		if (scl->Admin != m_who_sent.Admin)
+			changed |= ClientListDeltaAdmin;
+		if (scl->LFG != m_who_sent.LFG || scl->LFGFromLevel != m_who_sent.LFGFromLevel ||
+			scl->LFGToLevel != m_who_sent.LFGToLevel || scl->LFGMatchFilter != m_who_sent.LFGMatchFilter ||
+			memcmp(scl->LFGComments, m_who_sent.LFGComments, sizeof(scl->LFGComments)) != 0)
+			changed |= ClientListDeltaLFG;
+
+		if (changed == 0)
+			return;
+
+		auto pack = new ServerPacket(ServerOP_ClientListDelta, sizeof(ServerClientListDelta_Struct));
+		auto delta = (ServerClientListDelta_Struct*) pack->pBuffer;
+		delta->sequence = worldserver.NextClientListSequence();
+		delta->wid = scl->wid;
+		delta->changed = changed;
+		delta->race = scl->race;
+		delta->Admin = scl->Admin;
+		delta->class_ = scl->class_;
+		delta->level = scl->level;
+		delta->anon = scl->anon;
+		delta->tellsoff = scl->tellsoff;
+		delta->gm = scl->gm;
+		delta->LFG = scl->LFG;
+		delta->guild_id = scl->guild_id;
+		delta->LFGFromLevel = scl->LFGFromLevel;
+		delta->LFGToLevel = scl->LFGToLevel;
+		delta->LFGMatchFilter = scl->LFGMatchFilter;
+		memcpy(delta->LFGComments, scl->LFGComments, sizeof(delta->LFGComments));
+
+		worldserver.SendPacket(pack);
+		safe_delete(pack);
+
+		m_who_sent = who;
+		return;
+	}
+
+	scl->sequence = worldserver.NextClientListSequence();
+
+	auto pack = new ServerPacket(ServerOP_ClientList, sizeof(ServerClientList_Struct));
+	memcpy(pack->pBuffer, scl, sizeof(ServerClientList_Struct));
 	worldserver.SendPacket(pack);
 	safe_delete(pack);
+
+	m_who_sent = who;
+	m_who_sent_valid = (remove == 0);
 }
 
 void Client::WhoAll(Who_All_Struct* whom) {
@@ -4492,7 +4617,7 @@ bool Client::GroupFollow(Client* inviter) {
 			}
 
 			//now we have a group id, can set inviter's id
-			database.SetGroupID(inviter->GetName(), group->GetID(), inviter->CharacterID(), false);
+			Group::SendWorldGroupID(inviter->GetName(), group->GetID(), inviter->CharacterID(), false);
 			database.SetGroupLeaderName(group->GetID(), inviter->GetName());
 			group->UpdateGroupAAs();
 
@@ -9562,12 +9687,34 @@ void Client::SendCrossZoneMessageString(
 	}
 }
 
-void Client::UpdateExpeditionInfoAndLockouts()
+void Client::RequestExpeditionInfoAndLockouts()
 {
-	// this is processed by client after entering a zone
-	SendDzCompassUpdate();
+	// world sends these with the zone-in, this asks for them again when that didn't
+	// arrive. world replies with them (and the expedition if this zone doesn't have
+	// it cached)
+	auto expedition = Expedition::FindCachedExpeditionByCharacterID(CharacterID());
+
+	uint32_t pack_size = sizeof(ServerExpeditionCharacterRequest_Struct);
+	auto pack = std::unique_ptr<ServerPacket>(new ServerPacket(ServerOP_ExpeditionCharacterRequest, pack_size));
+	auto buf = reinterpret_cast<ServerExpeditionCharacterRequest_Struct*>(pack->pBuffer);
+	buf->sender_zone_id       = zone ? zone->GetZoneID() : 0;
+	buf->sender_instance_id   = zone ? zone->GetInstanceID() : 0;
+	buf->character_id         = CharacterID();
+	buf->cached_expedition_id = expedition ? expedition->GetID() : 0;
+	worldserver.SendPacket(pack.get());
+}
+
+void Client::UpdateExpeditionInfoAndLockouts(uint32 expedition_id, std::vector<ExpeditionLockoutTimer> lockouts)
+{
+	m_expedition_id = expedition_id;
+	m_expedition_lockouts = std::move(lockouts);
+
+	SendExpeditionInfoAndLockouts();
+}
 
-	m_expedition_lockouts = ExpeditionDatabase::LoadCharacterLockouts(CharacterID());
+void Client::SendExpeditionInfoAndLockouts()
+{
+	SendDzCompassUpdate();
 
 	auto expedition = GetExpedition();
 	if (expedition)
@@ -9635,7 +9782,7 @@ void Client::AddExpeditionLockout(const ExpeditionLockoutTimer& lockout, bool up
 
 	if (update_db) // for quest api
 	{
-		ExpeditionDatabase::InsertCharacterLockouts(CharacterID(), { lockout });
+		Expedition::SendWorldCharacterLockout(CharacterID(), lockout, false);
 	}
 
 	SendExpeditionLockoutTimers();
@@ -9668,7 +9815,7 @@ void Client::AddExpeditionLockoutDuration(
 
 		if (update_db)
 		{
-			ExpeditionDatabase::InsertCharacterLockouts(CharacterID(), { *it });
+			Expedition::SendWorldCharacterLockout(CharacterID(), *it, false);
 		}
 
 		SendExpeditionLockoutTimers();
@@ -9691,7 +9838,8 @@ void Client::RemoveExpeditionLockout(
 
 	if (update_db) // for quest api
 	{
-		ExpeditionDatabase::DeleteCharacterLockout(CharacterID(), expedition_name, event_name);
+		ExpeditionLockoutTimer lockout{ {}, expedition_name, event_name, 0, 0 };
+		Expedition::SendWorldCharacterLockout(CharacterID(), lockout, true);
 	}
 
 	SendExpeditionLockoutTimers();
@@ -9699,21 +9847,19 @@ void Client::RemoveExpeditionLockout(
 
 void Client::RemoveAllExpeditionLockouts(const std::string& expedition_name, bool update_db)
 {
+	if (update_db)
+	{
+		// an empty expedition name removes all of the character's lockouts
+		ExpeditionLockoutTimer lockout{ {}, expedition_name, {}, 0, 0 };
+		Expedition::SendWorldCharacterLockout(CharacterID(), lockout, true);
+	}
+
 	if (expedition_name.empty())
 	{
-		if (update_db)
-		{
-			ExpeditionDatabase::DeleteAllCharacterLockouts(CharacterID());
-		}
 		m_expedition_lockouts.clear();
 	}
 	else
 	{
-		if (update_db)
-		{
-			ExpeditionDatabase::DeleteAllCharacterLockouts(CharacterID(), expedition_name);
-		}
-
 		m_expedition_lockouts.erase(std::remove_if(m_expedition_lockouts.begin(), m_expedition_lockouts.end(),
 			[&](const ExpeditionLockoutTimer& lockout) {
 				return lockout.GetExpeditionName() == expedition_name;
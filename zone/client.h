@@ -53,6 +53,7 @@ namespace EQ
 #include "../common/seperator.h"
 #include "../common/inventory_profile.h"
 #include "../common/guilds.h"
+#include "../common/servertalk.h"
 //#include "../common/item_data.h"
 #include "xtargetautohaters.h"
 #include "aggromanager.h"
@@ -85,7 +86,7 @@ namespace EQ
 #define TARGETING_RANGE 200 // range for /assist and /target
 #define XTARGET_HARDCAP 20
 
-extern Zone* zone;
+extern Zone*& zone;
 extern TaskManager *taskmanager;
 
 class CLIENTPACKET
@@ -279,6 +280,15 @@ public:
 	void KeyRingList();
 	virtual bool IsClient() const { return true; }
 	void CompleteConnect();
+
+	// Spawns still owed to this client after zone in, nearest first
+	struct ZoneInSpawn {
+		uint16 entity_id;
+		uint32 serial;
+		bool   send_spawn; // false when the spawn already went out in OP_ZoneSpawns and only appearance is owed
+	};
+	void StartZoneInSpawnStream(std::deque<ZoneInSpawn> &&spawns, uint32 packets_sent);
+	void ProcessZoneInSpawnStream();
 	bool TryStacking(EQ::ItemInstance* item, uint8 type = ItemPacketTrade, bool try_worn = true, bool try_cursor = true);
 	void SendTraderPacket(Client* trader, uint32 Unknown72 = 51);
 	void SendBuyerPacket(Client* Buyer);
@@ -693,6 +703,8 @@ public:
 	inline uint32 CharacterID() const { return character_id; }
 	void UpdateAdmin(bool iFromDB = true);
 	void UpdateWho(uint8 remove = 0);
+	inline void ResetWho() { m_who_sent_valid = false; }
+	inline bool IsWhoAnnounced() const { return m_who_sent_valid; }
 	bool GMHideMe(Client* client = 0);
 
 	inline bool IsInAGuild() const { return(guild_id != GUILD_NONE && guild_id != 0); }
@@ -1147,11 +1159,13 @@ public:
 	void RemoveAllExpeditionLockouts(const std::string& expedition_name, bool update_db = false);
 	void RemoveExpeditionLockout(const std::string& expedition_name,
 		const std::string& event_name, bool update_db = false);
+	void RequestExpeditionInfoAndLockouts();
 	void RequestPendingExpeditionInvite();
+	void SendExpeditionInfoAndLockouts();
 	void SendExpeditionLockoutTimers();
 	void SetExpeditionID(uint32 expedition_id) { m_expedition_id = expedition_id; };
 	void SetPendingExpeditionInvite(ExpeditionInvite&& invite) { m_pending_expedition_invite = invite; }
-	void UpdateExpeditionInfoAndLockouts();
+	void UpdateExpeditionInfoAndLockouts(uint32 expedition_id, std::vector<ExpeditionLockoutTimer> lockouts);
 	void DzListTimers();
 	void SetDzRemovalTimer(bool enable_timer);
 	void SendDzCompassUpdate();
@@ -1503,6 +1517,8 @@ private:
 	uint8 LFGToLevel;
 	bool LFGMatchFilter;
 	char LFGComments[64];
+	ServerClientList_Struct m_who_sent; // what world was last told about this client
+	bool m_who_sent_valid;
 	bool AFK;
 	bool auto_attack;
 	bool auto_fire;
@@ -1558,6 +1574,9 @@ private:
 	bool AddPacket(EQApplicationPacket**, bool);
 	bool SendAllPackets();
 	std::deque<std::unique_ptr<CLIENTPACKET>> clientpackets;
+	std::deque<ZoneInSpawn> zone_in_spawns;
+	uint32 zone_in_spawn_packets;
+	uint32 zone_in_spawn_start;
 
 	//Zoning related stuff
 	void SendZoneCancel(ZoneChange_Struct *zc);
@@ -1716,6 +1735,7 @@ private:
 	int client_max_level;
 
 	uint32 m_expedition_id = 0;
+	bool m_expedition_info_loaded = false; // world sent the id and lockouts ahead of zone entry
 	ExpeditionInvite m_pending_expedition_invite { 0 };
 	std::vector<ExpeditionLockoutTimer> m_expedition_lockouts;
 	glm::vec3 m_quest_compass;
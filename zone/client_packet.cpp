@@ -50,7 +50,6 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include "data_bucket.h"
 #include "event_codes.h"
 #include "expedition.h"
-#include "expedition_database.h"
 #include "guild_mgr.h"
 #include "merc.h"
 #include "petitions.h"
@@ -70,11 +69,11 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #endif
 
 extern QueryServ* QServ;
-extern Zone* zone;
+extern Zone*& zone;
 extern volatile bool is_zone_loaded;
-extern WorldServer worldserver;
+extern WorldServer &worldserver;
 extern PetitionList petition_list;
-extern EntityList entity_list;
+extern EntityList &entity_list;
 typedef void (Client::*ClientPacketProc)(const EQApplicationPacket *app);
 
 
@@ -551,23 +550,20 @@ void Client::CompleteConnect()
 
 	if (GetHideMe()) Message(Chat::Red, "[GM] You are currently hidden to all clients");
 
-	uint32 raidid = database.GetRaidID(GetName());
+	// world sent our raid roster with ServerOP_CharacterRoster, which already built the raid
+	uint32 raidid = 0;
+	auto incoming_roster = zone->incoming_rosters.find(CharacterID());
+	if (incoming_roster != zone->incoming_rosters.end()) {
+		raidid = incoming_roster->second.raid_id;
+		zone->incoming_rosters.erase(incoming_roster);
+	}
 	Raid *raid = nullptr;
 	if (raidid > 0) {
 		raid = entity_list.GetRaidByID(raidid);
-		if (!raid) {
-			raid = new Raid(raidid);
-			if (raid->GetID() != 0) {
-				entity_list.AddRaid(raid, raidid);
-				raid->LoadLeadership(); // Recreating raid in new zone, get leadership from DB
-			}
-			else
-				raid = nullptr;
-		}
+		if (raid && !raid->IsRaidMember(GetName()))
+			raid = nullptr;
 		if (raid) {
 			SetRaidGrouped(true);
-			raid->LearnMembers();
-			raid->VerifyRaid();
 			raid->GetRaidDetails();
 			/*
 			Only leader should get this; send to all for now till
@@ -897,7 +893,10 @@ void Client::CompleteConnect()
 		guild_mgr.RequestOnlineGuildMembers(this->CharacterID(), this->GuildID());
 	}
 
-	UpdateExpeditionInfoAndLockouts();
+	if (m_expedition_info_loaded)
+		SendExpeditionInfoAndLockouts();
+	else
+		RequestExpeditionInfoAndLockouts();
 
 	/** Request adventure info **/
 	auto pack = new ServerPacket(ServerOP_AdventureDataRequest, 64);
@@ -1493,23 +1492,17 @@ void Client::Handle_Connect_OP_ZoneEntry(const EQApplicationPacket *app)
 	KeyRingLoad();
 
 	/* Send Group Members via PP */
-	uint32 groupid = database.GetGroupID(GetName());
+	// world sent our group roster with ServerOP_CharacterRoster, which already built the group
+	uint32 groupid = 0;
+	auto incoming_roster = zone->incoming_rosters.find(CharacterID());
+	if (incoming_roster != zone->incoming_rosters.end())
+		groupid = incoming_roster->second.group_id;
 	Group* group = nullptr;
 	if (groupid > 0) {
 		group = entity_list.GetGroupByID(groupid);
-		if (!group) {	//nobody from our is here... start a new group
-			group = new Group(groupid);
-			if (group->GetID() != 0)
-				entity_list.AddGroup(group, groupid);
-			else	//error loading group members...
-			{
-				delete group;
-				group = nullptr;
-			}
-		}	//else, somebody from our group is already here...
 
 		if (!group)
-			database.SetGroupID(GetName(), 0, CharacterID(), false);	//cannot re-establish group, kill it
+			Group::SendWorldGroupID(GetName(), 0, CharacterID(), false);	//cannot re-establish group, kill it
 
 	}
 	else {	//no group id
@@ -1715,7 +1708,14 @@ void Client::Handle_Connect_OP_ZoneEntry(const EQApplicationPacket *app)
 	/* Task Packets */
 	LoadClientTaskState();
 
-	m_expedition_id = ExpeditionDatabase::GetExpeditionIDFromCharacterID(CharacterID());
+	/* Expedition id and lockouts world sent with the zone-in */
+	auto incoming_expedition = zone->incoming_expedition_info.find(CharacterID());
+	if (incoming_expedition != zone->incoming_expedition_info.end()) {
+		m_expedition_id = incoming_expedition->second.expedition_id;
+		m_expedition_lockouts = std::move(incoming_expedition->second.lockouts);
+		m_expedition_info_loaded = true;
+		zone->incoming_expedition_info.erase(incoming_expedition);
+	}
 
 	/**
 	 * DevTools Load Settings
@@ -6678,7 +6678,7 @@ void Client::Handle_OP_GroupCancelInvite(const EQApplicationPacket *app)
 
 	if (!GetMerc())
 	{
-		database.SetGroupID(GetName(), 0, CharacterID(), false);
+		Group::SendWorldGroupID(GetName(), 0, CharacterID(), false);
 	}
 	return;
 }
@@ -11735,6 +11735,7 @@ void Client::Handle_OP_RaidCommand(const EQApplicationPacket *app)
 												ServerRaidGeneralAction_Struct *raid_command_packet = (ServerRaidGeneralAction_Struct*)pack->pBuffer;
 
 												raid_command_packet->rid = raid->GetID();
+												raid_command_packet->gid = raid->members[x].GroupNumber;
 												raid_command_packet->zoneid = zone->GetZoneID();
 												raid_command_packet->instance_id = zone->GetInstanceID();
 												strn0cpy(raid_command_packet->playername, raid->members[x].membername, 64);
@@ -11806,6 +11807,7 @@ void Client::Handle_OP_RaidCommand(const EQApplicationPacket *app)
 									ServerRaidGeneralAction_Struct *raid_command = (ServerRaidGeneralAction_Struct*)pack->pBuffer;
 
 									raid_command->rid = raid->GetID();
+									raid_command->gid = raid->members[x].GroupNumber;
 									strn0cpy(raid_command->playername, raid->members[x].membername, 64);
 									raid_command->zoneid = zone->GetZoneID();
 									raid_command->instance_id = zone->GetInstanceID();
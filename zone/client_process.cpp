@@ -57,11 +57,11 @@
 #include "zone_store.h"
 
 extern QueryServ* QServ;
-extern Zone* zone;
+extern Zone*& zone;
 extern volatile bool is_zone_loaded;
-extern WorldServer worldserver;
+extern WorldServer &worldserver;
 extern PetitionList petition_list;
-extern EntityList entity_list;
+extern EntityList &entity_list;
 
 bool Client::Process() {
 	bool ret = true;
@@ -678,6 +678,7 @@ bool Client::Process() {
 	}
 
 	if (client_state == CLIENT_CONNECTED) {
+		ProcessZoneInSpawnStream();
 		if (m_dirtyautohaters)
 			ProcessXTargetAutoHaters();
 		if (aggro_meter_timer.Check())
@@ -73,10 +73,12 @@
 #include "fastmath.h"
 #include "mob_movement_manager.h"
 #include "npc_scale_manager.h"
+#include "zone_profiler.h"
+#include "zone_map_cache.h"
 #include "../common/content/world_content_service.h"
 
 extern QueryServ* QServ;
-extern WorldServer worldserver;
+extern WorldServer &worldserver;
 extern TaskManager *taskmanager;
 extern FastMath g_Math;
 void CatchSignal(int sig_num);
@@ -275,6 +277,7 @@ int command_init(void)
 		command_add("lock", "- Lock the worldserver", 150, command_lock) ||
 		command_add("logs",  "Manage anything to do with logs",  250, command_logs) ||
 		command_add("logtest",  "Performs log performance testing.",  250, command_logtest) ||
+		command_add("losstats", "[reset] - Show or reset the zone line of sight cache statistics", 200, command_losstats) ||
 		command_add("makepet", "[level] [class] [race] [texture] - Make a pet", 50, command_makepet) ||
 		command_add("mana", "- Fill your or your target's mana", 50, command_mana) ||
 		command_add("maxskills", "Maxes skills for you.", 200, command_max_all_skills) ||
@@ -413,6 +416,7 @@ int command_init(void)
 		command_add("test", "Test command", 200, command_test) ||
 		command_add("texture", "[texture] [helmtexture] - Change your or your target's appearance, use 255 to show equipment", 10, command_texture) ||
 		command_add("time", "[HH] [MM] - Set EQ time", 90, command_time) ||
+		command_add("tickstats", "[reset|slow] - Show zone main loop phase timings, the slowest recent ticks, or reset them", 200, command_tickstats) ||
 		command_add("timers", "- Display persistent timers for target", 200, command_timers) ||
 		command_add("timezone", "[HH] [MM] - Set timezone. Minutes are optional", 90, command_timezone) ||
 		command_add("title", "[text] [1 = create title table row] - Set your or your player target's title", 50, command_title) ||
@@ -6922,10 +6926,9 @@ void command_dz(Client* c, const Seperator* sep)
 		}
 		else if (strcasecmp(sep->arg[2], "reload") == 0)
 		{
-			Expedition::CacheAllFromDatabase();
-			c->Message(Chat::White, fmt::format(
-				"Reloaded [{}] expeditions to cache from database.", zone->expedition_cache.size()
-			).c_str());
+			zone->expedition_cache.clear();
+			Expedition::SendWorldCacheRequest();
+			c->Message(Chat::White, "Requested expeditions for this zone and its players from world.");
 		}
 		else if (strcasecmp(sep->arg[2], "destroy") == 0 && sep->IsNumber(3))
 		{
@@ -7052,7 +7055,7 @@ void command_dz(Client* c, const Seperator* sep)
 	{
 		c->Message(Chat::White, "#dz usage:");
 		c->Message(Chat::White, "#dz expedition list - list expeditions in current zone cache");
-		c->Message(Chat::White, "#dz expedition reload - reload expedition zone cache from database");
+		c->Message(Chat::White, "#dz expedition reload - reload expedition zone cache from world");
 		c->Message(Chat::White, "#dz expedition destroy <expedition_id> - destroy expedition globally (must be in cache)");
 		c->Message(Chat::White, "#dz expedition unlock <expedition_id> - unlock expedition");
 		c->Message(Chat::White, "#dz list [all] - list dynamic zone instances from database -- 'all' includes expired");
@@ -10978,6 +10981,114 @@ void command_setstartzone(Client *c, const Seperator *sep)
 	target->SetStartZone(startzone);
 }
 
+void command_losstats(Client *c, const Seperator *sep)
+{
+	if (!zone->zonemap) {
+		c->Message(Chat::White, "This zone has no map loaded.");
+		return;
+	}
+
+	if (strcasecmp(sep->arg[1], "reset") == 0) {
+		zone->zonemap->ResetLoSCacheStats();
+		c->Message(Chat::White, "Line of sight cache statistics reset.");
+		return;
+	}
+
+	auto stats   = zone->zonemap->GetLoSCacheStats();
+	auto lookups = stats.hits + stats.misses;
+
+	c->Message(Chat::White, "Line of sight cache:");
+	c->Message(Chat::White, "--------------------------------------------------------------------");
+	c->Message(Chat::White, "Enabled: %s", RuleB(Map, UseLoSCache) ? "true" : "false");
+	c->Message(Chat::White, "Entries: %u / %i", stats.entries, RuleI(Map, LoSCacheSize));
+	c->Message(Chat::White, "Lookups: %llu", (unsigned long long) lookups);
+	c->Message(
+		Chat::White,
+		"Hits: %llu (%.2f%%)",
+		(unsigned long long) stats.hits,
+		lookups ? 100.0 * static_cast<double>(stats.hits) / static_cast<double>(lookups) : 0.0
+	);
+	c->Message(Chat::White, "Misses: %llu", (unsigned long long) stats.misses);
+	c->Message(Chat::White, "Evictions: %llu", (unsigned long long) stats.evictions);
+	c->Message(Chat::White, "Invalidations: %llu", (unsigned long long) stats.invalidations);
+}
+
+void command_tickstats(Client *c, const Seperator *sep)
+{
+	if (strcasecmp(sep->arg[1], "reset") == 0) {
+		zone_profiler.Reset();
+		c->Message(Chat::White, "Zone tick statistics reset.");
+		return;
+	}
+
+	if (strcasecmp(sep->arg[1], "slow") == 0) {
+		auto &traces = zone_profiler.GetSlowTickTraces();
+		if (traces.empty()) {
+			c->Message(Chat::White, "No ticks over %i ms recorded.", RuleI(Zone, SlowTickThresholdMS));
+			return;
+		}
+
+		for (auto &trace : traces) {
+			c->Message(Chat::White, "%s", trace.ToString().c_str());
+		}
+		return;
+	}
+
+	c->Message(
+		Chat::White,
+		"Zone ticks: %llu Slow (>= %i ms): %llu Profiler: %s",
+		(unsigned long long) zone_profiler.GetTicks(),
+		RuleI(Zone, SlowTickThresholdMS),
+		(unsigned long long) zone_profiler.GetSlowTicks(),
+		zone_profiler.IsEnabled() ? "enabled" : "disabled"
+	);
+	c->Message(Chat::White, "--------------------------------------------------------------------");
+	c->Message(Chat::White, "Phase: mean / p50 / p99 / max (ms)");
+
+	for (int i = 0; i < ZoneProfiler::MaxPhase; i++) {
+		auto       phase     = static_cast<ZoneProfiler::Phase>(i);
+		const auto &histogram = zone_profiler.GetHistogram(phase);
+		if (histogram.GetMax() == 0) {
+			continue;
+		}
+
+		c->Message(
+			Chat::White,
+			"%s: %.2f / %.2f / %.2f / %.2f",
+			ZoneProfiler::GetPhaseName(phase),
+			histogram.GetMean() / 1000.0,
+			histogram.GetPercentile(50) / 1000.0,
+			histogram.GetPercentile(99) / 1000.0,
+			histogram.GetMax() / 1000.0
+		);
+	}
+
+	const auto &zone_in_time = zone_profiler.GetZoneInTime();
+	if (zone_in_time.GetCount() > 0) {
+		c->Message(
+			Chat::White,
+			"Zone ins: %llu Packets mean / max: %.0f / %llu Time to last spawn p50 / max (ms): %llu / %llu",
+			(unsigned long long) zone_in_time.GetCount(),
+			zone_profiler.GetZoneInPackets().GetMean(),
+			(unsigned long long) zone_profiler.GetZoneInPackets().GetMax(),
+			(unsigned long long) zone_in_time.GetPercentile(50),
+			(unsigned long long) zone_in_time.GetMax()
+		);
+	}
+
+	const auto &zone_boot_time = zone_profiler.GetZoneBootTime();
+	if (zone_boot_time.GetCount() > 0) {
+		c->Message(
+			Chat::White,
+			"Zone boots: %llu Time to ready p50 / max (ms): %llu / %llu Cached map sets: %u",
+			(unsigned long long) zone_boot_time.GetCount(),
+			(unsigned long long) zone_boot_time.GetPercentile(50),
+			(unsigned long long) zone_boot_time.GetMax(),
+			(uint32) ZoneMapCache::Instance().Size()
+		);
+	}
+}
+
 void command_netstats(Client *c, const Seperator *sep)
 {
 	if(c)
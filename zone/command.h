@@ -170,6 +170,8 @@ void command_loc(Client *c, const Seperator *sep);
 void command_lock(Client *c, const Seperator *sep);
 void command_logs(Client *c, const Seperator *sep);
 void command_logtest(Client *c, const Seperator *sep);
+void command_losstats(Client *c, const Seperator *sep);
+void command_tickstats(Client *c, const Seperator *sep);
 void command_makepet(Client *c, const Seperator *sep);
 void command_mana(Client *c, const Seperator *sep);
 void command_manastat(Client *c, const Seperator *sep);
@@ -53,9 +53,9 @@ Child of the Mob class.
 #include <iostream>
 
 
-extern EntityList entity_list;
-extern Zone* zone;
-extern WorldServer worldserver;
+extern EntityList &entity_list;
+extern Zone*& zone;
+extern WorldServer &worldserver;
 extern npcDecayTimes_Struct npcCorpseDecayTimes[100];
 
 void Corpse::SendEndLootErrorPacket(Client* client) {
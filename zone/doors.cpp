@@ -24,6 +24,7 @@
 #include "doors.h"
 #include "entity.h"
 #include "guild_mgr.h"
+#include "map.h"
 #include "mob.h"
 #include "string_ids.h"
 #include "worldserver.h"
@@ -39,8 +40,8 @@
 #define OPEN_INVDOOR 0x03
 #define CLOSE_INVDOOR 0x02
 
-extern EntityList entity_list;
-extern WorldServer worldserver;
+extern EntityList &entity_list;
+extern WorldServer &worldserver;
 
 Doors::Doors(const Door *door) :
 		close_timer(5000),
@@ -518,18 +519,18 @@ void Doors::Open(Mob* sender, bool alt_mode)
 			if (!is_open) {
 				if (!disable_timer)
 					close_timer.Start();
-				is_open = true;
+				SetOpenState(true);
 			}
 			else {
 				close_timer.Disable();
 				if (!disable_timer)
-					is_open = false;
+					SetOpenState(false);
 			}
 		}
 		else { // alternative function
 			if (!disable_timer)
 				close_timer.Start();
-			is_open = true;
+			SetOpenState(true);
 		}
 	}
 }
@@ -547,18 +548,18 @@ void Doors::ForceOpen(Mob *sender, bool alt_mode)
 		if (!is_open) {
 			if (!disable_timer)
 				close_timer.Start();
-			is_open = true;
+			SetOpenState(true);
 		}
 		else {
 			close_timer.Disable();
 			if (!disable_timer)
-				is_open = false;
+				SetOpenState(false);
 		}
 	}
 	else { // alternative function
 		if (!disable_timer)
 			close_timer.Start();
-		is_open = true;
+		SetOpenState(true);
 	}
 }
 
@@ -575,10 +576,10 @@ void Doors::ForceClose(Mob *sender, bool alt_mode) {
 		if (!is_open) {
 			if (!disable_timer)
 				close_timer.Start();
-			is_open = true;
+			SetOpenState(true);
 		} else {
 			close_timer.Disable();
-			is_open = false;
+			SetOpenState(false);
 		}
 	} else { // alternative function
 		if (is_open)
@@ -599,11 +600,11 @@ void Doors::ToggleState(Mob *sender)
 
 	if(!is_open) {
 		move_door_packet->action = static_cast<uint8>(invert_state == 0 ? OPEN_DOOR : OPEN_INVDOOR);
-		is_open=true;
+		SetOpenState(true);
 	}
 	else {
 		move_door_packet->action = static_cast<uint8>(invert_state == 0 ? CLOSE_DOOR : CLOSE_INVDOOR);
-		is_open=false;
+		SetOpenState(false);
 	}
 
 	entity_list.QueueClients(sender,outapp,false);
@@ -782,6 +783,16 @@ bool ZoneDatabase::LoadDoors(int32 door_count, Door *into, const char *zone_name
 }
 
 
+void Doors::SetOpenState(bool st)
+{
+	// opening or closing a door can change what mobs see through the doorway
+	if (st != is_open && zone && zone->zonemap) {
+		zone->zonemap->InvalidateLoSCache();
+	}
+
+	is_open = st;
+}
+
 void Doors::SetLocation(float x, float y, float z)
 {
 	entity_list.DespawnAllDoors();
@@ -58,7 +58,7 @@ public:
 	void SetLocation(float x, float y, float z);
 	void SetLockpick(uint16 in) { lockpick = in; }
 	void SetNoKeyring(uint8 in) { no_key_ring = in; }
-	void SetOpenState(bool st) { is_open = st; }
+	void SetOpenState(bool st);
 	void SetOpenType(uint8 in);
 	void SetPosition(const glm::vec4 &position);
 	void SetSize(uint16 size);
@@ -88,7 +88,7 @@ private:
 	int       invert_state;
 	uint32    entity_id;
 	bool      disable_timer;
-	bool      is_open;
+	bool      is_open = false;
 	Timer     close_timer;
 	char      destination_zone_name[16];
 	int       destination_instance_id;
@@ -24,7 +24,7 @@
 #include "zonedb.h"
 #include "../common/eqemu_logsys.h"
 
-extern WorldServer worldserver;
+extern WorldServer &worldserver;
 
 DynamicZone::DynamicZone(
 	uint32_t zone_id, uint32_t version, uint32_t duration, DynamicZoneType type
@@ -51,309 +51,67 @@ DynamicZone::DynamicZone(
 	}
 }
 
-std::unordered_map<uint32_t, DynamicZone> DynamicZone::LoadMultipleDzFromDatabase(
-	const std::vector<uint32_t>& dynamic_zone_ids)
+void DynamicZone::LoadServerDzInfo(const ServerDzInfo_Struct& info)
 {
-	LogDynamicZonesDetail("Loading dynamic zone data for [{}] instances", dynamic_zone_ids.size());
-
-	std::string in_dynamic_zone_ids_query = fmt::format("{}", fmt::join(dynamic_zone_ids, ","));
-
-	std::unordered_map<uint32_t, DynamicZone> dynamic_zones;
-
-	if (!in_dynamic_zone_ids_query.empty())
-	{
-		std::string query = fmt::format(SQL(
-			{} WHERE dynamic_zones.id IN ({});
-		), DynamicZoneSelectQuery(), in_dynamic_zone_ids_query);
-
-		auto results = database.QueryDatabase(query);
-		if (results.Success())
-		{
-			for (auto row = results.begin(); row != results.end(); ++row)
-			{
-				DynamicZone dz;
-				dz.LoadDatabaseResult(row);
-				dynamic_zones.emplace(dz.GetID(), dz);
-			}
-		}
-	}
-
-	return dynamic_zones;
-}
-
-uint32_t DynamicZone::Create()
-{
-	if (m_id != 0)
-	{
-		return m_id;
-	}
-
-	if (GetInstanceID() == 0)
-	{
-		CreateInstance();
-	}
-
-	m_id = SaveToDatabase();
-
-	return m_id;
-}
-
-uint32_t DynamicZone::CreateInstance()
-{
-	if (m_instance_id)
-	{
-		LogDynamicZones("CreateInstance failed, instance id [{}] already created", m_instance_id);
-		return 0;
-	}
-
-	if (!m_zone_id)
-	{
-		LogDynamicZones("CreateInstance failed, invalid zone id [{}]", m_zone_id);
-		return 0;
-	}
-
-	uint16_t instance_id = 0;
-	if (!database.GetUnusedInstanceID(instance_id)) // todo: doesn't this race with insert?
-	{
-		LogDynamicZones("Failed to find unused instance id");
-		return 0;
-	}
-
-	m_start_time    = std::chrono::system_clock::now();
-	auto start_time = std::chrono::system_clock::to_time_t(m_start_time);
-
-	std::string query = fmt::format(SQL(
-		INSERT INTO instance_list
-			(id, zone, version, start_time, duration)
-		VALUES
-			({}, {}, {}, {}, {})
-	), instance_id, m_zone_id, m_version, start_time, m_duration.count());
-
-	auto results = database.QueryDatabase(query);
-	if (!results.Success())
-	{
-		LogDynamicZones("Failed to create instance [{}] for Dynamic Zone [{}]", instance_id, m_zone_id);
-		return 0;
-	}
-
-	m_instance_id   = instance_id;
-	m_never_expires = false;
-	m_expire_time   = m_start_time + m_duration;
-
-	return m_instance_id;
-}
-
-std::string DynamicZone::DynamicZoneSelectQuery()
-{
-	return std::string(SQL(
-		SELECT
-			instance_list.id,
-			instance_list.zone,
-			instance_list.version,
-			instance_list.start_time,
-			instance_list.duration,
-			instance_list.never_expires,
-			dynamic_zones.id,
-			dynamic_zones.type,
-			dynamic_zones.compass_zone_id,
-			dynamic_zones.compass_x,
-			dynamic_zones.compass_y,
-			dynamic_zones.compass_z,
-			dynamic_zones.safe_return_zone_id,
-			dynamic_zones.safe_return_x,
-			dynamic_zones.safe_return_y,
-			dynamic_zones.safe_return_z,
-			dynamic_zones.safe_return_heading,
-			dynamic_zones.zone_in_x,
-			dynamic_zones.zone_in_y,
-			dynamic_zones.zone_in_z,
-			dynamic_zones.zone_in_heading,
-			dynamic_zones.has_zone_in
-		FROM dynamic_zones
-			INNER JOIN instance_list ON dynamic_zones.instance_id = instance_list.id
-	));
-}
-
-void DynamicZone::LoadDatabaseResult(MySQLRequestRow& row)
-{
-	m_instance_id        = strtoul(row[0], nullptr, 10);
-	m_zone_id            = strtoul(row[1], nullptr, 10);
-	m_version            = strtoul(row[2], nullptr, 10);
-	m_start_time         = std::chrono::system_clock::from_time_t(strtoul(row[3], nullptr, 10));
-	m_duration           = std::chrono::seconds(strtoul(row[4], nullptr, 10));
+	m_id                 = info.dz_id;
+	m_zone_id            = info.zone_id;
+	m_instance_id        = info.instance_id;
+	m_version            = info.version;
+	m_type               = static_cast<DynamicZoneType>(info.type);
+	m_never_expires      = (info.never_expires != 0);
+	m_has_zonein         = (info.has_zonein != 0);
+	m_start_time         = std::chrono::system_clock::from_time_t(info.start_time);
+	m_duration           = std::chrono::seconds(info.duration);
 	m_expire_time        = m_start_time + m_duration;
-	m_never_expires      = (strtoul(row[5], nullptr, 10) != 0);
-	m_id                 = strtoul(row[6], nullptr, 10);
-	m_type               = static_cast<DynamicZoneType>(strtoul(row[7], nullptr, 10));
-	m_compass.zone_id    = strtoul(row[8], nullptr, 10);
-	m_compass.x          = strtof(row[9], nullptr);
-	m_compass.y          = strtof(row[10], nullptr);
-	m_compass.z          = strtof(row[11], nullptr);
-	m_safereturn.zone_id = strtoul(row[12], nullptr, 10);
-	m_safereturn.x       = strtof(row[13], nullptr);
-	m_safereturn.y       = strtof(row[14], nullptr);
-	m_safereturn.z       = strtof(row[15], nullptr);
-	m_safereturn.heading = strtof(row[16], nullptr);
-	m_zonein.x           = strtof(row[17], nullptr);
-	m_zonein.y           = strtof(row[18], nullptr);
-	m_zonein.z           = strtof(row[19], nullptr);
-	m_zonein.heading     = strtof(row[20], nullptr);
-	m_has_zonein         = (strtoul(row[21], nullptr, 10) != 0);
-}
-
-uint32_t DynamicZone::SaveToDatabase()
-{
-	LogDynamicZonesDetail("Saving dz instance [{}] to database", m_instance_id);
-
-	if (m_instance_id != 0)
-	{
-		std::string query = fmt::format(SQL(
-			INSERT INTO dynamic_zones
-				(
-					instance_id,
-					type,
-					compass_zone_id,
-					compass_x,
-					compass_y,
-					compass_z,
-					safe_return_zone_id,
-					safe_return_x,
-					safe_return_y,
-					safe_return_z,
-					safe_return_heading,
-					zone_in_x,
-					zone_in_y,
-					zone_in_z,
-					zone_in_heading,
-					has_zone_in
-				)
-			VALUES
-				({}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {});
-		),
-			m_instance_id,
-			static_cast<uint8_t>(m_type),
-			m_compass.zone_id,
-			m_compass.x,
-			m_compass.y,
-			m_compass.z,
-			m_safereturn.zone_id,
-			m_safereturn.x,
-			m_safereturn.y,
-			m_safereturn.z,
-			m_safereturn.heading,
-			m_zonein.x,
-			m_zonein.y,
-			m_zonein.z,
-			m_zonein.heading,
-			m_has_zonein
-		);
-
-		auto results = database.QueryDatabase(query);
-		if (results.Success())
-		{
-			return results.LastInsertedID();
-		}
-	}
-	return 0;
-}
-
-void DynamicZone::SaveCompassToDatabase()
-{
-	LogDynamicZonesDetail(
-		"Instance [{}] saving compass zone: [{}] xyz: ([{}], [{}], [{}])",
-		m_instance_id, m_compass.zone_id, m_compass.x, m_compass.y, m_compass.z
-	);
-
-	if (m_instance_id != 0)
-	{
-		std::string query = fmt::format(SQL(
-			UPDATE dynamic_zones SET
-				compass_zone_id = {},
-				compass_x = {},
-				compass_y = {},
-				compass_z = {}
-			WHERE instance_id = {};
-		),
-			m_compass.zone_id,
-			m_compass.x,
-			m_compass.y,
-			m_compass.z,
-			m_instance_id
-		);
-
-		database.QueryDatabase(query);
-	}
-}
-
-void DynamicZone::SaveSafeReturnToDatabase()
-{
-	LogDynamicZonesDetail(
-		"Instance [{}] saving safereturn zone: [{}] xyzh: ([{}], [{}], [{}], [{}])",
-		m_instance_id, m_safereturn.zone_id, m_safereturn.x, m_safereturn.y, m_safereturn.z, m_safereturn.heading
-	);
-
-	if (m_instance_id != 0)
-	{
-		std::string query = fmt::format(SQL(
-			UPDATE dynamic_zones SET
-				safe_return_zone_id = {},
-				safe_return_x = {},
-				safe_return_y = {},
-				safe_return_z = {},
-				safe_return_heading = {}
-			WHERE instance_id = {};
-		),
-			m_safereturn.zone_id,
-			m_safereturn.x,
-			m_safereturn.y,
-			m_safereturn.z,
-			m_safereturn.heading,
-			m_instance_id
-		);
-
-		database.QueryDatabase(query);
-	}
+	m_compass.zone_id    = info.compass_zone_id;
+	m_compass.x          = info.compass_x;
+	m_compass.y          = info.compass_y;
+	m_compass.z          = info.compass_z;
+	m_safereturn.zone_id = info.safereturn_zone_id;
+	m_safereturn.x       = info.safereturn_x;
+	m_safereturn.y       = info.safereturn_y;
+	m_safereturn.z       = info.safereturn_z;
+	m_safereturn.heading = info.safereturn_heading;
+	m_zonein.x           = info.zonein_x;
+	m_zonein.y           = info.zonein_y;
+	m_zonein.z           = info.zonein_z;
+	m_zonein.heading     = info.zonein_heading;
 }
 
-void DynamicZone::SaveZoneInLocationToDatabase()
+void DynamicZone::SaveServerDzInfo(ServerDzInfo_Struct& info) const
 {
-	LogDynamicZonesDetail(
-		"Instance [{}] saving zonein zone: [{}] xyzh: ([{}], [{}], [{}], [{}]) has: [{}]",
-		m_instance_id, m_zone_id, m_zonein.x, m_zonein.y, m_zonein.z, m_zonein.heading, m_has_zonein
-	);
-
-	if (m_instance_id != 0)
-	{
-		std::string query = fmt::format(SQL(
-			UPDATE dynamic_zones SET
-				zone_in_x = {},
-				zone_in_y = {},
-				zone_in_z = {},
-				zone_in_heading = {},
-				has_zone_in = {}
-			WHERE instance_id = {};
-		),
-			m_zonein.x,
-			m_zonein.y,
-			m_zonein.z,
-			m_zonein.heading,
-			m_has_zonein,
-			m_instance_id
-		);
-
-		database.QueryDatabase(query);
-	}
+	info.dz_id              = m_id;
+	info.zone_id            = GetZoneID();
+	info.instance_id        = GetInstanceID();
+	info.version            = m_version;
+	info.type               = static_cast<uint8_t>(m_type);
+	info.never_expires      = m_never_expires;
+	info.has_zonein         = m_has_zonein;
+	info.start_time         = std::chrono::system_clock::to_time_t(m_start_time);
+	info.duration           = static_cast<uint32_t>(m_duration.count());
+	info.compass_zone_id    = m_compass.zone_id;
+	info.compass_x          = m_compass.x;
+	info.compass_y          = m_compass.y;
+	info.compass_z          = m_compass.z;
+	info.safereturn_zone_id = m_safereturn.zone_id;
+	info.safereturn_x       = m_safereturn.x;
+	info.safereturn_y       = m_safereturn.y;
+	info.safereturn_z       = m_safereturn.z;
+	info.safereturn_heading = m_safereturn.heading;
+	info.zonein_x           = m_zonein.x;
+	info.zonein_y           = m_zonein.y;
+	info.zonein_z           = m_zonein.z;
+	info.zonein_heading     = m_zonein.heading;
 }
 
 void DynamicZone::AddCharacter(uint32_t character_id)
 {
-	database.AddClientToInstance(m_instance_id, character_id);
+	// world stores instance players along with the expedition members
 	SendInstanceCharacterChange(character_id, false); // stops client kick timer
 }
 
 void DynamicZone::RemoveCharacter(uint32_t character_id)
 {
-	database.RemoveClientFromInstance(m_instance_id, character_id);
 	SendInstanceCharacterChange(character_id, true); // start client kick timer
 }
 
@@ -389,30 +147,6 @@ void DynamicZone::RemoveAllCharacters(bool enable_removal_timers)
 			worldserver.SendPacket(pack.get());
 		}
 	}
-
-	database.RemoveClientsFromInstance(GetInstanceID());
-}
-
-void DynamicZone::SaveInstanceMembersToDatabase(const std::vector<uint32_t>& character_ids)
-{
-	LogDynamicZonesDetail("Saving [{}] instance members to database", character_ids.size());
-
-	std::string insert_values;
-	for (const auto& character_id : character_ids)
-	{
-		fmt::format_to(std::back_inserter(insert_values), "({}, {}),", m_instance_id, character_id);
-	}
-
-	if (!insert_values.empty())
-	{
-		insert_values.pop_back(); // trailing comma
-
-		std::string query = fmt::format(SQL(
-			REPLACE INTO instance_list_player (id, charid) VALUES {};
-		), insert_values);
-
-		database.QueryDatabase(query);
-	}
 }
 
 void DynamicZone::SendInstanceCharacterChange(uint32_t character_id, bool removed)
@@ -439,35 +173,20 @@ void DynamicZone::SendInstanceCharacterChange(uint32_t character_id, bool remove
 	}
 }
 
-void DynamicZone::SetCompass(const DynamicZoneLocation& location, bool update_db)
+void DynamicZone::SetCompass(const DynamicZoneLocation& location)
 {
 	m_compass = location;
-
-	if (update_db)
-	{
-		SaveCompassToDatabase();
-	}
 }
 
-void DynamicZone::SetSafeReturn(const DynamicZoneLocation& location, bool update_db)
+void DynamicZone::SetSafeReturn(const DynamicZoneLocation& location)
 {
 	m_safereturn = location;
-
-	if (update_db)
-	{
-		SaveSafeReturnToDatabase();
-	}
 }
 
-void DynamicZone::SetZoneInLocation(const DynamicZoneLocation& location, bool update_db)
+void DynamicZone::SetZoneInLocation(const DynamicZoneLocation& location)
 {
 	m_zonein = location;
 	m_has_zonein = true;
-
-	if (update_db)
-	{
-		SaveZoneInLocationToDatabase();
-	}
 }
 
 bool DynamicZone::IsCurrentZoneDzInstance() const
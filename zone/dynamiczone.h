@@ -24,11 +24,9 @@
 #include <chrono>
 #include <cstdint>
 #include <string>
-#include <unordered_map>
-#include <vector>
 
-class MySQLRequestRow;
 class ServerPacket;
+struct ServerDzInfo_Struct;
 
 enum class DynamicZoneType : uint8_t
 {
@@ -62,8 +60,6 @@ public:
 	DynamicZone(uint32_t dz_id) : m_id(dz_id) {}
 	DynamicZone(DynamicZoneType type) : m_type(type) {}
 
-	static std::unordered_map<uint32_t, DynamicZone> LoadMultipleDzFromDatabase(
-		const std::vector<uint32_t>& dynamic_zone_ids);
 	static void HandleWorldMessage(ServerPacket* pack);
 
 	uint64_t GetExpireTime() const { return std::chrono::system_clock::to_time_t(m_expire_time); }
@@ -79,8 +75,8 @@ public:
 	DynamicZoneLocation GetZoneInLocation() const { return m_zonein; }
 
 	void     AddCharacter(uint32_t character_id);
-	uint32_t Create();
-	uint32_t CreateInstance();
+	void     LoadServerDzInfo(const ServerDzInfo_Struct& info);
+	void     SaveServerDzInfo(ServerDzInfo_Struct& info) const;
 	bool     HasZoneInLocation() const { return m_has_zonein; }
 	bool     IsCurrentZoneDzInstance() const;
 	bool     IsInstanceID(uint32_t instance_id) const;
@@ -88,21 +84,13 @@ public:
 	bool     IsSameDz(uint32_t zone_id, uint32_t instance_id) const;
 	void     RemoveAllCharacters(bool enable_removal_timers = true);
 	void     RemoveCharacter(uint32_t character_id);
-	void     SaveInstanceMembersToDatabase(const std::vector<uint32_t>& character_ids);
 	void     SendInstanceCharacterChange(uint32_t character_id, bool removed);
-	void     SetCompass(const DynamicZoneLocation& location, bool update_db = false);
-	void     SetSafeReturn(const DynamicZoneLocation& location, bool update_db = false);
-	void     SetZoneInLocation(const DynamicZoneLocation& location, bool update_db = false);
+	void     SetCompass(const DynamicZoneLocation& location);
+	void     SetSafeReturn(const DynamicZoneLocation& location);
+	void     SetZoneInLocation(const DynamicZoneLocation& location);
 	void     SetUpdatedDuration(uint32_t seconds);
 
 private:
-	static std::string DynamicZoneSelectQuery();
-	void LoadDatabaseResult(MySQLRequestRow& row);
-	void SaveCompassToDatabase();
-	void SaveSafeReturnToDatabase();
-	void SaveZoneInLocationToDatabase();
-	uint32_t SaveToDatabase();
-
 	uint32_t m_id            = 0;
 	uint32_t m_zone_id       = 0;
 	uint32_t m_instance_id   = 0;
@@ -31,7 +31,7 @@
 #include <algorithm>
 #include <sstream>
 
-extern Zone *zone;
+extern Zone *&zone;
 
 const char *QuestEventSubroutines[_LargestEventID] = {
 	"EVENT_SAY",
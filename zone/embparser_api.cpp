@@ -37,7 +37,7 @@
 
 #include <cctype>
 
-extern Zone      *zone;
+extern Zone      *&zone;
 extern QueryServ *QServ;
 
 /*
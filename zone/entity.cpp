@@ -53,9 +53,9 @@
 #include "bot.h"
 #endif
 
-extern Zone *zone;
+extern Zone *&zone;
 extern volatile bool is_zone_loaded;
-extern WorldServer worldserver;
+extern WorldServer &worldserver;
 extern uint32 numclients;
 extern PetitionList petition_list;
 
@@ -63,8 +63,11 @@ extern char errorname[32];
 
 Entity::Entity()
 {
+	static uint32 next_serial = 0;
+
 	id              = 0;
 	initial_id      = 0;
+	serial          = ++next_serial;
 	spawn_timestamp = time(nullptr);
 }
 
@@ -712,6 +715,7 @@ void EntityList::AddNPC(NPC *npc, bool SendSpawnPacket, bool dontqueue)
 
 	npc_list.insert(std::pair<uint16, NPC *>(npc->GetID(), npc));
 	mob_list.insert(std::pair<uint16, Mob *>(npc->GetID(), npc));
+	IndexNPC(npc);
 
 	entity_list.ScanCloseMobs(npc->close_mobs, npc, true);
 
@@ -1109,11 +1113,10 @@ NPC *EntityList::GetNPCByNPCTypeID(uint32 npc_id)
 	if (npc_id == 0 || npc_list.empty())
 		return nullptr;
 
-	auto it = npc_list.begin();
-	while (it != npc_list.end()) {
+	auto range = npc_type_index.equal_range(npc_id);
+	for (auto it = range.first; it != range.second; ++it) {
 		if (it->second->GetNPCTypeID() == npc_id)
 			return it->second;
-		++it;
 	}
 
 	return nullptr;
@@ -1125,16 +1128,74 @@ NPC *EntityList::GetNPCBySpawnID(uint32 spawn_id)
 		return nullptr;
 	}
 
-	auto it = npc_list.begin();
-	while (it != npc_list.end()) {
+	auto range = npc_spawn_group_index.equal_range(spawn_id);
+	for (auto it = range.first; it != range.second; ++it) {
 		if (it->second->GetSpawnGroupId() == spawn_id) {
 			return it->second;
 		}
-		++it;
 	}
 	return nullptr;
 }
 
+/**
+ * @param npc
+ */
+void EntityList::IndexNPC(NPC *npc)
+{
+	NPCIndexKeys keys;
+	keys.npc_type_id    = npc->GetNPCTypeID();
+	keys.spawn_group_id = npc->GetSpawnGroupId();
+
+	npc_type_index.insert(std::make_pair(keys.npc_type_id, npc));
+	npc_spawn_group_index.insert(std::make_pair(keys.spawn_group_id, npc));
+	npc_index_keys[npc->GetID()] = keys;
+}
+
+/**
+ * @param entity_id
+ */
+void EntityList::UnindexNPC(uint16 entity_id)
+{
+	auto keys = npc_index_keys.find(entity_id);
+	if (keys == npc_index_keys.end()) {
+		return;
+	}
+
+	auto erase_from = [entity_id](std::unordered_multimap<uint32, NPC *> &index, uint32 key) {
+		auto range = index.equal_range(key);
+		for (auto it = range.first; it != range.second; ++it) {
+			if (it->second->GetID() == entity_id) {
+				index.erase(it);
+				return;
+			}
+		}
+	};
+
+	erase_from(npc_type_index, keys->second.npc_type_id);
+	erase_from(npc_spawn_group_index, keys->second.spawn_group_id);
+	npc_index_keys.erase(keys);
+}
+
+/**
+ * Call after changing the npc type or spawn group of an npc that is already in the list
+ *
+ * @param npc
+ */
+void EntityList::ReindexNPC(NPC *npc)
+{
+	if (!npc) {
+		return;
+	}
+
+	auto it = npc_list.find(npc->GetID());
+	if (it == npc_list.end() || it->second != npc) {
+		return;
+	}
+
+	UnindexNPC(npc->GetID());
+	IndexNPC(npc);
+}
+
 Mob *EntityList::GetMob(uint16 get_id)
 {
 	Entity *ent = nullptr;
@@ -1170,8 +1231,13 @@ Mob *EntityList::GetMobByNpcTypeID(uint32 get_id)
 	if (get_id == 0 || mob_list.empty())
 		return 0;
 
-	auto it = mob_list.begin();
-	while (it != mob_list.end()) {
+	auto npc = GetNPCByNPCTypeID(get_id);
+	if (npc)
+		return npc;
+
+	// mercs carry an npc type too but are not part of npc_list
+	auto it = merc_list.begin();
+	while (it != merc_list.end()) {
 		if (it->second->GetNPCTypeID() == get_id)
 			return it->second;
 		++it;
@@ -1184,12 +1250,11 @@ bool EntityList::IsMobSpawnedByNpcTypeID(uint32 get_id)
 	if (get_id == 0 || npc_list.empty())
 		return false;
 
-	auto it = npc_list.begin();
-	while (it != npc_list.end()) {
+	auto range = npc_type_index.equal_range(get_id);
+	for (auto it = range.first; it != range.second; ++it) {
 		// Mobs will have a 0 as their GetID() if they're dead
 		if (it->second->GetNPCTypeID() == get_id && it->second->GetID() != 0)
 			return true;
-		++it;
 	}
 
 	return false;
@@ -1309,77 +1374,110 @@ void EntityList::SendZoneSpawns(Client *client)
 	}
 }
 
+/**
+ * Only the nearest Zone:ZoneInSpawnBurst spawns go out in OP_ZoneSpawns during zone in, everything else,
+ * including all wear changes, is streamed nearest first by Client::ProcessZoneInSpawnStream once connected
+ *
+ * @param client
+ */
 void EntityList::SendZoneSpawnsBulk(Client *client)
 {
-	NewSpawn_Struct     ns{};
-	Mob                 *spawn;
-	EQApplicationPacket *app;
+	struct ZoneInCandidate {
+		Mob   *spawn;
+		float distance;
+	};
 
-	uint32 max_spawns = 100;
+	NewSpawn_Struct ns{};
+	Mob             *spawn;
 
-	if (max_spawns > mob_list.size()) {
-		max_spawns = static_cast<uint32>(mob_list.size());
-	}
+	std::vector<ZoneInCandidate> candidates;
+	candidates.reserve(mob_list.size());
 
-	auto            bulk_zone_spawn_packet = new BulkZoneSpawnPacket(client, max_spawns);
-	const glm::vec4 &client_position       = client->GetPosition();
-	const float     distance_max           = (600.0 * 600.0);
+	const glm::vec4 &client_position = client->GetPosition();
 
-	for (auto & it : mob_list) {
+	for (auto &it : mob_list) {
 		spawn = it.second;
 		if (spawn && spawn->GetID() > 0 && spawn->Spawned()) {
 			if (!spawn->ShouldISpawnFor(client)) {
 				continue;
 			}
 
-			const glm::vec4 &spawn_position = spawn->GetPosition();
+			candidates.push_back({spawn, DistanceSquared(client_position, spawn->GetPosition())});
+		}
+	}
 
-			bool is_delayed_packet = (
-				DistanceSquared(client_position, spawn_position) > distance_max ||
-				(spawn->IsClient() && (spawn->GetRace() == MINOR_ILL_OBJ || spawn->GetRace() == TREE))
-			);
+	std::sort(
+		candidates.begin(), candidates.end(), [](const ZoneInCandidate &a, const ZoneInCandidate &b) {
+			return a.distance < b.distance;
+		}
+	);
 
-			if (is_delayed_packet) {
-				app = new EQApplicationPacket;
-				spawn->CreateSpawnPacket(app);
-				client->QueuePacket(app, true, Client::CLIENT_CONNECTED);
-				safe_delete(app);
-			}
-			else {
-				memset(&ns, 0, sizeof(NewSpawn_Struct));
-				spawn->FillSpawnStruct(&ns, client);
-				bulk_zone_spawn_packet->AddSpawn(&ns);
-			}
+	uint32 max_spawns = 100;
 
-			spawn->SendArmorAppearance(client);
-
-			/**
-			 * Original code kept for spawn packet research
-			 *
-			 * int32 race = spawn->GetRace();
-			 *
-			 * Illusion races on PCs don't work as a mass spawn
-			 * But they will work as an add_spawn AFTER CLIENT_CONNECTED.
-			 * if (spawn->IsClient() && (race == MINOR_ILL_OBJ || race == TREE)) {
-			 * 	app = new EQApplicationPacket;
-			 * 	spawn->CreateSpawnPacket(app);
-			 * 	client->QueuePacket(app, true, Client::CLIENT_CONNECTED);
-			 * 	safe_delete(app);
-			 * }
-			 * else {
-			 * 	memset(&ns, 0, sizeof(NewSpawn_Struct));
-			 * 	spawn->FillSpawnStruct(&ns, client);
-			 * 	bzsp->AddSpawn(&ns);
-			 * }
-			 *
-			 * Despite being sent in the OP_ZoneSpawns packet, the client
-			 * does not display worn armor correctly so display it.
-			 * spawn->SendArmorAppearance(client);
-			*/
-		}
+	if (max_spawns > candidates.size()) {
+		max_spawns = static_cast<uint32>(candidates.size());
+	}
+
+	auto        bulk_zone_spawn_packet = new BulkZoneSpawnPacket(client, max_spawns);
+	const float distance_max           = (600.0 * 600.0);
+	const int   burst                  = RuleI(Zone, ZoneInSpawnBurst);
+	uint32      bulk_spawns            = 0;
+	uint32      packets_sent           = 0;
+
+	std::deque<Client::ZoneInSpawn> stream;
+
+	for (auto &candidate : candidates) {
+		spawn = candidate.spawn;
+
+		bool is_delayed_packet = (
+			candidate.distance > distance_max ||
+			(spawn->IsClient() && (spawn->GetRace() == MINOR_ILL_OBJ || spawn->GetRace() == TREE)) ||
+			(burst >= 0 && bulk_spawns >= static_cast<uint32>(burst))
+		);
+
+		if (!is_delayed_packet) {
+			memset(&ns, 0, sizeof(NewSpawn_Struct));
+			spawn->FillSpawnStruct(&ns, client);
+			if (bulk_zone_spawn_packet->AddSpawn(&ns)) {
+				packets_sent++;
+			}
+			bulk_spawns++;
+		}
+
+		stream.push_back({spawn->GetID(), spawn->GetSerial(), is_delayed_packet});
+
+		/**
+		 * Original code kept for spawn packet research
+		 *
+		 * int32 race = spawn->GetRace();
+		 *
+		 * Illusion races on PCs don't work as a mass spawn
+		 * But they will work as an add_spawn AFTER CLIENT_CONNECTED.
+		 * if (spawn->IsClient() && (race == MINOR_ILL_OBJ || race == TREE)) {
+		 * 	app = new EQApplicationPacket;
+		 * 	spawn->CreateSpawnPacket(app);
+		 * 	client->QueuePacket(app, true, Client::CLIENT_CONNECTED);
+		 * 	safe_delete(app);
+		 * }
+		 * else {
+		 * 	memset(&ns, 0, sizeof(NewSpawn_Struct));
+		 * 	spawn->FillSpawnStruct(&ns, client);
+		 * 	bzsp->AddSpawn(&ns);
+		 * }
+		 *
+		 * Despite being sent in the OP_ZoneSpawns packet, the client
+		 * does not display worn armor correctly so display it.
+		 * spawn->SendArmorAppearance(client);
+		*/
+	}
+
+	if (max_spawns > 0 && bulk_spawns % max_spawns != 0) {
+		packets_sent++;
 	}
 
 	safe_delete(bulk_zone_spawn_packet);
+
+	client->StartZoneInSpawnStream(std::move(stream), packets_sent);
 }
 
 //this is a hack to handle a broken spawn struct
@@ -2465,6 +2563,9 @@ void EntityList::RemoveAllNPCs()
 {
 	// doesn't clear the data
 	npc_list.clear();
+	npc_type_index.clear();
+	npc_spawn_group_index.clear();
+	npc_index_keys.clear();
 	npc_limit_list.clear();
 }
 
@@ -2633,6 +2734,7 @@ bool EntityList::RemoveNPC(uint16 delete_id)
 	if (it != npc_list.end()) {
 		NPC *npc = it->second;
 		RemoveProximity(delete_id);
+		UnindexNPC(delete_id);
 		npc_list.erase(it);
 
 		if (npc_limit_list.count(delete_id)) {
@@ -2904,41 +3006,70 @@ void EntityList::UpdateWho(bool iSendFullUpdate)
 {
 	if ((!worldserver.Connected()) || !is_zone_loaded)
 		return;
-	uint32 tmpNumUpdates = numclients + 5;
-	ServerPacket* pack = 0;
-	ServerClientListKeepAlive_Struct* sclka = 0;
-	if (!iSendFullUpdate) {
-		pack = new ServerPacket(ServerOP_ClientListKA, sizeof(ServerClientListKeepAlive_Struct) + (tmpNumUpdates * 4));
-		sclka = (ServerClientListKeepAlive_Struct*) pack->pBuffer;
-	}
 
-	auto it = client_list.begin();
-	while (it != client_list.end()) {
-		if (it->second->InZone()) {
-			if (iSendFullUpdate) {
-				it->second->UpdateWho();
-			} else {
-				if (sclka->numupdates >= tmpNumUpdates) {
-					tmpNumUpdates += 10;
-					uint8* tmp = pack->pBuffer;
-					pack->pBuffer = new uint8[sizeof(ServerClientListKeepAlive_Struct) + (tmpNumUpdates * 4)];
-					memset(pack->pBuffer, 0, sizeof(ServerClientListKeepAlive_Struct) + (tmpNumUpdates * 4));
-					memcpy(pack->pBuffer, tmp, pack->size);
-					pack->size = sizeof(ServerClientListKeepAlive_Struct) + (tmpNumUpdates * 4);
-					safe_delete_array(tmp);
-					sclka = (ServerClientListKeepAlive_Struct*) pack->pBuffer;
-				}
-				sclka->wid[sclka->numupdates] = it->second->GetWID();
-				sclka->numupdates++;
+	if (iSendFullUpdate) {
+		for (auto &it : client_list) {
+			if (it.second->InZone()) {
+				it.second->ResetWho();
+				it.second->UpdateWho();
 			}
 		}
-		++it;
+		return;
 	}
-	if (!iSendFullUpdate) {
-		pack->size = sizeof(ServerClientListKeepAlive_Struct) + (sclka->numupdates * 4);
-		worldserver.SendPacket(pack);
-		safe_delete(pack);
+
+	// joins, leaves and field changes already went out as they happened, world only needs to
+	// check it applied all of them and that the clients it has for this zone are still here
+	if (RuleB(Zone, DeltaClientList)) {
+		SendClientListSync();
+		return;
 	}
+
+	SendWhoKeepAlive();
+}
+
+/**
+ * @param resynced set once a full resend has gone out, world adopts our sequence instead of checking it
+ */
+void EntityList::SendClientListSync(bool resynced)
+{
+	if ((!worldserver.Connected()) || !is_zone_loaded)
+		return;
+
+	auto pack = new ServerPacket(ServerOP_ClientListSync, sizeof(ServerClientListSync_Struct));
+	auto sync = (ServerClientListSync_Struct*) pack->pBuffer;
+	sync->sequence = worldserver.GetClientListSequence();
+	sync->resynced = resynced ? 1 : 0;
+	for (auto &it : client_list) {
+		if (it.second->IsWhoAnnounced()) {
+			sync->count++;
+		}
+	}
+	worldserver.SendPacket(pack);
+	safe_delete(pack);
+}
+
+void EntityList::SendWhoKeepAlive()
+{
+	if ((!worldserver.Connected()) || !is_zone_loaded)
+		return;
+
+	uint32 num_updates = 0;
+	for (auto &it : client_list) {
+		if (it.second->InZone()) {
+			num_updates++;
+		}
+	}
+
+	auto pack = new ServerPacket(ServerOP_ClientListKA, sizeof(ServerClientListKeepAlive_Struct) + (num_updates * 4));
+	auto sclka = (ServerClientListKeepAlive_Struct*) pack->pBuffer;
+	for (auto &it : client_list) {
+		if (it.second->InZone() && sclka->numupdates < num_updates) {
+			sclka->wid[sclka->numupdates] = it.second->GetWID();
+			sclka->numupdates++;
+		}
+	}
+	worldserver.SendPacket(pack);
+	safe_delete(pack);
 }
 
 void EntityList::RemoveEntity(uint16 id)
@@ -3013,11 +3144,15 @@ void EntityList::Depop(bool StartSpawnTimer)
 
 void EntityList::DepopAll(int NPCTypeID, bool StartSpawnTimer)
 {
-	for (auto it = npc_list.begin(); it != npc_list.end(); ++it) {
-		NPC *pnpc = it->second;
-		if (pnpc && (pnpc->GetNPCTypeID() == (uint32)NPCTypeID))
-			pnpc->Depop(StartSpawnTimer);
+	std::vector<NPC *> matches;
+	auto range = npc_type_index.equal_range((uint32)NPCTypeID);
+	for (auto it = range.first; it != range.second; ++it) {
+		if (it->second->GetNPCTypeID() == (uint32)NPCTypeID)
+			matches.push_back(it->second);
 	}
+
+	for (auto pnpc : matches)
+		pnpc->Depop(StartSpawnTimer);
 }
 
 void EntityList::SendTraders(Client *client)
@@ -3481,12 +3616,11 @@ void EntityList::AggroZone(Mob *who, uint32 hate)
 // Signal Quest command function
 void EntityList::SignalMobsByNPCID(uint32 snpc, int signal_id)
 {
-	auto it = npc_list.begin();
-	while (it != npc_list.end()) {
+	auto range = npc_type_index.equal_range(snpc);
+	for (auto it = range.first; it != range.second; ++it) {
 		NPC *pit = it->second;
 		if (pit->GetNPCTypeID() == snpc)
 			pit->SignalNPC(signal_id);
-		++it;
 	}
 }
 
@@ -3957,6 +4091,29 @@ bool EntityList::IsMobInZone(Mob *who)
 	return false;
 }
 
+/**
+ * Resolves a mob or encounter from an id/serial pair taken earlier, returning nullptr if that
+ * entity has since left the zone, even when its id has been handed out again.
+ *
+ * @param id
+ * @param serial
+ * @return
+ */
+Mob *EntityList::GetMobBySerial(uint16 id, uint32 serial)
+{
+	auto it = mob_list.find(id);
+	if (it != mob_list.end()) {
+		return it->second->GetSerial() == serial ? it->second : nullptr;
+	}
+
+	auto enc_it = encounter_list.find(id);
+	if (enc_it != encounter_list.end() && enc_it->second->GetSerial() == serial) {
+		return enc_it->second;
+	}
+
+	return nullptr;
+}
+
 /*
 Code to limit the amount of certain NPCs in a given zone.
 Primarily used to make a named mob unique within the zone, but written
@@ -61,7 +61,7 @@ class Bot;
 class BotRaids;
 #endif
 
-extern EntityList entity_list;
+extern EntityList &entity_list;
 
 class Entity
 {
@@ -112,6 +112,7 @@ public:
 
 	inline const uint16& GetInitialId() const { return initial_id; }
 	inline const uint16& GetID() const { return id; }
+	inline const uint32& GetSerial() const { return serial; }
 	inline const time_t& GetSpawnTimeStamp() const { return spawn_timestamp; }
 
 	virtual const char* GetName() { return ""; }
@@ -135,6 +136,7 @@ protected:
 private:
 	uint16 id;
 	uint16 initial_id;
+	uint32 serial; // unique for the life of the zone process, unlike entity ids which get reused
 	time_t spawn_timestamp;
 };
 
@@ -168,6 +170,7 @@ public:
 	}
 	NPC *GetNPCByNPCTypeID(uint32 npc_id);
 	NPC *GetNPCBySpawnID(uint32 spawn_id);
+	void ReindexNPC(NPC *npc);
 	inline Merc *GetMercByID(uint16 id)
 	{
 		auto it = merc_list.find(id);
@@ -235,6 +238,7 @@ public:
 	void RemoveCorpseByDBID(uint32 dbid);
 	int RezzAllCorpsesByCharID(uint32 charid);
 	bool IsMobInZone(Mob *who);
+	Mob *GetMobBySerial(uint16 id, uint32 serial);
 	void ClearClientPetitionQueue();
 	bool CanAddHateForMob(Mob *p);
 	void	SendGuildMOTD(uint32 guild_id);
@@ -427,6 +431,8 @@ public:
 	Mob*	FindDefenseNPC(uint32 npcid);
 	void	OpenDoorsNear(Mob* opener);
 	void	UpdateWho(bool iSendFullUpdate = false);
+	void	SendWhoKeepAlive();
+	void	SendClientListSync(bool resynced = false);
 	char*	MakeNameUnique(char* name);
 	static char* RemoveNumbers(char* name);
 	void	SignalMobsByNPCID(uint32 npc_type, int signal_id);
@@ -560,6 +566,14 @@ private:
 	std::unordered_map<uint16, Mob *> mob_list;
 	std::unordered_map<uint16, NPC *> npc_list;
 	std::unordered_map<uint16, Merc *> merc_list;
+
+	// secondary indexes over npc_list, kept in step by AddNPC/RemoveNPC/ReindexNPC
+	struct NPCIndexKeys { uint32 npc_type_id; uint32 spawn_group_id; };
+	void IndexNPC(NPC *npc);
+	void UnindexNPC(uint16 entity_id);
+	std::unordered_multimap<uint32, NPC *> npc_type_index;
+	std::unordered_multimap<uint32, NPC *> npc_spawn_group_index;
+	std::unordered_map<uint16, NPCIndexKeys> npc_index_keys; // the keys each npc was indexed under
 	std::unordered_map<uint16, Corpse *> corpse_list;
 	std::unordered_map<uint16, Object *> object_list;
 	std::unordered_map<uint16, Doors *> door_list;
@@ -20,17 +20,18 @@
 
 #include "expedition.h"
 #include "expedition_database.h"
-#include "expedition_lockout_timer.h"
 #include "expedition_request.h"
 #include "client.h"
 #include "string_ids.h"
 #include "worldserver.h"
 #include "zonedb.h"
 #include "../common/eqemu_logsys.h"
+#include "../common/expedition_lockout_timer.h"
 #include "../common/util/uuid.h"
+#include <algorithm>
 
-extern WorldServer worldserver;
-extern Zone* zone;
+extern WorldServer &worldserver;
+extern Zone*& zone;
 
 // message string 8271 (not in emu clients)
 const char* const DZ_YOU_NOT_ASSIGNED        = "You could not use this command because you are not currently assigned to a dynamic zone.";
@@ -63,6 +64,8 @@ Expedition::Expedition(
 {
 }
 
+Expedition::~Expedition() = default;
+
 Expedition* Expedition::TryCreate(
 	Client* requester, DynamicZone& dynamiczone, ExpeditionRequest& request)
 {
@@ -71,15 +74,14 @@ Expedition* Expedition::TryCreate(
 		return nullptr;
 	}
 
-	// request parses leader, members list, and lockouts while validating
+	// request only gathers the leader and members, world checks them for conflicts
 	if (!request.Validate(requester))
 	{
 		LogExpeditionsModerate("[{}] request by [{}] denied", request.GetExpeditionName(), requester->GetName());
 		return nullptr;
 	}
 
-	auto dynamic_zone_id = dynamiczone.Create();
-	if (dynamic_zone_id == 0)
+	if (dynamiczone.GetZoneID() == 0)
 	{
 		// live uses this message when trying to enter an instance that isn't ready
 		// we can use it as the client error message if instance creation fails
@@ -88,217 +90,280 @@ Expedition* Expedition::TryCreate(
 		return nullptr;
 	}
 
-	std::string expedition_uuid = EQ::Util::UUID::Generate().ToString();
-
-	// unique expedition ids are created from database via auto-increment column
-	auto expedition_id = ExpeditionDatabase::InsertExpedition(
-		expedition_uuid,
-		dynamiczone.GetID(),
+	// world assigns the expedition id when it accepts the request. until then
+	// this pending expedition (id 0) collects quest settings and calls for it.
+	// the same object becomes the cached expedition so quest handles stay valid
+	auto expedition = std::unique_ptr<Expedition>(new Expedition(
+		0,
+		EQ::Util::UUID::Generate().ToString(),
+		dynamiczone,
 		request.GetExpeditionName(),
-		request.GetLeaderID(),
+		ExpeditionMember{ request.GetLeaderID(), request.GetLeaderName() },
 		request.GetMinPlayers(),
 		request.GetMaxPlayers()
+	));
+
+	expedition->m_create_request.reset(new ExpeditionRequest(request));
+
+	LogExpeditionsModerate(
+		"Requesting [{}] for leader [{}] with [{}] members", expedition->GetName(),
+		expedition->GetLeaderName(), request.GetMembers().size()
 	);
 
-	if (expedition_id)
-	{
-		auto expedition = std::unique_ptr<Expedition>(new Expedition(
-			expedition_id,
-			expedition_uuid,
-			dynamiczone,
-			request.GetExpeditionName(),
-			ExpeditionMember{ request.GetLeaderID(), request.GetLeaderName() },
-			request.GetMinPlayers(),
-			request.GetMaxPlayers()
-		));
+	zone->pending_expeditions.emplace_back(std::move(expedition));
 
-		LogExpeditions(
-			"Created [{}] [{}] instance id: [{}] leader: [{}] minplayers: [{}] maxplayers: [{}]",
-			expedition->GetID(),
-			expedition->GetName(),
-			expedition->GetInstanceID(),
-			expedition->GetLeaderName(),
-			expedition->GetMinPlayers(),
-			expedition->GetMaxPlayers()
-		);
+	return zone->pending_expeditions.back().get();
+}
 
-		expedition->SaveMembers(request);
-		expedition->SaveLockouts(request);
+void Expedition::SendPendingCreateRequests()
+{
+	if (!zone)
+	{
+		return;
+	}
 
-		auto inserted = zone->expedition_cache.emplace(expedition_id, std::move(expedition));
+	// sent after the quest event that created them so their settings go in the request
+	for (auto it = zone->pending_expeditions.begin(); it != zone->pending_expeditions.end();)
+	{
+		auto& expedition = *it;
+		++it;
 
-		inserted.first->second->SendUpdatesToZoneMembers();
-		inserted.first->second->SendWorldExpeditionUpdate(ServerOP_ExpeditionCreate); // cache in other zones
-		inserted.first->second->SendLeaderMessage(request.GetLeaderClient(),
-			Chat::System, EXPEDITION_AVAILABLE, { request.GetExpeditionName() });
+		if (expedition->m_is_create_sent)
+		{
+			continue;
+		}
+
+		expedition->m_is_create_sent = true;
 
-		if (!request.GetNotAllAddedMessage().empty())
+		if (!worldserver.Connected())
 		{
-			Client::SendCrossZoneMessage(request.GetLeaderClient(), request.GetLeaderName(),
-				Chat::System, request.GetNotAllAddedMessage());
+			Client* requester = entity_list.GetClientByCharID(expedition->m_create_request->GetRequesterID());
+			if (requester)
+			{
+				requester->MessageString(Chat::Red, DZ_PREVENT_ENTERING);
+			}
+			expedition->m_is_rejected = true;
+			expedition->m_deferred_calls.clear();
+			continue;
 		}
 
-		return inserted.first->second.get();
+		expedition->SendWorldCreateRequest();
 	}
+}
 
-	return nullptr;
+void Expedition::SendWorldCreateRequest()
+{
+	const auto& members = m_create_request->GetMembers();
+
+	uint32_t pack_size = sizeof(ServerExpeditionCreateRequest_Struct) +
+		static_cast<uint32_t>(members.size()) * sizeof(ServerExpeditionMemberEntry_Struct);
+	auto pack = std::unique_ptr<ServerPacket>(new ServerPacket(ServerOP_ExpeditionCreateRequest, pack_size));
+	auto buf = reinterpret_cast<ServerExpeditionCreateRequest_Struct*>(pack->pBuffer);
+	buf->sender_zone_id     = zone ? zone->GetZoneID() : 0;
+	buf->sender_instance_id = zone ? zone->GetInstanceID() : 0;
+	buf->disable_messages   = m_create_request->IsMessagesDisabled();
+	buf->gm_bypass          = m_create_request->IsGMBypass();
+	buf->requester_id       = m_create_request->GetRequesterID();
+	buf->leader_id          = m_leader.char_id;
+	buf->min_players        = m_min_players;
+	buf->max_players        = m_max_players;
+	buf->add_replay_on_join = m_add_replay_on_join;
+	buf->is_locked          = m_is_locked;
+	buf->member_count       = static_cast<uint32_t>(members.size());
+	strn0cpy(buf->requester_name, m_create_request->GetRequesterName().c_str(), sizeof(buf->requester_name));
+	strn0cpy(buf->leader_name, m_leader.name.c_str(), sizeof(buf->leader_name));
+	strn0cpy(buf->uuid, m_uuid.c_str(), sizeof(buf->uuid));
+	strn0cpy(buf->expedition_name, m_expedition_name.c_str(), sizeof(buf->expedition_name));
+	m_dynamiczone.SaveServerDzInfo(buf->dz);
+
+	for (size_t i = 0; i < members.size(); ++i)
+	{
+		buf->members[i].char_id = members[i].char_id;
+		strn0cpy(buf->members[i].name, members[i].name.c_str(), sizeof(buf->members[i].name));
+	}
+
+	worldserver.SendPacket(pack.get());
 }
 
-void Expedition::CacheExpeditions(MySQLRequestResult& results)
+void Expedition::SendWorldCacheRequest()
 {
-	if (!results.Success() || !zone)
+	if (!zone)
 	{
 		return;
 	}
 
-	std::vector<uint32_t> expedition_ids;
-	std::vector<uint32_t> dynamic_zone_ids;;
-	std::vector<std::pair<uint32_t, uint32_t>> expedition_character_ids;
+	// world sends the expedition of this dz instance and of any characters in zone
+	std::vector<uint32_t> character_ids;
+	for (const auto& client : entity_list.GetClientList())
+	{
+		character_ids.emplace_back(client.second->CharacterID());
+	}
 
-	using col = LoadExpeditionColumns::eLoadExpeditionColumns;
+	uint32_t pack_size = sizeof(ServerExpeditionZoneRequest_Struct) +
+		static_cast<uint32_t>(character_ids.size()) * sizeof(uint32_t);
+	auto pack = std::unique_ptr<ServerPacket>(new ServerPacket(ServerOP_ExpeditionZoneRequest, pack_size));
+	auto buf = reinterpret_cast<ServerExpeditionZoneRequest_Struct*>(pack->pBuffer);
+	buf->sender_zone_id     = zone->GetZoneID();
+	buf->sender_instance_id = zone->GetInstanceID();
+	buf->count              = static_cast<uint32_t>(character_ids.size());
+	std::copy(character_ids.begin(), character_ids.end(), buf->character_ids);
 
-	uint32_t last_expedition_id = 0;
+	worldserver.SendPacket(pack.get());
+}
 
-	for (auto row = results.begin(); row != results.end(); ++row)
+void Expedition::CacheFromWorldPacket(ServerPacket* pack)
+{
+	auto buf = reinterpret_cast<ServerExpeditionCreate_Struct*>(pack->pBuffer);
+	if (!zone || FindCachedExpeditionByID(buf->expedition_id))
 	{
-		auto expedition_id = strtoul(row[col::id], nullptr, 10);
-
-		if (expedition_id != last_expedition_id)
-		{
-			expedition_ids.emplace_back(expedition_id);
+		return;
+	}
 
-			uint32_t leader_id = strtoul(row[col::leader_id], nullptr, 10);
-			uint32_t dynamic_zone_id = strtoul(row[col::dz_id], nullptr, 10);
+	size_t entries_size = buf->member_count * sizeof(ServerExpeditionMemberEntry_Struct) +
+		buf->lockout_count * sizeof(ServerExpeditionLockoutEntry_Struct);
 
-			dynamic_zone_ids.emplace_back(dynamic_zone_id);
+	if (pack->size < sizeof(ServerExpeditionCreate_Struct) + entries_size)
+	{
+		LogExpeditions("Ignoring malformed create packet for expedition [{}]", buf->expedition_id);
+		return;
+	}
 
-			std::unique_ptr<Expedition> expedition = std::unique_ptr<Expedition>(new Expedition(
-				expedition_id,
-				row[col::uuid],                                         // expedition uuid
-				DynamicZone{ dynamic_zone_id },
-				row[col::expedition_name],                              // expedition name
-				ExpeditionMember{ leader_id, row[col::leader_name] },   // expedition leader id, name
-				strtoul(row[col::min_players], nullptr, 10),            // min_players
-				strtoul(row[col::max_players], nullptr, 10)             // max_players
-			));
+	// a create request from this zone is finished in place so quest handles to it stay valid
+	std::string uuid = buf->uuid;
+	auto pending_it = std::find_if(zone->pending_expeditions.begin(), zone->pending_expeditions.end(),
+		[&](const std::unique_ptr<Expedition>& pending) { return pending->GetUUID() == uuid && !pending->m_is_rejected; });
 
-			bool add_replay_on_join = (strtoul(row[col::add_replay_on_join], nullptr, 10) != 0);
-			bool is_locked = (strtoul(row[col::is_locked], nullptr, 10) != 0);
+	std::unique_ptr<Expedition> expedition;
+	if (pending_it != zone->pending_expeditions.end())
+	{
+		expedition = std::move(*pending_it);
+		zone->pending_expeditions.erase(pending_it);
+	}
+	else
+	{
+		expedition.reset(new Expedition(0, uuid, DynamicZone{}, {}, {}, 0, 0));
+	}
 
-			expedition->SetReplayLockoutOnMemberJoin(add_replay_on_join);
-			expedition->SetLocked(is_locked, ExpeditionLockMessage::None);
+	expedition->m_id              = buf->expedition_id;
+	expedition->m_expedition_name = buf->expedition_name;
+	expedition->m_leader          = ExpeditionMember{ buf->leader_id, buf->leader_name };
+	expedition->m_min_players     = buf->min_players;
+	expedition->m_max_players     = buf->max_players;
+	expedition->m_dynamiczone.LoadServerDzInfo(buf->dz);
+	expedition->SetReplayLockoutOnMemberJoin(buf->add_replay_on_join != 0);
+	expedition->SetLocked(buf->is_locked != 0, ExpeditionLockMessage::None);
 
-			zone->expedition_cache.emplace(expedition_id, std::move(expedition));
+	expedition->m_members.clear();
+	auto members = reinterpret_cast<ServerExpeditionMemberEntry_Struct*>(buf->entries);
+	for (uint32_t i = 0; i < buf->member_count; ++i)
+	{
+		// world tracks member statuses from its client list
+		auto status = static_cast<ExpeditionMemberStatus>(members[i].status);
+		if (status == ExpeditionMemberStatus::InDynamicZone && !RuleB(Expedition, EnableInDynamicZoneStatus))
+		{
+			status = ExpeditionMemberStatus::Online;
 		}
+		expedition->AddInternalMember(members[i].name, members[i].char_id, status);
 
-		last_expedition_id = expedition_id;
-
-		// looping expedition members
-		auto current_expedition = Expedition::FindCachedExpeditionByID(last_expedition_id);
-		if (current_expedition)
+		if (members[i].char_id == expedition->m_leader.char_id)
 		{
-			auto member_id = strtoul(row[col::member_id], nullptr, 10);
-			current_expedition->AddInternalMember(
-				row[col::member_name], member_id, ExpeditionMemberStatus::Offline);
-			expedition_character_ids.emplace_back(expedition_id, member_id);
+			expedition->m_leader.status = status;
 		}
 	}
 
-	// ask world for online members from all cached expeditions at once
-	Expedition::SendWorldGetOnlineMembers(expedition_character_ids);
-
-	// bulk load dynamic zone data and expedition lockouts for cached expeditions
-	auto dynamic_zones = DynamicZone::LoadMultipleDzFromDatabase(dynamic_zone_ids);
-	auto expedition_lockouts = ExpeditionDatabase::LoadMultipleExpeditionLockouts(expedition_ids);
-
-	for (const auto& expedition_id : expedition_ids)
+	expedition->m_lockouts.clear();
+	auto lockouts = reinterpret_cast<ServerExpeditionLockoutEntry_Struct*>(members + buf->member_count);
+	for (uint32_t i = 0; i < buf->lockout_count; ++i)
 	{
-		auto expedition = Expedition::FindCachedExpeditionByID(expedition_id);
-		if (expedition)
-		{
-			auto dz_iter = dynamic_zones.find(expedition->GetDynamicZoneID());
-			if (dz_iter != dynamic_zones.end())
-			{
-				expedition->m_dynamiczone = dz_iter->second;
-			}
+		ExpeditionLockoutTimer lockout{
+			lockouts[i].uuid, expedition->GetName(), lockouts[i].event_name,
+			lockouts[i].expire_time, lockouts[i].duration
+		};
+		expedition->m_lockouts.emplace(lockout.GetEventName(), lockout);
+	}
 
-			auto lockout_iter = expedition_lockouts.find(expedition->GetID());
-			if (lockout_iter != expedition_lockouts.end())
-			{
-				expedition->m_lockouts = lockout_iter->second;
-			}
+	auto create_request = std::move(expedition->m_create_request);
+	auto deferred_calls = std::move(expedition->m_deferred_calls);
+	expedition->m_deferred_calls.clear();
 
-			// send member updates now that all data is loaded for the cached expedition
-			expedition->SendUpdatesToZoneMembers();
-		}
-	}
-}
+	auto inserted = zone->expedition_cache.emplace(buf->expedition_id, std::move(expedition));
+	auto cached_expedition = inserted.first->second.get();
+	cached_expedition->SendUpdatesToZoneMembers();
 
-void Expedition::CacheFromDatabase(uint32_t expedition_id)
-{
-	if (zone)
+	LogExpeditionsModerate("Cached expedition [{}] from world", buf->expedition_id);
+
+	if (create_request)
 	{
-		BenchTimer benchmark;
+		LogExpeditions(
+			"Created [{}] [{}] instance id: [{}] leader: [{}] minplayers: [{}] maxplayers: [{}]",
+			cached_expedition->GetID(),
+			cached_expedition->GetName(),
+			cached_expedition->GetInstanceID(),
+			cached_expedition->GetLeaderName(),
+			cached_expedition->GetMinPlayers(),
+			cached_expedition->GetMaxPlayers()
+		);
+
+		Client* leader_client = entity_list.GetClientByCharID(cached_expedition->GetLeaderID());
+		cached_expedition->SendLeaderMessage(leader_client, Chat::System, EXPEDITION_AVAILABLE, { cached_expedition->GetName() });
 
-		auto results = ExpeditionDatabase::LoadExpedition(expedition_id);
-		if (!results.Success())
+		if (!create_request->GetNotAllAddedMessage().empty())
 		{
-			LogExpeditions("Failed to load Expedition [{}] for zone cache", expedition_id);
-			return;
+			Client::SendCrossZoneMessage(leader_client, cached_expedition->GetLeaderName(),
+				Chat::System, create_request->GetNotAllAddedMessage());
 		}
 
-		CacheExpeditions(results);
-
-		auto elapsed = benchmark.elapsed();
-		LogExpeditions("Caching new expedition [{}] took [{}s]", expedition_id, elapsed);
+		for (const auto& call : deferred_calls)
+		{
+			call(cached_expedition);
+		}
 	}
 }
 
-bool Expedition::CacheAllFromDatabase()
+void Expedition::ProcessCreateRejected(ServerPacket* pack)
 {
-	if (!zone)
+	auto buf = reinterpret_cast<ServerExpeditionCreateRejected_Struct*>(pack->pBuffer);
+	if (!zone || pack->size < sizeof(ServerExpeditionCreateRejected_Struct) +
+	    buf->conflict_count * sizeof(ServerExpeditionConflictEntry_Struct))
 	{
-		return false;
+		return;
 	}
 
-	BenchTimer benchmark;
+	LogExpeditionsModerate("Request [{}] by [{}] denied by world", buf->uuid, buf->requester_name);
 
-	zone->expedition_cache.clear();
+	ExpeditionRequest::SendRejectedMessages(buf);
 
-	// load all active expeditions and members to current zone cache
-	auto results = ExpeditionDatabase::LoadAllExpeditions();
-	if (!results.Success())
+	// kept until the zone shuts down since quest handles to it may outlive the event that created it
+	std::string uuid = buf->uuid;
+	for (auto& pending : zone->pending_expeditions)
 	{
-		LogExpeditions("Failed to load Expeditions for zone cache");
-		return false;
+		if (pending->GetUUID() == uuid)
+		{
+			pending->m_is_rejected = true;
+			pending->m_deferred_calls.clear();
+		}
 	}
-
-	CacheExpeditions(results);
-
-	auto elapsed = benchmark.elapsed();
-	LogExpeditions("Caching [{}] expedition(s) took [{}s]", zone->expedition_cache.size(), elapsed);
-
-	return true;
 }
 
-void Expedition::SaveLockouts(ExpeditionRequest& request)
+bool Expedition::DeferIfPending(std::function<void(Expedition*)> call)
 {
-	m_lockouts = request.GetLockouts();
-	ExpeditionDatabase::InsertLockouts(m_id, m_lockouts);
-}
-
-void Expedition::SaveMembers(ExpeditionRequest& request)
-{
-	m_members = request.GetMembers();
-
-	std::vector<uint32_t> member_ids;
-	for (const auto& member : m_members)
+	// world hasn't accepted the create request yet, replayed once it's cached.
+	// a rejected request never gets an id so its calls are dropped
+	if (m_id == 0)
 	{
-		member_ids.emplace_back(member.char_id);
+		if (!m_is_rejected)
+		{
+			m_deferred_calls.emplace_back(std::move(call));
+		}
+		return true;
 	}
+	return false;
+}
 
-	ExpeditionDatabase::InsertMembers(m_id, m_members);
-	m_dynamiczone.SaveInstanceMembersToDatabase(member_ids);
+bool Expedition::DeferSettingIfSent(bool update_db, std::function<void(Expedition*)> call)
+{
+	// settings go out with the create request, once it's sent they wait for world like other calls
+	return update_db && m_is_create_sent && DeferIfPending(std::move(call));
 }
 
 Expedition* Expedition::FindCachedExpeditionByCharacterID(uint32_t character_id)
@@ -429,11 +494,16 @@ ExpeditionMember Expedition::GetMemberData(const std::string& character_name)
 
 void Expedition::SetReplayLockoutOnMemberJoin(bool add_on_join, bool update_db)
 {
+	if (DeferSettingIfSent(update_db, [=](Expedition* expedition) { expedition->SetReplayLockoutOnMemberJoin(add_on_join, true); }))
+	{
+		return;
+	}
+
 	m_add_replay_on_join = add_on_join;
 
-	if (update_db)
+	// pending expeditions send the setting with their create request
+	if (update_db && m_id != 0)
 	{
-		ExpeditionDatabase::UpdateReplayLockoutOnJoin(m_id, add_on_join);
 		SendWorldSettingChanged(ServerOP_ExpeditionReplayOnJoin, m_add_replay_on_join);
 	}
 }
@@ -445,48 +515,35 @@ void Expedition::AddReplayLockout(uint32_t seconds)
 
 void Expedition::AddLockout(const std::string& event_name, uint32_t seconds)
 {
+	if (DeferIfPending([=](Expedition* expedition) { expedition->AddLockout(event_name, seconds); }))
+	{
+		return;
+	}
+
 	auto lockout = ExpeditionLockoutTimer::CreateLockout(m_expedition_name, event_name, seconds, m_uuid);
 	AddLockout(lockout);
 }
 
 void Expedition::AddLockout(const ExpeditionLockoutTimer& lockout, bool members_only)
 {
-	if (!members_only)
-	{
-		ExpeditionDatabase::InsertLockout(m_id, lockout);
-	}
-	ExpeditionDatabase::InsertMembersLockout(m_members, lockout);
-
+	// world stores the expedition and member lockouts when it relays the update
 	ProcessLockoutUpdate(lockout, false, members_only);
 	SendWorldLockoutUpdate(lockout, false, members_only);
 }
 
 void Expedition::AddLockoutDuration(const std::string& event_name, int seconds, bool members_only)
 {
+	if (DeferIfPending([=](Expedition* expedition) { expedition->AddLockoutDuration(event_name, seconds, members_only); }))
+	{
+		return;
+	}
+
 	// lockout timers use unsigned durations to define intent but we may need
 	// to insert a new lockout while still supporting timer reductions
 	auto lockout = ExpeditionLockoutTimer::CreateLockout(
 		m_expedition_name, event_name, std::max(0, seconds), m_uuid);
 
-	if (!members_only)
-	{
-		auto it = m_lockouts.find(event_name);
-		if (it != m_lockouts.end())
-		{
-			it->second.AddLockoutTime(seconds);
-			ExpeditionDatabase::InsertLockout(m_id, it->second); // replaces current one
-		}
-		else
-		{
-			ExpeditionDatabase::InsertLockout(m_id, lockout);
-		}
-	}
-
-	// processing lockout duration applies multiplier again in client methods,
-	// update database with modified value now but pass original on
-	int modified_seconds = static_cast<int>(seconds * RuleR(Expedition, LockoutDurationMultiplier));
-	ExpeditionDatabase::AddLockoutDuration(m_members, lockout, modified_seconds);
-
+	// world stores the expedition and member lockouts when it relays the update
 	ProcessLockoutDuration(lockout, seconds, members_only);
 	SendWorldLockoutDuration(lockout, seconds, members_only);
 }
@@ -499,6 +556,11 @@ void Expedition::AddReplayLockoutDuration(int seconds, bool members_only)
 void Expedition::UpdateLockoutDuration(
 	const std::string& event_name, uint32_t seconds, bool members_only)
 {
+	if (DeferIfPending([=](Expedition* expedition) { expedition->UpdateLockoutDuration(event_name, seconds, members_only); }))
+	{
+		return;
+	}
+
 	// some live expeditions update existing lockout timers during progression
 	auto it = m_lockouts.find(event_name);
 	if (it != m_lockouts.end())
@@ -512,8 +574,10 @@ void Expedition::UpdateLockoutDuration(
 
 void Expedition::RemoveLockout(const std::string& event_name)
 {
-	ExpeditionDatabase::DeleteLockout(m_id, event_name);
-	ExpeditionDatabase::DeleteMembersLockout(m_members, m_expedition_name, event_name);
+	if (DeferIfPending([=](Expedition* expedition) { expedition->RemoveLockout(event_name); }))
+	{
+		return;
+	}
 
 	ExpeditionLockoutTimer lockout{m_uuid, m_expedition_name, event_name, 0, 0};
 	ProcessLockoutUpdate(lockout, true);
@@ -536,15 +600,17 @@ void Expedition::AddInternalMember(
 
 bool Expedition::AddMember(const std::string& add_char_name, uint32_t add_char_id)
 {
+	if (DeferIfPending([=](Expedition* expedition) { expedition->AddMember(add_char_name, add_char_id); }))
+	{
+		return true;
+	}
+
 	if (HasMember(add_char_id))
 	{
 		return false;
 	}
 
-	ExpeditionDatabase::InsertMember(m_id, add_char_id);
-	m_dynamiczone.AddCharacter(add_char_id);
-
-	ProcessMemberAdded(add_char_name, add_char_id);
+	// added when world relays the change back, it may reject the add
 	SendWorldMemberChanged(add_char_name, add_char_id, false);
 
 	return true;
@@ -552,9 +618,12 @@ bool Expedition::AddMember(const std::string& add_char_name, uint32_t add_char_i
 
 void Expedition::RemoveAllMembers(bool enable_removal_timers)
 {
-	m_dynamiczone.RemoveAllCharacters(enable_removal_timers);
+	if (DeferIfPending([=](Expedition* expedition) { expedition->RemoveAllMembers(enable_removal_timers); }))
+	{
+		return;
+	}
 
-	ExpeditionDatabase::DeleteAllMembers(m_id);
+	m_dynamiczone.RemoveAllCharacters(enable_removal_timers);
 
 	SendUpdatesToZoneMembers(true);
 	SendWorldExpeditionUpdate(ServerOP_ExpeditionMembersRemoved);
@@ -564,13 +633,17 @@ void Expedition::RemoveAllMembers(bool enable_removal_timers)
 
 bool Expedition::RemoveMember(const std::string& remove_char_name)
 {
+	if (DeferIfPending([=](Expedition* expedition) { expedition->RemoveMember(remove_char_name); }))
+	{
+		return true;
+	}
+
 	auto member = GetMemberData(remove_char_name);
 	if (!member.IsValid())
 	{
 		return false;
 	}
 
-	ExpeditionDatabase::DeleteMember(m_id, member.char_id);
 	m_dynamiczone.RemoveCharacter(member.char_id);
 
 	ProcessMemberRemoved(member.name, member.char_id);
@@ -592,14 +665,7 @@ void Expedition::SwapMember(Client* add_client, const std::string& remove_char_n
 		return;
 	}
 
-	// make remove and add atomic to avoid racing with separate world messages
-	ExpeditionDatabase::DeleteMember(m_id, member.char_id);
-	ExpeditionDatabase::InsertMember(m_id, add_client->CharacterID());
-	m_dynamiczone.RemoveCharacter(member.char_id);
-	m_dynamiczone.AddCharacter(add_client->CharacterID());
-
-	ProcessMemberRemoved(member.name, member.char_id);
-	ProcessMemberAdded(add_client->GetName(), add_client->CharacterID());
+	// world makes the remove and add atomic and relays the swap back once accepted
 	SendWorldMemberSwapped(member.name, member.char_id, add_client->GetName(), add_client->CharacterID());
 }
 
@@ -781,15 +847,15 @@ bool Expedition::ProcessAddConflicts(Client* leader_client, Client* add_client,
 		}
 	}
 
-	// member swapping integrity is handled by invite response
+	// member swapping integrity is handled by invite response. world repeats
+	// the member count check when it receives the add
 	if (!swapping)
 	{
-		auto member_count = ExpeditionDatabase::GetMemberCount(m_id);
-		if (member_count == 0)
+		if (m_members.empty())
 		{
 			has_conflict = true;
 		}
-		else if (member_count >= m_max_players)
+		else if (m_members.size() >= m_max_players)
 		{
 			SendLeaderMessage(leader_client, Chat::Red, DZADD_EXCEED_MAX, { fmt::format_int(m_max_players).str() });
 			has_conflict = true;
@@ -842,48 +908,61 @@ void Expedition::DzInviteResponse(Client* add_client, bool accepted, const std::
 	}
 
 	// error if swapping and character was already removed before the accept
-	if (was_swap_invite)
+	if (was_swap_invite && !GetMemberData(swap_remove_name).IsValid())
 	{
-		auto swap_member = GetMemberData(swap_remove_name);
-		if (!swap_member.IsValid() || !ExpeditionDatabase::HasMember(m_id, swap_member.char_id))
-		{
-			has_conflicts = true;
-		}
+		has_conflicts = true;
 	}
 
 	if (has_conflicts)
 	{
 		SendLeaderMessage(leader_client, Chat::Red, EXPEDITION_INVITE_ERROR, { add_client->GetName() });
 	}
+	else if (was_swap_invite)
+	{
+		// world checks these again against its own state and adds any replay
+		// timer on join. the accepted message is sent when it relays the change
+		SwapMember(add_client, swap_remove_name);
+	}
 	else
 	{
-		SendLeaderMessage(leader_client, Chat::Yellow, EXPEDITION_INVITE_ACCEPTED, { add_client->GetName() });
+		SendWorldMemberChanged(add_client->GetName(), add_client->CharacterID(), false, true);
+	}
+}
 
-		// replay timers are optionally added to new members on join with fresh expire time
-		if (m_add_replay_on_join)
-		{
-			auto replay_lockout = m_lockouts.find(DZ_REPLAY_TIMER_NAME);
-			if (replay_lockout != m_lockouts.end() &&
-			    replay_lockout->second.IsFromExpedition(m_uuid) &&
-			    !add_client->HasExpeditionLockout(m_expedition_name, DZ_REPLAY_TIMER_NAME))
-			{
-				ExpeditionLockoutTimer replay_timer = replay_lockout->second; // copy
-				replay_timer.Reset();
-				add_client->AddExpeditionLockout(replay_timer, true);
-			}
-		}
+void Expedition::ProcessMemberAccepted(const std::string& add_char_name, uint32_t add_char_id, bool from_invite)
+{
+	// the zone that sent an accepted add starts the member's dz instance access
+	m_dynamiczone.AddCharacter(add_char_id);
 
-		if (was_swap_invite)
-		{
-			SwapMember(add_client, swap_remove_name);
-		}
-		else
-		{
-			AddMember(add_client->GetName(), add_client->CharacterID());
-		}
+	if (from_invite)
+	{
+		Client* leader_client = entity_list.GetClientByCharID(m_leader.char_id);
+		SendLeaderMessage(leader_client, Chat::Yellow, EXPEDITION_INVITE_ACCEPTED, { add_char_name });
 	}
 }
 
+void Expedition::ProcessAddRejected(const std::string& add_char_name, uint8_t reason)
+{
+	Client* leader_client = entity_list.GetClientByCharID(m_leader.char_id);
+
+	switch (reason)
+	{
+	case 0:
+		SendLeaderMessage(leader_client, Chat::Red, DZADD_NOT_ALLOWING);
+		break;
+	case 1:
+		SendLeaderMessage(leader_client, Chat::Red, DZADD_EXCEED_MAX, { fmt::format_int(m_max_players).str() });
+		break;
+	case 2:
+		SendLeaderMessage(leader_client, Chat::Red, DZADD_ALREADY_ASSIGNED, { add_char_name });
+		break;
+	default: // swap member was removed before the accept
+		break;
+	}
+
+	SendLeaderMessage(leader_client, Chat::Red, EXPEDITION_INVITE_ERROR, { add_char_name });
+}
+
 bool Expedition::ConfirmLeaderCommand(Client* requester)
 {
 	if (!requester)
@@ -1104,6 +1183,11 @@ void Expedition::DzKickPlayers(Client* requester)
 void Expedition::SetLocked(
 	bool lock_expedition, ExpeditionLockMessage lock_msg, bool update_db, uint32_t msg_color)
 {
+	if (DeferSettingIfSent(update_db, [=](Expedition* expedition) { expedition->SetLocked(lock_expedition, lock_msg, true, msg_color); }))
+	{
+		return;
+	}
+
 	m_is_locked = lock_expedition;
 
 	if (m_is_locked && lock_msg != ExpeditionLockMessage::None && m_dynamiczone.IsCurrentZoneDzInstance())
@@ -1118,9 +1202,9 @@ void Expedition::SetLocked(
 		}
 	}
 
-	if (update_db)
+	// pending expeditions send the lock state with their create request
+	if (update_db && m_id != 0)
 	{
-		ExpeditionDatabase::UpdateLockState(m_id, lock_expedition);
 		SendWorldSettingChanged(ServerOP_ExpeditionLockState, m_is_locked);
 	}
 }
@@ -1280,23 +1364,15 @@ void Expedition::ProcessLockoutDuration(
 void Expedition::AddLockoutDurationClients(
 	const ExpeditionLockoutTimer& lockout, int seconds, uint32_t exclude_id)
 {
-	std::vector<ExpeditionMember> lockout_clients;
 	for (const auto& client_iter : entity_list.GetClientList())
 	{
 		Client* client = client_iter.second;
 		if (client && (exclude_id == 0 || client->GetExpeditionID() != exclude_id))
 		{
-			lockout_clients.emplace_back(client->CharacterID(), client->GetName());
 			client->AddExpeditionLockoutDuration(m_expedition_name,
-				lockout.GetEventName(), seconds, m_uuid);
+				lockout.GetEventName(), seconds, m_uuid, true);
 		}
 	}
-
-	if (!lockout_clients.empty())
-	{
-		int modified_seconds = static_cast<int>(seconds * RuleR(Expedition, LockoutDurationMultiplier));
-		ExpeditionDatabase::AddLockoutDuration(lockout_clients, lockout, modified_seconds);
-	}
 }
 
 void Expedition::ProcessLockoutUpdate(
@@ -1342,21 +1418,14 @@ void Expedition::ProcessLockoutUpdate(
 void Expedition::AddLockoutClients(
 	const ExpeditionLockoutTimer& lockout, uint32_t exclude_expedition_id)
 {
-	std::vector<ExpeditionMember> lockout_clients;
 	for (const auto& client_iter : entity_list.GetClientList())
 	{
 		Client* client = client_iter.second;
 		if (client && (exclude_expedition_id == 0 || client->GetExpeditionID() != exclude_expedition_id))
 		{
-			lockout_clients.emplace_back(client->CharacterID(), client->GetName());
-			client->AddExpeditionLockout(lockout);
+			client->AddExpeditionLockout(lockout, true);
 		}
 	}
-
-	if (!lockout_clients.empty())
-	{
-		ExpeditionDatabase::InsertMembersLockout(lockout_clients, lockout);
-	}
 }
 
 void Expedition::SendNewMemberAddedToZoneMembers(const std::string& added_name)
@@ -1594,7 +1663,8 @@ void Expedition::SendWorldMakeLeaderRequest(uint32_t requester_id, const std::st
 	worldserver.SendPacket(pack.get());
 }
 
-void Expedition::SendWorldMemberChanged(const std::string& char_name, uint32_t char_id, bool remove)
+void Expedition::SendWorldMemberChanged(
+	const std::string& char_name, uint32_t char_id, bool remove, bool from_invite)
 {
 	// notify other zones of added or removed member
 	uint32_t pack_size = sizeof(ServerExpeditionMemberChange_Struct);
@@ -1604,6 +1674,7 @@ void Expedition::SendWorldMemberChanged(const std::string& char_name, uint32_t c
 	buf->sender_zone_id = zone ? zone->GetZoneID() : 0;
 	buf->sender_instance_id = zone ? zone->GetInstanceID() : 0;
 	buf->removed = remove;
+	buf->from_invite = from_invite;
 	buf->char_id = char_id;
 	strn0cpy(buf->char_name, char_name.c_str(), sizeof(buf->char_name));
 	worldserver.SendPacket(pack.get());
@@ -1668,36 +1739,14 @@ void Expedition::SendWorldSettingChanged(uint16_t server_opcode, bool setting_va
 	worldserver.SendPacket(pack.get());
 }
 
-void Expedition::SendWorldGetOnlineMembers(
-	const std::vector<std::pair<uint32_t, uint32_t>>& expedition_character_ids)
-{
-	// request online status of characters
-	uint32_t count = static_cast<uint32_t>(expedition_character_ids.size());
-	uint32_t entries_size = sizeof(ServerExpeditionCharacterEntry_Struct) * count;
-	uint32_t pack_size = sizeof(ServerExpeditionCharacters_Struct) + entries_size;
-	auto pack = std::unique_ptr<ServerPacket>(new ServerPacket(ServerOP_ExpeditionGetOnlineMembers, pack_size));
-	auto buf = reinterpret_cast<ServerExpeditionCharacters_Struct*>(pack->pBuffer);
-	buf->sender_zone_id = zone ? zone->GetZoneID() : 0;
-	buf->sender_instance_id = zone ? zone->GetInstanceID() : 0;
-	buf->count = count;
-	for (uint32_t i = 0; i < buf->count; ++i)
-	{
-		buf->entries[i].expedition_id = expedition_character_ids[i].first;
-		buf->entries[i].character_id = expedition_character_ids[i].second;
-		buf->entries[i].character_zone_id = 0;
-		buf->entries[i].character_instance_id = 0;
-		buf->entries[i].character_online = false;
-	}
-	worldserver.SendPacket(pack.get());
-}
-
 void Expedition::SendWorldCharacterLockout(
-	uint32_t character_id, const ExpeditionLockoutTimer& lockout, bool remove)
+	uint32_t character_id, const ExpeditionLockoutTimer& lockout, bool remove, bool update_client)
 {
 	uint32_t pack_size = sizeof(ServerExpeditionCharacterLockout_Struct);
 	auto pack = std::unique_ptr<ServerPacket>(new ServerPacket(ServerOP_ExpeditionCharacterLockout, pack_size));
 	auto buf = reinterpret_cast<ServerExpeditionCharacterLockout_Struct*>(pack->pBuffer);
 	buf->remove = remove;
+	buf->update_client = update_client;
 	buf->character_id = character_id;
 	buf->expire_time = lockout.GetExpireTime();
 	buf->duration = lockout.GetDuration();
@@ -1723,9 +1772,9 @@ void Expedition::AddLockoutByCharacterID(
 {
 	if (character_id)
 	{
+		// world stores it and forwards it to the character's zone
 		auto lockout = ExpeditionLockoutTimer::CreateLockout(expedition_name, event_name, seconds, uuid);
-		ExpeditionDatabase::InsertCharacterLockouts(character_id, { lockout });
-		SendWorldCharacterLockout(character_id, lockout, false);
+		SendWorldCharacterLockout(character_id, lockout, false, true);
 	}
 }
 
@@ -1765,21 +1814,9 @@ void Expedition::RemoveLockoutsByCharacterID(
 {
 	if (character_id)
 	{
-		if (!event_name.empty())
-		{
-			ExpeditionDatabase::DeleteCharacterLockout(character_id, expedition_name, event_name);
-		}
-		else if (!expedition_name.empty())
-		{
-			ExpeditionDatabase::DeleteAllCharacterLockouts(character_id, expedition_name);
-		}
-		else
-		{
-			ExpeditionDatabase::DeleteAllCharacterLockouts(character_id);
-		}
-
+		// an empty event removes all of the expedition's lockouts, an empty expedition removes all
 		ExpeditionLockoutTimer lockout{{}, expedition_name, event_name, 0, 0};
-		SendWorldCharacterLockout(character_id, lockout, true);
+		SendWorldCharacterLockout(character_id, lockout, true, true);
 	}
 }
 
@@ -1799,10 +1836,47 @@ void Expedition::HandleWorldMessage(ServerPacket* pack)
 	{
 	case ServerOP_ExpeditionCreate:
 	{
-		auto buf = reinterpret_cast<ServerExpeditionID_Struct*>(pack->pBuffer);
-		if (zone && !zone->IsZone(buf->sender_zone_id, buf->sender_instance_id))
+		Expedition::CacheFromWorldPacket(pack);
+		break;
+	}
+	case ServerOP_ExpeditionCreateRejected:
+	{
+		Expedition::ProcessCreateRejected(pack);
+		break;
+	}
+	case ServerOP_ExpeditionAddRejected:
+	{
+		auto buf = reinterpret_cast<ServerExpeditionAddRejected_Struct*>(pack->pBuffer);
+		auto expedition = Expedition::FindCachedExpeditionByID(buf->expedition_id);
+		if (expedition)
 		{
-			Expedition::CacheFromDatabase(buf->expedition_id);
+			expedition->ProcessAddRejected(buf->char_name, buf->reason);
+		}
+		break;
+	}
+	case ServerOP_ExpeditionCharacterInfo:
+	{
+		// sent by world with the zone-in, or in reply to a later request from the client
+		auto buf = reinterpret_cast<ServerExpeditionCharacterInfo_Struct*>(pack->pBuffer);
+		if (zone && pack->size >= sizeof(ServerExpeditionCharacterInfo_Struct) +
+		    buf->lockout_count * sizeof(ServerExpeditionCharacterLockoutEntry_Struct))
+		{
+			std::vector<ExpeditionLockoutTimer> lockouts;
+			for (uint32_t i = 0; i < buf->lockout_count; ++i)
+			{
+				const auto& entry = buf->entries[i];
+				lockouts.emplace_back(entry.uuid, entry.expedition_name, entry.event_name, entry.expire_time, entry.duration);
+			}
+
+			Client* client = entity_list.GetClientByCharID(buf->character_id);
+			if (client)
+			{
+				client->UpdateExpeditionInfoAndLockouts(buf->expedition_id, std::move(lockouts));
+			}
+			else
+			{
+				zone->incoming_expedition_info[buf->character_id] = { buf->expedition_id, std::move(lockouts) };
+			}
 		}
 		break;
 	}
@@ -1870,20 +1944,24 @@ void Expedition::HandleWorldMessage(ServerPacket* pack)
 	}
 	case ServerOP_ExpeditionMemberChange:
 	{
+		// removals are processed by the sender before it notifies world but adds
+		// are only processed once world accepts them, including by the sender
 		auto buf = reinterpret_cast<ServerExpeditionMemberChange_Struct*>(pack->pBuffer);
-		if (zone && !zone->IsZone(buf->sender_zone_id, buf->sender_instance_id))
+		bool is_sender = zone && zone->IsZone(buf->sender_zone_id, buf->sender_instance_id);
+		auto expedition = Expedition::FindCachedExpeditionByID(buf->expedition_id);
+		if (zone && expedition && (!buf->removed || !is_sender))
 		{
-			auto expedition = Expedition::FindCachedExpeditionByID(buf->expedition_id);
-			if (expedition)
+			if (buf->removed)
 			{
-				if (buf->removed)
-				{
-					expedition->ProcessMemberRemoved(buf->char_name, buf->char_id);
-				}
-				else
+				expedition->ProcessMemberRemoved(buf->char_name, buf->char_id);
+			}
+			else
+			{
+				if (is_sender)
 				{
-					expedition->ProcessMemberAdded(buf->char_name, buf->char_id);
+					expedition->ProcessMemberAccepted(buf->char_name, buf->char_id, buf->from_invite);
 				}
+				expedition->ProcessMemberAdded(buf->char_name, buf->char_id);
 			}
 		}
 		break;
@@ -1891,14 +1969,16 @@ void Expedition::HandleWorldMessage(ServerPacket* pack)
 	case ServerOP_ExpeditionMemberSwap:
 	{
 		auto buf = reinterpret_cast<ServerExpeditionMemberSwap_Struct*>(pack->pBuffer);
-		if (zone && !zone->IsZone(buf->sender_zone_id, buf->sender_instance_id))
+		auto expedition = Expedition::FindCachedExpeditionByID(buf->expedition_id);
+		if (zone && expedition)
 		{
-			auto expedition = Expedition::FindCachedExpeditionByID(buf->expedition_id);
-			if (expedition)
+			if (zone->IsZone(buf->sender_zone_id, buf->sender_instance_id))
 			{
-				expedition->ProcessMemberRemoved(buf->remove_char_name, buf->remove_char_id);
-				expedition->ProcessMemberAdded(buf->add_char_name, buf->add_char_id);
+				expedition->m_dynamiczone.RemoveCharacter(buf->remove_char_id);
+				expedition->ProcessMemberAccepted(buf->add_char_name, buf->add_char_id, true);
 			}
+			expedition->ProcessMemberRemoved(buf->remove_char_name, buf->remove_char_id);
+			expedition->ProcessMemberAdded(buf->add_char_name, buf->add_char_id);
 		}
 		break;
 	}
@@ -1941,27 +2021,6 @@ void Expedition::HandleWorldMessage(ServerPacket* pack)
 		}
 		break;
 	}
-	case ServerOP_ExpeditionGetOnlineMembers:
-	{
-		// reply from world for online member statuses request (for multiple expeditions)
-		auto buf = reinterpret_cast<ServerExpeditionCharacters_Struct*>(pack->pBuffer);
-		for (uint32_t i = 0; i < buf->count; ++i)
-		{
-			auto member = reinterpret_cast<ServerExpeditionCharacterEntry_Struct*>(&buf->entries[i]);
-			auto expedition = Expedition::FindCachedExpeditionByID(member->expedition_id);
-			if (expedition)
-			{
-				auto is_online = member->character_online;
-				auto status = is_online ? ExpeditionMemberStatus::Online : ExpeditionMemberStatus::Offline;
-				if (is_online && expedition->GetDynamicZone().IsInstanceID(member->character_instance_id))
-				{
-					status = ExpeditionMemberStatus::InDynamicZone;
-				}
-				expedition->UpdateMemberStatus(member->character_id, status);
-			}
-		}
-		break;
-	}
 	case ServerOP_ExpeditionDzAddPlayer:
 	{
 		auto buf = reinterpret_cast<ServerDzCommand_Struct*>(pack->pBuffer);
@@ -2072,8 +2131,13 @@ void Expedition::HandleWorldMessage(ServerPacket* pack)
 
 void Expedition::SetDzCompass(uint32_t zone_id, float x, float y, float z, bool update_db)
 {
+	if (DeferSettingIfSent(update_db, [=](Expedition* expedition) { expedition->SetDzCompass(zone_id, x, y, z, true); }))
+	{
+		return;
+	}
+
 	DynamicZoneLocation location{ zone_id, x, y, z, 0.0f };
-	m_dynamiczone.SetCompass(location, update_db);
+	m_dynamiczone.SetCompass(location);
 
 	for (const auto& member : m_members)
 	{
@@ -2084,7 +2148,8 @@ void Expedition::SetDzCompass(uint32_t zone_id, float x, float y, float z, bool
 		}
 	}
 
-	if (update_db)
+	// pending expeditions send their dz locations with the create request
+	if (update_db && m_id != 0)
 	{
 		SendWorldDzLocationUpdate(ServerOP_ExpeditionDzCompass, location);
 	}
@@ -2098,11 +2163,17 @@ void Expedition::SetDzCompass(const std::string& zone_name, float x, float y, fl
 
 void Expedition::SetDzSafeReturn(uint32_t zone_id, float x, float y, float z, float heading, bool update_db)
 {
+	if (DeferSettingIfSent(update_db, [=](Expedition* expedition) { expedition->SetDzSafeReturn(zone_id, x, y, z, heading, true); }))
+	{
+		return;
+	}
+
 	DynamicZoneLocation location{ zone_id, x, y, z, heading };
 
-	m_dynamiczone.SetSafeReturn(location, update_db);
+	m_dynamiczone.SetSafeReturn(location);
 
-	if (update_db)
+	// pending expeditions send their dz locations with the create request
+	if (update_db && m_id != 0)
 	{
 		SendWorldDzLocationUpdate(ServerOP_ExpeditionDzSafeReturn, location);
 	}
@@ -2116,16 +2187,27 @@ void Expedition::SetDzSafeReturn(const std::string& zone_name, float x, float y,
 
 void Expedition::SetDzSecondsRemaining(uint32_t seconds_remaining)
 {
+	if (DeferIfPending([=](Expedition* expedition) { expedition->SetDzSecondsRemaining(seconds_remaining); }))
+	{
+		return;
+	}
+
 	SendWorldSetSecondsRemaining(seconds_remaining); // async
 }
 
 void Expedition::SetDzZoneInLocation(float x, float y, float z, float heading, bool update_db)
 {
+	if (DeferSettingIfSent(update_db, [=](Expedition* expedition) { expedition->SetDzZoneInLocation(x, y, z, heading, true); }))
+	{
+		return;
+	}
+
 	DynamicZoneLocation location{ 0, x, y, z, heading };
 
-	m_dynamiczone.SetZoneInLocation(location, update_db);
+	m_dynamiczone.SetZoneInLocation(location);
 
-	if (update_db)
+	// pending expeditions send their dz locations with the create request
+	if (update_db && m_id != 0)
 	{
 		SendWorldDzLocationUpdate(ServerOP_ExpeditionDzZoneIn, location);
 	}
@@ -2254,7 +2336,7 @@ void Expedition::SyncCharacterLockouts(
 	// client timers that are both shorter and from another expedition
 	BenchTimer benchmark;
 
-	bool modified = false;
+	std::vector<ExpeditionLockoutTimer> modified_lockouts;
 
 	for (const auto& lockout_iter : m_lockouts)
 	{
@@ -2271,22 +2353,23 @@ void Expedition::SyncCharacterLockouts(
 
 		if (client_lockout_iter == client_lockouts.end())
 		{
-			modified = true;
 			client_lockouts.emplace_back(lockout); // insert missing
+			modified_lockouts.emplace_back(lockout);
 		}
 		else if (client_lockout_iter->GetSecondsRemaining() < lockout.GetSecondsRemaining() &&
 		         client_lockout_iter->GetExpeditionUUID() != m_uuid)
 		{
 			// only update lockout timer not uuid so loot event apis still work
-			modified = true;
 			client_lockout_iter->SetDuration(lockout.GetDuration());
 			client_lockout_iter->SetExpireTime(lockout.GetExpireTime());
+			modified_lockouts.emplace_back(*client_lockout_iter);
 		}
 	}
 
-	if (modified)
+	// world stores the character lockouts
+	for (const auto& lockout : modified_lockouts)
 	{
-		ExpeditionDatabase::InsertCharacterLockouts(character_id, client_lockouts);
+		SendWorldCharacterLockout(character_id, lockout, false);
 	}
 
 	LogExpeditionsDetail("Syncing character lockouts with expedition took [{}] s", benchmark.elapsed());
@@ -22,9 +22,10 @@
 #define EXPEDITION_H
 
 #include "dynamiczone.h"
-#include "expedition_lockout_timer.h"
 #include "../common/eq_constants.h"
+#include "../common/expedition_lockout_timer.h"
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -34,7 +35,6 @@ class Client;
 class EQApplicationPacket;
 struct ExpeditionInvite;
 class ExpeditionRequest;
-class MySQLRequestResult;
 class ServerPacket;
 
 extern const char* const DZ_YOU_NOT_ASSIGNED;
@@ -78,11 +78,14 @@ public:
 	Expedition() = delete;
 	Expedition(uint32_t id, const std::string& uuid, const DynamicZone& dz, const std::string& expedition_name,
 		const ExpeditionMember& leader, uint32_t min_players, uint32_t max_players);
+	~Expedition();
 
 	static Expedition* TryCreate(Client* requester, DynamicZone& dynamiczone, ExpeditionRequest& request);
 
-	static void CacheFromDatabase(uint32_t expedition_id);
-	static bool CacheAllFromDatabase();
+	static void SendPendingCreateRequests();
+	static void SendWorldCacheRequest();
+	static void SendWorldCharacterLockout(uint32_t character_id, const ExpeditionLockoutTimer& lockout,
+		bool remove, bool update_client = false);
 	static Expedition* FindCachedExpeditionByCharacterID(uint32_t character_id);
 	static Expedition* FindCachedExpeditionByCharacterName(const std::string& char_name);
 	static Expedition* FindCachedExpeditionByDynamicZoneID(uint32_t dz_id);
@@ -111,6 +114,7 @@ public:
 	uint32_t GetMinPlayers() const { return m_min_players; }
 	uint32_t GetMaxPlayers() const { return m_max_players; }
 	uint32_t GetMemberCount() const { return static_cast<uint32_t>(m_members.size()); }
+	bool IsPending() const { return m_id == 0 && !m_is_rejected; }
 	const DynamicZone& GetDynamicZone() const { return m_dynamiczone; }
 	const std::string& GetName() const { return m_expedition_name; }
 	const std::string& GetLeaderName() const { return m_leader.name; }
@@ -170,24 +174,25 @@ public:
 	static const int32_t EVENT_TIMER_ID;
 
 private:
-	static void CacheExpeditions(MySQLRequestResult& results);
-	static void SendWorldGetOnlineMembers(const std::vector<std::pair<uint32_t, uint32_t>>& expedition_character_ids);
-	static void SendWorldCharacterLockout(uint32_t character_id, const ExpeditionLockoutTimer& lockout, bool remove);
+	static void CacheFromWorldPacket(ServerPacket* pack);
+	static void ProcessCreateRejected(ServerPacket* pack);
 
 	void AddLockout(const ExpeditionLockoutTimer& lockout, bool members_only = false);
 	void AddLockoutDurationClients(const ExpeditionLockoutTimer& lockout, int seconds, uint32_t exclude_id = 0);
 	void AddInternalMember(const std::string& char_name, uint32_t char_id, ExpeditionMemberStatus status);
 	bool ConfirmLeaderCommand(Client* requester);
+	bool DeferIfPending(std::function<void(Expedition*)> call);
+	bool DeferSettingIfSent(bool update_db, std::function<void(Expedition*)> call);
 	bool ProcessAddConflicts(Client* leader_client, Client* add_client, bool swapping);
+	void ProcessAddRejected(const std::string& add_char_name, uint8_t reason);
 	void ProcessLeaderChanged(uint32_t new_leader_id);
 	void ProcessLockoutDuration(const ExpeditionLockoutTimer& lockout, int seconds, bool members_only = false);
 	void ProcessLockoutUpdate(const ExpeditionLockoutTimer& lockout, bool remove, bool members_only = false);
 	void ProcessMakeLeader(Client* old_leader, Client* new_leader,
 		const std::string& new_leader_name, bool is_success, bool is_online);
+	void ProcessMemberAccepted(const std::string& add_char_name, uint32_t add_char_id, bool from_invite);
 	void ProcessMemberAdded(const std::string& added_char_name, uint32_t added_char_id);
 	void ProcessMemberRemoved(const std::string& removed_char_name, uint32_t removed_char_id);
-	void SaveLockouts(ExpeditionRequest& request);
-	void SaveMembers(ExpeditionRequest& request);
 	void SendClientExpeditionInvite(
 		Client* client, const std::string& inviter_name, const std::string& swap_remove_name);
 	void SendLeaderMessage(Client* leader_client, uint16_t chat_type, uint32_t string_id,
@@ -196,6 +201,7 @@ private:
 	void SendNewMemberAddedToZoneMembers(const std::string& added_name);
 	void SendUpdatesToZoneMembers(bool clear = false, bool message_on_clear = true);
 	void SendWorldDzLocationUpdate(uint16_t server_opcode, const DynamicZoneLocation& location);
+	void SendWorldCreateRequest();
 	void SendWorldExpeditionUpdate(uint16_t server_opcode);
 	void SendWorldAddPlayerInvite(const std::string& inviter_name, const std::string& swap_remove_name,
 		const std::string& add_name, bool pending = false);
@@ -203,7 +209,7 @@ private:
 		const ExpeditionLockoutTimer& lockout, int seconds, bool members_only = false);
 	void SendWorldLockoutUpdate(
 		const ExpeditionLockoutTimer& lockout, bool remove, bool members_only = false);
-	void SendWorldMemberChanged(const std::string& char_name, uint32_t char_id, bool remove);
+	void SendWorldMemberChanged(const std::string& char_name, uint32_t char_id, bool remove, bool from_invite = false);
 	void SendWorldMemberStatus(uint32_t character_id, ExpeditionMemberStatus status);
 	void SendWorldMemberSwapped(const std::string& remove_char_name, uint32_t remove_char_id,
 		const std::string& add_char_name, uint32_t add_char_id);
@@ -229,6 +235,8 @@ private:
 	uint32_t    m_max_players        = 0;
 	bool        m_is_locked          = false;
 	bool        m_add_replay_on_join = true;
+	bool        m_is_create_sent     = false; // pending expeditions (id 0) only
+	bool        m_is_rejected        = false; // create request denied, never gets an id
 	std::string m_uuid;
 	std::string m_expedition_name;
 	DynamicZone m_dynamiczone { DynamicZoneType::Expedition };
@@ -237,6 +245,8 @@ private:
 	std::unordered_map<std::string, ExpeditionLockoutTimer> m_lockouts;
 	std::unordered_map<uint32_t, std::string> m_npc_loot_events;   // only valid inside dz zone
 	std::unordered_map<uint32_t, std::string> m_spawn_loot_events; // only valid inside dz zone
+	std::unique_ptr<ExpeditionRequest> m_create_request;            // pending expeditions only
+	std::vector<std::function<void(Expedition*)>> m_deferred_calls; // replayed once world creates it
 };
 
 #endif
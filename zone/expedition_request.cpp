@@ -21,23 +21,14 @@
 #include "expedition_request.h"
 #include "client.h"
 #include "expedition.h"
-#include "expedition_database.h"
-#include "expedition_lockout_timer.h"
 #include "groups.h"
 #include "raids.h"
 #include "string_ids.h"
-#include "worldserver.h"
-
-extern WorldServer worldserver;
+#include "../common/expedition_lockout_timer.h"
+#include "../common/servertalk.h"
 
 constexpr char SystemName[] = "expedition";
 
-struct ExpeditionRequestConflict
-{
-	std::string character_name;
-	ExpeditionLockoutTimer lockout;
-};
-
 ExpeditionRequest::ExpeditionRequest(
 	std::string expedition_name, uint32_t min_players, uint32_t max_players, bool disable_messages
 ) :
@@ -50,47 +41,45 @@ ExpeditionRequest::ExpeditionRequest(
 
 bool ExpeditionRequest::Validate(Client* requester)
 {
-	m_requester = requester;
-	if (!m_requester)
+	if (!requester)
 	{
 		return false;
 	}
 
-	// a message is sent to leader for every member that fails a requirement
+	// only gathers the members here, world checks them for conflicts against
+	// its own expedition and lockout state when it receives the create request
 
-	BenchTimer benchmark;
+	m_requester_id = requester->CharacterID();
+	m_requester_name = requester->GetName();
 
-	bool requirements_met = false;
+	auto bypass_status = RuleI(Expedition, MinStatusToBypassPlayerCountRequirements);
+	m_gm_bypass = (requester->GetGM() && requester->Admin() >= bypass_status);
 
-	Raid* raid = m_requester->GetRaid();
-	Group* group = m_requester->GetGroup();
+	Raid* raid = requester->GetRaid();
+	Group* group = requester->GetGroup();
 	if (raid)
 	{
-		requirements_met = CanRaidRequest(raid);
+		AddRaidMembers(raid);
 	}
 	else if (group)
 	{
-		requirements_met = CanGroupRequest(group);
+		AddGroupMembers(group);
 	}
 	else // solo request
 	{
-		m_leader = m_requester;
-		m_leader_id = m_requester->CharacterID();
-		m_leader_name = m_requester->GetName();
-		requirements_met = CanMembersJoin({m_leader_name});
+		m_leader_id = m_requester_id;
+		m_leader_name = m_requester_name;
+		m_members.emplace_back(m_leader_id, m_leader_name);
 	}
 
-	auto elapsed = benchmark.elapsed();
-	LogExpeditions("Create validation for [{}] members took [{}s]", m_members.size(), elapsed);
-
-	return requirements_met;
+	return !m_members.empty();
 }
 
-bool ExpeditionRequest::CanRaidRequest(Raid* raid)
+void ExpeditionRequest::AddRaidMembers(Raid* raid)
 {
-	m_leader = raid->GetLeader();
+	Client* leader = raid->GetLeader();
 	m_leader_name = raid->leadername;
-	m_leader_id = m_leader ? m_leader->CharacterID() : database.GetCharacterID(raid->leadername);
+	m_leader_id = leader ? leader->CharacterID() : 0;
 
 	// live (as of September 16, 2020) supports creation even if raid count exceeds
 	// expedition max. members are added up to the max ordered by group number.
@@ -113,46 +102,47 @@ bool ExpeditionRequest::CanRaidRequest(Raid* raid)
 			SystemName, m_max_players, "raid", raid_members.size());
 	}
 
-	// live still performs conflict checks for all members even those beyond max
-	std::vector<std::string> member_names;
-	for (int i = 0; i < raid_members.size(); ++i)
+	// live still performs conflict checks for all members even those beyond max.
+	// world looks up the ids of members not in this zone
+	for (const auto& raid_member : raid_members)
 	{
-		member_names.emplace_back(raid_members[i].membername);
+		if (raid_member.membername[0])
+		{
+			uint32_t character_id = raid_member.member ? raid_member.member->CharacterID() : 0;
+			m_members.emplace_back(character_id, raid_member.membername);
+		}
 	}
-
-	return CanMembersJoin(member_names);
 }
 
-bool ExpeditionRequest::CanGroupRequest(Group* group)
+void ExpeditionRequest::AddGroupMembers(Group* group)
 {
-	m_leader = nullptr;
+	Client* leader = nullptr;
 	if (group->GetLeader() && group->GetLeader()->IsClient())
 	{
-		m_leader = group->GetLeader()->CastToClient();
+		leader = group->GetLeader()->CastToClient();
 	}
 
 	// Group::GetLeaderName() is broken if group formed across zones, ask database instead
-	m_leader_name = m_leader ? m_leader->GetName() : GetGroupLeaderName(group->GetID()); // group->GetLeaderName();
-	m_leader_id = m_leader ? m_leader->CharacterID() : database.GetCharacterID(m_leader_name.c_str());
+	m_leader_name = leader ? leader->GetName() : GetGroupLeaderName(group->GetID()); // group->GetLeaderName();
+	m_leader_id = leader ? leader->CharacterID() : 0;
 
-	std::vector<std::string> member_names;
-	member_names.emplace_back(m_leader_name); // leader always added first
+	m_members.emplace_back(m_leader_id, m_leader_name); // leader always added first
 
 	for (int i = 0; i < MAX_GROUP_MEMBERS; ++i)
 	{
 		if (group->membername[i][0] && m_leader_name != group->membername[i])
 		{
-			member_names.emplace_back(group->membername[i]);
+			Mob* member = group->members[i];
+			uint32_t character_id = (member && member->IsClient()) ? member->CastToClient()->CharacterID() : 0;
+			m_members.emplace_back(character_id, group->membername[i]);
 		}
 	}
 
-	if (member_names.size() > m_max_players)
+	if (m_members.size() > m_max_players)
 	{
 		m_not_all_added_msg = fmt::format(CREATE_NOT_ALL_ADDED, "group", SystemName,
-			SystemName, m_max_players, "group", member_names.size());
+			SystemName, m_max_players, "group", m_members.size());
 	}
-
-	return CanMembersJoin(member_names);
 }
 
 std::string ExpeditionRequest::GetGroupLeaderName(uint32_t group_id)
@@ -162,236 +152,79 @@ std::string ExpeditionRequest::GetGroupLeaderName(uint32_t group_id)
 	return std::string(leader_name_buffer);
 }
 
-bool ExpeditionRequest::CanMembersJoin(const std::vector<std::string>& member_names)
+void ExpeditionRequest::SendRejectedMessages(const ServerExpeditionCreateRejected_Struct* buf)
 {
-	if (member_names.empty())
-	{
-		return false;
-	}
+	// a message is sent to leader for every member that failed a requirement,
+	// in the order world found them
+	Client* requester = entity_list.GetClientByName(buf->requester_name);
+	Client* leader = entity_list.GetClientByName(buf->leader_name);
 
-	bool requirements_met = true;
-
-	if (CheckMembersForConflicts(member_names))
+	for (uint32_t i = 0; i < buf->conflict_count; ++i)
 	{
-		requirements_met = false;
-	}
+		const auto& conflict = buf->conflicts[i];
 
-	// live only checks player count requirement after other expensive checks pass (?)
-	// maybe it's done intentionally as a way to preview lockout conflicts
-	if (requirements_met)
-	{
-		requirements_met = IsPlayerCountValidated();
-	}
+		ExpeditionLockoutTimer lockout{ {}, {}, conflict.event_name, conflict.expire_time, conflict.duration };
+		auto time_remaining = lockout.GetDaysHoursMinutesRemaining();
 
-	return requirements_met;
-}
-
-bool ExpeditionRequest::LoadLeaderLockouts()
-{
-	// leader's lockouts are used to check member conflicts and later stored in expedition
-	auto lockouts = ExpeditionDatabase::LoadCharacterLockouts(m_leader_id, m_expedition_name);
-
-	for (auto& lockout : lockouts)
-	{
-		if (!lockout.IsExpired())
+		if (conflict.type == 4)
 		{
-			m_lockouts.emplace(lockout.GetEventName(), lockout);
-
-			// on live if leader has a replay lockout it never bothers checking for event conflicts
-			if (m_check_event_lockouts && lockout.IsReplayTimer())
+			if (requester)
 			{
-				m_check_event_lockouts = false;
+				requester->MessageString(Chat::Red, DZ_PREVENT_ENTERING);
 			}
+			continue;
 		}
-	}
-
-	return true;
-}
-
-bool ExpeditionRequest::CheckMembersForConflicts(const std::vector<std::string>& member_names)
-{
-	// load data for each member and compare with leader lockouts
-	auto results = ExpeditionDatabase::LoadMembersForCreateRequest(member_names, m_expedition_name);
-	if (!results.Success() || !LoadLeaderLockouts())
-	{
-		LogExpeditions("Failed to load data to verify members for expedition request");
-		return true;
-	}
-
-	bool is_solo = (member_names.size() == 1);
-	bool has_conflicts = false;
-
-	using col = LoadMembersForCreateRequestColumns::eLoadMembersForCreateRequestColumns;
-
-	std::vector<ExpeditionRequestConflict> member_lockout_conflicts;
-
-	uint32_t last_character_id = 0;
-	for (auto row = results.begin(); row != results.end(); ++row)
-	{
-		uint32_t character_id      = std::strtoul(row[col::character_id], nullptr, 10);
-		std::string character_name = row[col::character_name];
-		bool has_expedition        = (row[col::character_expedition_id] != nullptr);
-
-		if (character_id != last_character_id)
+		else if (buf->disable_messages)
 		{
-			// defaults to online status, if offline group members implemented this needs to change
-			m_members.emplace_back(character_id, character_name);
+			continue;
+		}
 
-			// process event lockout conflict messages from the previous character
-			for (const auto& member_lockout : member_lockout_conflicts)
+		switch (conflict.type)
+		{
+		case 0:
+			if (buf->is_solo)
 			{
-				SendLeaderMemberEventLockout(member_lockout.character_name, member_lockout.lockout);
+				Client::SendCrossZoneMessageString(leader, buf->leader_name, Chat::Red, EXPEDITION_YOU_BELONG);
 			}
-			member_lockout_conflicts.clear();
-
-			if (has_expedition)
+			else
 			{
-				has_conflicts = true;
-				SendLeaderMemberInExpedition(character_name, is_solo);
-
-				// solo requests break out early if requester in an expedition
-				if (is_solo)
-				{
-					return has_conflicts;
-				}
+				std::string message = fmt::format(EXPEDITION_OTHER_BELONGS, buf->requester_name, conflict.character_name);
+				Client::SendCrossZoneMessage(leader, buf->leader_name, Chat::Red, message);
 			}
-		}
-
-		last_character_id = character_id;
-
-		// compare member lockouts with leader lockouts
-		if (row[col::lockout_uuid]) // lockout results may be null
-		{
-			auto expire_time = strtoull(row[col::lockout_expire_time], nullptr, 10);
-			uint32_t duration = strtoul(row[col::lockout_duration], nullptr, 10);
-
-			ExpeditionLockoutTimer lockout{
-				row[col::lockout_uuid], m_expedition_name, row[col::lockout_event_name], expire_time, duration
-			};
-
-			if (!lockout.IsExpired())
+			break;
+		case 1:
+			if (buf->is_solo)
 			{
-				if (lockout.IsReplayTimer())
-				{
-					// replay timer conflict messages always show up before event conflicts
-					has_conflicts = true;
-					SendLeaderMemberReplayLockout(character_name, lockout, is_solo);
-				}
-				else if (m_check_event_lockouts && character_id != m_leader_id)
-				{
-					if (m_lockouts.find(lockout.GetEventName()) == m_lockouts.end())
-					{
-						// leader doesn't have this lockout. queue instead of messaging
-						// now so message comes after any replay lockout messages
-						has_conflicts = true;
-						member_lockout_conflicts.push_back({character_name, lockout});
-					}
-				}
+				Client::SendCrossZoneMessageString(leader, buf->leader_name, Chat::Red, EXPEDITION_YOU_PLAYED_HERE, {
+					time_remaining.days, time_remaining.hours, time_remaining.mins
+				});
+			}
+			else
+			{
+				Client::SendCrossZoneMessageString(leader, buf->leader_name, Chat::Red, EXPEDITION_REPLAY_TIMER, {
+					conflict.character_name, time_remaining.days, time_remaining.hours, time_remaining.mins
+				});
 			}
+			break;
+		case 2:
+			Client::SendCrossZoneMessageString(leader, buf->leader_name, Chat::Red, EXPEDITION_EVENT_TIMER, {
+				conflict.character_name,
+				conflict.event_name,
+				time_remaining.days,
+				time_remaining.hours,
+				time_remaining.mins,
+				conflict.event_name
+			});
+			break;
+		case 3:
+			Client::SendCrossZoneMessageString(leader, buf->leader_name, Chat::System, REQUIRED_PLAYER_COUNT, {
+				fmt::format_int(buf->member_count).str(),
+				fmt::format_int(buf->min_players).str(),
+				fmt::format_int(buf->max_players).str()
+			});
+			break;
+		default:
+			break;
 		}
 	}
-
-	// event lockout messages for last processed character
-	for (const auto& member_lockout : member_lockout_conflicts)
-	{
-		SendLeaderMemberEventLockout(member_lockout.character_name, member_lockout.lockout);
-	}
-
-	return has_conflicts;
-}
-
-void ExpeditionRequest::SendLeaderMessage(
-	uint16_t chat_type, uint32_t string_id, const std::initializer_list<std::string>& args)
-{
-	if (!m_disable_messages)
-	{
-		Client::SendCrossZoneMessageString(m_leader, m_leader_name, chat_type, string_id, args);
-	}
-}
-
-void ExpeditionRequest::SendLeaderMemberInExpedition(const std::string& member_name, bool is_solo)
-{
-	if (m_disable_messages)
-	{
-		return;
-	}
-
-	if (is_solo)
-	{
-		SendLeaderMessage(Chat::Red, EXPEDITION_YOU_BELONG);
-	}
-	else if (m_requester)
-	{
-		std::string message = fmt::format(EXPEDITION_OTHER_BELONGS, m_requester->GetName(), member_name);
-		Client::SendCrossZoneMessage(m_leader, m_leader_name, Chat::Red, message);
-	}
-}
-
-void ExpeditionRequest::SendLeaderMemberReplayLockout(
-	const std::string& member_name, const ExpeditionLockoutTimer& lockout, bool is_solo)
-{
-	if (m_disable_messages)
-	{
-		return;
-	}
-
-	auto time_remaining = lockout.GetDaysHoursMinutesRemaining();
-	if (is_solo)
-	{
-		SendLeaderMessage(Chat::Red, EXPEDITION_YOU_PLAYED_HERE, {
-			time_remaining.days, time_remaining.hours, time_remaining.mins
-		});
-	}
-	else
-	{
-		SendLeaderMessage(Chat::Red, EXPEDITION_REPLAY_TIMER, {
-			member_name, time_remaining.days, time_remaining.hours, time_remaining.mins
-		});
-	}
-}
-
-void ExpeditionRequest::SendLeaderMemberEventLockout(
-	const std::string& member_name, const ExpeditionLockoutTimer& lockout)
-{
-	if (m_disable_messages)
-	{
-		return;
-	}
-
-	auto time_remaining = lockout.GetDaysHoursMinutesRemaining();
-	SendLeaderMessage(Chat::Red, EXPEDITION_EVENT_TIMER, {
-		member_name,
-		lockout.GetEventName(),
-		time_remaining.days,
-		time_remaining.hours,
-		time_remaining.mins,
-		lockout.GetEventName()
-	});
-}
-
-bool ExpeditionRequest::IsPlayerCountValidated()
-{
-	// note: offline group members count towards requirement but not added to expedition
-	bool requirements_met = true;
-
-	auto bypass_status = RuleI(Expedition, MinStatusToBypassPlayerCountRequirements);
-	auto gm_bypass = (m_requester && m_requester->GetGM() && m_requester->Admin() >= bypass_status);
-
-	if (m_members.size() > m_max_players)
-	{
-		// members were sorted at start, truncate after conflict checks to act like live
-		m_members.resize(m_max_players);
-	}
-	else if (!gm_bypass && m_members.size() < m_min_players)
-	{
-		requirements_met = false;
-
-		SendLeaderMessage(Chat::System, REQUIRED_PLAYER_COUNT, {
-			fmt::format_int(m_members.size()).str(),
-			fmt::format_int(m_min_players).str(),
-			fmt::format_int(m_max_players).str()
-		});
-	}
-
-	return requirements_met;
 }
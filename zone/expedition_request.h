@@ -22,17 +22,14 @@
 #define EXPEDITION_REQUEST_H
 
 #include "expedition.h"
-#include "expedition_lockout_timer.h"
 #include <cstdint>
 #include <string>
 #include <vector>
-#include <unordered_map>
 
 class Client;
 class Group;
-class MySQLRequestResult;
 class Raid;
-class ServerPacket;
+struct ServerExpeditionCreateRejected_Struct;
 
 class ExpeditionRequest
 {
@@ -44,40 +41,35 @@ public:
 	bool Validate(Client* requester);
 
 	const std::string& GetExpeditionName() const { return m_expedition_name; }
-	Client* GetLeaderClient() const { return m_leader; }
+	uint32_t GetRequesterID() const { return m_requester_id; }
+	const std::string& GetRequesterName() const { return m_requester_name; }
 	uint32_t GetLeaderID() const { return m_leader_id; }
 	const std::string& GetLeaderName() const { return m_leader_name; }
 	const std::string& GetNotAllAddedMessage() const { return m_not_all_added_msg; }
 	uint32_t GetMinPlayers() const { return m_min_players; }
 	uint32_t GetMaxPlayers() const { return m_max_players; }
-	std::vector<ExpeditionMember> GetMembers() const { return m_members; }
-	std::unordered_map<std::string, ExpeditionLockoutTimer> GetLockouts() const { return m_lockouts; }
+	bool IsGMBypass() const { return m_gm_bypass; }
+	bool IsMessagesDisabled() const { return m_disable_messages; }
+	const std::vector<ExpeditionMember>& GetMembers() const { return m_members; }
+
+	static void SendRejectedMessages(const ServerExpeditionCreateRejected_Struct* buf);
 
 private:
-	bool CanMembersJoin(const std::vector<std::string>& member_names);
-	bool CanRaidRequest(Raid* raid);
-	bool CanGroupRequest(Group* group);
-	bool CheckMembersForConflicts(const std::vector<std::string>& member_names);
+	void AddRaidMembers(Raid* raid);
+	void AddGroupMembers(Group* group);
 	std::string GetGroupLeaderName(uint32_t group_id);
-	bool IsPlayerCountValidated();
-	bool LoadLeaderLockouts();
-	void SendLeaderMemberInExpedition(const std::string& member_name, bool is_solo);
-	void SendLeaderMemberReplayLockout(const std::string& member_name, const ExpeditionLockoutTimer& lockout, bool is_solo);
-	void SendLeaderMemberEventLockout(const std::string& member_name, const ExpeditionLockoutTimer& lockout);
-	void SendLeaderMessage(uint16_t chat_type, uint32_t string_id, const std::initializer_list<std::string>& args = {});
 
-	Client*  m_requester            = nullptr;
-	Client*  m_leader               = nullptr;
-	uint32_t m_leader_id            = 0;
-	uint32_t m_min_players          = 0;
-	uint32_t m_max_players          = 0;
-	bool     m_check_event_lockouts = true;
-	bool     m_disable_messages     = false;
+	uint32_t m_requester_id     = 0;
+	uint32_t m_leader_id        = 0;
+	uint32_t m_min_players      = 0;
+	uint32_t m_max_players      = 0;
+	bool     m_disable_messages = false;
+	bool     m_gm_bypass        = false;
 	std::string m_expedition_name;
+	std::string m_requester_name;
 	std::string m_leader_name;
 	std::string m_not_all_added_msg;
 	std::vector<ExpeditionMember> m_members;
-	std::unordered_map<std::string, ExpeditionLockoutTimer> m_lockouts;
 };
 
 #endif
@@ -25,7 +25,7 @@
 #define snprintf	_snprintf
 #endif
 
-extern Zone* zone;
+extern Zone*& zone;
 
 #define FEAR_PATHING_DEBUG
 
@@ -3,7 +3,7 @@
 #include "client.h"
 #include "zone.h"
 
-extern Zone *zone;
+extern Zone *&zone;
 
 std::vector<int> GlobalLootManager::GetGlobalLootTables(NPC *mob) const
 {
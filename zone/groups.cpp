@@ -26,8 +26,8 @@
 #include "../common/string_util.h"
 #include "worldserver.h"
 
-extern EntityList entity_list;
-extern WorldServer worldserver;
+extern EntityList &entity_list;
+extern WorldServer &worldserver;
 
 /*
 note about how groups work:
@@ -38,7 +38,7 @@ Only members in this zone will have non-null pointers in the
 members array.
 */
 
-//create a group which should already exist in the database
+//create a group world already knows about, its roster is set from world's
 Group::Group(uint32 gid)
 : GroupIDConsumer(gid)
 {
@@ -58,14 +58,6 @@ Group::Group(uint32 gid)
 		MemberRoles[i] = 0;
 	}
 
-	if(gid != 0) {
-		if(!LearnMembers()) {
-			SetID(0);
-		}
-		if(GetLeader() != nullptr) {
-			SetOldLeaderName(GetLeaderName());
-		}
-	}
 	for(int i = 0; i < MAX_MARKED_NPCS; ++i)
 		MarkedNPCs[i] = 0;
 
@@ -329,7 +321,7 @@ bool Group::AddMember(Mob* newmember, const char *NewMemberName, uint32 Characte
 		{
 			strcpy(newmember->CastToClient()->GetPP().groupMembers[x], NewMemberName);
 			newmember->CastToClient()->Save();
-			database.SetGroupID(NewMemberName, GetID(), newmember->CastToClient()->CharacterID(), false);
+			SendWorldGroupID(NewMemberName, GetID(), newmember->CastToClient()->CharacterID(), false);
 			SendMarkedNPCsToMember(newmember->CastToClient());
 
 			NotifyMainTank(newmember->CastToClient(), 1);
@@ -342,7 +334,7 @@ bool Group::AddMember(Mob* newmember, const char *NewMemberName, uint32 Characte
 			Client* owner = newmember->CastToMerc()->GetMercOwner();
 			if(owner)
 			{
-				database.SetGroupID(NewMemberName, GetID(), owner->CharacterID(), true);
+				SendWorldGroupID(NewMemberName, GetID(), owner->CharacterID(), true);
 			}
 		}
 
@@ -355,7 +347,7 @@ bool Group::AddMember(Mob* newmember, const char *NewMemberName, uint32 Characte
 	}
 	else
 	{
-		database.SetGroupID(NewMemberName, GetID(), CharacterID, ismerc);
+		SendWorldGroupID(NewMemberName, GetID(), CharacterID, ismerc);
 	}
 
 	if (newmember && newmember->IsClient())
@@ -757,7 +749,7 @@ bool Group::DelMember(Mob* oldmember, bool ignoresender)
 
 	if(oldmember->IsClient())
 	{
-		database.SetGroupID(oldmember->GetCleanName(), 0, oldmember->CastToClient()->CharacterID(), false);
+		SendWorldGroupID(oldmember->GetCleanName(), 0, oldmember->CastToClient()->CharacterID(), false);
 	}
 	
 	if(oldmember->IsMerc())
@@ -765,7 +757,7 @@ bool Group::DelMember(Mob* oldmember, bool ignoresender)
 		Client* owner = oldmember->CastToMerc()->GetMercOwner();
 		if(owner)
 		{
-			database.SetGroupID(oldmember->GetCleanName(), 0, owner->CharacterID(), true);
+			SendWorldGroupID(oldmember->GetCleanName(), 0, owner->CharacterID(), true);
 		}
 	}
 
@@ -982,21 +974,11 @@ void Group::DisbandGroup(bool joinraid) {
 			}
 
 			strcpy(gu->yourname, members[i]->GetCleanName());
-			database.SetGroupID(members[i]->GetCleanName(), 0, members[i]->CastToClient()->CharacterID(), false);
 			members[i]->CastToClient()->QueuePacket(outapp);
 			SendMarkedNPCsToMember(members[i]->CastToClient(), true);
 			if (!joinraid)
 				members[i]->CastToClient()->LeaveGroupXTargets(this);
 		}
-		
-		if (members[i]->IsMerc())
-		{
-			Client* owner = members[i]->CastToMerc()->GetMercOwner();
-			if(owner)
-			{
-				database.SetGroupID(members[i]->GetCleanName(), 0, owner->CharacterID(), true);
-			}
-		}
 
 		members[i]->SetGrouped(false);
 		members[i] = nullptr;
@@ -1005,6 +987,7 @@ void Group::DisbandGroup(bool joinraid) {
 
 	ClearAllNPCMarks();
 
+	// world drops the whole roster when it gets this, members' group_id rows included
 	auto pack = new ServerPacket(ServerOP_DisbandGroup, sizeof(ServerDisbandGroup_Struct));
 	ServerDisbandGroup_Struct* dg = (ServerDisbandGroup_Struct*)pack->pBuffer;
 	dg->zoneid = zone->GetZoneID();
@@ -1015,7 +998,7 @@ void Group::DisbandGroup(bool joinraid) {
 
 	if(GetID() != 0)
 	{
-		database.ClearGroup(GetID());
+		database.ClearGroupLeader(GetID());
 	}
 
 	entity_list.RemoveGroup(GetID());
@@ -1188,34 +1171,47 @@ void Group::TeleportGroup(Mob* sender, uint32 zoneID, uint16 instance_id, float
 	}
 }
 
-bool Group::LearnMembers() {
-	std::string query = StringFormat("SELECT name FROM group_id WHERE groupid = %lu", (unsigned long)GetID());
-	auto results = database.QueryDatabase(query);
-	if (!results.Success())
-        return false;
-
-	if (results.RowCount() == 0) {
-		LogError(
-			"Error getting group members for group [{}]: [{}]",
-			(unsigned long) GetID(),
-			results.ErrorMessage().c_str()
-		);
+void Group::SetRosterFromWorld(const ServerRosterMember_Struct *roster, uint32 count)
+{
+	Mob* old_members[MAX_GROUP_MEMBERS];
+	char old_names[MAX_GROUP_MEMBERS][64];
+	uint8 old_roles[MAX_GROUP_MEMBERS];
+	memcpy(old_members, members, sizeof(old_members));
+	memcpy(old_names, membername, sizeof(old_names));
+	memcpy(old_roles, MemberRoles, sizeof(old_roles));
 
-		return false;
-	}
+	// members already in zone keep their entity and roles
+	for (uint32 i = 0; i < MAX_GROUP_MEMBERS; ++i) {
+		members[i] = nullptr;
+		membername[i][0] = '\0';
+		MemberRoles[i] = 0;
 
-	int memberIndex = 0;
-    for(auto row = results.begin(); row != results.end(); ++row) {
-		if(!row[0])
+		if (i >= count)
 			continue;
 
-		members[memberIndex] = nullptr;
-		strn0cpy(membername[memberIndex], row[0], 64);
-
-		memberIndex++;
+		strn0cpy(membername[i], roster[i].name, 64);
+		for (uint32 j = 0; j < MAX_GROUP_MEMBERS; ++j) {
+			if (old_names[j][0] != '\0' && !strcasecmp(old_names[j], membername[i])) {
+				members[i] = old_members[j];
+				MemberRoles[i] = old_roles[j];
+				break;
+			}
+		}
 	}
+}
 
-	return true;
+void Group::SendWorldGroupID(const char *name, uint32 group_id, uint32 character_id, bool is_merc)
+{
+	auto pack = new ServerPacket(ServerOP_GroupRosterUpdate, sizeof(ServerGroupRosterUpdate_Struct));
+	ServerGroupRosterUpdate_Struct* gru = (ServerGroupRosterUpdate_Struct*)pack->pBuffer;
+	gru->zoneid = zone->GetZoneID();
+	gru->instance_id = zone->GetInstanceID();
+	gru->gid = group_id;
+	gru->char_id = character_id;
+	gru->is_merc = is_merc;
+	strn0cpy(gru->member_name, name, sizeof(gru->member_name));
+	worldserver.SendPacket(pack);
+	safe_delete(pack);
 }
 
 void Group::VerifyGroup() {
@@ -1302,10 +1298,10 @@ void Client::LeaveGroup() {
 	else
 	{
 		//force things a little
-		database.SetGroupID(GetCleanName(), 0, CharacterID(), false);
+		Group::SendWorldGroupID(GetCleanName(), 0, CharacterID(), false);
 		if (GetMerc())
 		{
-			database.SetGroupID(GetMerc()->GetCleanName(), 0, CharacterID(), true);
+			Group::SendWorldGroupID(GetMerc()->GetCleanName(), 0, CharacterID(), true);
 		}
 	}
 
@@ -27,6 +27,7 @@
 class Client;
 class EQApplicationPacket;
 class Mob;
+struct ServerRosterMember_Struct;
 
 #define MAX_MARKED_NPCS 3
 
@@ -64,6 +65,7 @@ public:
 	bool	DelMemberOOZ(const char *Name, bool checkleader);
 	bool	DelMember(Mob* oldmember,bool ignoresender = false);
 	void	DisbandGroup(bool joinraid = false);
+	static void	SendWorldGroupID(const char *name, uint32 group_id, uint32 character_id, bool is_merc = false);
 	void	GetMemberList(std::list<Mob*>& member_list, bool clear_list = true);
 	void	GetClientList(std::list<Client*>& client_list, bool clear_list = true);
 #ifdef BOTS
@@ -97,7 +99,7 @@ public:
 	void	QueuePacket(const EQApplicationPacket *app, bool ack_req = true);
 	void	TeleportGroup(Mob* sender, uint32 zoneID, uint16 instance_id, float x, float y, float z, float heading);
 	uint16	GetAvgLevel();
-	bool	LearnMembers();
+	void	SetRosterFromWorld(const ServerRosterMember_Struct *roster, uint32 count);
 	void	VerifyGroup();
 	void	BalanceHP(int32 penalty, float range = 0, Mob* caster = nullptr, int32 limit = 0);
 	void	BalanceMana(int32 penalty, float range = 0, Mob* caster = nullptr, int32 limit = 0);
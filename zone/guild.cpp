@@ -23,7 +23,7 @@
 #include "guild_mgr.h"
 #include "worldserver.h"
 
-extern WorldServer worldserver;
+extern WorldServer &worldserver;
 
 void Client::SendGuildMOTD(bool GetGuildMOTDReply) {
 	auto outapp = new EQApplicationPacket(OP_GuildMOTD, sizeof(GuildMOTD_Struct));
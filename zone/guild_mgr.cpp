@@ -29,7 +29,7 @@
 ZoneGuildManager guild_mgr;
 GuildBankManager *GuildBanks;
 
-extern WorldServer worldserver;
+extern WorldServer &worldserver;
 extern volatile bool is_zone_loaded;
 
 void ZoneGuildManager::SendGuildRefresh(uint32 guild_id, bool name, bool motd, bool rank, bool relation) {
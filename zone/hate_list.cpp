@@ -33,7 +33,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <stdlib.h>
 #include <list>
 
-extern Zone *zone;
+extern Zone *&zone;
 
 HateList::HateList()
 {
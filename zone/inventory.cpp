@@ -25,7 +25,7 @@
 #include "zonedb.h"
 #include "zone_store.h"
 
-extern WorldServer worldserver;
+extern WorldServer &worldserver;
 
 // @merth: this needs to be touched up
 uint32 Client::NukeItem(uint32 itemnum, uint8 where_to_check) {
@@ -5,7 +5,7 @@
 
 #include "client.h"
 #include "dynamiczone.h"
-#include "expedition_lockout_timer.h"
+#include "../common/expedition_lockout_timer.h"
 #include "expedition_request.h"
 #include "lua_client.h"
 #include "lua_expedition.h"
@@ -129,7 +129,7 @@ const char *LuaEvents[_LargestEventID] = {
 	"event_bot_command"
 };
 
-extern Zone *zone;
+extern Zone *&zone;
 
 struct lua_registered_event {
 	std::string encounter_name;
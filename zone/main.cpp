@@ -50,6 +50,7 @@
 #include "masterentity.h"
 #include "worldserver.h"
 #include "zone.h"
+#include "zone_context.h"
 #include "queryserv.h"
 #include "command.h"
 #ifdef BOTS
@@ -66,6 +67,8 @@
 #include "lua_parser.h"
 #include "questmgr.h"
 #include "npc_scale_manager.h"
+#include "zone_profiler.h"
+#include "zone_map_cache.h"
 
 #include "../common/event/event_loop.h"
 #include "../common/event/timer.h"
@@ -107,12 +110,13 @@ volatile bool RunLoops = true;
 
 extern volatile bool is_zone_loaded;
 
-EntityList entity_list;
-WorldServer worldserver;
+ZoneContext zone_context;
+Zone *&zone = zone_context.zone;
+EntityList &entity_list = zone_context.entity_list;
+WorldServer &worldserver = zone_context.worldserver;
 ZoneStore zone_store;
 uint32 numclients = 0;
 char errorname[32];
-extern Zone* zone;
 npcDecayTimes_Struct npcCorpseDecayTimes[100];
 TitleManager title_manager;
 QueryServ *QServ = 0;
@@ -150,6 +154,7 @@ int main(int argc, char** argv) {
 		filename += mapfile;
 
 		auto m = new Map();
+		m->SetLoadOptions(Map::LoadOptions::FromRules());
 		auto success = m->Load(filename, true);
 		delete m;
 		std::cout << mapfile.c_str() << " conversion " << (success ? "succeeded" : "failed") << std::endl;
@@ -460,6 +465,7 @@ int main(int argc, char** argv) {
 #endif
 	if (!strlen(zone_name) || !strcmp(zone_name, ".")) {
 		LogInfo("Entering sleep mode");
+		ZoneMapCache::Instance().PrewarmPopular();
 	}
 	else if (!Zone::Bootup(ZoneID(zone_name), instance_id, true)) {
 		LogError("Zone Bootup failed :: Zone::Bootup");
@@ -492,6 +498,8 @@ int main(int argc, char** argv) {
 		//Advance the timer to our current point in time
 		Timer::SetCurrentTime();
 
+		zone_profiler.BeginTick();
+
 		/**
 		 * Calculate frame time
 		 */
@@ -531,16 +539,22 @@ int main(int argc, char** argv) {
 		}
 
 		//give the stream identifier a chance to do its work....
-		stream_identifier.Process();
+		{
+			ZoneProfiler::Scope scope(zone_profiler, ZoneProfiler::StreamIdentify);
+			stream_identifier.Process();
+		}
 
 		//check the stream identifier for any now-identified streams
-		while ((eqsi = stream_identifier.PopIdentified())) {
-			//now that we know what patch they are running, start up their client object
-			struct in_addr	in;
-			in.s_addr = eqsi->GetRemoteIP();
-			LogInfo("New client from [{}]:[{}]", inet_ntoa(in), ntohs(eqsi->GetRemotePort()));
-			auto client = new Client(eqsi);
-			entity_list.AddClient(client);
+		{
+			ZoneProfiler::Scope scope(zone_profiler, ZoneProfiler::NewClients);
+			while ((eqsi = stream_identifier.PopIdentified())) {
+				//now that we know what patch they are running, start up their client object
+				struct in_addr	in;
+				in.s_addr = eqsi->GetRemoteIP();
+				LogInfo("New client from [{}]:[{}]", inet_ntoa(in), ntohs(eqsi->GetRemotePort()));
+				auto client = new Client(eqsi);
+				entity_list.AddClient(client);
+			}
 		}
 
 		if (worldserver.Connected()) {
@@ -555,25 +569,57 @@ int main(int argc, char** argv) {
 
 		if (is_zone_loaded) {
 			{
-				entity_list.GroupProcess();
-				entity_list.DoorProcess();
-				entity_list.ObjectProcess();
-				entity_list.CorpseProcess();
-				entity_list.TrapProcess();
-				entity_list.RaidProcess();
-
-				entity_list.Process();
-				entity_list.MobProcess();
-				entity_list.BeaconProcess();
-				entity_list.EncounterProcess();
+				{
+					ZoneProfiler::Scope scope(zone_profiler, ZoneProfiler::GroupProcess);
+					entity_list.GroupProcess();
+				}
+				{
+					ZoneProfiler::Scope scope(zone_profiler, ZoneProfiler::DoorProcess);
+					entity_list.DoorProcess();
+				}
+				{
+					ZoneProfiler::Scope scope(zone_profiler, ZoneProfiler::ObjectProcess);
+					entity_list.ObjectProcess();
+				}
+				{
+					ZoneProfiler::Scope scope(zone_profiler, ZoneProfiler::CorpseProcess);
+					entity_list.CorpseProcess();
+				}
+				{
+					ZoneProfiler::Scope scope(zone_profiler, ZoneProfiler::TrapProcess);
+					entity_list.TrapProcess();
+				}
+				{
+					ZoneProfiler::Scope scope(zone_profiler, ZoneProfiler::RaidProcess);
+					entity_list.RaidProcess();
+				}
+
+				{
+					ZoneProfiler::Scope scope(zone_profiler, ZoneProfiler::EntityProcess);
+					entity_list.Process();
+				}
+				{
+					ZoneProfiler::Scope scope(zone_profiler, ZoneProfiler::MobProcess);
+					entity_list.MobProcess();
+				}
+				{
+					ZoneProfiler::Scope scope(zone_profiler, ZoneProfiler::BeaconProcess);
+					entity_list.BeaconProcess();
+				}
+				{
+					ZoneProfiler::Scope scope(zone_profiler, ZoneProfiler::EncounterProcess);
+					entity_list.EncounterProcess();
+				}
 
 				if (zone) {
+					ZoneProfiler::Scope scope(zone_profiler, ZoneProfiler::ZoneProcess);
 					if (!zone->Process()) {
 						Zone::Shutdown();
 					}
 				}
 
 				if (quest_timers.Check()) {
+					ZoneProfiler::Scope scope(zone_profiler, ZoneProfiler::QuestTimers);
 					quest_manager.Process();
 				}
 
@@ -581,11 +627,14 @@ int main(int argc, char** argv) {
 		}
 
 		if (InterserverTimer.Check()) {
+			ZoneProfiler::Scope scope(zone_profiler, ZoneProfiler::Interserver);
 			InterserverTimer.Start();
 			database.ping();
 			content_db.ping();
 			entity_list.UpdateWho();
 		}
+
+		zone_profiler.EndTick();
 	};
 
 	EQ::Timer process_timer(loop_fn);
@@ -7,18 +7,344 @@
 #include "zone.h"
 
 #include <algorithm>
+#include <cfloat>
+#include <list>
 #include <map>
 #include <memory>
 #include <tuple>
+#include <unordered_map>
 #include <vector>
 
+#define HEIGHT_FIELD_EPSILON 0.01f
+#define HEIGHT_FIELD_MAX_CELLS (4 * 1024 * 1024)
+
+/**
+ * A vertical slab of geometry inside one height field cell; every triangle that overlaps
+ * the cell in x/y lies within [min_z, max_z] of exactly one of the cell's layers.
+ * When the layer is a single triangle that covers the whole cell the plane is stored so
+ * the height can be answered without a raycast.
+ */
+struct HeightFieldLayer
+{
+	float min_z;
+	float max_z;
+	float plane_x;
+	float plane_y;
+	float plane_c;
+	uint8 exact;
+};
+
+struct HeightField
+{
+	float min_x;
+	float min_y;
+	float cell_size;
+	uint32 width;
+	uint32 height;
+	std::vector<uint32> offsets; // width * height + 1 entries, layers of a cell are [offsets[i], offsets[i + 1])
+	std::vector<HeightFieldLayer> layers; // sorted by min_z within a cell, never overlapping
+};
+
+enum class HeightFieldResult
+{
+	Hit,
+	Miss,
+	Outside
+};
+
+/**
+ * Both ends of a line of sight check snapped to the LoS cache grid, stored with the
+ * lesser end first since the raycast gives the same answer in either direction
+ */
+struct LoSCacheKey
+{
+	int32 a[3];
+	int32 b[3];
+
+	bool operator==(const LoSCacheKey &other) const
+	{
+		return memcmp(this, &other, sizeof(LoSCacheKey)) == 0;
+	}
+};
+
+struct LoSCacheKeyHash
+{
+	size_t operator()(const LoSCacheKey &key) const
+	{
+		uint64 h = 14695981039346656037ULL;
+		const int32 *v = key.a;
+		for (int i = 0; i < 6; ++i) {
+			h = (h ^ static_cast<uint32>(v[i])) * 1099511628211ULL;
+		}
+
+		return static_cast<size_t>(h);
+	}
+};
+
+struct LoSCache
+{
+	typedef std::list<std::pair<LoSCacheKey, bool>> LRUList;
+
+	LRUList lru; // most recently used at the front
+	std::unordered_map<LoSCacheKey, LRUList::iterator, LoSCacheKeyHash> entries;
+	Map::LoSCacheStats stats = { 0, 0, 0, 0, 0 };
+};
+
 struct Map::impl
 {
 	RaycastMesh *rm;
+	std::unique_ptr<HeightField> height_field;
+	LoSCache los_cache;
 };
 
+static bool TriangleCoversPoint(const glm::vec3 &a, const glm::vec3 &b, const glm::vec3 &c, float x, float y)
+{
+	float d1 = (x - b.x) * (a.y - b.y) - (a.x - b.x) * (y - b.y);
+	float d2 = (x - c.x) * (b.y - c.y) - (b.x - c.x) * (y - c.y);
+	float d3 = (x - a.x) * (c.y - a.y) - (c.x - a.x) * (y - a.y);
+
+	// strictly inside only, points on an edge fall back to the raycast
+	return (d1 > HEIGHT_FIELD_EPSILON && d2 > HEIGHT_FIELD_EPSILON && d3 > HEIGHT_FIELD_EPSILON) ||
+		(d1 < -HEIGHT_FIELD_EPSILON && d2 < -HEIGHT_FIELD_EPSILON && d3 < -HEIGHT_FIELD_EPSILON);
+}
+
+static std::unique_ptr<HeightField> BuildHeightField(
+	const std::vector<glm::vec3> &verts,
+	const std::vector<uint32> &indices,
+	const Map::LoadOptions &options
+)
+{
+	if (verts.empty() || indices.size() < 3) {
+		return nullptr;
+	}
+
+	glm::vec2 min(FLT_MAX, FLT_MAX);
+	glm::vec2 max(-FLT_MAX, -FLT_MAX);
+	for (auto &v : verts) {
+		min.x = std::min(min.x, v.x);
+		min.y = std::min(min.y, v.y);
+		max.x = std::max(max.x, v.x);
+		max.y = std::max(max.y, v.y);
+	}
+
+	float cell_size = std::max(options.height_field_cell_size, 1.0f);
+	uint32 width = 0;
+	uint32 height = 0;
+	for (;;) {
+		width = static_cast<uint32>((max.x - min.x) / cell_size) + 1;
+		height = static_cast<uint32>((max.y - min.y) / cell_size) + 1;
+		if (static_cast<uint64>(width) * height <= HEIGHT_FIELD_MAX_CELLS) {
+			break;
+		}
+
+		cell_size *= 2.0f;
+	}
+
+	struct CellEntry
+	{
+		uint32 cell;
+		uint32 tri;
+		float min_z;
+		float max_z;
+	};
+
+	std::vector<CellEntry> entries;
+	entries.reserve(indices.size() / 3);
+
+	for (uint32 tri = 0; tri < indices.size() / 3; ++tri) {
+		auto &a = verts[indices[tri * 3]];
+		auto &b = verts[indices[tri * 3 + 1]];
+		auto &c = verts[indices[tri * 3 + 2]];
+
+		float tri_min_z = std::min(a.z, std::min(b.z, c.z)) - HEIGHT_FIELD_EPSILON;
+		float tri_max_z = std::max(a.z, std::max(b.z, c.z)) + HEIGHT_FIELD_EPSILON;
+
+		int x0 = static_cast<int>((std::min(a.x, std::min(b.x, c.x)) - HEIGHT_FIELD_EPSILON - min.x) / cell_size);
+		int x1 = static_cast<int>((std::max(a.x, std::max(b.x, c.x)) + HEIGHT_FIELD_EPSILON - min.x) / cell_size);
+		int y0 = static_cast<int>((std::min(a.y, std::min(b.y, c.y)) - HEIGHT_FIELD_EPSILON - min.y) / cell_size);
+		int y1 = static_cast<int>((std::max(a.y, std::max(b.y, c.y)) + HEIGHT_FIELD_EPSILON - min.y) / cell_size);
+		x0 = std::max(x0, 0);
+		y0 = std::max(y0, 0);
+		x1 = std::min(x1, static_cast<int>(width) - 1);
+		y1 = std::min(y1, static_cast<int>(height) - 1);
+
+		glm::vec3 normal = glm::cross(b - a, c - a);
+		bool has_plane = std::abs(normal.z) > 0.001f * glm::length(normal);
+
+		for (int cy = y0; cy <= y1; ++cy) {
+			for (int cx = x0; cx <= x1; ++cx) {
+				float z_lo = tri_min_z;
+				float z_hi = tri_max_z;
+
+				// a plane is linear, so its extremes over the cell are at the corners
+				if (has_plane) {
+					float corner_min = FLT_MAX;
+					float corner_max = -FLT_MAX;
+					for (int corner = 0; corner < 4; ++corner) {
+						float x = min.x + (cx + (corner & 1)) * cell_size;
+						float y = min.y + (cy + (corner >> 1)) * cell_size;
+						float z = a.z - (normal.x * (x - a.x) + normal.y * (y - a.y)) / normal.z;
+						corner_min = std::min(corner_min, z);
+						corner_max = std::max(corner_max, z);
+					}
+
+					z_lo = std::max(z_lo, corner_min - HEIGHT_FIELD_EPSILON);
+					z_hi = std::min(z_hi, corner_max + HEIGHT_FIELD_EPSILON);
+				}
+
+				entries.push_back({ cy * width + cx, tri, z_lo, z_hi });
+			}
+		}
+	}
+
+	std::sort(
+		entries.begin(), entries.end(), [](const CellEntry &lhs, const CellEntry &rhs) {
+			return lhs.cell < rhs.cell || (lhs.cell == rhs.cell && lhs.min_z < rhs.min_z);
+		}
+	);
+
+	std::unique_ptr<HeightField> hf(new HeightField);
+	hf->min_x = min.x;
+	hf->min_y = min.y;
+	hf->cell_size = cell_size;
+	hf->width = width;
+	hf->height = height;
+	hf->offsets.resize(static_cast<size_t>(width) * height + 1);
+
+	struct PendingLayer
+	{
+		float min_z;
+		float max_z;
+		uint32 tri;
+		uint32 tri_count;
+	};
+
+	size_t max_layers = static_cast<size_t>(std::max(options.height_field_max_layers, 1));
+	std::vector<PendingLayer> pending;
+	size_t current = 0;
+	for (uint32 cell = 0; cell < width * height; ++cell) {
+		hf->offsets[cell] = static_cast<uint32>(hf->layers.size());
+
+		pending.clear();
+		for (; current < entries.size() && entries[current].cell == cell; ++current) {
+			auto &e = entries[current];
+			if (!pending.empty() && e.min_z <= pending.back().max_z) {
+				pending.back().max_z = std::max(pending.back().max_z, e.max_z);
+				pending.back().tri_count++;
+				continue;
+			}
+
+			pending.push_back({ e.min_z, e.max_z, e.tri, 1 });
+		}
+
+		// merging only widens the span a raycast has to cover, it never loses geometry
+		while (pending.size() > max_layers) {
+			size_t best = 0;
+			for (size_t i = 1; i + 1 < pending.size(); ++i) {
+				if (pending[i + 1].min_z - pending[i].max_z < pending[best + 1].min_z - pending[best].max_z) {
+					best = i;
+				}
+			}
+
+			pending[best].max_z = std::max(pending[best].max_z, pending[best + 1].max_z);
+			pending[best].tri_count += pending[best + 1].tri_count;
+			pending.erase(pending.begin() + best + 1);
+		}
+
+		float x0 = hf->min_x + (cell % width) * cell_size;
+		float y0 = hf->min_y + (cell / width) * cell_size;
+		for (auto &p : pending) {
+			HeightFieldLayer layer = { p.min_z, p.max_z, 0.0f, 0.0f, 0.0f, 0 };
+			if (p.tri_count == 1) {
+				auto &a = verts[indices[p.tri * 3]];
+				auto &b = verts[indices[p.tri * 3 + 1]];
+				auto &c = verts[indices[p.tri * 3 + 2]];
+				glm::vec3 normal = glm::cross(b - a, c - a);
+
+				if (std::abs(normal.z) > 0.001f * glm::length(normal) &&
+					TriangleCoversPoint(a, b, c, x0, y0) &&
+					TriangleCoversPoint(a, b, c, x0 + cell_size, y0) &&
+					TriangleCoversPoint(a, b, c, x0, y0 + cell_size) &&
+					TriangleCoversPoint(a, b, c, x0 + cell_size, y0 + cell_size)) {
+					layer.plane_x = -normal.x / normal.z;
+					layer.plane_y = -normal.y / normal.z;
+					layer.plane_c = a.z - layer.plane_x * a.x - layer.plane_y * a.y;
+					layer.exact = 1;
+				}
+			}
+
+			hf->layers.push_back(layer);
+		}
+	}
+
+	hf->offsets[width * height] = static_cast<uint32>(hf->layers.size());
+
+	LogInfo(
+		"Built map height field [{}] x [{}] cells of [{}] units with [{}] layers",
+		width,
+		height,
+		cell_size,
+		hf->layers.size()
+	);
+
+	return hf;
+}
+
+/**
+ * Answers a vertical raycast from the height field: layers are walked nearest first and
+ * only the z span of a layer is raycast, or its plane evaluated when the layer is exact.
+ * Returns the same surface the full length raycast would hit.
+ */
+static HeightFieldResult QueryHeightField(
+	const HeightField &hf,
+	RaycastMesh *rm,
+	const glm::vec3 &from,
+	bool search_down,
+	glm::vec3 *result
+)
+{
+	float fx = (from.x - hf.min_x) / hf.cell_size;
+	float fy = (from.y - hf.min_y) / hf.cell_size;
+	if (fx < 0.0f || fy < 0.0f || fx >= hf.width || fy >= hf.height) {
+		return HeightFieldResult::Outside;
+	}
+
+	uint32 cell = static_cast<uint32>(fy) * hf.width + static_cast<uint32>(fx);
+	uint32 first = hf.offsets[cell];
+	uint32 last = hf.offsets[cell + 1];
+	float hit_distance;
+
+	for (uint32 n = 0; n < last - first; ++n) {
+		auto &layer = hf.layers[search_down ? last - 1 - n : first + n];
+		if (search_down ? layer.min_z >= from.z : layer.max_z <= from.z) {
+			continue;
+		}
+
+		if (layer.exact) {
+			float z = layer.plane_x * from.x + layer.plane_y * from.y + layer.plane_c;
+			if (search_down ? z < from.z : z > from.z) {
+				*result = glm::vec3(from.x, from.y, z);
+				return HeightFieldResult::Hit;
+			}
+
+			continue;
+		}
+
+		glm::vec3 seg_from(from.x, from.y, search_down ? std::min(from.z, layer.max_z) : std::max(from.z, layer.min_z));
+		glm::vec3 seg_to(from.x, from.y, search_down ? layer.min_z : layer.max_z);
+		if (rm->raycast((const RmReal*)&seg_from, (const RmReal*)&seg_to, (RmReal*)result, nullptr, &hit_distance)) {
+			return HeightFieldResult::Hit;
+		}
+	}
+
+	return HeightFieldResult::Miss;
+}
+
 Map::Map() {
 	imp = nullptr;
+	load_options.use_height_field        = false;
+	load_options.height_field_cell_size  = 0.0f;
+	load_options.height_field_max_layers = 0;
 }
 
 Map::~Map() {
@@ -38,6 +364,22 @@ float Map::FindBestZ(glm::vec3 &start, glm::vec3 *result) const {
 
 	start.z += RuleI(Map, FindBestZHeightAdjust);
 	glm::vec3 from(start.x, start.y, start.z);
+
+	if (imp->height_field) {
+		auto below = QueryHeightField(*imp->height_field, imp->rm, from, true, result);
+		if (below == HeightFieldResult::Hit) {
+			return result->z;
+		}
+
+		if (below == HeightFieldResult::Miss) {
+			if (QueryHeightField(*imp->height_field, imp->rm, from, false, result) == HeightFieldResult::Hit) {
+				return result->z;
+			}
+
+			return BEST_Z_INVALID;
+		}
+	}
+
 	glm::vec3 to(start.x, start.y, BEST_Z_INVALID);
 	float hit_distance;
 	bool hit = false;
@@ -185,11 +527,79 @@ bool Map::LineIntersectsZoneNoZLeaps(glm::vec3 start, glm::vec3 end, float step_
 	return false;
 }
 
+static LoSCacheKey MakeLoSCacheKey(const glm::vec3 &myloc, const glm::vec3 &oloc)
+{
+	float grid = std::max(RuleR(Map, LoSCacheGridSize), 0.01f);
+
+	LoSCacheKey key;
+	for (int i = 0; i < 3; ++i) {
+		key.a[i] = static_cast<int32>(std::floor(myloc[i] / grid));
+		key.b[i] = static_cast<int32>(std::floor(oloc[i] / grid));
+	}
+
+	if (std::lexicographical_compare(key.b, key.b + 3, key.a, key.a + 3)) {
+		std::swap(key.a, key.b);
+	}
+
+	return key;
+}
+
 bool Map::CheckLoS(glm::vec3 myloc, glm::vec3 oloc) const {
 	if(!imp)
 		return false;
 
-	return !imp->rm->raycast((const RmReal*)&myloc, (const RmReal*)&oloc, nullptr, nullptr, nullptr);
+	if (!RuleB(Map, UseLoSCache)) {
+		return !imp->rm->raycast((const RmReal*)&myloc, (const RmReal*)&oloc, nullptr, nullptr, nullptr);
+	}
+
+	auto &cache = imp->los_cache;
+	auto key = MakeLoSCacheKey(myloc, oloc);
+	auto iter = cache.entries.find(key);
+	if (iter != cache.entries.end()) {
+		cache.lru.splice(cache.lru.begin(), cache.lru, iter->second);
+		cache.stats.hits++;
+		return iter->second->second;
+	}
+
+	cache.stats.misses++;
+	bool result = !imp->rm->raycast((const RmReal*)&myloc, (const RmReal*)&oloc, nullptr, nullptr, nullptr);
+
+	cache.lru.emplace_front(key, result);
+	cache.entries[key] = cache.lru.begin();
+
+	size_t capacity = static_cast<size_t>(std::max(RuleI(Map, LoSCacheSize), 0));
+	while (cache.entries.size() > capacity) {
+		cache.entries.erase(cache.lru.back().first);
+		cache.lru.pop_back();
+		cache.stats.evictions++;
+	}
+
+	return result;
+}
+
+void Map::InvalidateLoSCache() {
+	if (!imp)
+		return;
+
+	imp->los_cache.entries.clear();
+	imp->los_cache.lru.clear();
+	imp->los_cache.stats.invalidations++;
+}
+
+void Map::ResetLoSCacheStats() {
+	if (!imp)
+		return;
+
+	imp->los_cache.stats = { 0, 0, 0, 0, 0 };
+}
+
+Map::LoSCacheStats Map::GetLoSCacheStats() const {
+	if (!imp)
+		return { 0, 0, 0, 0, 0 };
+
+	auto stats = imp->los_cache.stats;
+	stats.entries = static_cast<uint32>(imp->los_cache.entries.size());
+	return stats;
 }
 
 // returns true if a collision happens
@@ -205,7 +615,17 @@ inline bool file_exists(const std::string& name) {
 	return f.good();
 }
 
-Map *Map::LoadMapFile(std::string file) {
+Map::LoadOptions Map::LoadOptions::FromRules()
+{
+	LoadOptions options;
+	options.use_height_field        = RuleB(Map, UseHeightField);
+	options.height_field_cell_size  = RuleR(Map, HeightFieldCellSize);
+	options.height_field_max_layers = RuleI(Map, HeightFieldMaxLayers);
+
+	return options;
+}
+
+Map *Map::LoadMapFile(std::string file, const LoadOptions &options) {
 
 	std::string filename = "";
 	if (file_exists("maps")) {
@@ -226,6 +646,7 @@ Map *Map::LoadMapFile(std::string file) {
 	LogInfo("Attempting to load Map File [{}]", filename.c_str());
 
 	auto m = new Map();
+	m->SetLoadOptions(options);
 	if (m->Load(filename)) {
 		return m;
 	}
@@ -369,6 +790,11 @@ bool Map::LoadV1(FILE *f) {
 		imp = nullptr;
 		return false;
 	}
+
+	imp->height_field.reset();
+	if (load_options.use_height_field) {
+		imp->height_field = BuildHeightField(verts, indices, load_options);
+	}
 	
 	return true;
 }
@@ -901,6 +1327,11 @@ bool Map::LoadV2(FILE *f) {
 		return false;
 	}
 
+	imp->height_field.reset();
+	if (load_options.use_height_field) {
+		imp->height_field = BuildHeightField(verts, indices, load_options);
+	}
+
 	return true;
 }
 
@@ -954,6 +1385,82 @@ inline bool add_mmf_extension(std::string& mmf_file_name)
 	return (dot_check == 1);
 }
 
+/**
+ * Height field section of the MMF cache, present from file version 1:
+ * header, cell offsets and layers written raw then deflated like the raycast mesh
+ */
+struct HeightFieldHeader
+{
+	float min_x;
+	float min_y;
+	float cell_size;
+	uint32 width;
+	uint32 height;
+	uint32 layer_count;
+};
+
+static void SerializeHeightField(const HeightField &hf, std::vector<char> &buffer)
+{
+	HeightFieldHeader header = { hf.min_x, hf.min_y, hf.cell_size, hf.width, hf.height, (uint32)hf.layers.size() };
+	size_t offsets_size = hf.offsets.size() * sizeof(uint32);
+	size_t layers_size = hf.layers.size() * sizeof(HeightFieldLayer);
+
+	buffer.resize(sizeof(header) + offsets_size + layers_size);
+	memcpy(buffer.data(), &header, sizeof(header));
+	memcpy(buffer.data() + sizeof(header), hf.offsets.data(), offsets_size);
+	memcpy(buffer.data() + sizeof(header) + offsets_size, hf.layers.data(), layers_size);
+}
+
+static std::unique_ptr<HeightField> LoadHeightField(const std::vector<char> &buffer)
+{
+	HeightFieldHeader header;
+	if (buffer.size() < sizeof(header)) {
+		return nullptr;
+	}
+
+	memcpy(&header, buffer.data(), sizeof(header));
+	if (!(header.cell_size > 0.0f) || header.width == 0 || header.height == 0) {
+		return nullptr;
+	}
+
+	// bound the counts by the buffer before multiplying so a corrupt header can't overflow the sizes
+	size_t cells = static_cast<size_t>(header.width) * header.height;
+	if (header.width > buffer.size() || header.height > buffer.size() || cells >= buffer.size() / sizeof(uint32) ||
+		header.layer_count > buffer.size() / sizeof(HeightFieldLayer)) {
+		return nullptr;
+	}
+
+	size_t offsets_size = (cells + 1) * sizeof(uint32);
+	size_t layers_size = static_cast<size_t>(header.layer_count) * sizeof(HeightFieldLayer);
+	if (buffer.size() != sizeof(header) + offsets_size + layers_size) {
+		return nullptr;
+	}
+
+	std::unique_ptr<HeightField> hf(new HeightField);
+	hf->min_x = header.min_x;
+	hf->min_y = header.min_y;
+	hf->cell_size = header.cell_size;
+	hf->width = header.width;
+	hf->height = header.height;
+	hf->offsets.resize(offsets_size / sizeof(uint32));
+	hf->layers.resize(header.layer_count);
+	memcpy(hf->offsets.data(), buffer.data() + sizeof(header), offsets_size);
+	memcpy(hf->layers.data(), buffer.data() + sizeof(header) + offsets_size, layers_size);
+
+	// QueryHeightField indexes layers straight from the offsets
+	if (hf->offsets.front() != 0 || hf->offsets.back() != header.layer_count) {
+		return nullptr;
+	}
+
+	for (size_t i = 1; i < hf->offsets.size(); ++i) {
+		if (hf->offsets[i] < hf->offsets[i - 1]) {
+			return nullptr;
+		}
+	}
+
+	return hf;
+}
+
 bool Map::LoadMMF(const std::string& map_file_name, bool force_mmf_overwrite)
 {
 	if (force_mmf_overwrite)
@@ -1011,11 +1518,34 @@ bool Map::LoadMMF(const std::string& map_file_name, bool force_mmf_overwrite)
 		LogInfo("Failed to load Map MMF file: [{}] - f@mmf_buffer", mmf_file_name.c_str());
 		return false;
 	}
+
+	uint32 hf_buffer_size = 0;
+	std::vector<char> hf_mmf_buffer;
+	if (file_version >= 1) {
+		uint32 hf_mmf_buffer_size;
+		if (fread(&hf_buffer_size, sizeof(uint32), 1, f) != 1 ||
+			fread(&hf_mmf_buffer_size, sizeof(uint32), 1, f) != 1) {
+			fclose(f);
+			LogInfo("Failed to load Map MMF file: [{}] - f@hf_buffer_size", mmf_file_name.c_str());
+			return false;
+		}
+
+		hf_mmf_buffer.resize(hf_mmf_buffer_size);
+		if (hf_mmf_buffer_size && fread(hf_mmf_buffer.data(), hf_mmf_buffer_size, 1, f) != 1) {
+			fclose(f);
+			LogInfo("Failed to load Map MMF file: [{}] - f@hf_mmf_buffer", mmf_file_name.c_str());
+			return false;
+		}
+	}
 	
 	fclose(f);
 
 	std::vector<char> rm_buffer(rm_buffer_size);
 	uint32 v = InflateData(mmf_buffer.data(), mmf_buffer_size, rm_buffer.data(), rm_buffer_size);
+	if (v != rm_buffer_size) {
+		LogInfo("Failed to load Map MMF file: [{}] - bad rm_buffer inflate", mmf_file_name.c_str());
+		return false;
+	}
 
 	if (imp) {
 		imp->rm->release();
@@ -1039,6 +1569,19 @@ bool Map::LoadMMF(const std::string& map_file_name, bool force_mmf_overwrite)
 		return false;
 	}
 
+	imp->height_field.reset();
+	if (hf_buffer_size && load_options.use_height_field) {
+		std::vector<char> hf_buffer(hf_buffer_size);
+		uint32 hf_inflated = EQ::InflateData(hf_mmf_buffer.data(), hf_mmf_buffer.size(), hf_buffer.data(), hf_buffer_size);
+		if (hf_inflated == hf_buffer_size) {
+			imp->height_field = LoadHeightField(hf_buffer);
+		}
+
+		if (!imp->height_field) {
+			LogInfo("Map MMF file: [{}] - discarding malformed height field", mmf_file_name.c_str());
+		}
+	}
+
 	return true;
 }
 
@@ -1087,7 +1630,7 @@ bool Map::SaveMMF(const std::string& map_file_name, bool force_mmf_overwrite)
 		return false;
 	}
 	
-	uint32 file_version = 0;
+	uint32 file_version = 1;
 	if (fwrite(&file_version, sizeof(uint32), 1, f) != 1) {
 		fclose(f);
 		std::remove(mmf_file_name.c_str());
@@ -1124,6 +1667,30 @@ bool Map::SaveMMF(const std::string& map_file_name, bool force_mmf_overwrite)
 		return false;
 	}
 
+	std::vector<char> hf_buffer;
+	if (imp->height_field) {
+		SerializeHeightField(*imp->height_field, hf_buffer);
+	}
+
+	uint32 hf_buffer_size = hf_buffer.size();
+	std::vector<char> hf_mmf_buffer(hf_buffer_size ? EQ::EstimateDeflateBuffer(hf_buffer_size) : 0);
+	uint32 hf_mmf_buffer_size = 0;
+	if (hf_buffer_size) {
+		hf_mmf_buffer_size = EQ::DeflateData(hf_buffer.data(), hf_buffer_size, hf_mmf_buffer.data(), hf_mmf_buffer.size());
+		if (!hf_mmf_buffer_size) {
+			hf_buffer_size = 0;
+		}
+	}
+
+	if (fwrite(&hf_buffer_size, sizeof(uint32), 1, f) != 1 ||
+		fwrite(&hf_mmf_buffer_size, sizeof(uint32), 1, f) != 1 ||
+		(hf_mmf_buffer_size && fwrite(hf_mmf_buffer.data(), hf_mmf_buffer_size, 1, f) != 1)) {
+		fclose(f);
+		std::remove(mmf_file_name.c_str());
+		LogInfo("Failed to save Map MMF file: [{}] - f@hf_mmf_buffer", mmf_file_name.c_str());
+		return false;
+	}
+
 	fclose(f);
 	
 	return true;
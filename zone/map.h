@@ -44,13 +44,40 @@ public:
 	bool CheckLoS(glm::vec3 myloc, glm::vec3 oloc) const;
 	bool DoCollisionCheck(glm::vec3 myloc, glm::vec3 oloc, glm::vec3 &outnorm, float &distance) const;
 
+	struct LoSCacheStats
+	{
+		uint64 hits;
+		uint64 misses;
+		uint64 evictions;
+		uint64 invalidations;
+		uint32 entries;
+	};
+
+	void InvalidateLoSCache();
+	void ResetLoSCacheStats();
+	LoSCacheStats GetLoSCacheStats() const;
+
+	/**
+	 * Rule values a load depends on, read on the zone thread so maps can be loaded from worker threads
+	 */
+	struct LoadOptions
+	{
+		bool use_height_field;
+		float height_field_cell_size;
+		int height_field_max_layers;
+
+		static LoadOptions FromRules();
+	};
+
+	void SetLoadOptions(const LoadOptions &options) { load_options = options; }
+
 #ifdef USE_MAP_MMFS
 	bool Load(std::string filename, bool force_mmf_overwrite = false);
 #else
 	bool Load(const std::string& filename);
 #endif
 
-	static Map *LoadMapFile(std::string file);
+	static Map *LoadMapFile(std::string file, const LoadOptions &options);
 private:
 	void RotateVertex(glm::vec3 &v, float rx, float ry, float rz);
 	void ScaleVertex(glm::vec3 &v, float sx, float sy, float sz);
@@ -65,6 +92,7 @@ private:
 
 	struct impl;
 	impl *imp;
+	LoadOptions load_options;
 };
 
 #endif
@@ -5839,7 +5839,7 @@ bool Merc::RemoveMercFromGroup(Merc* merc, Group* group) {
 				{
 					if(merc->GetMercCharacterID() != 0)
 					{
-						database.SetGroupID(merc->GetName(), 0, merc->GetMercCharacterID(), true);
+						Group::SendWorldGroupID(merc->GetName(), 0, merc->GetMercCharacterID(), true);
 					}
 				}
 			}
@@ -5924,7 +5924,7 @@ bool Merc::MercJoinClientGroup() {
 
 			if (AddMercToGroup(this, g))
 			{
-				database.SetGroupID(mercOwner->GetName(), g->GetID(), mercOwner->CharacterID(), false);
+				Group::SendWorldGroupID(mercOwner->GetName(), g->GetID(), mercOwner->CharacterID(), false);
 				database.SetGroupLeaderName(g->GetID(), mercOwner->GetName());
 				database.RefreshGroupFromDB(mercOwner);
 				g->SaveGroupLeaderAA();
@@ -35,10 +35,10 @@
 #include "bot.h"
 #endif
 
-extern EntityList entity_list;
+extern EntityList &entity_list;
 
-extern Zone* zone;
-extern WorldServer worldserver;
+extern Zone*& zone;
+extern WorldServer &worldserver;
 
 Mob::Mob(
 	const char *in_name,
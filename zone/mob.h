@@ -268,7 +268,7 @@ public:
 	int32 GetTextureProfileColor(uint8 material_slot) const;
 	int32 GetTextureProfileHeroForgeModel(uint8 material_slot) const;
 
-	virtual void SendArmorAppearance(Client *one_client = nullptr);
+	virtual uint32 SendArmorAppearance(Client *one_client = nullptr);
 	virtual void SendTextureWC(uint8 slot, uint16 texture, uint32 hero_forge_model = 0, uint32 elite_material = 0, uint32 unknown06 = 0, uint32 unknown18 = 0);
 	virtual void SendWearChange(uint8 material_slot, Client *one_client = nullptr);
 	virtual void SetSlotTint(uint8 material_slot, uint8 red_tint, uint8 green_tint, uint8 blue_tint);
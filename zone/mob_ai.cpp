@@ -38,10 +38,10 @@
 #include <limits>
 #include <math.h>
 
-extern EntityList entity_list;
+extern EntityList &entity_list;
 extern FastMath g_Math;
 
-extern Zone *zone;
+extern Zone *&zone;
 
 #if EQDEBUG >= 12
 	#define MobAI_DEBUG_Spells	25
@@ -83,19 +83,16 @@ bool NPC::AICastSpell(Mob* tar, uint8 iChance, uint32 iSpellTypes, bool bInnates
 	bool checked_los = false;	//we do not check LOS until we are absolutely sure we need to, and we only do it once.
 
 	float manaR = GetManaRatio();
-	for (int i = static_cast<int>(AIspells.size()) - 1; i >= 0; i--) {
-		if (AIspells[i].spellid <= 0 || AIspells[i].spellid >= SPDAT_RECORDS) {
-			// this is both to quit early to save cpu and to avoid casting bad spells
-			// Bad info from database can trigger this incorrectly, but that should be fixed in DB, not here
-			//return false;
-			continue;
-		}
 
-		if ((AIspells[i].priority == 0 && !bInnates) || (AIspells[i].priority != 0 && bInnates)) {
-			// so "innate" spells are special and spammed a bit
-			// we define an innate spell as a spell with priority 0
-			continue;
-		}
+	// only spells of the requested types and innate class are visited, in the same order the full list used to be walked
+	const std::vector<AISpellPlanEntry> &plan = GetAISpellPlan(iSpellTypes, bInnates);
+	const uint32 plan_generation = AIspells_generation;
+	for (const AISpellPlanEntry &entry : plan) {
+		// a quest reacting to a cast may have rewritten the list under us
+		if (plan_generation != AIspells_generation)
+			return false;
+
+		int i = entry.index;
 
 		// we reuse these fields for heal overrides
 		if (AIspells[i].type != SpellType_Heal && AIspells[i].min_hp != 0 && GetIntHPRatio() < AIspells[i].min_hp)
@@ -104,25 +101,10 @@ bool NPC::AICastSpell(Mob* tar, uint8 iChance, uint32 iSpellTypes, bool bInnates
 		if (AIspells[i].type != SpellType_Heal && AIspells[i].max_hp != 0 && GetIntHPRatio() > AIspells[i].max_hp)
 			continue;
 
-		if (iSpellTypes & AIspells[i].type) {
-			// manacost has special values, -1 is no mana cost, -2 is instant cast (no mana)
-			int32 mana_cost = AIspells[i].manacost;
-			if (mana_cost == -1)
-				mana_cost = spells[AIspells[i].spellid].mana;
-			else if (mana_cost == -2)
-				mana_cost = 0;
-			// this is ugly -- ignore distance for hatelist spells, looks like the client is only checking distance for some targettypes in CastSpell,
-			// should probably match that eventually. This should be good enough for now I guess ....
+		{
+			int32 mana_cost = entry.mana_cost;
 			if (
-				(
-				 (spells[AIspells[i].spellid].targettype == ST_HateList || spells[AIspells[i].spellid].targettype == ST_AETargetHateList) ||
-				 (
-				  // note: I think this check is actually wrong and we should be checking range instead in all cases, BUT if range is 0, range check is skipped? Works for now
-				  (spells[AIspells[i].spellid].targettype==ST_AECaster || spells[AIspells[i].spellid].targettype==ST_AEBard || spells[AIspells[i].spellid].targettype==ST_AEClientV1)
-				  && dist2 <= spells[AIspells[i].spellid].aoerange*spells[AIspells[i].spellid].aoerange
-				 ) ||
-				 dist2 <= spells[AIspells[i].spellid].range*spells[AIspells[i].spellid].range
-				 )
+				(entry.max_dist2 < 0.0f || dist2 <= entry.max_dist2)
 				&& (mana_cost <= GetMana() || GetMana() == GetMaxMana())
 				&& (AIspells[i].time_cancast + (zone->random.Int(0, 4) * 500)) <= Timer::GetCurrentTime() //break up the spelling casting over a period of time.
 				) {
@@ -370,6 +352,71 @@ bool NPC::AICastSpell(Mob* tar, uint8 iChance, uint32 iSpellTypes, bool bInnates
 	return false;
 }
 
+/**
+ * Candidates for AICastSpell, compiled once per spell type mask / innate flag and reused until AIspells changes
+ *
+ * @param iSpellTypes
+ * @param bInnates
+ * @return
+ */
+const std::vector<AISpellPlanEntry>& NPC::GetAISpellPlan(uint32 iSpellTypes, bool bInnates) {
+	if (AIspell_plans_generation != AIspells_generation) {
+		AIspell_plans.clear();
+		AIspell_plans_generation = AIspells_generation;
+	}
+
+	uint64 key = (static_cast<uint64>(iSpellTypes) << 1) | (bInnates ? 1 : 0);
+	auto iter = AIspell_plans.find(key);
+	if (iter != AIspell_plans.end())
+		return iter->second;
+
+	std::vector<AISpellPlanEntry> &plan = AIspell_plans[key];
+	for (int i = static_cast<int>(AIspells.size()) - 1; i >= 0; i--) {
+		if (AIspells[i].spellid <= 0 || AIspells[i].spellid >= SPDAT_RECORDS) {
+			// this is both to quit early to save cpu and to avoid casting bad spells
+			// Bad info from database can trigger this incorrectly, but that should be fixed in DB, not here
+			continue;
+		}
+
+		if ((AIspells[i].priority == 0 && !bInnates) || (AIspells[i].priority != 0 && bInnates)) {
+			// so "innate" spells are special and spammed a bit
+			// we define an innate spell as a spell with priority 0
+			continue;
+		}
+
+		if (!(iSpellTypes & AIspells[i].type))
+			continue;
+
+		const SPDat_Spell_Struct &spell = spells[AIspells[i].spellid];
+
+		AISpellPlanEntry entry;
+		entry.index = static_cast<uint16>(i);
+
+		// manacost has special values, -1 is no mana cost, -2 is instant cast (no mana)
+		entry.mana_cost = AIspells[i].manacost;
+		if (entry.mana_cost == -1)
+			entry.mana_cost = spell.mana;
+		else if (entry.mana_cost == -2)
+			entry.mana_cost = 0;
+
+		// this is ugly -- ignore distance for hatelist spells, looks like the client is only checking distance for some targettypes in CastSpell,
+		// should probably match that eventually. This should be good enough for now I guess ....
+		if (spell.targettype == ST_HateList || spell.targettype == ST_AETargetHateList) {
+			entry.max_dist2 = -1.0f;
+		}
+		else {
+			entry.max_dist2 = spell.range * spell.range;
+			// note: I think this check is actually wrong and we should be checking range instead in all cases, BUT if range is 0, range check is skipped? Works for now
+			if (spell.targettype == ST_AECaster || spell.targettype == ST_AEBard || spell.targettype == ST_AEClientV1)
+				entry.max_dist2 = std::max(entry.max_dist2, spell.aoerange * spell.aoerange);
+		}
+
+		plan.push_back(entry);
+	}
+
+	return plan;
+}
+
 bool NPC::AIDoSpellCast(uint8 i, Mob* tar, int32 mana_cost, uint32* oDontDoAgainBefore) {
 #if MobAI_DEBUG_Spells >= 1
 	LogAI("Mob::AIDoSpellCast: spellid = [{}], tar = [{}], mana = [{}], Name: [{}]", AIspells[i].spellid, tar->GetName(), mana_cost, spells[AIspells[i].spellid].name);
@@ -2489,6 +2536,7 @@ bool NPC::AI_AddNPCSpells(uint32 iDBSpellsID) {
 	// ok, this function should load the list, and the parent list then shove them into the struct and sort
 	npc_spells_id = iDBSpellsID;
 	AIspells.clear();
+	AIspells_generation++;
 	if (iDBSpellsID == 0) {
 		AIautocastspell_timer->Disable();
 		return false;
@@ -2621,6 +2669,7 @@ bool NPC::AI_AddNPCSpells(uint32 iDBSpellsID) {
 	std::sort(AIspells.begin(), AIspells.end(), [](const AISpells_Struct& a, const AISpells_Struct& b) {
 		return a.priority > b.priority;
 	});
+	AIspells_generation++;
 
 	if (IsValidSpell(attack_proc_spell)) {
 		AddProcToWeapon(attack_proc_spell, true, proc_chance);
@@ -2782,6 +2831,7 @@ void NPC::AddSpellToNPCList(int16 iPriority, int16 iSpellID, uint32 iType,
 	t.max_hp = max_hp;
 
 	AIspells.push_back(t);
+	AIspells_generation++;
 
 	// If we're going from an empty list, we need to start the timer
 	if (AIspells.size() == 1)
@@ -2796,6 +2846,7 @@ void NPC::RemoveSpellFromNPCList(int16 spell_id)
 		if((*iter).spellid == spell_id)
 		{
 			iter = AIspells.erase(iter);
+			AIspells_generation++;
 			continue;
 		}
 		++iter;
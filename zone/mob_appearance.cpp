@@ -364,8 +364,9 @@ uint32 NPC::GetEquippedItemFromTextureSlot(uint8 material_slot) const
 /**
  * NPCs typically use this function for sending appearance
  * @param one_client
+ * @return wear change packets sent
  */
-void Mob::SendArmorAppearance(Client *one_client)
+uint32 Mob::SendArmorAppearance(Client *one_client)
 {
 	/**
 	 * one_client of 0 means sent to all clients
@@ -382,22 +383,31 @@ void Mob::SendArmorAppearance(Client *one_client)
 		this->GetCleanName()
 	);
 
+	// a slot can qualify through both an equipped item and its texture profile, it only needs one packet
+	uint32 sent_slots = 0;
+	uint32 sent       = 0;
+
 	if (IsPlayerRace(race)) {
 		if (!IsClient()) {
 			for (uint8 i = 0; i <= EQ::textures::materialCount; ++i) {
 				const EQ::ItemData *item = database.GetItem(GetEquippedItemFromTextureSlot(i));
 				if (item != nullptr) {
 					SendWearChange(i, one_client);
+					sent_slots |= (1u << i);
+					sent++;
 				}
 			}
 		}
 	}
 
 	for (uint8 i = 0; i <= EQ::textures::materialCount; ++i) {
-		if (GetTextureProfileMaterial(i)) {
+		if (GetTextureProfileMaterial(i) && !(sent_slots & (1u << i))) {
 			SendWearChange(i, one_client);
+			sent++;
 		}
 	}
+
+	return sent;
 }
 
 /**
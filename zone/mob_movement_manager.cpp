@@ -11,10 +11,13 @@
 #include <vector>
 #include <deque>
 #include <map>
+#include <unordered_map>
+#include <algorithm>
+#include <cmath>
 #include <stdlib.h>
 
 extern double frame_time;
-extern Zone   *zone;
+extern Zone   *&zone;
 
 class IMovementCommand {
 public:
@@ -621,6 +624,7 @@ struct MovementStats {
 		TotalSentMovement = 0ULL;
 		TotalSentPosition = 0ULL;
 		TotalSentHeading  = 0ULL;
+		TotalThrottled    = 0ULL;
 	}
 
 	double   LastResetTime;
@@ -628,6 +632,7 @@ struct MovementStats {
 	uint64_t TotalSentMovement;
 	uint64_t TotalSentPosition;
 	uint64_t TotalSentHeading;
+	uint64_t TotalThrottled;
 };
 
 struct NavigateTo {
@@ -648,11 +653,99 @@ struct NavigateTo {
 };
 
 struct MobMovementEntry {
+	MobMovementEntry()
+	{
+		PathRequest      = 0;
+		MediumUpdateTime = 0;
+	}
+
 	std::deque<std::unique_ptr<IMovementCommand>> Commands;
 	NavigateTo                                    NavTo;
+	uint64                                        PathRequest;      // outstanding async ground path, 0 if none
+	uint32                                        MediumUpdateTime; // last moving update sent to the medium band
+};
+
+/**
+ * Uniform 2d grid of clients, cells are at least as wide as the largest update range so every client a
+ * close or medium update can reach is in the 3x3 block of cells around the mob
+ */
+class ClientGrid {
+public:
+	ClientGrid()
+	{
+		cell_size  = 0.0f;
+		built_time = 0;
+		dirty      = true;
+	}
+
+	void MarkDirty()
+	{
+		dirty = true;
+	}
+
+	/**
+	 * @param clients
+	 * @param size
+	 */
+	void Update(const std::vector<Client *> &clients, float size)
+	{
+		uint32 now = Timer::GetCurrentTime();
+		if (!dirty && now == built_time && size == cell_size) {
+			return;
+		}
+
+		for (auto &cell : cells) {
+			cell.second.clear();
+		}
+
+		cell_size  = size;
+		built_time = now;
+		dirty      = false;
+
+		for (auto &c : clients) {
+			cells[GetKey(CellOf(c->GetX()), CellOf(c->GetY()))].push_back(c);
+		}
+	}
+
+	/**
+	 * @param x
+	 * @param y
+	 * @param out
+	 */
+	void Query(float x, float y, std::vector<Client *> &out) const
+	{
+		out.clear();
+
+		int32 cell_x = CellOf(x);
+		int32 cell_y = CellOf(y);
+		for (int32 i = cell_x - 1; i <= cell_x + 1; ++i) {
+			for (int32 j = cell_y - 1; j <= cell_y + 1; ++j) {
+				auto iter = cells.find(GetKey(i, j));
+				if (iter != cells.end()) {
+					out.insert(out.end(), iter->second.begin(), iter->second.end());
+				}
+			}
+		}
+	}
+
+private:
+	int32 CellOf(float v) const
+	{
+		return static_cast<int32>(std::floor(v / cell_size));
+	}
+
+	static uint64 GetKey(int32 x, int32 y)
+	{
+		return (static_cast<uint64>(static_cast<uint32>(x)) << 32) | static_cast<uint32>(y);
+	}
+
+	std::unordered_map<uint64, std::vector<Client *>> cells;
+	float                                             cell_size;
+	uint32                                            built_time;
+	bool                                              dirty;
 };
 
-void AdjustRoute(std::list<IPathfinder::IPathNode> &nodes, Mob *who)
+void AdjustRoute(IPathfinder::IPath &nodes, Mob *who)
 {
 	if (!zone->HasMap() || !zone->HasWaterMap()) {
 		return;
@@ -660,8 +753,18 @@ void AdjustRoute(std::list<IPathfinder::IPathNode> &nodes, Mob *who)
 
 	auto offset = who->GetZOffset();
 
+	std::vector<glm::vec3> positions;
+	positions.reserve(nodes.size());
 	for (auto &node : nodes) {
-		if (!zone->watermap->InLiquid(node.pos)) {
+		positions.push_back(node.pos);
+	}
+
+	std::vector<bool> in_liquid;
+	zone->watermap->InLiquid(positions, in_liquid);
+
+	size_t i = 0;
+	for (auto &node : nodes) {
+		if (!in_liquid[i++]) {
 			auto best_z = zone->zonemap->FindBestZ(node.pos, nullptr);
 			if (best_z != BEST_Z_INVALID) {
 				node.pos.z = best_z + offset;
@@ -671,9 +774,17 @@ void AdjustRoute(std::list<IPathfinder::IPathNode> &nodes, Mob *who)
 }
 
 struct MobMovementManager::Implementation {
+	Implementation()
+	{
+		NextPathRequest = 0;
+	}
+
 	std::map<Mob *, MobMovementEntry> Entries;
 	std::vector<Client *>             Clients;
+	ClientGrid                        Grid;
+	std::vector<Client *>             NearbyClients; // scratch for grid queries
 	MovementStats                     Stats;
+	uint64                            NextPathRequest;
 };
 
 MobMovementManager::MobMovementManager()
@@ -726,6 +837,7 @@ void MobMovementManager::RemoveMob(Mob *mob)
 void MobMovementManager::AddClient(Client *client)
 {
 	_impl->Clients.push_back(client);
+	_impl->Grid.MarkDirty();
 }
 
 /**
@@ -737,6 +849,7 @@ void MobMovementManager::RemoveClient(Client *client)
 	while (iter != _impl->Clients.end()) {
 		if (client == *iter) {
 			_impl->Clients.erase(iter);
+			_impl->Grid.MarkDirty();
 			return;
 		}
 
@@ -774,6 +887,7 @@ void MobMovementManager::Teleport(Mob *who, float x, float y, float z, float hea
 	auto &ent = (*iter);
 
 	ent.second.Commands.clear();
+	ent.second.PathRequest = 0;
 
 	PushTeleportTo(ent.second, x, y, z, heading);
 }
@@ -807,9 +921,10 @@ void MobMovementManager::NavigateTo(Mob *who, float x, float y, float z, MobMove
 		);
 		auto heading_match = IsHeadingEqual(0.0, nav.navigate_to_heading);
 
-		if (false == within || false == heading_match || ent.second.Commands.size() == 0) {
-			ent.second.Commands.clear();
+		//an empty queue with a ground path still in flight for this destination just means the route hasn't arrived yet
+		auto idle = ent.second.Commands.size() == 0 && ent.second.PathRequest == 0;
 
+		if (false == within || false == heading_match || idle) {
 			//Path is no longer valid, calculate a new path
 			UpdatePath(who, x, y, z, mode);
 			nav.navigate_to_x       = x;
@@ -834,6 +949,7 @@ void MobMovementManager::StopNavigation(Mob *who)
 	nav.navigate_to_y       = 0.0;
 	nav.navigate_to_z       = 0.0;
 	nav.navigate_to_heading = 0.0;
+	ent.second.PathRequest  = 0;
 
 	if (true == ent.second.Commands.empty()) {
 		PushStopMoving(ent.second);
@@ -906,10 +1022,45 @@ void MobMovementManager::SendCommandToClients(
 		}
 	}
 	else {
-		float short_range = RuleR(Pathing, ShortMovementUpdateRange);
-		float long_range  = zone->GetNpcPositionUpdateDistance();
+		float short_range  = RuleR(Pathing, ShortMovementUpdateRange);
+		float long_range   = zone->GetNpcPositionUpdateDistance();
+		float short_range2 = short_range * short_range;
+		float long_range2  = long_range * long_range;
+
+		/**
+		 * Moving updates to the medium band are throttled per mob, the next update that does go out carries
+		 * the absolute position so skipped ones are coalesced rather than lost. Stops, position and heading
+		 * updates are always sent
+		 */
+		bool send_medium = true;
+		if (anim != 0 && (range & ClientRangeMedium)) {
+			int interval = RuleI(Pathing, MediumRangeUpdateIntervalMS);
+			if (interval > 0) {
+				auto ent = _impl->Entries.find(mob);
+				if (ent != _impl->Entries.end()) {
+					uint32 now = Timer::GetCurrentTime();
+					if (now - ent->second.MediumUpdateTime < static_cast<uint32>(interval)) {
+						send_medium = false;
+					}
+					else {
+						ent->second.MediumUpdateTime = now;
+					}
+				}
+			}
+		}
 
-		for (auto &c : _impl->Clients) {
+		/**
+		 * Clients past long range can only match ClientRangeLong, without it the grid narrows the candidates
+		 * down to the cells around the mob instead of every client in the zone
+		 */
+		const std::vector<Client *> *candidates = &_impl->Clients;
+		if (!(range & ClientRangeLong) && !single_client) {
+			_impl->Grid.Update(_impl->Clients, std::max(std::max(short_range, long_range), 100.0f));
+			_impl->Grid.Query(mob->GetX(), mob->GetY(), _impl->NearbyClients);
+			candidates = &_impl->NearbyClients;
+		}
+
+		for (auto &c : *candidates) {
 			if (single_client && c != single_client) {
 				continue;
 			}
@@ -918,23 +1069,31 @@ void MobMovementManager::SendCommandToClients(
 				continue;
 			}
 
-			float distance = c->CalculateDistance(mob->GetX(), mob->GetY(), mob->GetZ());
+			float dx        = c->GetX() - mob->GetX();
+			float dy        = c->GetY() - mob->GetY();
+			float dz        = c->GetZ() - mob->GetZ();
+			float distance2 = dx * dx + dy * dy + dz * dz;
 
 			bool match = false;
 			if (range & ClientRangeClose) {
-				if (distance < short_range) {
+				if (distance2 < short_range2) {
 					match = true;
 				}
 			}
 
 			if (!match && range & ClientRangeMedium) {
-				if (distance >= short_range && distance < long_range) {
+				if (distance2 >= short_range2 && distance2 < long_range2) {
+					if (!send_medium) {
+						_impl->Stats.TotalThrottled++;
+						continue;
+					}
+
 					match = true;
 				}
 			}
 
 			if (!match && range & ClientRangeLong) {
-				if (distance >= long_range) {
+				if (distance2 >= long_range2) {
 					match = true;
 				}
 			}
@@ -1009,6 +1168,12 @@ void MobMovementManager::DumpStats(Client *client)
 		_impl->Stats.TotalSentPosition,
 		static_cast<double>(_impl->Stats.TotalSentPosition) / total_time
 	);
+	client->Message(
+		Chat::System,
+		"Total Throttled: %u (%.2f / sec)",
+		_impl->Stats.TotalThrottled,
+		static_cast<double>(_impl->Stats.TotalThrottled) / total_time
+	);
 }
 
 void MobMovementManager::ClearStats()
@@ -1018,6 +1183,7 @@ void MobMovementManager::ClearStats()
 	_impl->Stats.TotalSentHeading  = 0;
 	_impl->Stats.TotalSentMovement = 0;
 	_impl->Stats.TotalSentPosition = 0;
+	_impl->Stats.TotalThrottled    = 0;
 }
 
 /**
@@ -1063,28 +1229,32 @@ void MobMovementManager::UpdatePath(Mob *who, float x, float y, float z, MobMove
 {
 	Mob *target=who->GetTarget();
 
-	if (!zone->HasMap() || !zone->HasWaterMap()) {
-		auto iter = _impl->Entries.find(who);
-		auto &ent = (*iter);
+	auto iter = _impl->Entries.find(who);
+	auto &ent = (*iter);
 
+	//any ground path still in flight is for a stale destination now
+	ent.second.PathRequest = 0;
+
+	if (!zone->HasMap() || !zone->HasWaterMap()) {
+		ent.second.Commands.clear();
 		PushMoveTo(ent.second, x, y, z, mob_movement_mode);
 		PushStopMoving(ent.second);
 		return;
 	}
 
 	if (who->IsBoat()) {
+		ent.second.Commands.clear();
 		UpdatePathBoat(who, x, y, z, mob_movement_mode);
 	}
 	else if (who->IsUnderwaterOnly()) {
+		ent.second.Commands.clear();
 		UpdatePathUnderwater(who, x, y, z, mob_movement_mode);
 	}
 	// If we can fly, and we have a target and we have LoS, simply fly to them.
 	// if we ever lose LoS we go back to mesh run mode.
 	else if (target && who->GetFlyMode() == GravityBehavior::Flying &&
 				who->CheckLosFN(x,y,z,target->GetSize())) {
-		auto iter = _impl->Entries.find(who);
-		auto &ent = (*iter);
-
+		ent.second.Commands.clear();
 		PushFlyTo(ent.second, x, y, z, mob_movement_mode);
 		PushStopMoving(ent.second);
 		}
@@ -1093,13 +1263,12 @@ void MobMovementManager::UpdatePath(Mob *who, float x, float y, float z, MobMove
 			 zone->watermap->InLiquid(who->GetPosition()) && 
 			 zone->watermap->InLiquid(glm::vec3(x, y, z)) &&
 			 zone->zonemap->CheckLoS(who->GetPosition(), glm::vec3(x, y, z))) {
-		auto iter = _impl->Entries.find(who);
-		auto &ent = (*iter);
-
+		ent.second.Commands.clear();
 		PushSwimTo(ent.second, x, y, z, mob_movement_mode);
 		PushStopMoving(ent.second);
 	}
 	else {
+		// clears the command queue itself once the route is known
 		UpdatePathGround(who, x, y, z, mob_movement_mode);
 	}
 }
@@ -1120,16 +1289,58 @@ void MobMovementManager::UpdatePathGround(Mob *who, float x, float y, float z, M
 	opts.flags       = PathingNotDisabled ^ PathingZoneLine;
 
 	//This is probably pointless since the nav mesh tool currently sets zonelines to disabled anyway
-	auto partial = false;
-	auto stuck   = false;
-	auto route   = zone->pathing->FindPath(
+	auto eiter = _impl->Entries.find(who);
+	auto &ent  = (*eiter);
+
+	if (!RuleB(Pathing, AsyncPathfinding)) {
+		auto partial = false;
+		auto stuck   = false;
+		auto route   = zone->pathing->FindPath(
+			glm::vec3(who->GetX(), who->GetY(), who->GetZ()),
+			glm::vec3(x, y, z),
+			partial,
+			stuck,
+			opts
+		);
+
+		ent.second.Commands.clear();
+		ApplyPathGround(who, x, y, z, mode, route, stuck);
+		return;
+	}
+
+	//the mob keeps running its current commands until the route comes back from the worker
+	auto request = ++_impl->NextPathRequest;
+	ent.second.PathRequest = request;
+
+	zone->pathing->FindPathAsync(
 		glm::vec3(who->GetX(), who->GetY(), who->GetZ()),
 		glm::vec3(x, y, z),
-		partial,
-		stuck,
-		opts
+		opts,
+		[this, who, x, y, z, mode, request](IPathfinder::IPath &route, bool partial, bool stuck) {
+			//the mob may have been removed, re-pathed or stopped while the query ran
+			auto eiter = _impl->Entries.find(who);
+			if (eiter == _impl->Entries.end() || eiter->second.PathRequest != request) {
+				return;
+			}
+
+			eiter->second.PathRequest = 0;
+			eiter->second.Commands.clear();
+			ApplyPathGround(who, x, y, z, mode, route, stuck);
+		}
 	);
+}
 
+/**
+ * @param who
+ * @param x
+ * @param y
+ * @param z
+ * @param mode
+ * @param route
+ * @param stuck
+ */
+void MobMovementManager::ApplyPathGround(Mob *who, float x, float y, float z, MobMovementMode mode, IPathfinder::IPath &route, bool stuck)
+{
 	auto eiter = _impl->Entries.find(who);
 	auto &ent  = (*eiter);
 
@@ -1254,8 +1465,11 @@ void MobMovementManager::UpdatePathUnderwater(Mob *who, float x, float y, float
 {
 	auto eiter = _impl->Entries.find(who);
 	auto &ent  = (*eiter);
-	if (zone->watermap->InLiquid(who->GetPosition()) && zone->watermap->InLiquid(glm::vec3(x, y, z)) &&
-		zone->zonemap->CheckLoS(who->GetPosition(), glm::vec3(x, y, z))) {
+
+	std::vector<bool> in_liquid;
+	zone->watermap->InLiquid({ glm::vec3(who->GetPosition()), glm::vec3(x, y, z) }, in_liquid);
+
+	if (in_liquid[0] && in_liquid[1] && zone->zonemap->CheckLoS(who->GetPosition(), glm::vec3(x, y, z))) {
 		PushSwimTo(ent.second, x, y, z, movement_mode);
 		PushStopMoving(ent.second);
 		return;
@@ -1288,16 +1502,20 @@ void MobMovementManager::UpdatePathUnderwater(Mob *who, float x, float y, float
 	glm::vec3 previous_pos(who->GetX(), who->GetY(), who->GetZ());
 	bool      first_node = true;
 
-	while (iter != route.end()) {
-		auto &current_node = (*iter);
+	std::vector<glm::vec3> positions;
+	positions.reserve(route.size());
+	for (auto &node : route) {
+		positions.push_back(node.pos);
+	}
 
-		if (!zone->watermap->InLiquid(current_node.pos)) {
-			stuck = true;
+	zone->watermap->InLiquid(positions, in_liquid);
 
-			while (iter != route.end()) {
-				iter = route.erase(iter);
-			}
+	size_t node_index = 0;
+	while (iter != route.end()) {
+		if (!in_liquid[node_index++]) {
+			stuck = true;
 
+			route.erase(iter, route.end());
 			break;
 		}
 		else {
@@ -1,5 +1,6 @@
 #pragma once
 #include <memory>
+#include "pathfinder_interface.h"
 
 class Mob;
 class Client;
@@ -80,6 +81,7 @@ private:
 	void FillCommandStruct(PlayerPositionUpdateServer_Struct *position_update, Mob *mob, float delta_x, float delta_y, float delta_z, float delta_heading, int anim);
 	void UpdatePath(Mob *who, float x, float y, float z, MobMovementMode mob_movement_mode);
 	void UpdatePathGround(Mob *who, float x, float y, float z, MobMovementMode mode);
+	void ApplyPathGround(Mob *who, float x, float y, float z, MobMovementMode mode, IPathfinder::IPath &route, bool stuck);
 	void UpdatePathUnderwater(Mob *who, float x, float y, float z, MobMovementMode movement_mode);
 	void UpdatePathBoat(Mob *who, float x, float y, float z, MobMovementMode mode);
 	void PushTeleportTo(MobMovementEntry &ent, float x, float y, float z, float heading);
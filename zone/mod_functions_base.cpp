@@ -19,10 +19,10 @@
 #include <string>
 #include <iostream>
 
-extern EntityList entity_list;
-extern Zone* zone;
+extern EntityList &entity_list;
+extern Zone*& zone;
 
-extern WorldServer worldserver;
+extern WorldServer &worldserver;
 
 //All functions that modify a value are passed the value as it was computed by default formulas and bonuses.  In most cases this should be the final value that will be used.
 
@@ -55,9 +55,9 @@
 #include <pthread.h>
 #endif
 
-extern Zone* zone;
+extern Zone*& zone;
 extern volatile bool is_zone_loaded;
-extern EntityList entity_list;
+extern EntityList &entity_list;
 
 NPC::NPC(const NPCType *npc_type_data, Spawn2 *in_respawn, const glm::vec4 &position, GravityBehavior iflymode, bool IsCorpse)
 	: Mob(
@@ -261,6 +261,8 @@ NPC::NPC(const NPCType *npc_type_data, Spawn2 *in_respawn, const glm::vec4 &posi
 
 	npc_spells_id        = 0;
 	HasAISpell           = false;
+	AIspells_generation  = 0;
+	AIspell_plans_generation = 0;
 	HasAISpellEffects    = false;
 	innate_proc_spell_id = 0;
 
@@ -1395,6 +1397,7 @@ uint32 ZoneDatabase::CreateNewNPCCommand(
 
 	spawn->SetSpawnGroupId(spawngroupid);
 	spawn->SetNPCTypeID(npc_type_id);
+	entity_list.ReindexNPC(spawn);
 
 	query = StringFormat("INSERT INTO spawn2 (zone, version, x, y, z, respawntime, heading, spawngroupID) "
 			     "VALUES('%s', %u, %f, %f, %f, %i, %f, %i)",
@@ -2616,6 +2619,12 @@ uint32 NPC::GetSpawnPointID() const
 	return 0;
 }
 
+void NPC::SetSpawnGroupId(uint32 sg2)
+{
+	spawn_group_id = sg2;
+	entity_list.ReindexNPC(this);
+}
+
 void NPC::NPCSlotTexture(uint8 slot, uint16 texture)
 {
 	if (slot == 7) {
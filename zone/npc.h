@@ -29,6 +29,7 @@
 
 #include <deque>
 #include <list>
+#include <unordered_map>
 
 
 #ifdef _WINDOWS
@@ -68,6 +69,13 @@ struct AISpells_Struct {
 	int8	max_hp; // >0 won't cast if HP is above
 };
 
+// One candidate of a compiled cast plan, the static parts of the AICastSpell checks resolved up front
+struct AISpellPlanEntry {
+	uint16	index;			// slot in AIspells
+	int32	mana_cost;		// manacost with the -1 / -2 special values resolved
+	float	max_dist2;		// squared cast distance, negative when distance is not checked
+};
+
 struct AISpellsEffects_Struct {
 	uint16	spelleffectid;
 	int32	base;
@@ -220,7 +228,7 @@ public:
 
 	virtual int32 CalcMaxMana();
 	void SetGrid(int32 grid_){ grid=grid_; }
-	void SetSpawnGroupId(uint32 sg2){ spawn_group_id =sg2; }
+	void SetSpawnGroupId(uint32 sg2);
 	void SetWaypointMax(uint16 wp_){ wp_m=wp_; }
 	void SetSaveWaypoint(uint16 wp_){ save_wp=wp_; }
 
@@ -534,6 +542,10 @@ protected:
 
 	uint32*	pDontCastBefore_casting_spell;
 	std::vector<AISpells_Struct> AIspells;
+	uint32 AIspells_generation; // bumped whenever AIspells changes so derived caches can tell they are stale
+	uint32 AIspell_plans_generation;
+	std::unordered_map<uint64, std::vector<AISpellPlanEntry>> AIspell_plans; // keyed by requested spell types and innate flag
+	const std::vector<AISpellPlanEntry>& GetAISpellPlan(uint32 iSpellTypes, bool bInnates);
 	bool HasAISpell;
 	virtual bool AICastSpell(Mob* tar, uint8 iChance, uint32 iSpellTypes, bool bInnates = false);
 	virtual bool AIDoSpellCast(uint8 i, Mob* tar, int32 mana_cost, uint32* oDontDoAgainBefore = 0);
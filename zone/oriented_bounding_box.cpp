@@ -1,6 +1,7 @@
 #include "oriented_bounding_box.h"
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtx/transform.hpp>
+#include <algorithm>
 
 glm::mat4 CreateRotateMatrix(float rx, float ry, float rz) {
 	glm::mat4 rot_x(1.0f);
@@ -81,6 +82,26 @@ OrientedBoundingBox::OrientedBoundingBox(const glm::vec3 &pos, const glm::vec3 &
 	inverted_transformation = glm::inverse(transformation);
 }
 
+void OrientedBoundingBox::GetAxisAlignedBounds(glm::vec3 &min, glm::vec3 &max) const {
+	for (int i = 0; i < 8; ++i) {
+		glm::vec4 corner((i & 1) ? max_x : min_x, (i & 2) ? max_y : min_y, (i & 4) ? max_z : min_z, 1.0f);
+		glm::vec4 world_corner = transformation * corner;
+
+		if (i == 0) {
+			min = glm::vec3(world_corner.x, world_corner.y, world_corner.z);
+			max = min;
+			continue;
+		}
+
+		min.x = std::min(min.x, world_corner.x);
+		min.y = std::min(min.y, world_corner.y);
+		min.z = std::min(min.z, world_corner.z);
+		max.x = std::max(max.x, world_corner.x);
+		max.y = std::max(max.y, world_corner.y);
+		max.z = std::max(max.z, world_corner.z);
+	}
+}
+
 bool OrientedBoundingBox::ContainsPoint(const glm::vec3 &p) const {
 	glm::vec4 pt(p.x, p.y, p.z, 1);
 	glm::vec4 box_space_p = inverted_transformation * pt;
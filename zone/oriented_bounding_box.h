@@ -12,6 +12,7 @@ public:
 	~OrientedBoundingBox() { }
 
 	bool ContainsPoint(const glm::vec3 &p) const;
+	void GetAxisAlignedBounds(glm::vec3 &min, glm::vec3 &max) const;
 	
 	glm::mat4& GetTransformation() { return transformation; }
 	glm::mat4& GetInvertedTransformation() { return inverted_transformation; }
@@ -15,3 +15,11 @@ IPathfinder *IPathfinder::Load(const std::string &zone) {
 	
 	return new PathfinderNull();
 }
+
+void IPathfinder::FindPathAsync(const glm::vec3 &start, const glm::vec3 &end, const PathfinderOptions &opts, PathCallback callback)
+{
+	bool partial = false;
+	bool stuck = false;
+	auto route = FindPath(start, end, partial, stuck, opts);
+	callback(route, partial, stuck);
+}
@@ -1,7 +1,9 @@
 #pragma once
 
 #include "map.h"
+#include <functional>
 #include <list>
+#include <vector>
 
 class Client;
 class Seperator;
@@ -68,13 +70,15 @@ public:
 		bool teleport;
 	};
 
-	typedef std::list<IPathNode> IPath;
+	typedef std::vector<IPathNode> IPath;
+	typedef std::function<void(IPath &route, bool partial, bool stuck)> PathCallback;
 
 	IPathfinder() { }
 	virtual ~IPathfinder() { }
 
 	virtual IPath FindRoute(const glm::vec3 &start, const glm::vec3 &end, bool &partial, bool &stuck, int flags = PathingNotDisabled) = 0;
 	virtual IPath FindPath(const glm::vec3 &start, const glm::vec3 &end, bool &partial, bool &stuck, const PathfinderOptions& opts) = 0;
+	virtual void FindPathAsync(const glm::vec3 &start, const glm::vec3 &end, const PathfinderOptions& opts, PathCallback callback);
 	virtual glm::vec3 GetRandomLocation(const glm::vec3 &start) = 0;
 	virtual void DebugCommand(Client *c, const Seperator *sep) = 0;
 
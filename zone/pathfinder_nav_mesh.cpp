@@ -1,5 +1,10 @@
+#include <algorithm>
 #include <memory>
+#include <mutex>
+#include <list>
+#include <unordered_map>
 #include <stdio.h>
+#include <string.h>
 #include <vector>
 #include "pathfinder_nav_mesh.h"
 #include <DetourCommon.h>
@@ -9,26 +14,204 @@
 #include "water_map.h"
 #include "client.h"
 #include "../common/compression.h"
+#include "../common/event/task.h"
 
-extern Zone *zone;
+extern Zone *&zone;
 
-struct PathfinderNavmesh::Implementation
+static const int max_route_polys = 1024;
+static const int max_path_polys = 256;
+static const int max_straight_path = 2048;
+
+//A navmesh query plus its scratch buffers, only ever used by one thread at a time
+struct PathQuery
 {
-	dtNavMesh *nav_mesh;
+	PathQuery() {
+		query = dtAllocNavMeshQuery();
+		max_nodes = 0;
+		path.resize(max_route_polys);
+		straight_path.resize(max_straight_path);
+		straight_path_flags.resize(max_straight_path);
+		straight_path_polys.resize(max_straight_path);
+	}
+
+	~PathQuery() {
+		dtFreeNavMeshQuery(query);
+	}
+
 	dtNavMeshQuery *query;
+	int max_nodes;
+	std::vector<dtPolyRef> path;
+	std::vector<glm::vec3> straight_path;
+	std::vector<unsigned char> straight_path_flags;
+	std::vector<dtPolyRef> straight_path_polys;
+};
+
+struct PathCacheKey
+{
+	dtPolyRef start_ref;
+	dtPolyRef end_ref;
+	int flags;
+	float flag_cost[10];
+
+	bool operator==(const PathCacheKey &o) const {
+		return start_ref == o.start_ref && end_ref == o.end_ref && flags == o.flags &&
+			memcmp(flag_cost, o.flag_cost, sizeof(flag_cost)) == 0;
+	}
+};
+
+struct PathCacheKeyHash
+{
+	size_t operator()(const PathCacheKey &k) const {
+		size_t h = std::hash<dtPolyRef>()(k.start_ref);
+		h = h * 31 + std::hash<dtPolyRef>()(k.end_ref);
+		h = h * 31 + std::hash<int>()(k.flags);
+		return h;
+	}
+};
+
+struct PathCacheEntry
+{
+	PathCacheKey key;
+	std::vector<dtPolyRef> corridor;
+};
+
+struct PathResult
+{
+	IPathfinder::IPath route;
+	bool partial;
+	bool stuck;
+};
+
+struct PathfinderNavmesh::Implementation
+{
+	~Implementation() {
+		Clear();
+	}
+
+	void Clear();
+	std::unique_ptr<PathQuery> AcquireQuery(int max_nodes);
+	void ReleaseQuery(std::unique_ptr<PathQuery> query);
+	bool GetCachedCorridor(const PathCacheKey &key, std::vector<dtPolyRef> &corridor);
+	void CacheCorridor(const PathCacheKey &key, const dtPolyRef *corridor, int count, size_t capacity);
+	IPath FindPath(PathQuery &q, const glm::vec3 &start, const glm::vec3 &end, bool &partial, bool &stuck, const PathfinderOptions &opts, size_t cache_size);
+	dtStatus GetPolyHeightNoConnections(dtPolyRef ref, const float *pos, float *height) const;
+	dtStatus GetPolyHeightOnPath(const dtPolyRef *path, const int path_len, const glm::vec3 &pos, float *h) const;
+
+	dtNavMesh *nav_mesh = nullptr;
+
+	std::mutex query_lock;
+	std::vector<std::unique_ptr<PathQuery>> queries;
+	size_t queries_allocated = 0;
+
+	std::mutex cache_lock;
+	std::list<PathCacheEntry> cache_order;
+	std::unordered_map<PathCacheKey, std::list<PathCacheEntry>::iterator, PathCacheKeyHash> cache;
+	uint64 cache_hits = 0;
+	uint64 cache_misses = 0;
 };
 
+void PathfinderNavmesh::Implementation::Clear()
+{
+	{
+		std::lock_guard<std::mutex> lock(query_lock);
+		queries.clear();
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(cache_lock);
+		cache.clear();
+		cache_order.clear();
+	}
+
+	if (nav_mesh) {
+		dtFreeNavMesh(nav_mesh);
+		nav_mesh = nullptr;
+	}
+}
+
+std::unique_ptr<PathQuery> PathfinderNavmesh::Implementation::AcquireQuery(int max_nodes)
+{
+	std::unique_ptr<PathQuery> q;
+
+	{
+		std::lock_guard<std::mutex> lock(query_lock);
+		if (!queries.empty()) {
+			q = std::move(queries.back());
+			queries.pop_back();
+		}
+		else {
+			queries_allocated++;
+		}
+	}
+
+	if (!q) {
+		q.reset(new PathQuery());
+	}
+
+	//findPath resets the node pool itself, so a query only needs init when it is new or the node limit changed
+	if (q->max_nodes != max_nodes) {
+		q->query->init(nav_mesh, max_nodes);
+		q->max_nodes = max_nodes;
+	}
+
+	return q;
+}
+
+void PathfinderNavmesh::Implementation::ReleaseQuery(std::unique_ptr<PathQuery> query)
+{
+	std::lock_guard<std::mutex> lock(query_lock);
+	queries.push_back(std::move(query));
+}
+
+bool PathfinderNavmesh::Implementation::GetCachedCorridor(const PathCacheKey &key, std::vector<dtPolyRef> &corridor)
+{
+	std::lock_guard<std::mutex> lock(cache_lock);
+	auto iter = cache.find(key);
+	if (iter == cache.end()) {
+		cache_misses++;
+		return false;
+	}
+
+	cache_hits++;
+	cache_order.splice(cache_order.begin(), cache_order, iter->second);
+	corridor = iter->second->corridor;
+	return true;
+}
+
+void PathfinderNavmesh::Implementation::CacheCorridor(const PathCacheKey &key, const dtPolyRef *corridor, int count, size_t capacity)
+{
+	if (capacity == 0) {
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(cache_lock);
+	auto iter = cache.find(key);
+	if (iter != cache.end()) {
+		iter->second->corridor.assign(corridor, corridor + count);
+		cache_order.splice(cache_order.begin(), cache_order, iter->second);
+		return;
+	}
+
+	while (cache.size() >= capacity) {
+		cache.erase(cache_order.back().key);
+		cache_order.pop_back();
+	}
+
+	PathCacheEntry entry;
+	entry.key = key;
+	entry.corridor.assign(corridor, corridor + count);
+	cache_order.push_front(std::move(entry));
+	cache[key] = cache_order.begin();
+}
+
 PathfinderNavmesh::PathfinderNavmesh(const std::string &path)
 {
-	m_impl.reset(new Implementation());
-	m_impl->nav_mesh = nullptr;
-	m_impl->query = nullptr;
+	m_impl = std::make_shared<Implementation>();
 	Load(path);
 }
 
 PathfinderNavmesh::~PathfinderNavmesh()
 {
-	Clear();
 }
 
 IPathfinder::IPath PathfinderNavmesh::FindRoute(const glm::vec3 &start, const glm::vec3 &end, bool &partial, bool &stuck, int flags)
@@ -39,11 +222,8 @@ IPathfinder::IPath PathfinderNavmesh::FindRoute(const glm::vec3 &start, const gl
 		return IPath();
 	}
 	
-	if (!m_impl->query) {
-		m_impl->query = dtAllocNavMeshQuery();
-	}
-	
-	m_impl->query->init(m_impl->nav_mesh, RuleI(Pathing, MaxNavmeshNodes));
+	auto q = m_impl->AcquireQuery(RuleI(Pathing, MaxNavmeshNodes));
+	auto query = q->query;
 	glm::vec3 current_location(start.x, start.z, start.y);
 	glm::vec3 dest_location(end.x, end.z, end.y);
 	
@@ -64,21 +244,23 @@ IPathfinder::IPath PathfinderNavmesh::FindRoute(const glm::vec3 &start, const gl
 	dtPolyRef end_ref;
 	glm::vec3 ext(5.0f, 100.0f, 5.0f);
 	
-	m_impl->query->findNearestPoly(&current_location[0], &ext[0], &filter, &start_ref, 0);
-	m_impl->query->findNearestPoly(&dest_location[0], &ext[0], &filter, &end_ref, 0);
+	query->findNearestPoly(&current_location[0], &ext[0], &filter, &start_ref, 0);
+	query->findNearestPoly(&dest_location[0], &ext[0], &filter, &end_ref, 0);
 	
 	if (!start_ref || !end_ref) {
+		m_impl->ReleaseQuery(std::move(q));
 		return IPath();
 	}
 	
 	int npoly = 0;
-	dtPolyRef path[1024] = { 0 };
-	auto status = m_impl->query->findPath(start_ref, end_ref, &current_location[0], &dest_location[0], &filter, path, &npoly, 1024);
+	dtPolyRef *path = &q->path[0];
+	auto status = query->findPath(start_ref, end_ref, &current_location[0], &dest_location[0], &filter, path, &npoly, max_route_polys);
 	
+	IPath Route;
 	if (npoly) {
 		glm::vec3 epos = dest_location;
 		if (path[npoly - 1] != end_ref) {
-			m_impl->query->closestPointOnPoly(path[npoly - 1], &dest_location[0], &epos[0], 0);
+			query->closestPointOnPoly(path[npoly - 1], &dest_location[0], &epos[0], 0);
 			partial = true;
 	
 			auto dist = DistanceSquared(epos, current_location);
@@ -87,22 +269,21 @@ IPathfinder::IPath PathfinderNavmesh::FindRoute(const glm::vec3 &start, const gl
 			}
 		}
 	
-		float straight_path[2048 * 3];
-		unsigned char straight_path_flags[2048];
-	
+		auto straight_path = (float*)&q->straight_path[0];
+		auto straight_path_polys = &q->straight_path_polys[0];
 		int n_straight_polys;
-		dtPolyRef straight_path_polys[2048];
 	
-		status = m_impl->query->findStraightPath(&current_location[0], &epos[0], path, npoly,
-			straight_path, straight_path_flags,
-			straight_path_polys, &n_straight_polys, 2048, DT_STRAIGHTPATH_AREA_CROSSINGS);
+		status = query->findStraightPath(&current_location[0], &epos[0], path, npoly,
+			straight_path, &q->straight_path_flags[0],
+			straight_path_polys, &n_straight_polys, max_straight_path, DT_STRAIGHTPATH_AREA_CROSSINGS);
 	
 		if (dtStatusFailed(status)) {
+			m_impl->ReleaseQuery(std::move(q));
 			return IPath();
 		}
 	
 		if (n_straight_polys) {
-			IPath Route;
+			Route.reserve(n_straight_polys);
 			for (int i = 0; i < n_straight_polys; ++i)
 			{
 				glm::vec3 node;
@@ -120,11 +301,12 @@ IPathfinder::IPath PathfinderNavmesh::FindRoute(const glm::vec3 &start, const gl
 				}
 			}
 	
+			m_impl->ReleaseQuery(std::move(q));
 			return Route;
 		}
 	}
 	
-	IPath Route;
+	m_impl->ReleaseQuery(std::move(q));
 	Route.push_back(end);
 	return Route;
 }
@@ -137,11 +319,46 @@ IPathfinder::IPath PathfinderNavmesh::FindPath(const glm::vec3 &start, const glm
 		return IPath();
 	}
 	
-	if (!m_impl->query) {
-		m_impl->query = dtAllocNavMeshQuery();
+	auto q = m_impl->AcquireQuery(RuleI(Pathing, MaxNavmeshNodes));
+	auto route = m_impl->FindPath(*q, start, end, partial, stuck, opts, RuleI(Pathing, PathCacheSize));
+	m_impl->ReleaseQuery(std::move(q));
+	return route;
+}
+
+void PathfinderNavmesh::FindPathAsync(const glm::vec3 &start, const glm::vec3 &end, const PathfinderOptions &opts, PathCallback callback)
+{
+	if (!m_impl->nav_mesh) {
+		IPath route;
+		callback(route, false, false);
+		return;
 	}
-	
-	m_impl->query->init(m_impl->nav_mesh, RuleI(Pathing, MaxNavmeshNodes));
+
+	//rules are read here on the zone thread, the worker only sees copies
+	auto impl = m_impl;
+	int max_nodes = RuleI(Pathing, MaxNavmeshNodes);
+	size_t cache_size = RuleI(Pathing, PathCacheSize);
+
+	EQ::Task([=](EQ::Task::ResolveFn resolve, EQ::Task::RejectFn reject) {
+		PathResult result;
+		result.partial = false;
+		result.stuck = false;
+
+		auto q = impl->AcquireQuery(max_nodes);
+		result.route = impl->FindPath(*q, start, end, result.partial, result.stuck, opts, cache_size);
+		impl->ReleaseQuery(std::move(q));
+
+		resolve(result);
+	})
+	.Then([callback](const EQ::Any &r) {
+		auto result = EQ::any_cast<PathResult>(r);
+		callback(result.route, result.partial, result.stuck);
+	})
+	.Run();
+}
+
+IPathfinder::IPath PathfinderNavmesh::Implementation::FindPath(PathQuery &q, const glm::vec3 &start, const glm::vec3 &end, bool &partial, bool &stuck, const PathfinderOptions &opts, size_t cache_size)
+{
+	auto query = q.query;
 	glm::vec3 current_location(start.x, start.z, start.y);
 	glm::vec3 dest_location(end.x, end.z, end.y);
 	
@@ -158,26 +375,42 @@ IPathfinder::IPath PathfinderNavmesh::FindPath(const glm::vec3 &start, const glm
 	filter.setAreaCost(9, opts.flag_cost[8]); //Portal
 	filter.setAreaCost(10, opts.flag_cost[9]); //Prefer
 	
-	static const int max_polys = 256;
 	dtPolyRef start_ref;
 	dtPolyRef end_ref;
 	glm::vec3 ext(10.0f, 200.0f, 10.0f);
 	
-	m_impl->query->findNearestPoly(&current_location[0], &ext[0], &filter, &start_ref, 0);
-	m_impl->query->findNearestPoly(&dest_location[0], &ext[0], &filter, &end_ref, 0);
+	query->findNearestPoly(&current_location[0], &ext[0], &filter, &start_ref, 0);
+	query->findNearestPoly(&dest_location[0], &ext[0], &filter, &end_ref, 0);
 	
 	if (!start_ref || !end_ref) {
 		return IPath();
 	}
 	
+	//the corridor only depends on the poly pair and filter, so repeat trips skip the A* search
+	PathCacheKey key;
+	key.start_ref = start_ref;
+	key.end_ref = end_ref;
+	key.flags = opts.flags;
+	memcpy(key.flag_cost, opts.flag_cost, sizeof(key.flag_cost));
+
 	int npoly = 0;
-	dtPolyRef path[max_polys] = { 0 };
-	auto status = m_impl->query->findPath(start_ref, end_ref, &current_location[0], &dest_location[0], &filter, path, &npoly, max_polys);
+	dtPolyRef *path = &q.path[0];
+	std::vector<dtPolyRef> cached;
+	if (cache_size > 0 && GetCachedCorridor(key, cached)) {
+		npoly = (int)cached.size();
+		std::copy(cached.begin(), cached.end(), path);
+	}
+	else {
+		query->findPath(start_ref, end_ref, &current_location[0], &dest_location[0], &filter, path, &npoly, max_path_polys);
+		if (npoly) {
+			CacheCorridor(key, path, npoly, cache_size);
+		}
+	}
 	
 	if (npoly) {
 		glm::vec3 epos = dest_location;
 		if (path[npoly - 1] != end_ref) {
-			m_impl->query->closestPointOnPoly(path[npoly - 1], &dest_location[0], &epos[0], 0);
+			query->closestPointOnPoly(path[npoly - 1], &dest_location[0], &epos[0], 0);
 			partial = true;
 			
 			auto dist = DistanceSquared(epos, current_location);
@@ -187,13 +420,13 @@ IPathfinder::IPath PathfinderNavmesh::FindPath(const glm::vec3 &start, const glm
 		}
 	
 		int n_straight_polys;
-		glm::vec3 straight_path[max_polys];
-		unsigned char straight_path_flags[max_polys];
-		dtPolyRef straight_path_polys[max_polys];
+		glm::vec3 *straight_path = &q.straight_path[0];
+		unsigned char *straight_path_flags = &q.straight_path_flags[0];
+		dtPolyRef *straight_path_polys = &q.straight_path_polys[0];
 	
-		auto status = m_impl->query->findStraightPath(&current_location[0], &epos[0], path, npoly,
+		auto status = query->findStraightPath(&current_location[0], &epos[0], path, npoly,
 			(float*)&straight_path[0], straight_path_flags,
-			straight_path_polys, &n_straight_polys, 2048, DT_STRAIGHTPATH_AREA_CROSSINGS | DT_STRAIGHTPATH_ALL_CROSSINGS);
+			straight_path_polys, &n_straight_polys, max_straight_path, DT_STRAIGHTPATH_AREA_CROSSINGS | DT_STRAIGHTPATH_ALL_CROSSINGS);
 	
 		if (dtStatusFailed(status)) {
 			return IPath();
@@ -202,6 +435,7 @@ IPathfinder::IPath PathfinderNavmesh::FindPath(const glm::vec3 &start, const glm
 		if (n_straight_polys) {
 			if (opts.smooth_path) {
 				IPath Route;
+				Route.reserve(n_straight_polys);
 	
 				//Add the first point
 				{
@@ -228,14 +462,12 @@ IPathfinder::IPath PathfinderNavmesh::FindPath(const glm::vec3 &start, const glm
 					auto &flag = straight_path_flags[i];
 	
 					if (flag & DT_STRAIGHTPATH_OFFMESH_CONNECTION) {
-						auto &poly = straight_path_polys[i];
-	
 						auto &p2 = straight_path[i + 1];
 						glm::vec3 node(p2.x, p2.z, p2.y);
 						Route.push_back(node);
 	
 						unsigned short pflag = 0;
-						if (dtStatusSucceed(m_impl->nav_mesh->getPolyFlags(straight_path_polys[i], &pflag))) {
+						if (dtStatusSucceed(nav_mesh->getPolyFlags(straight_path_polys[i], &pflag))) {
 							if (pflag & 512) {
 								Route.push_back(true);
 							}
@@ -278,6 +510,7 @@ IPathfinder::IPath PathfinderNavmesh::FindPath(const glm::vec3 &start, const glm
 			}
 			else {
 				IPath Route;
+				Route.reserve(n_straight_polys);
 				for (int i = 0; i < n_straight_polys; ++i)
 				{
 					auto &current = straight_path[i];
@@ -285,7 +518,7 @@ IPathfinder::IPath PathfinderNavmesh::FindPath(const glm::vec3 &start, const glm
 					Route.push_back(node);
 	
 					unsigned short flag = 0;
-					if (dtStatusSucceed(m_impl->nav_mesh->getPolyFlags(straight_path_polys[i], &flag))) {
+					if (dtStatusSucceed(nav_mesh->getPolyFlags(straight_path_polys[i], &flag))) {
 						if (flag & 512) {
 							Route.push_back(true);
 						}
@@ -309,11 +542,6 @@ glm::vec3 PathfinderNavmesh::GetRandomLocation(const glm::vec3 &start)
 		return glm::vec3(0.f);
 	}
 
-	if (!m_impl->query) {
-		m_impl->query = dtAllocNavMeshQuery();
-		m_impl->query->init(m_impl->nav_mesh, RuleI(Pathing, MaxNavmeshNodes));
-	}
-
 	dtQueryFilter filter;
 	filter.setIncludeFlags(65535U ^ 2048);
 	filter.setAreaCost(0, 1.0f); //Normal
@@ -334,14 +562,19 @@ glm::vec3 PathfinderNavmesh::GetRandomLocation(const glm::vec3 &start)
 	glm::vec3 current_location(start.x, start.z, start.y);
 	glm::vec3 ext(5.0f, 100.0f, 5.0f);
 
-	m_impl->query->findNearestPoly(&current_location[0], &ext[0], &filter, &start_ref, 0);
+	auto q = m_impl->AcquireQuery(RuleI(Pathing, MaxNavmeshNodes));
+	q->query->findNearestPoly(&current_location[0], &ext[0], &filter, &start_ref, 0);
 
 	if (!start_ref)
 	{
+		m_impl->ReleaseQuery(std::move(q));
 		return glm::vec3(0.f);
 	}
 
-	if (dtStatusSucceed(m_impl->query->findRandomPointAroundCircle(start_ref, &current_location[0], 100.f, &filter, []() { return (float)zone->random.Real(0.0, 1.0); }, &randomRef, point)))
+	auto status = q->query->findRandomPointAroundCircle(start_ref, &current_location[0], 100.f, &filter, []() { return (float)zone->random.Real(0.0, 1.0); }, &randomRef, point);
+	m_impl->ReleaseQuery(std::move(q));
+
+	if (dtStatusSucceed(status))
 	{
 		return glm::vec3(point[0], point[2], point[1]);
 	}
@@ -354,6 +587,7 @@ void PathfinderNavmesh::DebugCommand(Client *c, const Seperator *sep)
 	if (sep->arg[1][0] == '\0' || !strcasecmp(sep->arg[1], "help"))
 	{
 		c->Message(Chat::White, "#path show: Plots a path from the user to their target.");
+		c->Message(Chat::White, "#path stats: Shows path cache and query pool statistics.");
 		return;
 	}
 
@@ -369,17 +603,17 @@ void PathfinderNavmesh::DebugCommand(Client *c, const Seperator *sep)
 
 		return;
 	}
+
+	if (!strcasecmp(sep->arg[1], "stats"))
+	{
+		ShowStats(c);
+		return;
+	}
 }
 
 void PathfinderNavmesh::Clear()
 {
-	if (m_impl->nav_mesh) {
-		dtFreeNavMesh(m_impl->nav_mesh);
-	}
-
-	if (m_impl->query) {
-		dtFreeNavMeshQuery(m_impl->query);
-	}
+	m_impl->Clear();
 }
 
 void PathfinderNavmesh::Load(const std::string &path)
@@ -504,9 +738,35 @@ void PathfinderNavmesh::ShowPath(Client * c, const glm::vec3 &start, const glm::
 	}
 }
 
-dtStatus PathfinderNavmesh::GetPolyHeightNoConnections(dtPolyRef ref, const float *pos, float *height) const
+void PathfinderNavmesh::ShowStats(Client *c)
+{
+	uint64 hits = 0;
+	uint64 misses = 0;
+	size_t entries = 0;
+	{
+		std::lock_guard<std::mutex> lock(m_impl->cache_lock);
+		hits = m_impl->cache_hits;
+		misses = m_impl->cache_misses;
+		entries = m_impl->cache.size();
+	}
+
+	size_t allocated = 0;
+	size_t idle = 0;
+	{
+		std::lock_guard<std::mutex> lock(m_impl->query_lock);
+		allocated = m_impl->queries_allocated;
+		idle = m_impl->queries.size();
+	}
+
+	auto total = hits + misses;
+	c->Message(Chat::White, "Path cache: %u entries, %llu hits, %llu misses (%.2f%% hit rate)",
+		(uint32)entries, (unsigned long long)hits, (unsigned long long)misses, total > 0 ? 100.0 * hits / total : 0.0);
+	c->Message(Chat::White, "Navmesh queries: %u allocated, %u idle", (uint32)allocated, (uint32)idle);
+}
+
+dtStatus PathfinderNavmesh::Implementation::GetPolyHeightNoConnections(dtPolyRef ref, const float *pos, float *height) const
 {
-	auto *m_nav = m_impl->nav_mesh;
+	auto *m_nav = nav_mesh;
 
 	if (!m_nav) {
 		return DT_FAILURE;
@@ -545,7 +805,7 @@ dtStatus PathfinderNavmesh::GetPolyHeightNoConnections(dtPolyRef ref, const floa
 	return DT_FAILURE | DT_INVALID_PARAM;
 }
 
-dtStatus PathfinderNavmesh::GetPolyHeightOnPath(const dtPolyRef *path, const int path_len, const glm::vec3 &pos, float *h) const
+dtStatus PathfinderNavmesh::Implementation::GetPolyHeightOnPath(const dtPolyRef *path, const int path_len, const glm::vec3 &pos, float *h) const
 {
 	if (!path || !path_len) {
 		return DT_FAILURE;
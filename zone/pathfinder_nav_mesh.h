@@ -1,6 +1,7 @@
 #pragma once
 
 #include "pathfinder_interface.h"
+#include <memory>
 #include <string>
 #include <DetourNavMesh.h>
 
@@ -12,6 +13,7 @@ public:
 
 	virtual IPath FindRoute(const glm::vec3 &start, const glm::vec3 &end, bool &partial, bool &stuck, int flags = PathingNotDisabled);
 	virtual IPath FindPath(const glm::vec3 &start, const glm::vec3 &end, bool &partial, bool &stuck, const PathfinderOptions& opts);
+	virtual void FindPathAsync(const glm::vec3 &start, const glm::vec3 &end, const PathfinderOptions& opts, PathCallback callback);
 	virtual glm::vec3 GetRandomLocation(const glm::vec3 &start);
 	virtual void DebugCommand(Client *c, const Seperator *sep);
 
@@ -19,9 +21,9 @@ private:
 	void Clear();
 	void Load(const std::string &path);
 	void ShowPath(Client *c, const glm::vec3 &start, const glm::vec3 &end);
-	dtStatus GetPolyHeightNoConnections(dtPolyRef ref, const float *pos, float *height) const;
-	dtStatus GetPolyHeightOnPath(const dtPolyRef *path, const int path_len, const glm::vec3 &pos, float *h) const;
+	void ShowStats(Client *c);
 
+	//shared with in flight worker queries so they can outlive the zone's pathfinder
 	struct Implementation;
-	std::unique_ptr<Implementation> m_impl;
+	std::shared_ptr<Implementation> m_impl;
 };
@@ -3,6 +3,7 @@
 #include <boost/geometry/index/rtree.hpp>
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/graph/astar_search.hpp>
+#include <algorithm>
 #include <string>
 #include <memory>
 #include <iostream>
@@ -15,7 +16,7 @@
 #include "../common/string_util.h"
 #include "../common/rulesys.h"
 
-extern Zone *zone;
+extern Zone *&zone;
 
 #pragma pack(1)
 struct NeighbourNode {
@@ -149,12 +150,13 @@ IPathfinder::IPath PathfinderWaypoint::FindRoute(const glm::vec3 &start, const g
 	}
 	catch (found_goal)
 	{
+		//walk the predecessor map back from the goal, then flip it into travel order
 		IPath Route;
 		
-		Route.push_front(end);
+		Route.push_back(end);
 		for (size_t v = nearest_end.second;; v = p[v]) {
 			if (p[v] == v) {
-				Route.push_front(m_impl->Nodes[v].v);
+				Route.push_back(m_impl->Nodes[v].v);
 				break;
 			}
 			else {
@@ -164,20 +166,21 @@ IPathfinder::IPath PathfinderWaypoint::FindRoute(const glm::vec3 &start, const g
 				if (iter != node.edges.end()) {
 					auto &edge = iter->second;
 					if (edge.teleport) {
-						Route.push_front(m_impl->Nodes[v].v);
-						Route.push_front(true);
+						Route.push_back(m_impl->Nodes[v].v);
+						Route.push_back(true);
 					}
 					else {
-						Route.push_front(m_impl->Nodes[v].v);
+						Route.push_back(m_impl->Nodes[v].v);
 					}
 				}
 				else {
-					Route.push_front(m_impl->Nodes[v].v);
+					Route.push_back(m_impl->Nodes[v].v);
 				}
 			}
 		}
 	
-		Route.push_front(start);
+		Route.push_back(start);
+		std::reverse(Route.begin(), Route.end());
 		return Route;
 	}
 	
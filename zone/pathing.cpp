@@ -5,7 +5,7 @@
 #include "zone.h"
 #include "water_map.h"
 
-extern Zone *zone;
+extern Zone *&zone;
 
 void CullPoints(std::vector<FindPerson_Point> &points) {
 	if (!zone->HasMap()) {
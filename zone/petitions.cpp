@@ -41,7 +41,7 @@ Copyright (C) 2001-2002 EQEMu Development Team (http://eqemu.org)
 
 PetitionList petition_list;
 
-extern WorldServer worldserver;
+extern WorldServer &worldserver;
 
 void Petition::SendPetitionToPlayer(Client* clientto) {
 	auto outapp = new EQApplicationPacket(OP_PetitionCheckout, sizeof(Petition_Struct));
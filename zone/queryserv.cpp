@@ -23,7 +23,7 @@ Copyright (C) 2001-2014 EQEMu Development Team (http://eqemulator.net)
 #include "worldserver.h"
 
 
-extern WorldServer worldserver;
+extern WorldServer &worldserver;
 extern QueryServ* QServ;
 
 QueryServ::QueryServ(){
@@ -29,7 +29,7 @@
 
 #include <stdio.h>
 
-extern Zone* zone;
+extern Zone*& zone;
 extern void MapOpcodes();
 
 QuestParserCollection::QuestParserCollection() {
@@ -46,9 +46,9 @@
 #endif
 
 extern QueryServ* QServ;
-extern Zone* zone;
-extern WorldServer worldserver;
-extern EntityList entity_list;
+extern Zone*& zone;
+extern WorldServer &worldserver;
+extern EntityList &entity_list;
 
 QuestManager quest_manager;
 
@@ -72,36 +72,44 @@ QuestManager quest_manager;
 QuestManager::QuestManager() {
 	HaveProximitySays = false;
 	item_timers = 0;
+	QTimerSequence = 0;
+	QTimerClock = 0;
+	QTimerLastTime = Timer::GetCurrentTime();
 }
 
 QuestManager::~QuestManager() {
 }
 
 void QuestManager::Process() {
-	std::list<QuestTimer>::iterator cur = QTimerList.begin(), end;
-
-	end = QTimerList.end();
-	while (cur != end) {
-		if (cur->Timer_.Enabled() && cur->Timer_.Check()) {
-			if(entity_list.IsMobInZone(cur->mob)) {
-				if(cur->mob->IsNPC()) {
-					parse->EventNPC(EVENT_TIMER, cur->mob->CastToNPC(), nullptr, cur->name, 0);
-				} else if (cur->mob->IsEncounter()) {
-					parse->EventEncounter(EVENT_TIMER, cur->mob->CastToEncounter()->GetEncounterName(), cur->name, 0, nullptr);
-				} else {
-					//this is inheriently unsafe if we ever make it so more than npc/client start timers
-					parse->EventPlayer(EVENT_TIMER, cur->mob->CastToClient(), cur->name, 0);
-				}
+	auto now = GetQuestTimerClock();
 
-				//we MUST reset our iterator since the quest could have removed/added any
-				//number of timers... worst case we have to check a bunch of timers twice
-				cur = QTimerList.begin();
-				end = QTimerList.end();	//dunno if this is needed, cant hurt...
-			} else {
-				cur = QTimerList.erase(cur);
-			}
-		} else
-			++cur;
+	// only timers that are due get touched, the queue is ordered by deadline
+	while (!QTimerQueue.empty() && QTimerQueue.top().due < now) {
+		auto deadline = QTimerQueue.top();
+		QTimerQueue.pop();
+
+		auto it = QTimers.find(deadline.key);
+		if (it == QTimers.end() || it->second.sequence != deadline.sequence) {
+			continue; // stopped or restarted since this entry was queued
+		}
+
+		auto mob = entity_list.GetMobBySerial(it->second.owner_id, deadline.key.first);
+		if (!mob) {
+			QTimers.erase(it);
+			continue;
+		}
+
+		// reschedule before the event, the quest may stop or restart this timer
+		ScheduleQuestTimer(it->first, it->second, now + it->second.interval);
+
+		if(mob->IsNPC()) {
+			parse->EventNPC(EVENT_TIMER, mob->CastToNPC(), nullptr, deadline.key.second, 0);
+		} else if (mob->IsEncounter()) {
+			parse->EventEncounter(EVENT_TIMER, mob->CastToEncounter()->GetEncounterName(), deadline.key.second, 0, nullptr);
+		} else {
+			//this is inheriently unsafe if we ever make it so more than npc/client start timers
+			parse->EventPlayer(EVENT_TIMER, mob->CastToClient(), deadline.key.second, 0);
+		}
 	}
 
 	auto cur_iter = STimerList.begin();
@@ -131,22 +139,92 @@ void QuestManager::EndQuest() {
 	running_quest run = quests_running_.top();
 	if(run.depop_npc && run.owner->IsNPC()) {
 		//clear out any timers for them...
-		std::list<QuestTimer>::iterator cur = QTimerList.begin(), end;
-
-		end = QTimerList.end();
-		while (cur != end) {
-			if (cur->mob == run.owner)
-				cur = QTimerList.erase(cur);
-			else
-				++cur;
-		}
+		StopAllQuestTimers(run.owner);
 		run.owner->Depop();
 	}
 	quests_running_.pop();
 }
 
 void QuestManager::ClearAllTimers() {
-	QTimerList.clear();
+	QTimers.clear();
+	QTimerQueue = decltype(QTimerQueue)();
+}
+
+uint64 QuestManager::GetQuestTimerClock() {
+	// Timer::GetCurrentTime wraps, the queue needs a clock that only ever moves forward
+	uint32 now = Timer::GetCurrentTime();
+	QTimerClock += static_cast<uint32>(now - QTimerLastTime);
+	QTimerLastTime = now;
+	return QTimerClock;
+}
+
+void QuestManager::ScheduleQuestTimer(const QuestTimerKey &key, QuestTimer &timer, uint64 due) {
+	timer.due = due;
+	timer.sequence = ++QTimerSequence;
+	QTimerQueue.push({ due, timer.sequence, key });
+
+	// restarting a timer leaves its old entry behind, rebuild once those outnumber the live ones
+	if (QTimerQueue.size() > QTimers.size() * 2 + 64) {
+		decltype(QTimerQueue) rebuilt;
+		for (auto &t : QTimers) {
+			rebuilt.push({ t.second.due, t.second.sequence, t.first });
+		}
+		QTimerQueue.swap(rebuilt);
+	}
+}
+
+void QuestManager::StartQuestTimer(Mob *mob, const std::string &name, uint32 milliseconds) {
+	if (!mob) {
+		return;
+	}
+
+	auto now = GetQuestTimerClock();
+	QuestTimerKey key(mob->GetSerial(), name);
+
+	auto it = QTimers.find(key);
+	if (it != QTimers.end()) {
+		// restarting keeps the original interval for later firings, like Timer::Start(ms, false)
+		ScheduleQuestTimer(it->first, it->second, now + milliseconds);
+		return;
+	}
+
+	QuestTimer timer;
+	timer.owner_id = mob->GetID();
+	timer.interval = milliseconds;
+	it = QTimers.insert(std::make_pair(key, timer)).first;
+	ScheduleQuestTimer(it->first, it->second, now + milliseconds);
+}
+
+bool QuestManager::StopQuestTimer(Mob *mob, const std::string &name, uint32 *remaining) {
+	if (!mob) {
+		return false;
+	}
+
+	auto it = QTimers.find(QuestTimerKey(mob->GetSerial(), name));
+	if (it == QTimers.end()) {
+		return false;
+	}
+
+	if (remaining) {
+		auto now = GetQuestTimerClock();
+		*remaining = it->second.due > now ? static_cast<uint32>(it->second.due - now) : 0;
+	}
+
+	QTimers.erase(it);
+	return true;
+}
+
+void QuestManager::StopAllQuestTimers(Mob *mob) {
+	if (!mob) {
+		return;
+	}
+
+	// the key orders by owner first, so an owner's timers are one contiguous range
+	auto serial = mob->GetSerial();
+	auto it = QTimers.lower_bound(QuestTimerKey(serial, std::string()));
+	while (it != QTimers.end() && it->first.first == serial) {
+		it = QTimers.erase(it);
+	}
 }
 
 //quest perl functions
@@ -494,20 +572,7 @@ void QuestManager::settimer(const char *timer_name, int seconds) {
 		return;
 	}
 
-	std::list<QuestTimer>::iterator cur = QTimerList.begin(), end;
-
-	end = QTimerList.end();
-	while (cur != end) {
-		if(cur->mob && cur->mob == owner && cur->name == timer_name)
-		{
-			cur->Timer_.Enable();
-			cur->Timer_.Start(seconds * 1000, false);
-			return;
-		}
-		++cur;
-	}
-
-	QTimerList.push_back(QuestTimer(seconds * 1000, owner, timer_name));
+	StartQuestTimer(owner, timer_name, seconds * 1000);
 }
 
 void QuestManager::settimerMS(const char *timer_name, int milliseconds) {
@@ -518,20 +583,7 @@ void QuestManager::settimerMS(const char *timer_name, int milliseconds) {
 		return;
 	}
 
-	std::list<QuestTimer>::iterator cur = QTimerList.begin(), end;
-
-	end = QTimerList.end();
-	while (cur != end) {
-		if(cur->mob && cur->mob == owner && cur->name == timer_name)
-		{
-			cur->Timer_.Enable();
-			cur->Timer_.Start(milliseconds, false);
-			return;
-		}
-		++cur;
-	}
-
-	QTimerList.push_back(QuestTimer(milliseconds, owner, timer_name));
+	StartQuestTimer(owner, timer_name, milliseconds);
 }
 
 void QuestManager::settimerMS(const char *timer_name, int milliseconds, EQ::ItemInstance *inst) {
@@ -541,20 +593,7 @@ void QuestManager::settimerMS(const char *timer_name, int milliseconds, EQ::Item
 }
 
 void QuestManager::settimerMS(const char *timer_name, int milliseconds, Mob *mob) {
-	std::list<QuestTimer>::iterator cur = QTimerList.begin(), end;
-
-	end = QTimerList.end();
-	while (cur != end) {
-		if (cur->mob && cur->mob == mob && cur->name == timer_name)
-		{
-			cur->Timer_.Enable();
-			cur->Timer_.Start(milliseconds, false);
-			return;
-		}
-		++cur;
-	}
-
-	QTimerList.push_back(QuestTimer(milliseconds, mob, timer_name));
+	StartQuestTimer(mob, timer_name, milliseconds);
 }
 
 void QuestManager::stoptimer(const char *timer_name) {
@@ -565,16 +604,7 @@ void QuestManager::stoptimer(const char *timer_name) {
 		return;
 	}
 
-	std::list<QuestTimer>::iterator cur = QTimerList.begin(), end;
-
-	end = QTimerList.end();
-	while (cur != end) {
-		if (cur->mob && cur->mob == owner && cur->name == timer_name) {
-			QTimerList.erase(cur);
-			return;
-		}
-		++cur;
-	}
+	StopQuestTimer(owner, timer_name);
 }
 
 void QuestManager::stoptimer(const char *timer_name, EQ::ItemInstance *inst) {
@@ -584,16 +614,7 @@ void QuestManager::stoptimer(const char *timer_name, EQ::ItemInstance *inst) {
 }
 
 void QuestManager::stoptimer(const char *timer_name, Mob *mob) {
-	std::list<QuestTimer>::iterator cur = QTimerList.begin(), end;
-
-	end = QTimerList.end();
-	while (cur != end) {
-		if (cur->mob && cur->mob == mob && cur->name == timer_name) {
-			QTimerList.erase(cur);
-			return;
-		}
-		++cur;
-	}
+	StopQuestTimer(mob, timer_name);
 }
 
 void QuestManager::stopalltimers() {
@@ -604,15 +625,7 @@ void QuestManager::stopalltimers() {
 		return;
 	}
 
-	std::list<QuestTimer>::iterator cur = QTimerList.begin(), end, tmp;
-
-	end = QTimerList.end();
-	while (cur != end) {
-		if(cur->mob && cur->mob == owner)
-			cur = QTimerList.erase(cur);
-		else
-			++cur;
-	}
+	StopAllQuestTimers(owner);
 }
 
 void QuestManager::stopalltimers(EQ::ItemInstance *inst) {
@@ -622,21 +635,12 @@ void QuestManager::stopalltimers(EQ::ItemInstance *inst) {
 }
 
 void QuestManager::stopalltimers(Mob *mob) {
-	std::list<QuestTimer>::iterator cur = QTimerList.begin(), end, tmp;
-
-	end = QTimerList.end();
-	while (cur != end) {
-		if (cur->mob && cur->mob == mob)
-			cur = QTimerList.erase(cur);
-		else
-			++cur;
-	}
+	StopAllQuestTimers(mob);
 }
 
 void QuestManager::pausetimer(const char *timer_name) {
 	QuestManagerCurrentQuestVars();
 
-	std::list<QuestTimer>::iterator cur = QTimerList.begin(), end;
 	std::list<PausedTimer>::iterator pcur = PTimerList.begin(), pend;
 	PausedTimer pt;
 	uint32 milliseconds = 0;
@@ -652,17 +656,7 @@ void QuestManager::pausetimer(const char *timer_name) {
 		++pcur;
 	}
 
-	end = QTimerList.end();
-	while (cur != end)
-	{
-		if (cur->mob && cur->mob == owner && cur->name == timer_name)
-		{
-			milliseconds = cur->Timer_.GetRemainingTime();
-			QTimerList.erase(cur);
-			break;
-		}
-		++cur;
-	}
+	StopQuestTimer(owner, timer_name, &milliseconds);
 
 	std::string timername = timer_name;
 	pt.name = timername;
@@ -675,7 +669,6 @@ void QuestManager::pausetimer(const char *timer_name) {
 void QuestManager::resumetimer(const char *timer_name) {
 	QuestManagerCurrentQuestVars();
 
-	std::list<QuestTimer>::iterator cur = QTimerList.begin(), end;
 	std::list<PausedTimer>::iterator pcur = PTimerList.begin(), pend;
 	PausedTimer pt;
 	uint32 milliseconds = 0;
@@ -698,21 +691,8 @@ void QuestManager::resumetimer(const char *timer_name) {
 		return;
 	}
 
-	end = QTimerList.end();
-	while (cur != end)
-	{
-		if (cur->mob && cur->mob == owner && cur->name == timer_name)
-		{
-			cur->Timer_.Enable();
-			cur->Timer_.Start(milliseconds, false);
-			LogQuests("Resuming timer [{}] for [{}] with [{}] ms remaining", timer_name, owner->GetName(), milliseconds);
-			return;
-		}
-		++cur;
-	}
-
-	QTimerList.push_back(QuestTimer(milliseconds, owner, timer_name));
-	LogQuests("Creating a new timer and resuming [{}] for [{}] with [{}] ms remaining", timer_name, owner->GetName(), milliseconds);
+	StartQuestTimer(owner, timer_name, milliseconds);
+	LogQuests("Resuming timer [{}] for [{}] with [{}] ms remaining", timer_name, owner->GetName(), milliseconds);
 
 }
 
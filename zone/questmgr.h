@@ -21,7 +21,10 @@
 #include "../common/timer.h"
 #include "tasks.h"
 
+#include <functional>
 #include <list>
+#include <map>
+#include <queue>
 #include <stack>
 
 class Client;
@@ -395,14 +398,29 @@ private:
 	int QGVarDuration(const char *fmt);
 	int InsertQuestGlobal(int charid, int npcid, int zoneid, const char *name, const char *value, int expdate);
 
-	class QuestTimer {
-	public:
-		inline QuestTimer(int duration, Mob *_mob, std::string _name)
-			: mob(_mob), name(_name), Timer_(duration) { Timer_.Start(duration, false); }
-		Mob*   mob;
-		std::string name;
-		Timer Timer_;
+	// Quest timers are keyed by (owner serial, timer name) and the owner is looked up by id/serial
+	// when the timer fires, so a despawned owner is never dereferenced and a recycled entity id
+	// never inherits someone else's timers.
+	typedef std::pair<uint32, std::string> QuestTimerKey;
+	struct QuestTimer {
+		uint16 owner_id;
+		uint32 interval; // the length the timer was created with, used again after every firing
+		uint64 due;
+		uint64 sequence; // the live QTimerQueue entry for this timer, any others are stale
 	};
+	struct QuestTimerDeadline {
+		uint64 due;
+		uint64 sequence;
+		QuestTimerKey key;
+		inline bool operator>(const QuestTimerDeadline &o) const { return due != o.due ? due > o.due : sequence > o.sequence; }
+	};
+
+	uint64 GetQuestTimerClock();
+	void StartQuestTimer(Mob *mob, const std::string &name, uint32 milliseconds);
+	bool StopQuestTimer(Mob *mob, const std::string &name, uint32 *remaining = nullptr);
+	void StopAllQuestTimers(Mob *mob);
+	void ScheduleQuestTimer(const QuestTimerKey &key, QuestTimer &timer, uint64 due);
+
 	class SignalTimer {
 	public:
 		inline SignalTimer(int duration, int _npc_id, int _signal_id) : npc_id(_npc_id), signal_id(_signal_id), Timer_(duration) { Timer_.Start(duration, false); }
@@ -410,7 +428,11 @@ private:
 		int signal_id;
 		Timer Timer_;
 	};
-	std::list<QuestTimer>	QTimerList;
+	std::map<QuestTimerKey, QuestTimer> QTimers;
+	std::priority_queue<QuestTimerDeadline, std::vector<QuestTimerDeadline>, std::greater<QuestTimerDeadline>> QTimerQueue;
+	uint64 QTimerSequence;
+	uint64 QTimerClock;
+	uint32 QTimerLastTime;
 	std::list<SignalTimer>	STimerList;
 	std::list<PausedTimer>	PTimerList;
 	size_t item_timers;
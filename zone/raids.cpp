@@ -27,8 +27,8 @@
 
 #include "worldserver.h"
 
-extern EntityList entity_list;
-extern WorldServer worldserver;
+extern EntityList &entity_list;
+extern WorldServer &worldserver;
 
 Raid::Raid(uint32 raidID)
 : GroupIDConsumer(raidID)
@@ -95,19 +95,7 @@ void Raid::AddMember(Client *c, uint32 group, bool rleader, bool groupleader, bo
 	if(!c)
 		return;
 
-	std::string query = StringFormat("INSERT INTO raid_members SET raidid = %lu, charid = %lu, "
-                                    "groupid = %lu, _class = %d, level = %d, name = '%s', "
-                                    "isgroupleader = %d, israidleader = %d, islooter = %d",
-                                    (unsigned long)GetID(), (unsigned long)c->CharacterID(),
-                                    (unsigned long)group, c->GetClass(), c->GetLevel(),
-                                    c->GetName(), groupleader, rleader, looter);
-    auto results = database.QueryDatabase(query);
-
-	if(!results.Success()) {
-		LogError("Error inserting into raid members: [{}]", results.ErrorMessage().c_str());
-	}
-
-	LearnMembers();
+	AddRosterMember(c->GetName(), group, c->GetClass(), c->GetLevel(), groupleader, rleader, looter);
 	VerifyRaid();
 	if (rleader) {
 		database.SetRaidGroupLeaderInfo(RAID_GROUPLESS, GetID());
@@ -156,6 +144,13 @@ void Raid::AddMember(Client *c, uint32 group, bool rleader, bool groupleader, bo
 	auto pack = new ServerPacket(ServerOP_RaidAdd, sizeof(ServerRaidGeneralAction_Struct));
 	ServerRaidGeneralAction_Struct *rga = (ServerRaidGeneralAction_Struct*)pack->pBuffer;
 	rga->rid = GetID();
+	rga->gid = group;
+	rga->char_id = c->CharacterID();
+	rga->_class = c->GetClass();
+	rga->level = c->GetLevel();
+	rga->is_group_leader = groupleader;
+	rga->is_raid_leader = rleader;
+	rga->is_looter = looter;
 	strn0cpy(rga->playername, c->GetName(), 64);
 	rga->zoneid = zone->GetZoneID();
 	rga->instance_id = zone->GetInstanceID();
@@ -165,14 +160,11 @@ void Raid::AddMember(Client *c, uint32 group, bool rleader, bool groupleader, bo
 
 void Raid::RemoveMember(const char *characterName)
 {
-	std::string query = StringFormat("DELETE FROM raid_members where name='%s'", characterName);
-	auto results = database.QueryDatabase(query);
-
 	Client *client = entity_list.GetClientByName(characterName);
 	disbandCheck = true;
 	SendRaidRemoveAll(characterName);
 	SendRaidDisband(client);
-	LearnMembers();
+	RemoveRosterMember(characterName);
 	VerifyRaid();
 
 	if(client) {
@@ -193,10 +185,7 @@ void Raid::RemoveMember(const char *characterName)
 
 void Raid::DisbandRaid()
 {
-	std::string query = StringFormat("DELETE FROM raid_members WHERE raidid = %lu", (unsigned long)GetID());
-	auto results = database.QueryDatabase(query);
-
-	LearnMembers();
+	ClearRoster();
 	VerifyRaid();
 	SendRaidDisbandAll();
 
@@ -214,17 +203,14 @@ void Raid::DisbandRaid()
 
 void Raid::MoveMember(const char *name, uint32 newGroup)
 {
-	std::string query = StringFormat("UPDATE raid_members SET groupid = %lu WHERE name = '%s'",
-                                    (unsigned long)newGroup, name);
-    auto results = database.QueryDatabase(query);
-
-	LearnMembers();
+	MoveRosterMember(name, newGroup);
 	VerifyRaid();
 	SendRaidMoveAll(name);
 
 	auto pack = new ServerPacket(ServerOP_RaidChangeGroup, sizeof(ServerRaidGeneralAction_Struct));
 	ServerRaidGeneralAction_Struct *rga = (ServerRaidGeneralAction_Struct*)pack->pBuffer;
 	rga->rid = GetID();
+	rga->gid = newGroup;
 	strn0cpy(rga->playername, name, 64);
 	rga->zoneid = zone->GetZoneID();
 	rga->instance_id = zone->GetInstanceID();
@@ -234,16 +220,13 @@ void Raid::MoveMember(const char *name, uint32 newGroup)
 
 void Raid::SetGroupLeader(const char *who, bool glFlag)
 {
-	std::string query = StringFormat("UPDATE raid_members SET isgroupleader = %lu WHERE name = '%s'",
-                                    (unsigned long)glFlag, who);
-    auto results = database.QueryDatabase(query);
-
-	LearnMembers();
+	SetRosterGroupLeader(who, glFlag);
 	VerifyRaid();
 
 	auto pack = new ServerPacket(ServerOP_RaidGroupLeader, sizeof(ServerRaidGeneralAction_Struct));
 	ServerRaidGeneralAction_Struct *rga = (ServerRaidGeneralAction_Struct*)pack->pBuffer;
 	rga->rid = GetID();
+	rga->is_group_leader = glFlag;
 	strn0cpy(rga->playername, who, 64);
 	rga->zoneid = zone->GetZoneID();
 	rga->instance_id = zone->GetInstanceID();
@@ -265,16 +248,6 @@ Client *Raid::GetGroupLeader(uint32 group_id)
 
 void Raid::SetRaidLeader(const char *wasLead, const char *name)
 {
-	std::string query = StringFormat("UPDATE raid_members SET israidleader = 0 WHERE name = '%s'", wasLead);
-	auto results = database.QueryDatabase(query);
-	if (!results.Success())
-		LogError("Set Raid Leader error: [{}]\n", results.ErrorMessage().c_str());
-
-	query = StringFormat("UPDATE raid_members SET israidleader = 1 WHERE name = '%s'", name);
-	results = database.QueryDatabase(query);
-	if (!results.Success())
-		LogError("Set Raid Leader error: [{}]\n", results.ErrorMessage().c_str());
-
 	strn0cpy(leadername, name, 64);
 
 	Client *c = entity_list.GetClientByName(name);
@@ -283,7 +256,7 @@ void Raid::SetRaidLeader(const char *wasLead, const char *name)
 	else
 		SetLeader(nullptr); //sanity check, should never get hit but we want to prefer to NOT crash if we do VerifyRaid and leader never gets set there (raid without a leader?)
 
-	LearnMembers();
+	SetRosterRaidLeader(name);
 	VerifyRaid();
 	SendMakeLeaderPacket(name);
 
@@ -367,12 +340,17 @@ bool Raid::IsGroupLeader(const char *who)
 
 void Raid::UpdateLevel(const char *name, int newLevel)
 {
-	std::string query = StringFormat("UPDATE raid_members SET level = %lu WHERE name = '%s'",
-                                    (unsigned long)newLevel, name);
-    auto results = database.QueryDatabase(query);
+	SetRosterLevel(name, newLevel);
 
-	LearnMembers();
-	VerifyRaid();
+	auto pack = new ServerPacket(ServerOP_RaidMemberLevel, sizeof(ServerRaidGeneralAction_Struct));
+	ServerRaidGeneralAction_Struct *rga = (ServerRaidGeneralAction_Struct*)pack->pBuffer;
+	rga->rid = GetID();
+	rga->level = newLevel;
+	strn0cpy(rga->playername, name, 64);
+	rga->zoneid = zone->GetZoneID();
+	rga->instance_id = zone->GetInstanceID();
+	worldserver.SendPacket(pack);
+	safe_delete(pack);
 }
 
 uint32 Raid::GetFreeGroup()
@@ -899,9 +877,6 @@ void Raid::ChangeLootType(uint32 type)
 
 void Raid::AddRaidLooter(const char* looter)
 {
-	std::string query = StringFormat("UPDATE raid_members SET islooter = 1 WHERE name = '%s'", looter);
-	auto results = database.QueryDatabase(query);
-
 	for(int x = 0; x < MAX_RAID_MEMBERS; x++)
 	{
 		if(strcmp(looter, members[x].membername) == 0)
@@ -913,6 +888,8 @@ void Raid::AddRaidLooter(const char* looter)
 	auto pack = new ServerPacket(ServerOP_DetailsChange, sizeof(ServerRaidGeneralAction_Struct));
 	ServerRaidGeneralAction_Struct *rga = (ServerRaidGeneralAction_Struct*)pack->pBuffer;
 	rga->rid = GetID();
+	strn0cpy(rga->playername, looter, 64);
+	rga->is_looter = 1;
 	rga->zoneid = zone->GetZoneID();
 	rga->instance_id = zone->GetInstanceID();
 	worldserver.SendPacket(pack);
@@ -921,9 +898,6 @@ void Raid::AddRaidLooter(const char* looter)
 
 void Raid::RemoveRaidLooter(const char* looter)
 {
-	std::string query = StringFormat("UPDATE raid_members SET islooter = 0 WHERE name = '%s'", looter);
-	auto results = database.QueryDatabase(query);
-
 	for(int x = 0; x < MAX_RAID_MEMBERS; x++)
 		if(strcmp(looter, members[x].membername) == 0) {
 			members[x].IsLooter = 0;
@@ -933,6 +907,8 @@ void Raid::RemoveRaidLooter(const char* looter)
 	auto pack = new ServerPacket(ServerOP_DetailsChange, sizeof(ServerRaidGeneralAction_Struct));
 	ServerRaidGeneralAction_Struct *rga = (ServerRaidGeneralAction_Struct*)pack->pBuffer;
 	rga->rid = GetID();
+	strn0cpy(rga->playername, looter, 64);
+	rga->is_looter = 0;
 	rga->zoneid = zone->GetZoneID();
 	rga->instance_id = zone->GetInstanceID();
 	worldserver.SendPacket(pack);
@@ -1489,46 +1465,24 @@ void Raid::SaveRaidMOTD()
 	auto results = database.QueryDatabase(query);
 }
 
-bool Raid::LearnMembers()
+void Raid::SetRosterFromWorld(const ServerRosterMember_Struct *roster, uint32 count)
 {
 	memset(members, 0, (sizeof(RaidMember)*MAX_RAID_MEMBERS));
 
-	std::string query = StringFormat("SELECT name, groupid, _class, level, "
-                                    "isgroupleader, israidleader, islooter "
-                                    "FROM raid_members WHERE raidid = %lu",
-                                    (unsigned long)GetID());
-    auto results = database.QueryDatabase(query);
-    if (!results.Success())
-        return false;
-
-	if(results.RowCount() == 0) {
-		LogError("Error getting raid members for raid [{}]: [{}]", (unsigned long)GetID(), results.ErrorMessage().c_str());
-        disbandCheck = true;
-        return false;
-    }
-
-    int index = 0;
-    for(auto row = results.begin(); row != results.end(); ++row) {
-        if(!row[0])
-            continue;
-
-        members[index].member = nullptr;
-        strn0cpy(members[index].membername, row[0], 64);
-        int groupNum = atoi(row[1]);
-        if(groupNum > 11)
-            members[index].GroupNumber = 0xFFFFFFFF;
-        else
-            members[index].GroupNumber = groupNum;
-
-        members[index]._class = atoi(row[2]);
-        members[index].level = atoi(row[3]);
-        members[index].IsGroupLeader = atoi(row[4]);
-        members[index].IsRaidLeader = atoi(row[5]);
-        members[index].IsLooter = atoi(row[6]);
-        ++index;
-    }
+	for (uint32 index = 0; index < count && index < MAX_RAID_MEMBERS; ++index) {
+		strn0cpy(members[index].membername, roster[index].name, 64);
+		members[index].GroupNumber = roster[index].gid > 11 ? RAID_GROUPLESS : roster[index].gid;
+		members[index]._class = roster[index]._class;
+		members[index].level = roster[index].level;
+		members[index].IsGroupLeader = roster[index].is_group_leader;
+		members[index].IsRaidLeader = roster[index].is_raid_leader;
+		members[index].IsLooter = roster[index].is_looter;
+	}
 
-	return true;
+	if (count == 0)
+		disbandCheck = true;
+
+	VerifyRaid();
 }
 
 void Raid::VerifyRaid()
@@ -1561,6 +1515,101 @@ void Raid::VerifyRaid()
 	}
 }
 
+void Raid::AddRosterMember(const char *name, uint32 group, uint8 _class, uint8 level, bool groupleader, bool raidleader, bool looter)
+{
+	int index = -1;
+	for (int x = 0; x < MAX_RAID_MEMBERS; x++) {
+		if (strcmp(name, members[x].membername) == 0) {
+			index = x;
+			break;
+		}
+
+		if (index == -1 && members[x].membername[0] == '\0')
+			index = x;
+	}
+
+	if (index == -1) {
+		LogError("No free roster slot for [{}] in raid [{}]", name, (unsigned long)GetID());
+		return;
+	}
+
+	members[index].member = nullptr;
+	strn0cpy(members[index].membername, name, 64);
+	members[index].GroupNumber = group > 11 ? RAID_GROUPLESS : group;
+	members[index]._class = _class;
+	members[index].level = level;
+	members[index].IsGroupLeader = groupleader;
+	members[index].IsRaidLeader = raidleader;
+	members[index].IsLooter = looter;
+}
+
+void Raid::RemoveRosterMember(const char *name)
+{
+	for (int x = 0; x < MAX_RAID_MEMBERS; x++) {
+		if (strcmp(name, members[x].membername) == 0) {
+			memset(&members[x], 0, sizeof(RaidMember));
+			break;
+		}
+	}
+
+	if (RaidCount() == 0)
+		disbandCheck = true;
+}
+
+void Raid::MoveRosterMember(const char *name, uint32 group)
+{
+	for (int x = 0; x < MAX_RAID_MEMBERS; x++) {
+		if (strcmp(name, members[x].membername) == 0) {
+			members[x].GroupNumber = group > 11 ? RAID_GROUPLESS : group;
+			break;
+		}
+	}
+}
+
+void Raid::SetRosterGroupLeader(const char *name, bool glFlag)
+{
+	for (int x = 0; x < MAX_RAID_MEMBERS; x++) {
+		if (strcmp(name, members[x].membername) == 0) {
+			members[x].IsGroupLeader = glFlag;
+			break;
+		}
+	}
+}
+
+void Raid::SetRosterRaidLeader(const char *name)
+{
+	for (int x = 0; x < MAX_RAID_MEMBERS; x++) {
+		if (members[x].membername[0] != '\0')
+			members[x].IsRaidLeader = strcmp(name, members[x].membername) == 0;
+	}
+}
+
+void Raid::SetRosterLevel(const char *name, uint8 level)
+{
+	for (int x = 0; x < MAX_RAID_MEMBERS; x++) {
+		if (strcmp(name, members[x].membername) == 0) {
+			members[x].level = level;
+			break;
+		}
+	}
+}
+
+void Raid::SetRosterLooter(const char *name, bool looter)
+{
+	for (int x = 0; x < MAX_RAID_MEMBERS; x++) {
+		if (strcmp(name, members[x].membername) == 0) {
+			members[x].IsLooter = looter;
+			break;
+		}
+	}
+}
+
+void Raid::ClearRoster()
+{
+	memset(members, 0, (sizeof(RaidMember)*MAX_RAID_MEMBERS));
+	disbandCheck = true;
+}
+
 void Raid::MemberZoned(Client *c)
 {
 	if(!c)
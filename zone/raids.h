@@ -25,6 +25,7 @@
 class Client;
 class EQApplicationPacket;
 class Mob;
+struct ServerRosterMember_Struct;
 
 enum {	//raid packet types:
 	raidAdd = 0,
@@ -149,6 +150,7 @@ public:
 
 	void	LockRaid(bool lockFlag);
 	bool	IsLocked() { return locked; }
+	void	SetLocked(bool lockFlag) { locked = lockFlag; }
 
 	//Actual Implementation Stuff
 
@@ -170,8 +172,18 @@ public:
 	void	SetRaidDetails();
 	void	GetRaidDetails();
 	void	SaveRaidMOTD();
-	bool	LearnMembers();
+	void	SetRosterFromWorld(const ServerRosterMember_Struct *roster, uint32 count);
 	void	VerifyRaid();
+
+	//in memory roster changes, applied from world's roster deltas
+	void	AddRosterMember(const char *name, uint32 group, uint8 _class, uint8 level, bool groupleader, bool raidleader, bool looter);
+	void	RemoveRosterMember(const char *name);
+	void	MoveRosterMember(const char *name, uint32 group);
+	void	SetRosterGroupLeader(const char *name, bool glFlag);
+	void	SetRosterLevel(const char *name, uint8 level);
+	void	SetRosterRaidLeader(const char *name);
+	void	SetRosterLooter(const char *name, bool looter);
+	void	ClearRoster();
 	void	MemberZoned(Client *c);
 	void	SendHPManaEndPacketsTo(Client *c);
 	void	SendHPManaEndPacketsFrom(Mob *mob);
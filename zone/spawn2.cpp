@@ -28,10 +28,10 @@
 #include "zonedb.h"
 #include "zone_store.h"
 
-extern EntityList entity_list;
-extern Zone* zone;
+extern EntityList &entity_list;
+extern Zone*& zone;
 
-extern WorldServer worldserver;
+extern WorldServer &worldserver;
 
 /*
 
@@ -27,8 +27,8 @@
 #include "zone_store.h"
 #include "../common/repositories/criteria/content_filter_criteria.h"
 
-extern EntityList entity_list;
-extern Zone       *zone;
+extern EntityList &entity_list;
+extern Zone       *&zone;
 
 SpawnEntry::SpawnEntry(uint32 in_NPCType, int in_chance, uint16 in_filter, uint8 in_npc_spawn_limit)
 {
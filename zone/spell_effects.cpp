@@ -39,9 +39,9 @@
 #endif
 
 
-extern Zone* zone;
+extern Zone*& zone;
 extern volatile bool is_zone_loaded;
-extern WorldServer worldserver;
+extern WorldServer &worldserver;
 
 
 // the spell can still fail here, if the buff can't stack
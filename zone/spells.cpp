@@ -104,9 +104,9 @@ Copyright (C) 2001-2002 EQEMu Development Team (http://eqemu.org)
 #include "client.h"
 
 
-extern Zone* zone;
+extern Zone*& zone;
 extern volatile bool is_zone_loaded;
-extern WorldServer worldserver;
+extern WorldServer &worldserver;
 extern FastMath g_Math;
 
 using EQ::spells::CastingSlot;
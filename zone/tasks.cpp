@@ -46,6 +46,8 @@ extern QueryServ* QServ;
 TaskManager::TaskManager() {
 	for(int i=0; i<MAXTASKS; i++)
 		Tasks[i] = nullptr;
+
+	TaskDataGeneration = 1;
 }
 
 TaskManager::~TaskManager() {
@@ -104,6 +106,8 @@ bool TaskManager::LoadSingleTask(int TaskID) {
 
 void TaskManager::ReloadGoalLists() {
 
+	TaskDataGeneration++;
+
 	if(!GoalListManager.LoadLists())
 		Log(Logs::Detail, Logs::Tasks,"TaskManager::LoadTasks LoadLists failed");
 }
@@ -113,6 +117,8 @@ bool TaskManager::LoadTasks(int singleTask)
 	// If TaskID !=0, then just load the task specified.
 	Log(Logs::General, Logs::Tasks, "[GLOBALLOAD] TaskManager::LoadTasks Called");
 
+	TaskDataGeneration++;
+
 	std::string query;
 	if (singleTask == 0) {
 		if (!GoalListManager.LoadLists())
@@ -1315,6 +1321,10 @@ ClientTaskState::ClientTaskState() {
 	ActiveTask.slot = 0;
 	ActiveTask.TaskID = TASKSLOTEMPTY;
 	// TODO: shared task
+
+	for (int i = 0; i < MAXACTIVEQUESTS + 1; i++)
+		IndexedTaskIDs[i] = TASKSLOTEMPTY;
+	IndexedGeneration = 0;
 }
 
 ClientTaskState::~ClientTaskState() {
@@ -1502,6 +1512,75 @@ bool ClientTaskState::UnlockActivities(int CharID, ClientTaskInformation &task_i
 	return false;
 }
 
+static inline uint64 ActivityIndexKey(int ActivityType, int GoalID)
+{
+	return (static_cast<uint64>(static_cast<uint32>(ActivityType)) << 32) | static_cast<uint32>(GoalID);
+}
+
+void ClientTaskState::BuildActivityIndex()
+{
+	ActivityIndex.clear();
+
+	for (int i = 0; i < MAXACTIVEQUESTS + 1; i++) {
+		IndexedTaskIDs[i] = ActiveTasks[i].TaskID;
+
+		if (ActiveTasks[i].TaskID == TASKSLOTEMPTY)
+			continue;
+
+		auto Task = taskmanager->Tasks[ActiveTasks[i].TaskID];
+		if (Task == nullptr)
+			continue;
+
+		for (int j = 0; j < Task->ActivityCount; j++) {
+			auto &activity = Task->Activity[j];
+			IndexedActivity entry = { i, ActiveTasks[i].TaskID, j };
+
+			// deliveries are keyed on the NPC handed to, the items are checked when the trade happens
+			if (activity.Type == ActivityDeliver || activity.Type == ActivityGiveCash) {
+				ActivityIndex[ActivityIndexKey(activity.Type, activity.DeliverToNPC)].push_back(entry);
+				continue;
+			}
+
+			switch (activity.GoalMethod) {
+			case METHODSINGLEID:
+				ActivityIndex[ActivityIndexKey(activity.Type, activity.GoalID)].push_back(entry);
+				break;
+			case METHODLIST:
+				for (auto goal : taskmanager->GoalListManager.GetListContents(activity.GoalID)) {
+					auto &list = ActivityIndex[ActivityIndexKey(activity.Type, goal)];
+					// a goal list may repeat an entry, only credit the activity once
+					if (!list.empty() && list.back().TaskIndex == i && list.back().ActivityID == j)
+						continue;
+					list.push_back(entry);
+				}
+				break;
+			default:
+				// METHODQUEST activities are only updated from quests
+				break;
+			}
+		}
+	}
+
+	IndexedGeneration = taskmanager->TaskDataGeneration;
+}
+
+std::vector<ClientTaskState::IndexedActivity> ClientTaskState::GetIndexedActivities(int ActivityType, int GoalID)
+{
+	bool stale = IndexedGeneration != taskmanager->TaskDataGeneration;
+	for (int i = 0; !stale && i < MAXACTIVEQUESTS + 1; i++)
+		stale = IndexedTaskIDs[i] != ActiveTasks[i].TaskID;
+
+	if (stale)
+		BuildActivityIndex();
+
+	// returned by value, crediting an activity can run quest code that accepts or removes tasks
+	auto it = ActivityIndex.find(ActivityIndexKey(ActivityType, GoalID));
+	if (it == ActivityIndex.end())
+		return std::vector<IndexedActivity>();
+
+	return it->second;
+}
+
 void ClientTaskState::UpdateTasksOnKill(Client *c, int NPCTypeID) {
 
 	UpdateTasksByNPC(c, ActivityKill, NPCTypeID);
@@ -1525,56 +1604,30 @@ bool ClientTaskState::UpdateTasksByNPC(Client *c, int ActivityType, int NPCTypeI
 	if (!taskmanager || (ActiveTaskCount == 0 && ActiveTask.TaskID == TASKSLOTEMPTY)) // could be better ...
 		return false;
 
-	// loop over the union of tasks and quests
-	for (int i = 0; i < MAXACTIVEQUESTS + 1; i++) {
-		auto cur_task = &ActiveTasks[i];
-		if (cur_task->TaskID == TASKSLOTEMPTY)
+	// only the activities of this type that target this NPC, in task/activity order
+	for (auto &indexed : GetIndexedActivities(ActivityType, NPCTypeID)) {
+		auto cur_task = &ActiveTasks[indexed.TaskIndex];
+		if (cur_task->TaskID != indexed.TaskID)
 			continue;
 
-		// Check if there are any active kill activities for this task
-
 		auto Task = taskmanager->Tasks[cur_task->TaskID];
+		int j = indexed.ActivityID;
 
-		if (Task == nullptr)
-			return false;
-
-		for (int j = 0; j < Task->ActivityCount; j++) {
-			// We are not interested in completed or hidden activities
-			if (cur_task->Activity[j].State != ActivityActive)
-				continue;
-			// We are only interested in Kill activities
-			if (Task->Activity[j].Type != ActivityType)
-				continue;
-			// Is there a zone restriction on the activity ?
-			if (!Task->Activity[j].CheckZone(zone->GetZoneID())) {
-				Log(Logs::General, Logs::Tasks,
-					"[UPDATE] Char: %s Task: %i, Activity %i, Activity type %i for NPC %i failed zone "
-					"check",
-					c->GetName(), cur_task->TaskID, j, ActivityType, NPCTypeID);
-				continue;
-			}
-			// Is the activity to kill this type of NPC ?
-			switch (Task->Activity[j].GoalMethod) {
-
-			case METHODSINGLEID:
-				if (Task->Activity[j].GoalID != NPCTypeID)
-					continue;
-				break;
-
-			case METHODLIST:
-				if (!taskmanager->GoalListManager.IsInList(Task->Activity[j].GoalID, NPCTypeID))
-					continue;
-				break;
-
-			default:
-				// If METHODQUEST, don't update the activity here
-				continue;
-			}
-			// We found an active task to kill this type of NPC, so increment the done count
-			Log(Logs::General, Logs::Tasks, "[UPDATE] Calling increment done count ByNPC");
-			IncrementDoneCount(c, Task, cur_task->slot, j);
-			Ret = true;
+		// We are not interested in completed or hidden activities
+		if (cur_task->Activity[j].State != ActivityActive)
+			continue;
+		// Is there a zone restriction on the activity ?
+		if (!Task->Activity[j].CheckZone(zone->GetZoneID())) {
+			Log(Logs::General, Logs::Tasks,
+				"[UPDATE] Char: %s Task: %i, Activity %i, Activity type %i for NPC %i failed zone "
+				"check",
+				c->GetName(), cur_task->TaskID, j, ActivityType, NPCTypeID);
+			continue;
 		}
+		// We found an active task to kill this type of NPC, so increment the done count
+		Log(Logs::General, Logs::Tasks, "[UPDATE] Calling increment done count ByNPC");
+		IncrementDoneCount(c, Task, cur_task->slot, j);
+		Ret = true;
 	}
 
 	return Ret;
@@ -1669,52 +1722,27 @@ void ClientTaskState::UpdateTasksForItem(Client *c, ActivityType Type, int ItemI
 	if (!taskmanager || (ActiveTaskCount == 0 && ActiveTask.TaskID == TASKSLOTEMPTY)) // could be better ...
 		return;
 
-	// loop over the union of tasks and quests
-	for (int i = 0; i < MAXACTIVEQUESTS + 1; i++) {
-		auto cur_task = &ActiveTasks[i];
-		if (cur_task->TaskID == TASKSLOTEMPTY)
+	// only the activities of this type that relate to this item, in task/activity order
+	for (auto &indexed : GetIndexedActivities(Type, ItemID)) {
+		auto cur_task = &ActiveTasks[indexed.TaskIndex];
+		if (cur_task->TaskID != indexed.TaskID)
 			continue;
 
-		// Check if there are any active loot activities for this task
-
 		TaskInformation* Task = taskmanager->Tasks[cur_task->TaskID];
+		int j = indexed.ActivityID;
 
-		if (Task == nullptr)
-			return;
-
-		for (int j = 0; j < Task->ActivityCount; j++) {
-			// We are not interested in completed or hidden activities
-			if (cur_task->Activity[j].State != ActivityActive)
-				continue;
-			// We are only interested in the ActivityType we were called with
-			if (Task->Activity[j].Type != (int)Type)
-				continue;
-			// Is there a zone restriction on the activity ?
-			if (!Task->Activity[j].CheckZone(zone->GetZoneID())) {
-				Log(Logs::General, Logs::Tasks, "[UPDATE] Char: %s Activity type %i for Item %i failed zone check",
-							c->GetName(), Type, ItemID);
-				continue;
-			}
-			// Is the activity related to this item ?
-			//
-			switch(Task->Activity[j].GoalMethod) {
-
-				case METHODSINGLEID:
-					if(Task->Activity[j].GoalID != ItemID) continue;
-					break;
-
-				case METHODLIST:
-					if(!taskmanager->GoalListManager.IsInList(Task->Activity[j].GoalID, ItemID)) continue;
-					break;
-
-				default:
-					// If METHODQUEST, don't update the activity here
-					continue;
-			}
-			// We found an active task related to this item, so increment the done count
-			Log(Logs::General, Logs::Tasks, "[UPDATE] Calling increment done count ForItem");
-			IncrementDoneCount(c, Task, cur_task->slot, j, Count);
+		// We are not interested in completed or hidden activities
+		if (cur_task->Activity[j].State != ActivityActive)
+			continue;
+		// Is there a zone restriction on the activity ?
+		if (!Task->Activity[j].CheckZone(zone->GetZoneID())) {
+			Log(Logs::General, Logs::Tasks, "[UPDATE] Char: %s Activity type %i for Item %i failed zone check",
+						c->GetName(), Type, ItemID);
+			continue;
 		}
+		// We found an active task related to this item, so increment the done count
+		Log(Logs::General, Logs::Tasks, "[UPDATE] Calling increment done count ForItem");
+		IncrementDoneCount(c, Task, cur_task->slot, j, Count);
 	}
 
 	return;
@@ -1729,55 +1757,29 @@ void ClientTaskState::UpdateTasksOnExplore(Client *c, int ExploreID)
 	if (!taskmanager || (ActiveTaskCount == 0 && ActiveTask.TaskID == TASKSLOTEMPTY)) // could be better ...
 		return;
 
-	// loop over the union of tasks and quests
-	for (int i = 0; i < MAXACTIVEQUESTS + 1; i++) {
-		auto cur_task = &ActiveTasks[i];
-		if (cur_task->TaskID == TASKSLOTEMPTY)
+	// only the explore activities for this area id, in task/activity order
+	for (auto &indexed : GetIndexedActivities(ActivityExplore, ExploreID)) {
+		auto cur_task = &ActiveTasks[indexed.TaskIndex];
+		if (cur_task->TaskID != indexed.TaskID)
 			continue;
 
-		// Check if there are any active explore activities for this task
-
 		TaskInformation *Task = taskmanager->Tasks[cur_task->TaskID];
+		int j = indexed.ActivityID;
 
-		if (Task == nullptr)
-			return;
-
-		for (int j = 0; j < Task->ActivityCount; j++) {
-			// We are not interested in completed or hidden activities
-			if (cur_task->Activity[j].State != ActivityActive)
-				continue;
-			// We are only interested in explore activities
-			if (Task->Activity[j].Type != ActivityExplore)
-				continue;
-			if (!Task->Activity[j].CheckZone(zone->GetZoneID())) {
-				Log(Logs::General, Logs::Tasks,
-				    "[UPDATE] Char: %s Explore exploreid %i failed zone check", c->GetName(),
-				    ExploreID);
-				continue;
-			}
-			// Is the activity to explore this area id ?
-			switch (Task->Activity[j].GoalMethod) {
-
-			case METHODSINGLEID:
-				if (Task->Activity[j].GoalID != ExploreID)
-					continue;
-				break;
-
-			case METHODLIST:
-				if (!taskmanager->GoalListManager.IsInList(Task->Activity[j].GoalID, ExploreID))
-					continue;
-				break;
-
-			default:
-				// If METHODQUEST, don't update the activity here
-				continue;
-			}
-			// We found an active task to explore this area, so set done count to goal count
-			// (Only a goal count of 1 makes sense for explore activities?)
-			Log(Logs::General, Logs::Tasks, "[UPDATE] Increment on explore");
-			IncrementDoneCount(c, Task, cur_task->slot, j,
-					   Task->Activity[j].GoalCount - cur_task->Activity[j].DoneCount);
+		// We are not interested in completed or hidden activities
+		if (cur_task->Activity[j].State != ActivityActive)
+			continue;
+		if (!Task->Activity[j].CheckZone(zone->GetZoneID())) {
+			Log(Logs::General, Logs::Tasks,
+			    "[UPDATE] Char: %s Explore exploreid %i failed zone check", c->GetName(),
+			    ExploreID);
+			continue;
 		}
+		// We found an active task to explore this area, so set done count to goal count
+		// (Only a goal count of 1 makes sense for explore activities?)
+		Log(Logs::General, Logs::Tasks, "[UPDATE] Increment on explore");
+		IncrementDoneCount(c, Task, cur_task->slot, j,
+				   Task->Activity[j].GoalCount - cur_task->Activity[j].DoneCount);
 	}
 
 	return;
@@ -1792,67 +1794,65 @@ bool ClientTaskState::UpdateTasksOnDeliver(Client *c, std::list<EQ::ItemInstance
 	if (!taskmanager || (ActiveTaskCount == 0 && ActiveTask.TaskID == TASKSLOTEMPTY)) // could be better ...
 		return false;
 
-	// loop over the union of tasks and quests
-	for (int i = 0; i < MAXACTIVEQUESTS + 1; i++) {
+	// only the deliver and give cash activities for this NPC, merged back into task/activity order
+	auto candidates = GetIndexedActivities(ActivityDeliver, NPCTypeID);
+	auto cash_candidates = GetIndexedActivities(ActivityGiveCash, NPCTypeID);
+	if (!cash_candidates.empty()) {
+		candidates.insert(candidates.end(), cash_candidates.begin(), cash_candidates.end());
+		std::sort(candidates.begin(), candidates.end(), [](const IndexedActivity &a, const IndexedActivity &b) {
+			return a.TaskIndex != b.TaskIndex ? a.TaskIndex < b.TaskIndex : a.ActivityID < b.ActivityID;
+		});
+	}
+
+	for (auto &indexed : candidates) {
+		int i = indexed.TaskIndex;
 		auto cur_task = &ActiveTasks[i];
-		if (cur_task->TaskID == TASKSLOTEMPTY)
+		if (cur_task->TaskID != indexed.TaskID)
 			continue;
 
-		// Check if there are any active deliver activities for this task
-
 		TaskInformation *Task = taskmanager->Tasks[cur_task->TaskID];
+		int j = indexed.ActivityID;
 
-		if (Task == nullptr)
-			return false;
+		// We are not interested in completed or hidden activities
+		if (cur_task->Activity[j].State != ActivityActive)
+			continue;
+		// Is there a zone restriction on the activity ?
+		if (!Task->Activity[j].CheckZone(zone->GetZoneID())) {
+			Log(Logs::General, Logs::Tasks,
+			    "[UPDATE] Char: %s Deliver activity failed zone check (current zone %i, need zone "
+			    "%s",
+			    c->GetName(), zone->GetZoneID(), Task->Activity[j].zones.c_str());
+			continue;
+		}
+		// Is the activity related to these items ?
+		//
+		if ((Task->Activity[j].Type == ActivityGiveCash) && Cash) {
+			Log(Logs::General, Logs::Tasks, "[UPDATE] Increment on GiveCash");
+			IncrementDoneCount(c, Task, i, j, Cash);
+			Ret = true;
+		} else {
+			for (auto &k : Items) {
+				switch (Task->Activity[j].GoalMethod) {
 
-		for (int j = 0; j < Task->ActivityCount; j++) {
-			// We are not interested in completed or hidden activities
-			if (cur_task->Activity[j].State != ActivityActive)
-				continue;
-			// We are only interested in Deliver activities
-			if (Task->Activity[j].Type != ActivityDeliver && Task->Activity[j].Type != ActivityGiveCash)
-				continue;
-			// Is there a zone restriction on the activity ?
-			if (!Task->Activity[j].CheckZone(zone->GetZoneID())) {
-				Log(Logs::General, Logs::Tasks,
-				    "[UPDATE] Char: %s Deliver activity failed zone check (current zone %i, need zone "
-				    "%s",
-				    c->GetName(), zone->GetZoneID(), Task->Activity[j].zones.c_str());
-				continue;
-			}
-			// Is the activity to deliver to this NPCTypeID ?
-			if (Task->Activity[j].DeliverToNPC != NPCTypeID)
-				continue;
-			// Is the activity related to these items ?
-			//
-			if ((Task->Activity[j].Type == ActivityGiveCash) && Cash) {
-				Log(Logs::General, Logs::Tasks, "[UPDATE] Increment on GiveCash");
-				IncrementDoneCount(c, Task, i, j, Cash);
-				Ret = true;
-			} else {
-				for (auto &k : Items) {
-					switch (Task->Activity[j].GoalMethod) {
-
-					case METHODSINGLEID:
-						if (Task->Activity[j].GoalID != k->GetID())
-							continue;
-						break;
-
-					case METHODLIST:
-						if (!taskmanager->GoalListManager.IsInList(Task->Activity[j].GoalID,
-											   k->GetID()))
-							continue;
-						break;
-
-					default:
-						// If METHODQUEST, don't update the activity here
+				case METHODSINGLEID:
+					if (Task->Activity[j].GoalID != k->GetID())
+						continue;
+					break;
+
+				case METHODLIST:
+					if (!taskmanager->GoalListManager.IsInList(Task->Activity[j].GoalID,
+										   k->GetID()))
 						continue;
-					}
-					// We found an active task related to this item, so increment the done count
-					Log(Logs::General, Logs::Tasks, "[UPDATE] Increment on GiveItem");
-					IncrementDoneCount(c, Task, cur_task->slot, j, k->GetCharges() <= 0 ? 1 : k->GetCharges());
-					Ret = true;
+					break;
+
+				default:
+					// If METHODQUEST, don't update the activity here
+					continue;
 				}
+				// We found an active task related to this item, so increment the done count
+				Log(Logs::General, Logs::Tasks, "[UPDATE] Increment on GiveItem");
+				IncrementDoneCount(c, Task, cur_task->slot, j, k->GetCharges() <= 0 ? 1 : k->GetCharges());
+				Ret = true;
 			}
 		}
 	}
@@ -3475,6 +3475,12 @@ bool TaskGoalListManager::LoadLists()
 		}
 	}
 
+	// both are loaded in order already, but lookups depend on it so don't trust the collation
+	std::sort(TaskGoalLists.begin(), TaskGoalLists.end(),
+		  [](const TaskGoalList_Struct &a, const TaskGoalList_Struct &b) { return a.ListID < b.ListID; });
+	for (auto &list : TaskGoalLists)
+		std::sort(list.GoalItemEntries.begin(), list.GoalItemEntries.end());
+
 	return true;
 
 }
@@ -3482,10 +3488,10 @@ bool TaskGoalListManager::LoadLists()
 int TaskGoalListManager::GetListByID(int ListID) {
 
 	// Find the list with the specified ListID and return the index
-	auto it = std::find_if(TaskGoalLists.begin(), TaskGoalLists.end(),
-			       [ListID](const TaskGoalList_Struct &t) { return t.ListID == ListID; });
+	auto it = std::lower_bound(TaskGoalLists.begin(), TaskGoalLists.end(), ListID,
+				   [](const TaskGoalList_Struct &t, int id) { return t.ListID < id; });
 
-	if (it == TaskGoalLists.end())
+	if (it == TaskGoalLists.end() || it->ListID != ListID)
 		return -1;
 
 	return std::distance(TaskGoalLists.begin(), it);
@@ -3531,9 +3537,7 @@ bool TaskGoalListManager::IsInList(int ListID, int Entry)
 	int FirstEntry = 0;
 	auto &task = TaskGoalLists[ListIndex];
 
-	auto it = std::find(task.GoalItemEntries.begin(), task.GoalItemEntries.end(), Entry);
-
-	if (it == task.GoalItemEntries.end())
+	if (!std::binary_search(task.GoalItemEntries.begin(), task.GoalItemEntries.end(), Entry))
 		return false;
 
 	Log(Logs::General, Logs::Tasks, "[UPDATE] TaskGoalListManager::IsInList(%i, %i) returning true", ListIndex,
@@ -26,6 +26,7 @@ Copyright (C) 2001-2004 EQEMu Development Team (http://eqemulator.net)
 #include <vector>
 #include <string>
 #include <algorithm>
+#include <unordered_map>
 
 #define MAXTASKS 10000
 #define MAXTASKSETS 1000
@@ -56,7 +57,7 @@ namespace EQ
 struct TaskGoalList_Struct {
 	int ListID;
 	int Min, Max;
-	std::vector<int> GoalItemEntries;
+	std::vector<int> GoalItemEntries; // kept sorted so IsInList can binary search
 };
 
 // This is used for handling lists, loading them from the database, searching them.
@@ -76,7 +77,7 @@ public:
 
 private:
 
-	std::vector<TaskGoalList_Struct> TaskGoalLists;
+	std::vector<TaskGoalList_Struct> TaskGoalLists; // sorted by ListID
 	int NumberOfLists;
 };
 
@@ -245,7 +246,16 @@ public:
 	friend class TaskManager;
 
 private:
+	// An activity of one of our active tasks, as found through ActivityIndex
+	struct IndexedActivity {
+		int TaskIndex; // into ActiveTasks
+		int TaskID;
+		int ActivityID;
+	};
+
 	bool UnlockActivities(int CharID, ClientTaskInformation &task_info);
+	void BuildActivityIndex();
+	std::vector<IndexedActivity> GetIndexedActivities(int ActivityType, int GoalID);
 	void IncrementDoneCount(Client *c, TaskInformation *Task, int TaskIndex, int ActivityID, int Count = 1, bool ignore_quest_update = false);
 	inline ClientTaskInformation *GetClientTaskInfo(TaskType type, int index)
 	{
@@ -279,6 +289,12 @@ private:
 	std::vector<CompletedTaskInformation> CompletedTasks;
 	int LastCompletedTaskLoaded;
 	bool CheckedTouchActivities;
+	// (activity type, goal id) -> activities of the active tasks that event would credit, regardless of
+	// activity state. It only depends on which tasks are active, so it is rebuilt lazily whenever the
+	// task in a slot changes or the task manager reloads task data.
+	std::unordered_map<uint64, std::vector<IndexedActivity>> ActivityIndex;
+	int IndexedTaskIDs[MAXACTIVEQUESTS + 1];
+	uint32 IndexedGeneration;
 };
 
 
@@ -325,6 +341,7 @@ private:
 	TaskProximityManager ProximityManager;
 	TaskInformation* Tasks[MAXTASKS];
 	std::vector<int> TaskSets[MAXTASKSETS];
+	uint32 TaskDataGeneration; // bumped on every task or goal list reload, invalidates client activity indexes
 	void SendActiveTaskDescription(Client *c, int TaskID, ClientTaskInformation &task_info, int StartTime, int Duration, bool BringUpTaskJournal=false);
 
 };
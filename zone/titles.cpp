@@ -27,7 +27,7 @@
 #include "titles.h"
 #include "worldserver.h"
 
-extern WorldServer worldserver;
+extern WorldServer &worldserver;
 
 TitleManager::TitleManager() {
 }
@@ -32,7 +32,7 @@
 
 class QueryServ;
 
-extern WorldServer worldserver;
+extern WorldServer &worldserver;
 extern QueryServ* QServ;
 
 // The maximum amount of a single bazaar/barter transaction expressed in copper.
@@ -43,7 +43,7 @@
 #endif
 
 extern QueryServ* QServ;
-extern WorldServer worldserver;
+extern WorldServer &worldserver;
 
 #ifdef _WINDOWS
 #define snprintf	_snprintf
@@ -51,8 +51,8 @@ extern WorldServer worldserver;
 #define strcasecmp	_stricmp
 #endif
 
-extern EntityList entity_list;
-extern Zone* zone;
+extern EntityList &entity_list;
+extern Zone*& zone;
 
 void Mob::Tune_FindATKByPctMitigation(Mob* defender,Mob *attacker, float pct_mitigation, int interval, int max_loop, int ac_override, int Msg)
 {
@@ -19,6 +19,28 @@ inline bool file_exists(const std::string& name) {
 	return f.good();
 }
 
+/**
+ * @param locations
+ * @param types
+ */
+void WaterMap::ReturnRegionTypes(const std::vector<glm::vec3>& locations, std::vector<WaterRegionType>& types) const {
+	types.resize(locations.size());
+	for (size_t i = 0; i < locations.size(); ++i) {
+		types[i] = ReturnRegionType(locations[i]);
+	}
+}
+
+/**
+ * @param locations
+ * @param in_liquid
+ */
+void WaterMap::InLiquid(const std::vector<glm::vec3>& locations, std::vector<bool>& in_liquid) const {
+	in_liquid.resize(locations.size());
+	for (size_t i = 0; i < locations.size(); ++i) {
+		in_liquid[i] = InLiquid(locations[i]);
+	}
+}
+
 /**
  * @param zone_name
  * @return
@@ -5,6 +5,7 @@
 #include "position.h"
 #include "zone_config.h"
 #include <string>
+#include <vector>
 
 extern const ZoneConfig *Config;
 
@@ -36,6 +37,10 @@ public:
 	virtual bool InPvP(const glm::vec3& location) const = 0;
 	virtual bool InZoneLine(const glm::vec3& location) const = 0;
 
+	// batched lookups, one result per location in the same order
+	virtual void ReturnRegionTypes(const std::vector<glm::vec3>& locations, std::vector<WaterRegionType>& types) const;
+	virtual void InLiquid(const std::vector<glm::vec3>& locations, std::vector<bool>& in_liquid) const;
+
 protected:
 	virtual bool Load(FILE *fp) { return false; }
 };
@@ -1,22 +1,151 @@
 #include "water_map_v2.h"
 
+#include <algorithm>
+
 WaterMapV2::WaterMapV2() {
 }
 
 WaterMapV2::~WaterMapV2() {
 }
 
+#define REGION_GRID_MIN_CELL_SIZE 32.0f
+#define REGION_GRID_MAX_CELLS_PER_AXIS 256
+#define REGION_BOUNDS_EPSILON 0.01f
+
 WaterRegionType WaterMapV2::ReturnRegionType(const glm::vec3& location) const {
-	size_t sz = regions.size();
-	for(size_t i = 0; i < sz; ++i) {
-		auto const &region = regions[i];
-		if (region.second.ContainsPoint(glm::vec3(location.y, location.x, location.z))) {
+	return FindRegionType(glm::vec3(location.y, location.x, location.z));
+}
+
+/**
+ * @param point location already swizzled into region space
+ */
+WaterRegionType WaterMapV2::FindRegionType(const glm::vec3& point) const {
+	if (grid_offsets.empty()) {
+		return RegionTypeNormal;
+	}
+
+	float fx = (point.x - grid_min_x) / grid_cell_size;
+	float fy = (point.y - grid_min_y) / grid_cell_size;
+	if (fx < 0.0f || fy < 0.0f || fx >= grid_width || fy >= grid_height) {
+		return RegionTypeNormal;
+	}
+
+	int64 cell = static_cast<int64>(fy) * grid_width + static_cast<int64>(fx);
+
+	for (uint32 i = grid_offsets[cell]; i < grid_offsets[cell + 1]; ++i) {
+		uint32 index = grid_regions[i];
+		auto const &bounds = region_bounds[index];
+		if (point.x < bounds.min.x || point.x > bounds.max.x ||
+			point.y < bounds.min.y || point.y > bounds.max.y ||
+			point.z < bounds.min.z || point.z > bounds.max.z) {
+			continue;
+		}
+
+		auto const &region = regions[index];
+		if (region.second.ContainsPoint(point)) {
 			return region.first;
 		}
 	}
+
 	return RegionTypeNormal;
 }
 
+void WaterMapV2::ReturnRegionTypes(const std::vector<glm::vec3>& locations, std::vector<WaterRegionType>& types) const {
+	types.resize(locations.size());
+
+	for (size_t i = 0; i < locations.size(); ++i) {
+		auto const &location = locations[i];
+		types[i] = FindRegionType(glm::vec3(location.y, location.x, location.z));
+	}
+}
+
+void WaterMapV2::InLiquid(const std::vector<glm::vec3>& locations, std::vector<bool>& in_liquid) const {
+	std::vector<WaterRegionType> types;
+	ReturnRegionTypes(locations, types);
+
+	in_liquid.resize(locations.size());
+	for (size_t i = 0; i < types.size(); ++i) {
+		in_liquid[i] = types[i] == RegionTypeWater || types[i] == RegionTypeVWater || types[i] == RegionTypeLava;
+	}
+}
+
+void WaterMapV2::BuildRegionGrid() {
+	region_bounds.clear();
+	grid_offsets.clear();
+	grid_regions.clear();
+
+	if (regions.empty()) {
+		return;
+	}
+
+	glm::vec3 min;
+	glm::vec3 max;
+	region_bounds.resize(regions.size());
+	for (size_t i = 0; i < regions.size(); ++i) {
+		auto &bounds = region_bounds[i];
+		regions[i].second.GetAxisAlignedBounds(bounds.min, bounds.max);
+		bounds.min -= glm::vec3(REGION_BOUNDS_EPSILON);
+		bounds.max += glm::vec3(REGION_BOUNDS_EPSILON);
+
+		if (i == 0) {
+			min = bounds.min;
+			max = bounds.max;
+			continue;
+		}
+
+		min.x = std::min(min.x, bounds.min.x);
+		min.y = std::min(min.y, bounds.min.y);
+		max.x = std::max(max.x, bounds.max.x);
+		max.y = std::max(max.y, bounds.max.y);
+	}
+
+	grid_min_x = min.x;
+	grid_min_y = min.y;
+	grid_cell_size = std::max(
+		REGION_GRID_MIN_CELL_SIZE,
+		std::max(max.x - min.x, max.y - min.y) / REGION_GRID_MAX_CELLS_PER_AXIS
+	);
+	grid_width = static_cast<uint32>((max.x - min.x) / grid_cell_size) + 1;
+	grid_height = static_cast<uint32>((max.y - min.y) / grid_cell_size) + 1;
+
+	// count then fill so every cell's regions are contiguous and in load order
+	std::vector<uint32> counts(grid_width * grid_height + 1, 0);
+	for (int pass = 0; pass < 2; ++pass) {
+		for (uint32 i = 0; i < regions.size(); ++i) {
+			auto &bounds = region_bounds[i];
+			uint32 x0 = static_cast<uint32>((bounds.min.x - grid_min_x) / grid_cell_size);
+			uint32 y0 = static_cast<uint32>((bounds.min.y - grid_min_y) / grid_cell_size);
+			uint32 x1 = std::min(static_cast<uint32>((bounds.max.x - grid_min_x) / grid_cell_size), grid_width - 1);
+			uint32 y1 = std::min(static_cast<uint32>((bounds.max.y - grid_min_y) / grid_cell_size), grid_height - 1);
+
+			for (uint32 y = y0; y <= y1; ++y) {
+				for (uint32 x = x0; x <= x1; ++x) {
+					uint32 cell = y * grid_width + x;
+					if (pass == 0) {
+						counts[cell]++;
+					}
+					else {
+						grid_regions[grid_offsets[cell] + counts[cell]++] = i;
+					}
+				}
+			}
+		}
+
+		if (pass == 0) {
+			grid_offsets.resize(grid_width * grid_height + 1);
+			uint32 total = 0;
+			for (uint32 cell = 0; cell < grid_width * grid_height; ++cell) {
+				grid_offsets[cell] = total;
+				total += counts[cell];
+				counts[cell] = 0;
+			}
+
+			grid_offsets[grid_width * grid_height] = total;
+			grid_regions.resize(total);
+		}
+	}
+}
+
 bool WaterMapV2::InWater(const glm::vec3& location) const {
 	return ReturnRegionType(location) == RegionTypeWater;
 }
@@ -119,5 +248,7 @@ bool WaterMapV2::Load(FILE *fp) {
 			OrientedBoundingBox(glm::vec3(x, y, z), glm::vec3(x_rot, y_rot, z_rot), glm::vec3(x_scale, y_scale, z_scale), glm::vec3(x_extent, y_extent, z_extent))));
 	}
 
+	BuildRegionGrid();
+
 	return true;
 }
@@ -19,12 +19,36 @@ public:
 	virtual bool InLiquid(const glm::vec3& location) const;
 	virtual bool InPvP(const glm::vec3& location) const;
 	virtual bool InZoneLine(const glm::vec3& location) const;
+	virtual void ReturnRegionTypes(const std::vector<glm::vec3>& locations, std::vector<WaterRegionType>& types) const;
+	virtual void InLiquid(const std::vector<glm::vec3>& locations, std::vector<bool>& in_liquid) const;
 
 protected:
 	virtual bool Load(FILE *fp);
 
 	std::vector<std::pair<WaterRegionType, OrientedBoundingBox>> regions;
 	friend class WaterMap;
+
+private:
+	void BuildRegionGrid();
+	WaterRegionType FindRegionType(const glm::vec3& point) const;
+
+	/**
+	 * Uniform x/y grid over the regions' world bounds; each cell lists, in load order,
+	 * the regions whose bounds overlap it so a lookup only tests nearby boxes
+	 */
+	struct RegionBounds {
+		glm::vec3 min;
+		glm::vec3 max;
+	};
+
+	std::vector<RegionBounds> region_bounds;
+	float grid_min_x = 0.0f;
+	float grid_min_y = 0.0f;
+	float grid_cell_size = 1.0f;
+	uint32 grid_width = 0;
+	uint32 grid_height = 0;
+	std::vector<uint32> grid_offsets;
+	std::vector<uint32> grid_regions;
 };
 
 #endif
@@ -54,13 +54,14 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include "zone.h"
 #include "zone_config.h"
 #include "zone_reload.h"
+#include "zone_profiler.h"
 
 
-extern EntityList entity_list;
-extern Zone* zone;
+extern EntityList &entity_list;
+extern Zone*& zone;
 extern volatile bool is_zone_loaded;
 extern void Shutdown();
-extern WorldServer worldserver;
+extern WorldServer &worldserver;
 extern PetitionList petition_list;
 extern uint32 numclients;
 extern volatile bool RunLoops;
@@ -72,6 +73,7 @@ WorldServer::WorldServer()
 {
 	cur_groupid = 0;
 	last_groupid = 0;
+	client_list_sequence = 0;
 	oocmuted = false;
 }
 
@@ -158,6 +160,9 @@ void WorldServer::OnConnected() {
 	SendPacket(pack);
 	safe_delete(pack);
 
+	// world starts a new connection's sequence at zero
+	client_list_sequence = 0;
+
 	if (is_zone_loaded) {
 		this->SetZoneData(zone->GetZoneID(), zone->GetInstanceID());
 		entity_list.UpdateWho(true);
@@ -178,6 +183,8 @@ void WorldServer::OnConnected() {
 /* Zone Process Packets from World */
 void WorldServer::HandleMessage(uint16 opcode, const EQ::Net::Packet &p)
 {
+	ZoneProfiler::Scope profiler_scope(zone_profiler, ZoneProfiler::WorldPackets);
+
 	ServerPacket tpack(opcode, p);
 	ServerPacket *pack = &tpack;
 
@@ -840,6 +847,20 @@ void WorldServer::HandleMessage(uint16 opcode, const EQ::Net::Packet &p)
 			LogError("Received request to refresh the profanity list..but, the action failed");
 		break;
 	}
+	case ServerOP_ClientListResync: {
+		if (pack->size != sizeof(ServerClientListResync_Struct))
+			break;
+		auto resync = (ServerClientListResync_Struct*)pack->pBuffer;
+		LogInfo(
+			"World requested a client list resync, world sequence [{}] zone sequence [{}]",
+			resync->sequence,
+			client_list_sequence
+		);
+		entity_list.UpdateWho(true);
+		entity_list.SendWhoKeepAlive();
+		entity_list.SendClientListSync(true);
+		break;
+	}
 	case ServerOP_ChangeWID: {
 		if (pack->size != sizeof(ServerChangeWID_Struct)) {
 			std::cout << "Wrong size on ServerChangeWID_Struct. Got: " << pack->size << ", Expected: " << sizeof(ServerChangeWID_Struct) << std::endl;
@@ -924,7 +945,7 @@ void WorldServer::HandleMessage(uint16 opcode, const EQ::Net::Packet &p)
 					break;
 				}
 
-				database.SetGroupID(Inviter->GetName(), group->GetID(), Inviter->CastToClient()->CharacterID(), false);
+				Group::SendWorldGroupID(Inviter->GetName(), group->GetID(), Inviter->CastToClient()->CharacterID(), false);
 				database.SetGroupLeaderName(group->GetID(), Inviter->GetName());
 				group->UpdateGroupAAs();
 
@@ -987,6 +1008,7 @@ void WorldServer::HandleMessage(uint16 opcode, const EQ::Net::Packet &p)
 				new ServerPacket(ServerOP_GroupFollowAck, sizeof(ServerGroupFollowAck_Struct));
 			ServerGroupFollowAck_Struct* sgfas = (ServerGroupFollowAck_Struct*)pack3->pBuffer;
 			strn0cpy(sgfas->Name, sgfs->gf.name2, sizeof(sgfas->Name));
+			sgfas->gid = group->GetID();
 			worldserver.SendPacket(pack3);
 			safe_delete(pack3);
 		}
@@ -1001,31 +1023,20 @@ void WorldServer::HandleMessage(uint16 opcode, const EQ::Net::Packet &p)
 		if (!client)
 			break;
 
-		uint32 groupid = database.GetGroupID(client->GetName());
-
 		Group* group = nullptr;
 
-		if (groupid > 0)
+		if (sgfas->gid > 0)
 		{
-			group = entity_list.GetGroupByID(groupid);
-
-			if (!group)
-			{	//nobody from our group is here... start a new group
-				group = new Group(groupid);
-
-				if (group->GetID() != 0)
-					entity_list.AddGroup(group, groupid);
-				else
-					group = nullptr;
-			}
+			// world sent this zone the group's roster just ahead of the ack
+			group = entity_list.GetGroupByID(sgfas->gid);
 
 			if (group)
 				group->UpdatePlayer(client);
 			else
 			{
 				if (client->GetMerc())
-					database.SetGroupID(client->GetMerc()->GetCleanName(), 0, client->CharacterID(), true);
-				database.SetGroupID(client->GetName(), 0, client->CharacterID(), false);	//cannot re-establish group, kill it
+					Group::SendWorldGroupID(client->GetMerc()->GetCleanName(), 0, client->CharacterID(), true);
+				Group::SendWorldGroupID(client->GetName(), 0, client->CharacterID(), false);	//cannot re-establish group, kill it
 			}
 
 		}
@@ -1147,6 +1158,53 @@ void WorldServer::HandleMessage(uint16 opcode, const EQ::Net::Packet &p)
 		}
 		break;
 	}
+	case ServerOP_CharacterRoster: {
+		if (!zone || pack->size < sizeof(ServerCharacterRoster_Struct))
+			break;
+
+		ServerCharacterRoster_Struct* cr = (ServerCharacterRoster_Struct*)pack->pBuffer;
+		uint32 count = cr->group_member_count + cr->raid_member_count;
+		if (pack->size < sizeof(ServerCharacterRoster_Struct) + count * sizeof(ServerRosterMember_Struct))
+			break;
+
+		// world sends this right after the character's ServerOP_ZoneIncClient
+		zone->incoming_rosters[cr->char_id] = { cr->group_id, cr->raid_id };
+
+		if (cr->group_id) {
+			Group *g = entity_list.GetGroupByID(cr->group_id);
+			if (!g) {
+				g = new Group(cr->group_id);
+				entity_list.AddGroup(g, cr->group_id);
+			}
+			g->SetRosterFromWorld(cr->members, cr->group_member_count);
+		}
+
+		if (cr->raid_id) {
+			Raid *r = entity_list.GetRaidByID(cr->raid_id);
+			if (!r) {
+				r = new Raid(cr->raid_id);
+				entity_list.AddRaid(r, cr->raid_id);
+				r->LoadLeadership();
+			}
+			r->SetRosterFromWorld(cr->members + cr->group_member_count, cr->raid_member_count);
+		}
+		break;
+	}
+
+	case ServerOP_RaidMemberLevel: {
+		ServerRaidGeneralAction_Struct* rga = (ServerRaidGeneralAction_Struct*)pack->pBuffer;
+		if (zone) {
+			if (rga->zoneid == zone->GetZoneID() && rga->instance_id == zone->GetInstanceID())
+				break;
+
+			Raid *r = entity_list.GetRaidByID(rga->rid);
+			if (r) {
+				r->SetRosterLevel(rga->playername, rga->level);
+			}
+		}
+		break;
+	}
+
 	case ServerOP_RaidAdd: {
 		ServerRaidGeneralAction_Struct* rga = (ServerRaidGeneralAction_Struct*)pack->pBuffer;
 		if (zone) {
@@ -1155,7 +1213,8 @@ void WorldServer::HandleMessage(uint16 opcode, const EQ::Net::Packet &p)
 
 			Raid *r = entity_list.GetRaidByID(rga->rid);
 			if (r) {
-				r->LearnMembers();
+				r->AddRosterMember(rga->playername, rga->gid, rga->_class, rga->level,
+					rga->is_group_leader, rga->is_raid_leader, rga->is_looter);
 				r->VerifyRaid();
 				r->SendRaidAddAll(rga->playername);
 			}
@@ -1177,7 +1236,7 @@ void WorldServer::HandleMessage(uint16 opcode, const EQ::Net::Packet &p)
 					rem->LeaveRaidXTargets(r);
 					r->SendRaidDisband(rem);
 				}
-				r->LearnMembers();
+				r->RemoveRosterMember(rga->playername);
 				r->VerifyRaid();
 			}
 		}
@@ -1193,7 +1252,7 @@ void WorldServer::HandleMessage(uint16 opcode, const EQ::Net::Packet &p)
 			Raid *r = entity_list.GetRaidByID(rga->rid);
 			if (r) {
 				r->SendRaidDisbandAll();
-				r->LearnMembers();
+				r->ClearRoster();
 				r->VerifyRaid();
 			}
 		}
@@ -1208,7 +1267,7 @@ void WorldServer::HandleMessage(uint16 opcode, const EQ::Net::Packet &p)
 
 			Raid *r = entity_list.GetRaidByID(rga->rid);
 			if (r) {
-				r->GetRaidDetails(); //update our details
+				r->SetLocked(rga->gid != 0);
 				if (rga->gid)
 					r->SendRaidLock();
 				else
@@ -1226,7 +1285,7 @@ void WorldServer::HandleMessage(uint16 opcode, const EQ::Net::Packet &p)
 
 			Raid *r = entity_list.GetRaidByID(rga->rid);
 			if (r) {
-				r->LearnMembers();
+				r->MoveRosterMember(rga->playername, rga->gid);
 				r->VerifyRaid();
 				Client *c = entity_list.GetClientByName(rga->playername);
 				if (c) {
@@ -1266,6 +1325,11 @@ void WorldServer::HandleMessage(uint16 opcode, const EQ::Net::Packet &p)
 		if (zone) {
 			if (rga->zoneid == zone->GetZoneID() && rga->instance_id == zone->GetInstanceID())
 				break;
+
+			Raid *r = entity_list.GetRaidByID(rga->rid);
+			if (r) {
+				r->SetRosterGroupLeader(rga->playername, rga->is_group_leader);
+			}
 		}
 		break;
 	}
@@ -1283,7 +1347,7 @@ void WorldServer::HandleMessage(uint16 opcode, const EQ::Net::Packet &p)
 				if (c) {
 					r->SetLeader(c);
 				}
-				r->LearnMembers();
+				r->SetRosterRaidLeader(rga->playername);
 				r->VerifyRaid();
 				r->SendMakeLeaderPacket(rga->playername);
 			}
@@ -1300,8 +1364,7 @@ void WorldServer::HandleMessage(uint16 opcode, const EQ::Net::Packet &p)
 			Raid *r = entity_list.GetRaidByID(rga->rid);
 			if (r) {
 				r->GetRaidDetails();
-				r->LearnMembers();
-				r->VerifyRaid();
+				r->SetRosterLooter(rga->playername, rga->is_looter);
 			}
 		}
 		break;
@@ -1333,7 +1396,6 @@ void WorldServer::HandleMessage(uint16 opcode, const EQ::Net::Packet &p)
 		if (zone) {
 			Raid *r = entity_list.GetRaidByID(rga->rid);
 			if (r) {
-				r->LearnMembers();
 				r->VerifyRaid();
 				auto outapp = new EQApplicationPacket(OP_GroupUpdate, sizeof(GroupJoin_Struct));
 				GroupJoin_Struct* gj = (GroupJoin_Struct*)outapp->pBuffer;
@@ -1364,7 +1426,6 @@ void WorldServer::HandleMessage(uint16 opcode, const EQ::Net::Packet &p)
 		if (zone) {
 			Raid *r = entity_list.GetRaidByID(rga->rid);
 			if (r) {
-				r->LearnMembers();
 				r->VerifyRaid();
 				auto outapp = new EQApplicationPacket(OP_GroupUpdate, sizeof(GroupJoin_Struct));
 				GroupJoin_Struct* gj = (GroupJoin_Struct*)outapp->pBuffer;
@@ -2902,6 +2963,9 @@ void WorldServer::HandleMessage(uint16 opcode, const EQ::Net::Packet &p)
 		break;
 	}
 	case ServerOP_ExpeditionCreate:
+	case ServerOP_ExpeditionCreateRejected:
+	case ServerOP_ExpeditionAddRejected:
+	case ServerOP_ExpeditionCharacterInfo:
 	case ServerOP_ExpeditionDeleted:
 	case ServerOP_ExpeditionLeaderChanged:
 	case ServerOP_ExpeditionLockout:
@@ -2912,7 +2976,6 @@ void WorldServer::HandleMessage(uint16 opcode, const EQ::Net::Packet &p)
 	case ServerOP_ExpeditionMemberStatus:
 	case ServerOP_ExpeditionMembersRemoved:
 	case ServerOP_ExpeditionReplayOnJoin:
-	case ServerOP_ExpeditionGetOnlineMembers:
 	case ServerOP_ExpeditionDzAddPlayer:
 	case ServerOP_ExpeditionDzMakeLeader:
 	case ServerOP_ExpeditionDzCompass:
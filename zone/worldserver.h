@@ -47,6 +47,8 @@ public:
 	bool IsOOCMuted() const { return(oocmuted); }
 
 	uint32 NextGroupID();
+	inline uint32 NextClientListSequence() { return ++client_list_sequence; }
+	inline uint32 GetClientListSequence() const { return client_list_sequence; }
 
 	void SetLaunchedName(const char *n) { m_launchedName = n; }
 	void SetLauncherName(const char *n) { m_launcherName = n; }
@@ -71,6 +73,7 @@ private:
 
 	uint32 cur_groupid;
 	uint32 last_groupid;
+	uint32 client_list_sequence; // bumped by every client list update sent to world
 
 	void OnKeepAlive(EQ::Timer *t);
 
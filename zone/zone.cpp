@@ -57,11 +57,14 @@
 #include "npc_scale_manager.h"
 #include "../common/data_verification.h"
 #include "zone_reload.h"
+#include "zone_map_cache.h"
+#include "zone_profiler.h"
 #include "../common/repositories/criteria/content_filter_criteria.h"
 #include "../common/repositories/content_flags_repository.h"
 #include "../common/repositories/zone_points_repository.h"
 
 #include <time.h>
+#include <chrono>
 #include <ctime>
 #include <iostream>
 
@@ -75,14 +78,13 @@ extern bool staticzone;
 extern PetitionList petition_list;
 extern QuestParserCollection* parse;
 extern uint32 numclients;
-extern WorldServer worldserver;
-extern Zone* zone;
+extern WorldServer &worldserver;
+extern Zone*& zone;
 extern NpcScaleManager* npc_scale_manager;
 
 Mutex MZoneShutdown;
 
 volatile bool is_zone_loaded = false;
-Zone* zone = 0;
 
 void UpdateWindowTitle(char* iNewTitle);
 
@@ -99,6 +101,8 @@ bool Zone::Bootup(uint32 iZoneID, uint32 iInstanceID, bool iStaticZone) {
 
 	LogInfo("Booting [{}] ([{}]:[{}])", zonename, iZoneID, iInstanceID);
 
+	auto boot_start = std::chrono::steady_clock::now();
+
 	numclients = 0;
 	zone = new Zone(iZoneID, iInstanceID, zonename);
 
@@ -168,6 +172,12 @@ bool Zone::Bootup(uint32 iZoneID, uint32 iInstanceID, bool iStaticZone) {
 	 */
 	LogSys.StartFileLogs(StringFormat("%s_version_%u_inst_id_%u_port_%u", zone->GetShortName(), zone->GetInstanceVersion(), zone->GetInstanceID(), ZoneConfig::get()->ZonePort));
 
+	auto boot_ms = static_cast<uint32>(
+		std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - boot_start).count()
+	);
+	zone_profiler.RecordZoneBoot(boot_ms);
+	LogInfo("Zone Bootup: [{}] ready in [{}] ms", zonename, boot_ms);
+
 	return true;
 }
 
@@ -905,6 +915,37 @@ void Zone::Shutdown(bool quiet)
 	}
 }
 
+/**
+ * Takes ownership of the maps requested from the map cache in Init, waiting for them if they are still loading
+ */
+void Zone::JoinMaps()
+{
+	if (!m_pending_maps.valid()) {
+		return;
+	}
+
+	auto wait_start = std::chrono::steady_clock::now();
+	auto maps       = m_pending_maps.get();
+	m_pending_maps  = std::shared_future<ZoneMaps>();
+
+	zonemap  = maps.zonemap;
+	watermap = maps.watermap;
+	pathing  = maps.pathing;
+
+	LogSys.OutDeferred(maps.log_messages);
+
+	if (zonemap && m_cached_maps) {
+		zonemap->InvalidateLoSCache();
+	}
+
+	LogInfo(
+		"Maps for [{}] ready after waiting [{}] ms ([{}])",
+		map_name,
+		std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - wait_start).count(),
+		m_cached_maps ? "cached" : "loaded"
+	);
+}
+
 void Zone::LoadZoneDoors(const char* zone, int16 version)
 {
 	LogInfo("Loading doors for [{}] ", zone);
@@ -1039,6 +1080,7 @@ Zone::Zone(uint32 in_zoneid, uint32 in_instanceid, const char* in_short_name)
 
 	m_ucss_available = false;
 	m_last_ucss_update = 0;
+	m_cached_maps = false;
 
 	mMovementManager = &MobMovementManager::Get();
 
@@ -1048,6 +1090,17 @@ Zone::Zone(uint32 in_zoneid, uint32 in_instanceid, const char* in_short_name)
 
 Zone::~Zone() {
 	spawn2_list.Clear();
+	JoinMaps();
+	if (map_name) {
+		ZoneMaps maps;
+		maps.zonemap  = zonemap;
+		maps.watermap = watermap;
+		maps.pathing  = pathing;
+		ZoneMapCache::Instance().Release(map_name, maps);
+		zonemap  = nullptr;
+		watermap = nullptr;
+		pathing  = nullptr;
+	}
 	safe_delete(zonemap);
 	safe_delete(watermap);
 	safe_delete(pathing);
@@ -1090,9 +1143,8 @@ bool Zone::Init(bool iStaticZone) {
 		}
 	}
 
-	zone->zonemap  = Map::LoadMapFile(zone->map_name);
-	zone->watermap = WaterMap::LoadWaterMapfile(zone->map_name);
-	zone->pathing  = IPathfinder::Load(zone->map_name);
+	// maps load on worker threads while the rest of the zone is read from the database
+	m_pending_maps = ZoneMapCache::Instance().Acquire(zone->map_name, m_cached_maps);
 
 	LogInfo("Loading spawn conditions");
 	if(!spawn_conditions.LoadSpawnConditions(short_name, instanceid)) {
@@ -1131,6 +1183,9 @@ bool Zone::Init(bool iStaticZone) {
 		return false;
 	}
 
+	// ground spawns and objects snap to the map from here on
+	JoinMaps();
+
 	LogInfo("Loading adventure flavor text");
 	LoadAdventureFlavor();
 
@@ -1186,8 +1241,8 @@ bool Zone::Init(bool iStaticZone) {
 	petition_list.ClearPetitions();
 	petition_list.ReadDatabase();
 
-	LogInfo("Loading active Expeditions");
-	Expedition::CacheAllFromDatabase();
+	LogInfo("Requesting active Expeditions from world");
+	Expedition::SendWorldCacheRequest();
 
 	LogInfo("Loading timezone data");
 	zone->zone_time.setEQTimeZone(content_db.GetZoneTZ(zoneid, GetInstanceVersion()));
@@ -1420,6 +1475,8 @@ uint32 Zone::CountAuth() {
 bool Zone::Process() {
 	spawn_conditions.Process();
 
+	Expedition::SendPendingCreateRequests();
+
 	if (spawn2_timer.Check()) {
 
 		LinkedListIterator<Spawn2 *> iterator(spawn2_list);
@@ -19,6 +19,7 @@
 #define ZONE_H
 
 #include "../common/eqtime.h"
+#include "../common/expedition_lockout_timer.h"
 #include "../common/linked_list.h"
 #include "../common/rulesys.h"
 #include "../common/types.h"
@@ -36,6 +37,7 @@
 #include "dynamiczone.h"
 #include "pathfinder_interface.h"
 #include "global_loot_manager.h"
+#include "zone_map_cache.h"
 
 struct ZonePoint {
 	float  x;
@@ -86,7 +88,7 @@ class Expedition;
 class Map;
 class Mob;
 class WaterMap;
-extern EntityList entity_list;
+extern EntityList &entity_list;
 struct NPCType;
 struct ServerZoneIncomingClient_Struct;
 class MobMovementManager;
@@ -222,6 +224,19 @@ public:
 	std::vector<GridEntriesRepository::GridEntry> zone_grid_entries;
 
 	std::unordered_map<uint32, std::unique_ptr<Expedition>> expedition_cache;
+	std::vector<std::unique_ptr<Expedition>>                pending_expeditions; // awaiting world create, rejected ones are kept for quest handles
+
+	struct IncomingRoster {
+		uint32 group_id;
+		uint32 raid_id;
+	};
+	std::unordered_map<uint32, IncomingRoster> incoming_rosters; // keyed by char id, sent by world ahead of zone entry
+
+	struct IncomingExpeditionInfo {
+		uint32 expedition_id;
+		std::vector<ExpeditionLockoutTimer> lockouts;
+	};
+	std::unordered_map<uint32, IncomingExpeditionInfo> incoming_expedition_info; // keyed by char id, sent by world ahead of zone entry
 
 	time_t weather_timer;
 	Timer  spawn2_timer;
@@ -269,6 +284,7 @@ public:
 	void LoadTickItems();
 	void LoadVeteranRewards();
 	void LoadZoneDoors(const char *zone, int16 version);
+	void JoinMaps();
 	void ReloadStaticData();
 	void ReloadWorld(uint32 Option);
 	void RemoveAuth(const char *iCharName, const char *iLSKey);
@@ -367,6 +383,7 @@ private:
 	bool      pers_instance;
 	bool      pvpzone;
 	bool      m_ucss_available;
+	bool      m_cached_maps;
 	bool      staticzone;
 	bool      zone_has_current_time;
 	bool      quest_hot_reload_queued;
@@ -404,6 +421,7 @@ private:
 	Timer                               initgrids_timer;
 	Timer                               qglobal_purge_timer;
 	ZoneSpellsBlocked                   *blocked_spells;
+	std::shared_future<ZoneMaps>        m_pending_maps; // maps still loading on worker threads during Init
 
 };
 
@@ -0,0 +1,42 @@
+/**
+ * EQEmulator: Everquest Server Emulator
+ * Copyright (C) 2001-2020 EQEmulator Development Team (https://github.com/EQEmu/Server)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 2 of the License.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY except by those people which sell it, which
+ * are required to give you total support for your newly bought product;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ */
+
+#ifndef EQEMU_ZONE_CONTEXT_H
+#define EQEMU_ZONE_CONTEXT_H
+
+#include "entity.h"
+#include "worldserver.h"
+
+class Zone;
+
+/**
+ * The state one hosted zone owns: the zone itself, its entities and its world connection. A zone process
+ * runs a single context, and the zone, entity_list and worldserver globals are references into it so
+ * existing code keeps working while it is moved over to taking a context explicitly
+ */
+struct ZoneContext {
+	Zone        *zone = nullptr;
+	EntityList  entity_list;
+	WorldServer worldserver;
+};
+
+extern ZoneContext zone_context;
+
+#endif
@@ -0,0 +1,230 @@
+/**
+ * EQEmulator: Everquest Server Emulator
+ * Copyright (C) 2001-2020 EQEmulator Development Team (https://github.com/EQEmu/Server)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 2 of the License.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY except by those people which sell it, which
+ * are required to give you total support for your newly bought product;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ */
+
+#include "zone_map_cache.h"
+#include "map.h"
+#include "pathfinder_interface.h"
+#include "water_map.h"
+#include "zonedb.h"
+#include "../common/eqemu_logsys.h"
+#include "../common/rulesys.h"
+#include "../common/string_util.h"
+
+#include <algorithm>
+
+ZoneMapCache &ZoneMapCache::Instance()
+{
+	static ZoneMapCache instance;
+	return instance;
+}
+
+ZoneMapCache::~ZoneMapCache()
+{
+	Clear();
+}
+
+/**
+ * @param map_name
+ * @return
+ */
+ZoneMaps ZoneMapCache::Load(const std::string &map_name, const Map::LoadOptions &options)
+{
+	std::vector<EQEmuLogSys::DeferredMessage> zonemap_messages;
+	std::vector<EQEmuLogSys::DeferredMessage> watermap_messages;
+
+	auto zonemap = std::async(
+		std::launch::async, [map_name, options, &zonemap_messages]() {
+			EQEmuLogSys::DeferThreadMessages(&zonemap_messages);
+			auto m = Map::LoadMapFile(map_name, options);
+			EQEmuLogSys::DeferThreadMessages(nullptr);
+			return m;
+		}
+	);
+	auto watermap = std::async(
+		std::launch::async, [map_name, &watermap_messages]() {
+			EQEmuLogSys::DeferThreadMessages(&watermap_messages);
+			auto m = WaterMap::LoadWaterMapfile(map_name);
+			EQEmuLogSys::DeferThreadMessages(nullptr);
+			return m;
+		}
+	);
+
+	ZoneMaps maps;
+	EQEmuLogSys::DeferThreadMessages(&maps.log_messages);
+	maps.pathing = IPathfinder::Load(map_name);
+	EQEmuLogSys::DeferThreadMessages(nullptr);
+
+	maps.zonemap  = zonemap.get();
+	maps.watermap = watermap.get();
+
+	maps.log_messages.insert(maps.log_messages.end(), zonemap_messages.begin(), zonemap_messages.end());
+	maps.log_messages.insert(maps.log_messages.end(), watermap_messages.begin(), watermap_messages.end());
+
+	return maps;
+}
+
+/**
+ * @param maps
+ */
+void ZoneMapCache::Free(const ZoneMaps &maps)
+{
+	delete maps.zonemap;
+	delete maps.watermap;
+	delete maps.pathing;
+}
+
+void ZoneMapCache::PrewarmPopular()
+{
+	int cache_size = RuleI(Zone, MapCacheSize);
+	if (cache_size <= 0) {
+		return;
+	}
+
+	auto results = database.QueryDatabase(
+		fmt::format(
+			"SELECT zone_id, COUNT(*) AS population FROM character_data WHERE deleted_at IS NULL "
+			"AND last_login > UNIX_TIMESTAMP() - 604800 GROUP BY zone_id ORDER BY population DESC LIMIT {}",
+			cache_size
+		)
+	);
+	if (!results.Success() || results.RowCount() == 0) {
+		return;
+	}
+
+	std::vector<std::string> zone_ids;
+	for (auto row = results.begin(); row != results.end(); ++row) {
+		zone_ids.push_back(row[0]);
+	}
+
+	auto map_results = content_db.QueryDatabase(
+		fmt::format(
+			"SELECT COALESCE(map_file_name, short_name) FROM zone WHERE zoneidnumber IN ({}) AND version = 0",
+			implode(",", zone_ids)
+		)
+	);
+	if (!map_results.Success()) {
+		return;
+	}
+
+	for (auto row = map_results.begin(); row != map_results.end(); ++row) {
+		if (row[0]) {
+			Prewarm(row[0]);
+		}
+	}
+
+	LogInfo("Prewarming maps for [{}] popular zones", map_results.RowCount());
+}
+
+/**
+ * @param map_name
+ */
+void ZoneMapCache::Prewarm(const std::string &map_name)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	for (auto &e : m_entries) {
+		if (e.first == map_name) {
+			return;
+		}
+	}
+
+	m_entries.emplace_back(
+		map_name,
+		std::async(std::launch::async, &ZoneMapCache::Load, map_name, Map::LoadOptions::FromRules()).share()
+	);
+}
+
+/**
+ * @param map_name
+ * @param cached
+ * @return
+ */
+std::shared_future<ZoneMaps> ZoneMapCache::Acquire(const std::string &map_name, bool &cached)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		for (auto iter = m_entries.begin(); iter != m_entries.end(); ++iter) {
+			if (iter->first == map_name) {
+				auto maps = iter->second;
+				m_entries.erase(iter);
+				cached = true;
+
+				return maps;
+			}
+		}
+	}
+
+	cached = false;
+	return std::async(std::launch::async, &ZoneMapCache::Load, map_name, Map::LoadOptions::FromRules()).share();
+}
+
+/**
+ * @param map_name
+ * @param maps
+ */
+void ZoneMapCache::Release(const std::string &map_name, const ZoneMaps &maps)
+{
+	int cache_size = RuleI(Zone, MapCacheSize);
+	if (cache_size <= 0) {
+		Free(maps);
+		return;
+	}
+
+	std::promise<ZoneMaps> ready;
+	ready.set_value(maps);
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_entries.emplace_back(map_name, ready.get_future().share());
+	}
+
+	Trim(static_cast<size_t>(cache_size));
+}
+
+/**
+ * @param max_size
+ */
+void ZoneMapCache::Trim(size_t max_size)
+{
+	std::deque<std::shared_future<ZoneMaps>> evicted;
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		while (m_entries.size() > max_size) {
+			evicted.push_back(m_entries.front().second);
+			m_entries.pop_front();
+		}
+	}
+
+	// entries still loading are waited on outside the lock
+	for (auto &e : evicted) {
+		Free(e.get());
+	}
+}
+
+void ZoneMapCache::Clear()
+{
+	Trim(0);
+}
+
+size_t ZoneMapCache::Size()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_entries.size();
+}
@@ -0,0 +1,97 @@
+/**
+ * EQEmulator: Everquest Server Emulator
+ * Copyright (C) 2001-2020 EQEmulator Development Team (https://github.com/EQEmu/Server)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 2 of the License.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY except by those people which sell it, which
+ * are required to give you total support for your newly bought product;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ */
+
+#ifndef EQEMU_ZONE_MAP_CACHE_H
+#define EQEMU_ZONE_MAP_CACHE_H
+
+#include "../common/types.h"
+#include "../common/eqemu_logsys.h"
+#include "map.h"
+
+#include <deque>
+#include <future>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+class WaterMap;
+class IPathfinder;
+
+struct ZoneMaps {
+	ZoneMaps() : zonemap(nullptr), watermap(nullptr), pathing(nullptr) {}
+
+	Map         *zonemap;
+	WaterMap    *watermap;
+	IPathfinder *pathing;
+
+	// logged by the loader threads, written out by Zone::JoinMaps on the zone thread
+	std::vector<EQEmuLogSys::DeferredMessage> log_messages;
+};
+
+/**
+ * Parsed .map, .wtr and .nav files kept by a zone process between boots. A sleeping process can prewarm the
+ * cache with the maps of the zones players are most likely to need, Zone::Init takes its maps from the cache
+ * or loads the three files in parallel on worker threads while it reads the rest of the zone from the database.
+ * Rules are read before a load is started and log output is held until the maps are joined, the worker threads
+ * never touch the rule or log systems
+ */
+class ZoneMapCache {
+public:
+	static ZoneMapCache &Instance();
+
+	/**
+	 * Starts loading the maps for the most populated zones, up to Zone:MapCacheSize
+	 */
+	void PrewarmPopular();
+
+	/**
+	 * @param map_name
+	 * @param cached set when the maps were already loaded or loading before the call
+	 * @return future owning the maps, the caller takes ownership once it resolves
+	 */
+	std::shared_future<ZoneMaps> Acquire(const std::string &map_name, bool &cached);
+
+	/**
+	 * Returns the maps of a zone that shut down to the cache, or frees them when the cache is disabled
+	 * @param map_name
+	 * @param maps
+	 */
+	void Release(const std::string &map_name, const ZoneMaps &maps);
+
+	void Clear();
+
+	size_t Size();
+
+private:
+	ZoneMapCache() = default;
+	~ZoneMapCache();
+
+	static ZoneMaps Load(const std::string &map_name, const Map::LoadOptions &options);
+	static void Free(const ZoneMaps &maps);
+
+	void Prewarm(const std::string &map_name);
+	void Trim(size_t max_size);
+
+	std::mutex                                                       m_mutex;
+	std::deque<std::pair<std::string, std::shared_future<ZoneMaps>>> m_entries; // oldest first
+};
+
+#endif //EQEMU_ZONE_MAP_CACHE_H
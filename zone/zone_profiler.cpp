@@ -0,0 +1,312 @@
+/**
+ * EQEmulator: Everquest Server Emulator
+ * Copyright (C) 2001-2020 EQEmulator Development Team (https://github.com/EQEmu/Server)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 2 of the License.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY except by those people which sell it, which
+ * are required to give you total support for your newly bought product;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ */
+
+#include "zone_profiler.h"
+#include "../common/dbcore.h"
+#include "../common/eqemu_logsys.h"
+#include "../common/rulesys.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string.h>
+
+ZoneProfiler zone_profiler;
+
+LatencyHistogram::LatencyHistogram()
+{
+	Reset();
+}
+
+void LatencyHistogram::Reset()
+{
+	memset(buckets, 0, sizeof(buckets));
+	count = 0;
+	total = 0;
+	max   = 0;
+}
+
+void LatencyHistogram::Record(uint64 microseconds)
+{
+	buckets[BucketIndex(microseconds)]++;
+	count++;
+	total += microseconds;
+	if (microseconds > max) {
+		max = microseconds;
+	}
+}
+
+uint64 LatencyHistogram::GetPercentile(double percentile) const
+{
+	if (count == 0) {
+		return 0;
+	}
+
+	auto target = static_cast<uint64>(std::ceil(percentile / 100.0 * static_cast<double>(count)));
+	if (target < 1) {
+		target = 1;
+	}
+
+	uint64 seen = 0;
+	for (int i = 0; i < BucketCount; ++i) {
+		seen += buckets[i];
+		if (seen >= target) {
+			return std::min(BucketUpperBound(i), max);
+		}
+	}
+
+	return max;
+}
+
+/**
+ * @param value
+ * @return
+ */
+int LatencyHistogram::BucketIndex(uint64 value)
+{
+	if (value < SubBuckets) {
+		return static_cast<int>(value);
+	}
+
+	int exponent = SubBucketBits;
+	while (exponent < MaxExponent - 1 && (value >> (exponent + 1)) != 0) {
+		exponent++;
+	}
+
+	if ((value >> (exponent + 1)) != 0) {
+		return BucketCount - 1;
+	}
+
+	int sub_bucket = static_cast<int>((value >> (exponent - SubBucketBits)) & (SubBuckets - 1));
+	return (exponent - SubBucketBits + 1) * SubBuckets + sub_bucket;
+}
+
+/**
+ * @param index
+ * @return
+ */
+uint64 LatencyHistogram::BucketUpperBound(int index)
+{
+	if (index < SubBuckets) {
+		return static_cast<uint64>(index);
+	}
+
+	int    exponent   = index / SubBuckets + SubBucketBits - 1;
+	int    sub_bucket = index % SubBuckets;
+	uint64 step       = static_cast<uint64>(1) << (exponent - SubBucketBits);
+
+	return static_cast<uint64>(SubBuckets + sub_bucket) * step + step - 1;
+}
+
+ZoneProfiler::Scope::Scope(ZoneProfiler &profiler, Phase phase)
+	: profiler(profiler), phase(phase), active(profiler.IsEnabled())
+{
+	if (active) {
+		start = Clock::now();
+	}
+}
+
+ZoneProfiler::Scope::~Scope()
+{
+	if (active) {
+		profiler.Record(
+			phase,
+			std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count()
+		);
+	}
+}
+
+std::string ZoneProfiler::SlowTick::ToString() const
+{
+	std::string out = fmt::format("Tick [{}] took [{:.2f}] ms", tick_number, phase_us[Tick] / 1000.0);
+	for (int i = 0; i < Tick; ++i) {
+		if (phase_us[i] == 0) {
+			continue;
+		}
+
+		out += fmt::format(" {} [{:.2f}]", GetPhaseName(static_cast<Phase>(i)), phase_us[i] / 1000.0);
+	}
+
+	return out;
+}
+
+ZoneProfiler::ZoneProfiler()
+{
+	enabled          = false;
+	in_tick          = false;
+	database_mark_us = 0;
+	ticks            = 0;
+	slow_ticks       = 0;
+	memset(tick_phase_us, 0, sizeof(tick_phase_us));
+	memset(tick_phase_ran, 0, sizeof(tick_phase_ran));
+}
+
+/**
+ * @param phase
+ * @return
+ */
+const char *ZoneProfiler::GetPhaseName(Phase phase)
+{
+	switch (phase) {
+		case StreamIdentify:
+			return "StreamIdentify";
+		case NewClients:
+			return "NewClients";
+		case GroupProcess:
+			return "GroupProcess";
+		case DoorProcess:
+			return "DoorProcess";
+		case ObjectProcess:
+			return "ObjectProcess";
+		case CorpseProcess:
+			return "CorpseProcess";
+		case TrapProcess:
+			return "TrapProcess";
+		case RaidProcess:
+			return "RaidProcess";
+		case EntityProcess:
+			return "EntityProcess";
+		case MobProcess:
+			return "MobProcess";
+		case BeaconProcess:
+			return "BeaconProcess";
+		case EncounterProcess:
+			return "EncounterProcess";
+		case ZoneProcess:
+			return "ZoneProcess";
+		case QuestTimers:
+			return "QuestTimers";
+		case Interserver:
+			return "Interserver";
+		case WorldPackets:
+			return "WorldPackets";
+		case Database:
+			return "Database";
+		case Tick:
+			return "Tick";
+		default:
+			return "Unknown";
+	}
+}
+
+void ZoneProfiler::BeginTick()
+{
+	bool was_enabled = enabled;
+
+	enabled = RuleB(Zone, TickProfiler);
+	if (!enabled) {
+		return;
+	}
+
+	if (!was_enabled) {
+		database_mark_us = DBcore::GetThreadQueryTimeUS();
+		memset(tick_phase_us, 0, sizeof(tick_phase_us));
+		memset(tick_phase_ran, 0, sizeof(tick_phase_ran));
+	}
+
+	in_tick    = true;
+	tick_start = Clock::now();
+}
+
+void ZoneProfiler::EndTick()
+{
+	if (!enabled || !in_tick) {
+		return;
+	}
+
+	in_tick = false;
+
+	// world packets and queries made between ticks are charged to the tick that follows them
+	uint64 database_us = DBcore::GetThreadQueryTimeUS();
+	tick_phase_us[Database]  = database_us - database_mark_us;
+	tick_phase_ran[Database] = tick_phase_us[Database] > 0;
+	database_mark_us = database_us;
+
+	tick_phase_us[Tick]  = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - tick_start).count();
+	tick_phase_ran[Tick] = true;
+
+	// phases that didn't run this tick would only drag the percentiles toward zero
+	for (int i = 0; i < MaxPhase; ++i) {
+		if (tick_phase_ran[i]) {
+			histograms[i].Record(tick_phase_us[i]);
+		}
+	}
+
+	ticks++;
+
+	int threshold_ms = RuleI(Zone, SlowTickThresholdMS);
+	if (threshold_ms > 0 && tick_phase_us[Tick] >= static_cast<uint64>(threshold_ms) * 1000) {
+		SlowTick trace;
+		trace.time_stamp  = time(nullptr);
+		trace.tick_number = ticks;
+		memcpy(trace.phase_us, tick_phase_us, sizeof(trace.phase_us));
+
+		slow_ticks++;
+		LogWarning("Slow zone tick, {}", trace.ToString());
+
+		slow_tick_traces.push_back(trace);
+		while (slow_tick_traces.size() > MaxSlowTicks) {
+			slow_tick_traces.pop_front();
+		}
+	}
+
+	memset(tick_phase_us, 0, sizeof(tick_phase_us));
+	memset(tick_phase_ran, 0, sizeof(tick_phase_ran));
+}
+
+/**
+ * @param phase
+ * @param microseconds
+ */
+void ZoneProfiler::Record(Phase phase, uint64 microseconds)
+{
+	tick_phase_us[phase] += microseconds;
+	tick_phase_ran[phase] = true;
+}
+
+/**
+ * @param packets
+ * @param milliseconds
+ */
+void ZoneProfiler::RecordZoneIn(uint32 packets, uint32 milliseconds)
+{
+	zone_in_packets.Record(packets);
+	zone_in_time.Record(milliseconds);
+}
+
+/**
+ * @param milliseconds
+ */
+void ZoneProfiler::RecordZoneBoot(uint32 milliseconds)
+{
+	zone_boot_time.Record(milliseconds);
+}
+
+void ZoneProfiler::Reset()
+{
+	for (auto &histogram : histograms) {
+		histogram.Reset();
+	}
+
+	ticks      = 0;
+	slow_ticks = 0;
+	slow_tick_traces.clear();
+	zone_in_packets.Reset();
+	zone_in_time.Reset();
+}
@@ -0,0 +1,157 @@
+/**
+ * EQEmulator: Everquest Server Emulator
+ * Copyright (C) 2001-2020 EQEmulator Development Team (https://github.com/EQEmu/Server)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 2 of the License.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY except by those people which sell it, which
+ * are required to give you total support for your newly bought product;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ */
+
+#ifndef EQEMU_ZONE_PROFILER_H
+#define EQEMU_ZONE_PROFILER_H
+
+#include "../common/types.h"
+
+#include <chrono>
+#include <deque>
+#include <string>
+
+/**
+ * Log-linear latency histogram in microseconds. Values are bucketed by power of two and then split into
+ * SubBuckets linear steps, so every recorded value is within ~12% of its bucket bound no matter the magnitude
+ */
+class LatencyHistogram {
+public:
+	static const int SubBucketBits = 3;
+	static const int SubBuckets    = 1 << SubBucketBits;
+	static const int MaxExponent   = 32;
+	static const int BucketCount   = (MaxExponent - SubBucketBits + 1) * SubBuckets;
+
+	LatencyHistogram();
+
+	void Record(uint64 microseconds);
+	void Reset();
+
+	uint64 GetCount() const { return count; }
+	uint64 GetTotal() const { return total; }
+	uint64 GetMax() const { return max; }
+	double GetMean() const { return count ? static_cast<double>(total) / static_cast<double>(count) : 0.0; }
+
+	/**
+	 * @param percentile 0-100
+	 * @return upper bound of the bucket holding the requested percentile
+	 */
+	uint64 GetPercentile(double percentile) const;
+
+private:
+	static int BucketIndex(uint64 value);
+	static uint64 BucketUpperBound(int index);
+
+	uint64 buckets[BucketCount];
+	uint64 count;
+	uint64 total;
+	uint64 max;
+};
+
+/**
+ * Timing of the zone main loop, on by default and toggled with Zone:TickProfiler. Phases are timed with ZoneProfiler::Scope,
+ * summed per tick and fed into the histogram of each phase that ran when the tick ends; ticks slower than
+ * Zone:SlowTickThresholdMS keep a per phase breakdown that is logged and retained for #tickstats and the websocket api
+ */
+class ZoneProfiler {
+public:
+	enum Phase {
+		StreamIdentify = 0,
+		NewClients,
+		GroupProcess,
+		DoorProcess,
+		ObjectProcess,
+		CorpseProcess,
+		TrapProcess,
+		RaidProcess,
+		EntityProcess,
+		MobProcess,
+		BeaconProcess,
+		EncounterProcess,
+		ZoneProcess,
+		QuestTimers,
+		Interserver,
+		WorldPackets,
+		Database,
+		Tick,
+		MaxPhase
+	};
+
+	struct SlowTick {
+		time_t      time_stamp;
+		uint64      tick_number;
+		uint64      phase_us[MaxPhase];
+		std::string ToString() const;
+	};
+
+	typedef std::chrono::steady_clock Clock;
+
+	class Scope {
+	public:
+		Scope(ZoneProfiler &profiler, Phase phase);
+		~Scope();
+
+	private:
+		ZoneProfiler      &profiler;
+		Phase             phase;
+		bool              active;
+		Clock::time_point start;
+	};
+
+	static const size_t MaxSlowTicks = 32;
+
+	ZoneProfiler();
+
+	static const char *GetPhaseName(Phase phase);
+
+	void BeginTick();
+	void EndTick();
+	void Record(Phase phase, uint64 microseconds);
+	void RecordZoneIn(uint32 packets, uint32 milliseconds);
+	void RecordZoneBoot(uint32 milliseconds);
+	void Reset();
+
+	bool IsEnabled() const { return enabled; }
+	uint64 GetTicks() const { return ticks; }
+	uint64 GetSlowTicks() const { return slow_ticks; }
+	const LatencyHistogram &GetHistogram(Phase phase) const { return histograms[phase]; }
+	const std::deque<SlowTick> &GetSlowTickTraces() const { return slow_tick_traces; }
+	const LatencyHistogram &GetZoneInPackets() const { return zone_in_packets; }
+	const LatencyHistogram &GetZoneInTime() const { return zone_in_time; }
+	const LatencyHistogram &GetZoneBootTime() const { return zone_boot_time; }
+
+private:
+	bool                 enabled;
+	bool                 in_tick;
+	Clock::time_point    tick_start;
+	uint64               tick_phase_us[MaxPhase];
+	bool                 tick_phase_ran[MaxPhase];
+	uint64               database_mark_us;
+	uint64               ticks;
+	uint64               slow_ticks;
+	LatencyHistogram     histograms[MaxPhase];
+	std::deque<SlowTick> slow_tick_traces;
+	LatencyHistogram     zone_in_packets; // spawn related packets per zone in, not a latency despite the type
+	LatencyHistogram     zone_in_time;    // ms from zone in until the last owed spawn was sent
+	LatencyHistogram     zone_boot_time;  // ms from boot request until the zone is ready for clients, kept by Reset
+};
+
+extern ZoneProfiler zone_profiler;
+
+#endif //EQEMU_ZONE_PROFILER_H
@@ -19,7 +19,7 @@
 #include <iostream>
 #include <fmt/format.h>
 
-extern Zone* zone;
+extern Zone*& zone;
 
 ZoneDatabase database;
 ZoneDatabase content_db;
@@ -3392,23 +3392,16 @@ void ZoneDatabase::RefreshGroupFromDB(Client *client){
 
 	int index = 0;
 
-	std::string query = StringFormat("SELECT name FROM group_id WHERE groupid = %d", group->GetID());
-	auto results = QueryDatabase(query);
-	if (!results.Success())
-	{
-	}
-	else
-	{
-		for (auto row = results.begin(); row != results.end(); ++row) {
-			if(index >= 6)
-				continue;
+	// the roster world last sent this zone, group_id may not be written yet
+	for (int i = 0; i < MAX_GROUP_MEMBERS; ++i) {
+		if (index >= 6)
+			break;
 
-            if(strcmp(client->GetName(), row[0]) == 0)
-				continue;
+		if (group->membername[i][0] == '\0' || strcmp(client->GetName(), group->membername[i]) == 0)
+			continue;
 
-			strcpy(gu->membername[index], row[0]);
-			index++;
-		}
+		strcpy(gu->membername[index], group->membername[i]);
+		index++;
 	}
 
 	client->QueuePacket(outapp);
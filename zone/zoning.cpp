@@ -33,8 +33,8 @@
 #endif
 
 extern QueryServ* QServ;
-extern WorldServer worldserver;
-extern Zone* zone;
+extern WorldServer &worldserver;
+extern Zone*& zone;
 
 #include "../common/repositories/zone_repository.h"
 #include "../common/content/world_content_service.h"